@@ -0,0 +1,115 @@
+#include <algorithm>
+#include <random>
+#include <string>
+#include <string_view>
+#include <utility>
+#include <vector>
+
+#include "SwitchStr/AdaptiveSwitch.hpp"
+#include "SwitchStr/Matcher.hpp"
+#include "SwitchStr/SwitchTable.hpp"
+#include "benchmark/benchmark.h"
+
+namespace {
+
+/// 50 distinct lowercase keywords
+auto MakeKeywords() -> std::vector<std::string> {
+  std::mt19937 rng(7);
+  std::uniform_int_distribution<int> letter('a', 'z');
+  std::uniform_int_distribution<std::size_t> length(3, 10);
+
+  std::vector<std::string> keywords;
+  while (keywords.size() < 50) {
+    std::string keyword(length(rng), '\0');
+    std::generate(keyword.begin(), keyword.end(),
+                  [&] { return letter(rng); });
+    if (std::find(keywords.begin(), keywords.end(), keyword) ==
+        keywords.end()) {
+      keywords.push_back(std::move(keyword));
+    }
+  }
+  return keywords;
+}
+
+/// Skewed traffic: 90% of the inputs are the 3 LAST keywords
+auto MakeInputs(const std::vector<std::string>& keywords)
+    -> std::vector<std::string> {
+  std::mt19937 rng(42);
+  std::uniform_int_distribution<std::size_t> percent(0, 99);
+  std::uniform_int_distribution<std::size_t> hot(keywords.size() - 3,
+                                                 keywords.size() - 1);
+  std::uniform_int_distribution<std::size_t> any(0, keywords.size() - 1);
+
+  std::vector<std::string> inputs(4096);
+  for (auto& input : inputs) {
+    input = keywords[(percent(rng) < 90) ? hot(rng) : any(rng)];
+  }
+  return inputs;
+}
+
+void BM_Skewed_Sequential(benchmark::State& state) {
+  const auto keywords = MakeKeywords();
+  const auto inputs = MakeInputs(keywords);
+
+  std::vector<swstr::EqualsMatcher> cases;
+  for (const auto& keyword : keywords) {
+    cases.push_back(swstr::Equals(keyword));
+  }
+
+  for (auto _ : state) {
+    for (const auto& input : inputs) {
+      int res = -1;
+      for (std::size_t i = 0; i < cases.size(); ++i) {
+        if (swstr::IsMatching(cases[i], input)) {
+          res = static_cast<int>(i);
+          break;
+        }
+      }
+      benchmark::DoNotOptimize(res);
+    }
+  }
+  state.SetItemsProcessed(state.iterations() * inputs.size());
+}
+
+void BM_Skewed_AdaptiveSwitch(benchmark::State& state) {
+  const auto keywords = MakeKeywords();
+  const auto inputs = MakeInputs(keywords);
+
+  auto builder = swstr::AdaptiveSwitch<int>::Builder();
+  for (std::size_t i = 0; i < keywords.size(); ++i) {
+    builder.Case(swstr::Equals(keywords[i]), static_cast<int>(i));
+  }
+  auto adaptive = std::move(builder).Build();
+
+  for (auto _ : state) {
+    for (const auto& input : inputs) {
+      benchmark::DoNotOptimize(adaptive.LookupOr(input, -1));
+    }
+  }
+  state.SetItemsProcessed(state.iterations() * inputs.size());
+}
+
+// Reference: all cases being Equals, the table uses a hash table
+void BM_Skewed_SwitchTable(benchmark::State& state) {
+  const auto keywords = MakeKeywords();
+  const auto inputs = MakeInputs(keywords);
+
+  auto builder = swstr::SwitchTable<int>::Builder();
+  for (std::size_t i = 0; i < keywords.size(); ++i) {
+    builder.Case(swstr::Equals(keywords[i]), static_cast<int>(i));
+  }
+  const auto table = std::move(builder).Build();
+
+  for (auto _ : state) {
+    for (const auto& input : inputs) {
+      benchmark::DoNotOptimize(table.LookupOr(input, -1));
+    }
+  }
+  state.SetItemsProcessed(state.iterations() * inputs.size());
+}
+
+BENCHMARK(BM_Skewed_Sequential);
+BENCHMARK(BM_Skewed_AdaptiveSwitch);
+BENCHMARK(BM_Skewed_SwitchTable);
+
+}  // namespace
@@ -0,0 +1,105 @@
+#include <functional>
+#include <string_view>
+
+#include "SwitchStr/Matcher.hpp"
+#include "benchmark/benchmark.h"
+
+namespace {
+
+// std::function (heap allocated for matchers bigger than 16 bytes) is used as
+// the reference type erasure
+
+constexpr std::string_view kInput = "GET /index.html HTTP/1.1";
+
+auto MakeMatcher() { return swstr::Contains("index"); }
+
+void BM_Construct_StdFunction(benchmark::State& state) {
+  const auto matcher = MakeMatcher();
+  for (auto _ : state) {
+    std::function<bool(std::string_view)> erased(matcher);
+    benchmark::DoNotOptimize(erased);
+  }
+}
+
+void BM_Construct_AnyMatcher(benchmark::State& state) {
+  const auto matcher = MakeMatcher();
+  for (auto _ : state) {
+    swstr::AnyMatcher erased(matcher);
+    benchmark::DoNotOptimize(erased);
+  }
+}
+
+void BM_Copy_StdFunction(benchmark::State& state) {
+  const std::function<bool(std::string_view)> erased(MakeMatcher());
+  for (auto _ : state) {
+    std::function<bool(std::string_view)> copy(erased);
+    benchmark::DoNotOptimize(copy);
+  }
+}
+
+void BM_Copy_AnyMatcher(benchmark::State& state) {
+  const swstr::AnyMatcher erased(MakeMatcher());
+  for (auto _ : state) {
+    swstr::AnyMatcher copy(erased);
+    benchmark::DoNotOptimize(copy);
+  }
+}
+
+void BM_Match_StdFunction(benchmark::State& state) {
+  const std::function<bool(std::string_view)> erased(MakeMatcher());
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(erased(kInput));
+  }
+}
+
+void BM_Match_AnyMatcher(benchmark::State& state) {
+  const swstr::AnyMatcher erased(MakeMatcher());
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(erased.IsMatching(kInput));
+  }
+}
+
+// Reference points: the matcher used directly (no type erasure), and the
+// equivalent hand written lambda. The input is laundered through
+// DoNotOptimize() such that the compiler can't constant fold the match.
+
+void BM_Match_Direct(benchmark::State& state) {
+  const auto matcher = MakeMatcher();
+  std::string_view input = kInput;
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(input);
+    benchmark::DoNotOptimize(swstr::IsMatching(matcher, input));
+  }
+}
+
+void BM_Match_Lambda(benchmark::State& state) {
+  const auto matcher = [](std::string_view str) {
+    return str.find("index") != std::string_view::npos;
+  };
+  std::string_view input = kInput;
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(input);
+    benchmark::DoNotOptimize(matcher(input));
+  }
+}
+
+void BM_Match_AnyMatcherOfLambda(benchmark::State& state) {
+  const swstr::AnyMatcher erased([](std::string_view str) {
+    return str.find("index") != std::string_view::npos;
+  });
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(erased.IsMatching(kInput));
+  }
+}
+
+BENCHMARK(BM_Construct_StdFunction);
+BENCHMARK(BM_Construct_AnyMatcher);
+BENCHMARK(BM_Copy_StdFunction);
+BENCHMARK(BM_Copy_AnyMatcher);
+BENCHMARK(BM_Match_StdFunction);
+BENCHMARK(BM_Match_AnyMatcher);
+BENCHMARK(BM_Match_Direct);
+BENCHMARK(BM_Match_Lambda);
+BENCHMARK(BM_Match_AnyMatcherOfLambda);
+
+}  // namespace
@@ -0,0 +1,144 @@
+#include <algorithm>
+#include <cstdint>
+#include <random>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include "SwitchStr/Batch.hpp"
+#include "SwitchStr/SwitchTable.hpp"
+#include "benchmark/benchmark.h"
+
+namespace {
+
+/// Random lowercase records, 3 out of 8 using "record" as the whole string,
+/// its prefix or its suffix
+auto MakeRecords(std::size_t count) -> std::vector<std::string> {
+  std::mt19937 rng(42);
+  std::uniform_int_distribution<int> letter('a', 'z');
+  std::uniform_int_distribution<std::size_t> length(4, 24);
+
+  std::vector<std::string> records(count);
+  for (std::size_t i = 0; i < count; ++i) {
+    auto& record = records[i];
+    record.resize(length(rng));
+    std::generate(record.begin(), record.end(), [&] { return letter(rng); });
+
+    switch (i % 8) {
+      case 0:
+        record = "record";
+        break;
+      case 2:
+        record = "record-" + record;
+        break;
+      case 4:
+        record += "-record";
+        break;
+      default:
+        break;
+    }
+  }
+  std::shuffle(records.begin(), records.end(), rng);
+  return records;
+}
+
+constexpr std::size_t kBatchSize = 64 << 10;
+
+template <typename Matcher>
+void BM_Scalar(benchmark::State& state, Matcher m) {
+  const auto records = MakeRecords(kBatchSize);
+  const std::vector<std::string_view> strs(records.begin(), records.end());
+  std::vector<std::uint8_t> out(strs.size());
+
+  for (auto _ : state) {
+    for (std::size_t i = 0; i < strs.size(); ++i) {
+      out[i] = swstr::IsMatching(m, strs[i]);
+    }
+    benchmark::DoNotOptimize(out.data());
+    benchmark::ClobberMemory();
+  }
+  state.SetItemsProcessed(state.iterations() * strs.size());
+}
+
+template <typename Matcher>
+void BM_Batch(benchmark::State& state, Matcher m) {
+  const auto records = MakeRecords(kBatchSize);
+  const std::vector<std::string_view> strs(records.begin(), records.end());
+  std::vector<std::uint8_t> out(strs.size());
+
+  for (auto _ : state) {
+    swstr::IsMatching(m, strs, out);
+    benchmark::DoNotOptimize(out.data());
+    benchmark::ClobberMemory();
+  }
+  state.SetItemsProcessed(state.iterations() * strs.size());
+}
+
+BENCHMARK_CAPTURE(BM_Scalar, Equals, swstr::Equals("record"));
+BENCHMARK_CAPTURE(BM_Batch, Equals, swstr::Equals("record"));
+BENCHMARK_CAPTURE(BM_Scalar, StartsWith, swstr::StartsWith("record-"));
+BENCHMARK_CAPTURE(BM_Batch, StartsWith, swstr::StartsWith("record-"));
+BENCHMARK_CAPTURE(BM_Scalar, EndsWith, swstr::EndsWith("-record"));
+BENCHMARK_CAPTURE(BM_Batch, EndsWith, swstr::EndsWith("-record"));
+BENCHMARK_CAPTURE(BM_Scalar, Contains, swstr::Contains("cord"));
+BENCHMARK_CAPTURE(BM_Batch, Contains, swstr::Contains("cord"));
+BENCHMARK_CAPTURE(BM_Scalar, ContainsR, swstr::ContainsR("cord"));
+BENCHMARK_CAPTURE(BM_Batch, ContainsR, swstr::ContainsR("cord"));
+
+/// SwitchTable over 16K distinct keys (bigger than the L1/L2 caches)
+auto MakeTable(const std::vector<std::string>& records)
+    -> swstr::SwitchTable<int> {
+  auto builder = swstr::SwitchTable<int>::Builder();
+  for (std::size_t i = 0; i < records.size(); i += 4) {
+    builder.Case(swstr::Equals(records[i] + "!"), static_cast<int>(i));
+  }
+  return std::move(builder).Build();
+}
+
+auto MakeLookups(const std::vector<std::string>& records)
+    -> std::vector<std::string> {
+  std::vector<std::string> lookups;
+  lookups.reserve(records.size());
+  for (std::size_t i = 0; i < records.size(); ++i) {
+    lookups.push_back(records[i] + (i % 2 == 0 ? "!" : "?"));
+  }
+  std::shuffle(lookups.begin(), lookups.end(), std::mt19937(3));
+  return lookups;
+}
+
+void BM_IndexOf_Scalar(benchmark::State& state) {
+  const auto records = MakeRecords(kBatchSize);
+  const auto table = MakeTable(records);
+  const auto lookups = MakeLookups(records);
+  const std::vector<std::string_view> strs(lookups.begin(), lookups.end());
+  std::vector<std::size_t> out(strs.size());
+
+  for (auto _ : state) {
+    for (std::size_t i = 0; i < strs.size(); ++i) {
+      out[i] = table.IndexOf(strs[i]);
+    }
+    benchmark::DoNotOptimize(out.data());
+    benchmark::ClobberMemory();
+  }
+  state.SetItemsProcessed(state.iterations() * strs.size());
+}
+
+void BM_IndexOf_Batch(benchmark::State& state) {
+  const auto records = MakeRecords(kBatchSize);
+  const auto table = MakeTable(records);
+  const auto lookups = MakeLookups(records);
+  const std::vector<std::string_view> strs(lookups.begin(), lookups.end());
+  std::vector<std::size_t> out(strs.size());
+
+  for (auto _ : state) {
+    swstr::IndexOf(table, strs, out);
+    benchmark::DoNotOptimize(out.data());
+    benchmark::ClobberMemory();
+  }
+  state.SetItemsProcessed(state.iterations() * strs.size());
+}
+
+BENCHMARK(BM_IndexOf_Scalar);
+BENCHMARK(BM_IndexOf_Batch);
+
+}  // namespace
@@ -0,0 +1,87 @@
+#include <random>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include "SwitchStr/CachedSwitch.hpp"
+#include "SwitchStr/Matcher.hpp"
+#include "benchmark/benchmark.h"
+
+namespace {
+
+/// 200 Contains() cases, like a user agent classifier
+auto MakeNeedles() -> std::vector<std::string> {
+  std::vector<std::string> needles;
+  for (int i = 0; i < 200; ++i) {
+    needles.push_back("Agent" + std::to_string(i) + "/");
+  }
+  return needles;
+}
+
+const std::vector<std::string> kNeedles = MakeNeedles();
+
+/// 64 distinct user agents, received again and again
+auto MakeInputs(std::size_t count) -> std::vector<std::string> {
+  std::mt19937 rng(42);
+  std::uniform_int_distribution<int> pick(0, 63);
+
+  std::vector<std::string> inputs;
+  inputs.reserve(count);
+  for (std::size_t i = 0; i < count; ++i) {
+    const int agent = pick(rng);
+    inputs.push_back("Mozilla/5.0 (X11; Linux x86_64) Agent" +
+                     std::to_string(agent * 3) + "/1." +
+                     std::to_string(agent));
+  }
+  return inputs;
+}
+
+const std::vector<std::string> kInputs = MakeInputs(4096);
+
+/// The matcher chain memoized: first case matching, -1 otherwise
+auto Classify(std::string_view str) -> int {
+  for (std::size_t i = 0; i < kNeedles.size(); ++i) {
+    if (swstr::Contains(kNeedles[i]).IsMatching(str)) {
+      return static_cast<int>(i);
+    }
+  }
+  return -1;
+}
+
+void BM_Cached_None(benchmark::State& state) {
+  for (auto _ : state) {
+    for (const auto& str : kInputs) {
+      benchmark::DoNotOptimize(Classify(str));
+    }
+  }
+  state.SetItemsProcessed(state.iterations() * kInputs.size());
+}
+BENCHMARK(BM_Cached_None);
+
+void BM_Cached_CachedSwitch(benchmark::State& state) {
+  swstr::CachedSwitch classify(&Classify, state.range(0));
+
+  for (auto _ : state) {
+    for (const auto& str : kInputs) {
+      benchmark::DoNotOptimize(classify(str));
+    }
+  }
+  state.SetItemsProcessed(state.iterations() * kInputs.size());
+  state.counters["HitRate"] = classify.Stats().HitRate();
+}
+// Capacity 16: most of the agents are evicted before being hit again
+BENCHMARK(BM_Cached_CachedSwitch)->Arg(16)->Arg(1024);
+
+void BM_Cached_ThreadLocal(benchmark::State& state) {
+  static const swstr::ThreadLocalCachedSwitch classify(&Classify, 1024);
+
+  for (auto _ : state) {
+    for (const auto& str : kInputs) {
+      benchmark::DoNotOptimize(classify(str));
+    }
+  }
+  state.SetItemsProcessed(state.iterations() * kInputs.size());
+}
+BENCHMARK(BM_Cached_ThreadLocal)->Threads(1)->Threads(4);
+
+}  // namespace
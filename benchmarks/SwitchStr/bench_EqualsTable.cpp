@@ -0,0 +1,98 @@
+#include <random>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include "SwitchStr/EqualsTable.hpp"
+#include "SwitchStr/Matcher.hpp"
+#include "SwitchStr/SwitchTable.hpp"
+#include "benchmark/benchmark.h"
+
+namespace {
+
+/// Hostnames loaded from a configuration, sharing long suffixes
+auto MakeHosts(std::size_t count) -> std::vector<std::string> {
+  std::vector<std::string> hosts;
+  hosts.reserve(count);
+  for (std::size_t i = 0; i < count; ++i) {
+    hosts.push_back("node-" + std::to_string(i) + ".eu-west.example.com");
+  }
+  return hosts;
+}
+
+/// Hostnames looked up, 1 out of 4 unknown
+auto MakeInputs(std::size_t hosts, std::size_t count)
+    -> std::vector<std::string> {
+  std::mt19937 rng(42);
+  std::uniform_int_distribution<std::size_t> pick(0, hosts - 1);
+
+  std::vector<std::string> inputs;
+  inputs.reserve(count);
+  for (std::size_t i = 0; i < count; ++i) {
+    inputs.push_back("node-" + std::to_string(pick(rng)) +
+                     (i % 4 == 0 ? ".us-east" : ".eu-west") + ".example.com");
+  }
+  return inputs;
+}
+
+/// Reference: the vector of type erased matchers, scanned linearly
+void BM_EqualsTable_AnyMatchers(benchmark::State& state) {
+  const auto hosts = MakeHosts(state.range(0));
+  const auto inputs = MakeInputs(hosts.size(), 256);
+
+  std::vector<swstr::AnyMatcher> matchers;
+  for (const auto& host : hosts) {
+    matchers.emplace_back(swstr::Equals(host));
+  }
+
+  for (auto _ : state) {
+    for (const auto& str : inputs) {
+      std::size_t i = 0;
+      while ((i < matchers.size()) and not matchers[i].IsMatching(str)) ++i;
+      benchmark::DoNotOptimize(i);
+    }
+  }
+  state.SetItemsProcessed(state.iterations() * inputs.size());
+}
+BENCHMARK(BM_EqualsTable_AnyMatchers)->Arg(1000)->Arg(30000);
+
+/// SwitchTable hash strategy (linear probing, 32 bits tags)
+void BM_EqualsTable_SwitchTable(benchmark::State& state) {
+  const auto hosts = MakeHosts(state.range(0));
+  const auto inputs = MakeInputs(hosts.size(), 4096);
+
+  auto builder = swstr::SwitchTable<int>::Builder();
+  for (std::size_t i = 0; i < hosts.size(); ++i) {
+    builder.Case(swstr::Equals(hosts[i]), static_cast<int>(i));
+  }
+  const auto table = std::move(builder).Build();
+
+  for (auto _ : state) {
+    for (const auto& str : inputs) {
+      benchmark::DoNotOptimize(table.LookupOr(str, -1));
+    }
+  }
+  state.SetItemsProcessed(state.iterations() * inputs.size());
+}
+BENCHMARK(BM_EqualsTable_SwitchTable)->Arg(1000)->Arg(30000);
+
+void BM_EqualsTable_Lookup(benchmark::State& state) {
+  const auto hosts = MakeHosts(state.range(0));
+  const auto inputs = MakeInputs(hosts.size(), 4096);
+
+  auto builder = swstr::EqualsTable<int>::Builder();
+  for (std::size_t i = 0; i < hosts.size(); ++i) {
+    builder.Case(hosts[i], static_cast<int>(i));
+  }
+  const auto table = std::move(builder).Build();
+
+  for (auto _ : state) {
+    for (const auto& str : inputs) {
+      benchmark::DoNotOptimize(table.LookupOr(str, -1));
+    }
+  }
+  state.SetItemsProcessed(state.iterations() * inputs.size());
+}
+BENCHMARK(BM_EqualsTable_Lookup)->Arg(1000)->Arg(30000);
+
+}  // namespace
@@ -0,0 +1,99 @@
+#include <random>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include "SwitchStr/Instrumentation.hpp"
+#include "SwitchStr/Matcher.hpp"
+#include "SwitchStr/SwitchStr.hpp"
+#include "benchmark/benchmark.h"
+
+// Built twice: within SwitchStr-bench (instrumentation disabled, such that the
+// SwitchStr chain must be as fast as the hand written one), and as
+// SwitchStr-bench-instrumentation (enabled, measuring the probes overhead)
+
+namespace {
+
+/// 4096 HTTP methods, 1 out of 8 being unknown
+auto MakeMethods() -> std::vector<std::string> {
+  const std::vector<std::string> methods = {"GET",    "HEAD",    "POST",
+                                            "PUT",    "DELETE",  "CONNECT",
+                                            "OPTIONS", "TRACE"};
+  std::mt19937 rng(42);
+  std::uniform_int_distribution<std::size_t> pick(0, methods.size() - 1);
+
+  std::vector<std::string> inputs(4096);
+  for (std::size_t i = 0; i < inputs.size(); ++i) {
+    inputs[i] = (i % 8 == 0) ? "PATCH" : methods[pick(rng)];
+  }
+  return inputs;
+}
+
+auto Label() -> const char* {
+  return SwitchStr_ENABLE_INSTRUMENTATION ? "instrumented" : "";
+}
+
+void BM_Instrumentation_SwitchStr(benchmark::State& state) {
+  const auto inputs = MakeMethods();
+  swstr::instrument::EnableCycles(state.range(0) != 0);
+
+  for (auto _ : state) {
+    for (const auto& input : inputs) {
+      benchmark::DoNotOptimize(swstr::SwitchStr<int>(input)
+                                   .Case("GET", 0)
+                                   .Case("HEAD", 1)
+                                   .Case("POST", 2)
+                                   .Case("PUT", 3)
+                                   .Case("DELETE", 4)
+                                   .Case("CONNECT", 5)
+                                   .Case("OPTIONS", 6)
+                                   .Case("TRACE", 7)
+                                   .Default(-1));
+    }
+  }
+
+  swstr::instrument::EnableCycles(false);
+  state.SetItemsProcessed(state.iterations() * inputs.size());
+  state.SetLabel(Label());
+}
+
+void BM_Instrumentation_HandWritten(benchmark::State& state) {
+  const auto inputs = MakeMethods();
+  const auto classify = [](std::string_view str) {
+    if (str == "GET") return 0;
+    if (str == "HEAD") return 1;
+    if (str == "POST") return 2;
+    if (str == "PUT") return 3;
+    if (str == "DELETE") return 4;
+    if (str == "CONNECT") return 5;
+    if (str == "OPTIONS") return 6;
+    if (str == "TRACE") return 7;
+    return -1;
+  };
+
+  for (auto _ : state) {
+    for (const auto& input : inputs) {
+      benchmark::DoNotOptimize(classify(input));
+    }
+  }
+  state.SetItemsProcessed(state.iterations() * inputs.size());
+}
+
+void BM_Instrumentation_AnyMatcher(benchmark::State& state) {
+  const auto inputs = MakeMethods();
+  const swstr::AnyMatcher matcher(swstr::StartsWith("P"));
+
+  for (auto _ : state) {
+    for (const auto& input : inputs) {
+      benchmark::DoNotOptimize(matcher.IsMatching(input));
+    }
+  }
+  state.SetItemsProcessed(state.iterations() * inputs.size());
+  state.SetLabel(Label());
+}
+
+BENCHMARK(BM_Instrumentation_SwitchStr)->ArgName("cycles")->Arg(0)->Arg(1);
+BENCHMARK(BM_Instrumentation_HandWritten);
+BENCHMARK(BM_Instrumentation_AnyMatcher);
+
+}  // namespace
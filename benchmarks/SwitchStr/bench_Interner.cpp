@@ -0,0 +1,117 @@
+#include <random>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include "SwitchStr/Interner.hpp"
+#include "SwitchStr/Matcher.hpp"
+#include "SwitchStr/SwitchTable.hpp"
+#include "benchmark/benchmark.h"
+
+namespace {
+
+/// 64 metric names, sharing long prefixes/suffixes
+auto MakeMetrics() -> std::vector<std::string> {
+  std::vector<std::string> metrics;
+  for (const char* group : {"system.cpu", "system.memory", "process.io",
+                            "network.interface"}) {
+    for (int i = 0; i < 16; ++i) {
+      metrics.push_back(std::string(group) + ".counter_" + std::to_string(i) +
+                        ".total");
+    }
+  }
+  return metrics;
+}
+
+const std::vector<std::string> kMetrics = MakeMetrics();
+
+/// The same metric names, received again and again (1 out of 8 unknown)
+auto MakeInputs(std::size_t count) -> std::vector<std::string> {
+  std::mt19937 rng(42);
+  std::uniform_int_distribution<std::size_t> pick(0, kMetrics.size() - 1);
+
+  std::vector<std::string> inputs;
+  inputs.reserve(count);
+  for (std::size_t i = 0; i < count; ++i) {
+    inputs.push_back(kMetrics[pick(rng)] + (i % 8 == 0 ? "_old" : ""));
+  }
+  return inputs;
+}
+
+const std::vector<std::string> kInputs = MakeInputs(4096);
+
+/// Reference: the bytes of each input are hashed and compared
+void BM_Symbols_SwitchTable(benchmark::State& state) {
+  auto builder = swstr::SwitchTable<int>::Builder();
+  for (std::size_t i = 0; i < kMetrics.size(); ++i) {
+    builder.Case(swstr::Equals(kMetrics[i]), static_cast<int>(i));
+  }
+  const auto table = std::move(builder).Build();
+
+  for (auto _ : state) {
+    for (const auto& str : kInputs) {
+      benchmark::DoNotOptimize(table.LookupOr(str, -1));
+    }
+  }
+  state.SetItemsProcessed(state.iterations() * kInputs.size());
+}
+BENCHMARK(BM_Symbols_SwitchTable);
+
+/// Each input is looked up in the interner, then dispatched on its symbol
+void BM_Symbols_FindThenTable(benchmark::State& state) {
+  swstr::Interner interner;
+  auto builder = swstr::SymbolTable<int>::Builder(interner);
+  for (std::size_t i = 0; i < kMetrics.size(); ++i) {
+    builder.Case(kMetrics[i], static_cast<int>(i));
+  }
+  const auto table = std::move(builder).Build();
+
+  for (auto _ : state) {
+    for (const auto& str : kInputs) {
+      benchmark::DoNotOptimize(table.LookupOr(interner.Find(str), -1));
+    }
+  }
+  state.SetItemsProcessed(state.iterations() * kInputs.size());
+}
+BENCHMARK(BM_Symbols_FindThenTable);
+
+/// Inputs interned once (i.e. when parsed), then dispatched many times
+void BM_Symbols_Table(benchmark::State& state) {
+  swstr::Interner interner;
+  auto builder = swstr::SymbolTable<int>::Builder(interner);
+  for (std::size_t i = 0; i < kMetrics.size(); ++i) {
+    builder.Case(kMetrics[i], static_cast<int>(i));
+  }
+  const auto table = std::move(builder).Build();
+
+  std::vector<swstr::Symbol> symbols;
+  for (const auto& str : kInputs) {
+    symbols.push_back(interner.Intern(str));
+  }
+
+  for (auto _ : state) {
+    for (const swstr::Symbol symbol : symbols) {
+      benchmark::DoNotOptimize(table.LookupOr(symbol, -1));
+    }
+  }
+  state.SetItemsProcessed(state.iterations() * symbols.size());
+}
+BENCHMARK(BM_Symbols_Table);
+
+/// Interning strings already interned: lock free lookup only
+void BM_Symbols_Intern(benchmark::State& state) {
+  swstr::Interner interner;
+  for (const auto& str : kInputs) {
+    interner.Intern(str);
+  }
+
+  for (auto _ : state) {
+    for (const auto& str : kInputs) {
+      benchmark::DoNotOptimize(interner.Intern(str));
+    }
+  }
+  state.SetItemsProcessed(state.iterations() * kInputs.size());
+}
+BENCHMARK(BM_Symbols_Intern);
+
+}  // namespace
@@ -0,0 +1,718 @@
+#include <algorithm>
+#include <cctype>
+#include <random>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include "SwitchStr/Matcher.hpp"
+#include "SwitchStr/SwitchStr.hpp"
+#include "benchmark/benchmark.h"
+
+namespace {
+
+/// Random lowercase words of 6 to 12 chars
+auto MakeWords(std::size_t count, std::uint32_t seed)
+    -> std::vector<std::string> {
+  std::mt19937 rng(seed);
+  std::uniform_int_distribution<int> letter('a', 'z');
+  std::uniform_int_distribution<std::size_t> length(6, 12);
+
+  std::vector<std::string> words(count);
+  for (auto& word : words) {
+    word.resize(length(rng));
+    std::generate(word.begin(), word.end(), [&] { return letter(rng); });
+  }
+  return words;
+}
+
+/// Log like lines of ~200 chars, 1 out of 16 containing one of the \a needles
+auto MakeLines(const std::vector<std::string>& needles, std::size_t count)
+    -> std::vector<std::string> {
+  const auto words = MakeWords(256, 1);
+  std::mt19937 rng(2);
+  std::uniform_int_distribution<std::size_t> pick_word(0, words.size() - 1);
+  std::uniform_int_distribution<std::size_t> pick_needle(0, needles.size() - 1);
+
+  std::vector<std::string> lines(count);
+  for (std::size_t i = 0; i < count; ++i) {
+    while (lines[i].size() < 200) {
+      lines[i] += words[pick_word(rng)] + ' ';
+    }
+    if (i % 16 == 0) lines[i] += needles[pick_needle(rng)];
+  }
+  return lines;
+}
+
+void BM_ContainsAnyOf_Sequential(benchmark::State& state) {
+  const auto needles = MakeWords(state.range(0), 3);
+  const auto lines = MakeLines(needles, 256);
+
+  std::vector<decltype(swstr::Contains(""))> matchers;
+  for (const auto& needle : needles) {
+    matchers.push_back(swstr::Contains(std::string_view{needle}));
+  }
+
+  for (auto _ : state) {
+    for (const auto& line : lines) {
+      benchmark::DoNotOptimize(
+          std::any_of(matchers.begin(), matchers.end(),
+                      [&](const auto& m) { return swstr::IsMatching(m, line); }));
+    }
+  }
+  state.SetBytesProcessed(state.iterations() * lines.size() * 200);
+}
+
+void BM_ContainsAnyOf_AhoCorasick(benchmark::State& state) {
+  const auto needles = MakeWords(state.range(0), 3);
+  const auto lines = MakeLines(needles, 256);
+
+  const auto matcher = swstr::ContainsAnyOf(needles);
+
+  for (auto _ : state) {
+    for (const auto& line : lines) {
+      benchmark::DoNotOptimize(swstr::IsMatching(matcher, line));
+    }
+  }
+  state.SetBytesProcessed(state.iterations() * lines.size() * 200);
+}
+
+BENCHMARK(BM_ContainsAnyOf_Sequential)->Arg(4)->Arg(32)->Arg(512);
+BENCHMARK(BM_ContainsAnyOf_AhoCorasick)->Arg(4)->Arg(32)->Arg(512);
+
+/// Haystack of state.range(0) bytes, full of partial matches of kNeedle (its
+/// prefix only), with a single kNeedle at the very end (or start, if reverse)
+constexpr std::string_view kNeedle = "needle";
+
+auto MakeHaystack(std::size_t size, bool reverse) -> std::string {
+  std::string haystack;
+  while (haystack.size() < size) {
+    haystack += "needl ";
+  }
+  haystack.resize(size);
+  haystack.replace(reverse ? 0 : size - kNeedle.size(), kNeedle.size(),
+                   kNeedle);
+  return haystack;
+}
+
+void BM_Contains_Find(benchmark::State& state) {
+  const auto haystack = MakeHaystack(state.range(0), false);
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(std::string_view{haystack}.find(kNeedle));
+  }
+  state.SetBytesProcessed(state.iterations() * haystack.size());
+}
+
+void BM_Contains_Simd(benchmark::State& state) {
+  const auto haystack = MakeHaystack(state.range(0), false);
+  std::size_t where = 0;
+  const auto matcher = swstr::Contains(kNeedle, &where);
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(swstr::IsMatching(matcher, haystack));
+  }
+  state.SetBytesProcessed(state.iterations() * haystack.size());
+}
+
+void BM_ContainsR_RFind(benchmark::State& state) {
+  const auto haystack = MakeHaystack(state.range(0), true);
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(std::string_view{haystack}.rfind(kNeedle));
+  }
+  state.SetBytesProcessed(state.iterations() * haystack.size());
+}
+
+void BM_ContainsR_Simd(benchmark::State& state) {
+  const auto haystack = MakeHaystack(state.range(0), true);
+  std::size_t where = 0;
+  const auto matcher = swstr::ContainsR(kNeedle, &where);
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(swstr::IsMatching(matcher, haystack));
+  }
+  state.SetBytesProcessed(state.iterations() * haystack.size());
+}
+
+BENCHMARK(BM_Contains_Find)->Arg(64)->Arg(4 << 10)->Arg(1 << 20);
+BENCHMARK(BM_Contains_Simd)->Arg(64)->Arg(4 << 10)->Arg(1 << 20);
+BENCHMARK(BM_ContainsR_RFind)->Arg(64)->Arg(4 << 10)->Arg(1 << 20);
+BENCHMARK(BM_ContainsR_Simd)->Arg(64)->Arg(4 << 10)->Arg(1 << 20);
+
+/// Payload of state.range(0) bytes, with a single delimiter at the very end
+auto MakePayload(std::size_t size) -> std::string {
+  std::string payload(size, 'x');
+  payload.back() = ';';
+  return payload;
+}
+
+constexpr std::string_view kDelimiters = " \t\r\n,;:=&";
+
+void BM_ContainsOneOf_FindFirstOf(benchmark::State& state) {
+  const auto payload = MakePayload(state.range(0));
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(
+        std::string_view{payload}.find_first_of(kDelimiters));
+  }
+  state.SetBytesProcessed(state.iterations() * payload.size());
+}
+
+void BM_ContainsOneOf_ByteSet(benchmark::State& state) {
+  const auto payload = MakePayload(state.range(0));
+  std::size_t where = 0;
+  const auto matcher = swstr::ContainsOneOf(kDelimiters, &where);
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(swstr::IsMatching(matcher, payload));
+  }
+  state.SetBytesProcessed(state.iterations() * payload.size());
+}
+
+void BM_ContainsOneOfR_FindLastOf(benchmark::State& state) {
+  auto payload = MakePayload(state.range(0));
+  payload.back() = 'x';
+  payload.front() = ';';
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(
+        std::string_view{payload}.find_last_of(kDelimiters));
+  }
+  state.SetBytesProcessed(state.iterations() * payload.size());
+}
+
+void BM_ContainsOneOfR_ByteSet(benchmark::State& state) {
+  auto payload = MakePayload(state.range(0));
+  payload.back() = 'x';
+  payload.front() = ';';
+  std::size_t where = 0;
+  const auto matcher = swstr::ContainsOneOfR(kDelimiters, &where);
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(swstr::IsMatching(matcher, payload));
+  }
+  state.SetBytesProcessed(state.iterations() * payload.size());
+}
+
+BENCHMARK(BM_ContainsOneOf_FindFirstOf)->Arg(64)->Arg(4 << 10);
+BENCHMARK(BM_ContainsOneOf_ByteSet)->Arg(64)->Arg(4 << 10);
+BENCHMARK(BM_ContainsOneOfR_FindLastOf)->Arg(64)->Arg(4 << 10);
+BENCHMARK(BM_ContainsOneOfR_ByteSet)->Arg(64)->Arg(4 << 10);
+
+// Every matcher, over several lengths and hit ratios ///////////////////////
+
+/// Where the pattern (or its near miss) is placed inside the inputs
+enum class Where { kWhole, kStart, kMiddle, kEnd };
+
+constexpr std::string_view kPattern = "needle";
+constexpr std::string_view kNearMiss = "needlx";
+
+/// Random chars, never part of kPattern/kNearMiss (nor any delimiter)
+auto Filler(std::mt19937& rng, std::size_t size) -> std::string {
+  std::uniform_int_distribution<int> letter('o', 'z');
+  std::string filler(size, '\0');
+  std::generate(filler.begin(), filler.end(), [&] { return letter(rng); });
+  return filler;
+}
+
+/**
+ *  \brief 1024 inputs of \a length chars, \a hit_percent of them containing
+ *         \a hit at \a where, the others containing \a miss
+ *
+ *  \note With Where::kWhole, the filler is the same for all inputs, such that
+ *        hits are all the same string (the one returned by WholeHit())
+ */
+auto MakeInputs(Where where, std::string_view hit, std::string_view miss,
+                std::size_t length, std::size_t hit_percent)
+    -> std::vector<std::string> {
+  std::mt19937 rng(42);
+  std::uniform_int_distribution<std::size_t> percent(0, 99);
+
+  std::vector<std::string> inputs(1024);
+  for (auto& input : inputs) {
+    const std::string_view piece = (percent(rng) < hit_percent) ? hit : miss;
+    const std::size_t filler_size = length - std::min(length, piece.size());
+
+    switch (where) {
+      case Where::kWhole:
+        input = std::string(filler_size, 'o').append(piece);
+        break;
+      case Where::kStart:
+        input = std::string(piece).append(Filler(rng, filler_size));
+        break;
+      case Where::kMiddle:
+        input = Filler(rng, filler_size);
+        input.insert(filler_size / 2, piece);
+        break;
+      case Where::kEnd:
+        input = Filler(rng, filler_size).append(piece);
+        break;
+    }
+  }
+  return inputs;
+}
+
+/// The input matched by Equals(), with Where::kWhole
+auto WholeHit(std::size_t length) -> std::string {
+  return std::string(length - kPattern.size(), 'o').append(kPattern);
+}
+
+/**
+ *  \brief Benchmark the matcher built by make_matcher(WholeHit(length)),
+ *         over inputs of state.range(0) chars, state.range(1) percents of
+ *         them matching
+ */
+template <typename MakeMatcher>
+void BM_Matcher(benchmark::State& state, Where where, std::string_view hit,
+                std::string_view miss, MakeMatcher make_matcher) {
+  const auto length = static_cast<std::size_t>(state.range(0));
+  const auto inputs = MakeInputs(where, hit, miss, length,
+                                 static_cast<std::size_t>(state.range(1)));
+  const std::string whole_hit = WholeHit(length);
+  const auto matcher = make_matcher(whole_hit);
+
+  for (auto _ : state) {
+    for (const auto& input : inputs) {
+      benchmark::DoNotOptimize(swstr::IsMatching(matcher, input));
+    }
+  }
+  state.SetItemsProcessed(state.iterations() * inputs.size());
+  state.SetBytesProcessed(state.iterations() * inputs.size() * length);
+}
+
+/// Lengths {8, 64, 1024} x hit percents {0, 50, 100}
+void LengthsAndHits(benchmark::internal::Benchmark* bench) {
+  bench->ArgNames({"length", "hit%"});
+  for (const int length : {8, 64, 1024}) {
+    for (const int hit_percent : {0, 50, 100}) {
+      bench->Args({length, hit_percent});
+    }
+  }
+}
+
+BENCHMARK_CAPTURE(BM_Matcher, Equals, Where::kWhole, kPattern, kNearMiss,
+                  [](std::string_view whole) { return swstr::Equals(whole); })
+    ->Apply(LengthsAndHits);
+BENCHMARK_CAPTURE(BM_Matcher, StringLike, Where::kWhole, kPattern, kNearMiss,
+                  [](std::string_view whole) { return whole; })
+    ->Apply(LengthsAndHits);
+BENCHMARK_CAPTURE(BM_Matcher, StartsWith, Where::kStart, kPattern, kNearMiss,
+                  [](std::string_view) { return swstr::StartsWith(kPattern); })
+    ->Apply(LengthsAndHits);
+BENCHMARK_CAPTURE(BM_Matcher, EndsWith, Where::kEnd, kPattern, kNearMiss,
+                  [](std::string_view) { return swstr::EndsWith(kPattern); })
+    ->Apply(LengthsAndHits);
+BENCHMARK_CAPTURE(BM_Matcher, Contains, Where::kMiddle, kPattern, kNearMiss,
+                  [](std::string_view) { return swstr::Contains(kPattern); })
+    ->Apply(LengthsAndHits);
+BENCHMARK_CAPTURE(BM_Matcher, ContainsR, Where::kMiddle, kPattern, kNearMiss,
+                  [](std::string_view) { return swstr::ContainsR(kPattern); })
+    ->Apply(LengthsAndHits);
+BENCHMARK_CAPTURE(BM_Matcher, ContainsOneOf, Where::kMiddle, ";", "",
+                  [](std::string_view) { return swstr::ContainsOneOf("!;"); })
+    ->Apply(LengthsAndHits);
+BENCHMARK_CAPTURE(BM_Matcher, ContainsOneOfR, Where::kMiddle, ";", "",
+                  [](std::string_view) { return swstr::ContainsOneOfR("!;"); })
+    ->Apply(LengthsAndHits);
+BENCHMARK_CAPTURE(BM_Matcher, ContainsAnyOf, Where::kMiddle, kPattern,
+                  kNearMiss,
+                  [](std::string_view) {
+                    return swstr::ContainsAnyOf({kPattern, "thread", "pin"});
+                  })
+    ->Apply(LengthsAndHits);
+BENCHMARK_CAPTURE(BM_Matcher, NeverMatches, Where::kMiddle, kPattern,
+                  kNearMiss,
+                  [](std::string_view) { return swstr::NeverMatches(); })
+    ->Args({64, 0});
+
+// Meta matchers nesting ////////////////////////////////////////////////////
+
+/// Request lines, half of them being static GET requests
+auto MakeRequests() -> std::vector<std::string> {
+  const std::vector<std::string> requests = {
+      "GET /index.html",        "GET /style/main.css",
+      "GET /../../etc/passwd",  "GET /api/users/",
+      "GET /api/users/42",      "POST /api/users",
+      "GET /images/logo.png",   "DELETE /api/users/42",
+      "GET /docs/../index.html", "GET /about.html"};
+
+  std::mt19937 rng(42);
+  std::uniform_int_distribution<std::size_t> pick(0, requests.size() - 1);
+
+  std::vector<std::string> inputs(1024);
+  for (auto& input : inputs) {
+    input = requests[pick(rng)];
+  }
+  return inputs;
+}
+
+void BM_Meta_Nested(benchmark::State& state) {
+  using namespace swstr;
+  const auto inputs = MakeRequests();
+  const auto matcher =
+      AllOf(StartsWith("GET "), DoNot(Contains("..")),
+            AnyOf(EndsWith(".html"), EndsWith(".css"),
+                  AllOf(Contains("/api/"), DoNot(EndsWith("/")))));
+
+  for (auto _ : state) {
+    for (const auto& input : inputs) {
+      benchmark::DoNotOptimize(IsMatching(matcher, input));
+    }
+  }
+  state.SetItemsProcessed(state.iterations() * inputs.size());
+}
+
+void BM_Meta_NestedAnyMatcher(benchmark::State& state) {
+  using namespace swstr;
+  const auto inputs = MakeRequests();
+  const AnyMatcher matcher(
+      AllOf(StartsWith("GET "), DoNot(Contains("..")),
+            AnyOf(EndsWith(".html"), EndsWith(".css"),
+                  AllOf(Contains("/api/"), DoNot(EndsWith("/"))))));
+
+  for (auto _ : state) {
+    for (const auto& input : inputs) {
+      benchmark::DoNotOptimize(matcher.IsMatching(input));
+    }
+  }
+  state.SetItemsProcessed(state.iterations() * inputs.size());
+}
+
+void BM_Meta_HandWritten(benchmark::State& state) {
+  const auto inputs = MakeRequests();
+  const auto matcher = [](std::string_view str) {
+    return str.starts_with("GET ") and
+           (str.find("..") == std::string_view::npos) and
+           (str.ends_with(".html") or str.ends_with(".css") or
+            ((str.find("/api/") != std::string_view::npos) and
+             not str.ends_with("/")));
+  };
+
+  for (auto _ : state) {
+    for (const auto& input : inputs) {
+      benchmark::DoNotOptimize(matcher(input));
+    }
+  }
+  state.SetItemsProcessed(state.iterations() * inputs.size());
+}
+
+/// AllOf(Contains(), StartsWith()): the prefix check is evaluated first
+void BM_Meta_ScanDeclaredFirst(benchmark::State& state) {
+  using namespace swstr;
+  const auto inputs = MakeInputs(Where::kEnd, kPattern, kNearMiss, 1024, 50);
+  const auto matcher = AllOf(Contains(kPattern), StartsWith("abc"));
+
+  for (auto _ : state) {
+    for (const auto& input : inputs) {
+      benchmark::DoNotOptimize(IsMatching(matcher, input));
+    }
+  }
+  state.SetItemsProcessed(state.iterations() * inputs.size());
+}
+
+/// Reference: the same matchers, evaluated in the order of declaration
+void BM_Meta_ScanDeclaredFirstInOrder(benchmark::State& state) {
+  using namespace swstr;
+  const auto inputs = MakeInputs(Where::kEnd, kPattern, kNearMiss, 1024, 50);
+  const auto contains = Contains(kPattern);
+  const auto starts_with = StartsWith("abc");
+
+  for (auto _ : state) {
+    for (const auto& input : inputs) {
+      benchmark::DoNotOptimize(contains.IsMatching(input) and
+                               starts_with.IsMatching(input));
+    }
+  }
+  state.SetItemsProcessed(state.iterations() * inputs.size());
+}
+
+/// Column names of a CSV header, all of the same length
+constexpr std::string_view kColumns[] = {
+    "sensor_01", "sensor_02", "sensor_03", "sensor_04", "sensor_05",
+    "sensor_06", "sensor_07", "sensor_08", "sensor_09"};
+
+/// Columns, uniformly distributed, 1/4 of them being unknown
+auto MakeColumns() -> std::vector<std::string> {
+  constexpr std::string_view kUnknown[] = {"sensor_10", "sensor_11",
+                                           "sensor_12"};
+
+  std::mt19937 rng(42);
+  std::uniform_int_distribution<std::size_t> pick(0, 11);
+
+  std::vector<std::string> inputs(1024);
+  for (auto& input : inputs) {
+    const std::size_t i = pick(rng);
+    input = (i < 9) ? kColumns[i] : kUnknown[i - 9];
+  }
+  return inputs;
+}
+
+/// AnyOf() of 9 Equals, static constexpr: collapsed into a set lookup
+void BM_Meta_AnyOfEquals(benchmark::State& state) {
+  using namespace swstr;
+  const auto inputs = MakeColumns();
+  static constexpr auto matcher = AnyOf(
+      Equals(kColumns[0]), Equals(kColumns[1]), Equals(kColumns[2]),
+      Equals(kColumns[3]), Equals(kColumns[4]), Equals(kColumns[5]),
+      Equals(kColumns[6]), Equals(kColumns[7]), Equals(kColumns[8]));
+
+  for (auto _ : state) {
+    for (const auto& input : inputs) {
+      benchmark::DoNotOptimize(IsMatching(matcher, input));
+    }
+  }
+  state.SetItemsProcessed(state.iterations() * inputs.size());
+}
+
+/// Same AnyOf(), constructed on each call like inside a SwitchStr chain
+void BM_Meta_AnyOfEqualsPerCall(benchmark::State& state) {
+  using namespace swstr;
+  const auto inputs = MakeColumns();
+
+  for (auto _ : state) {
+    for (const auto& input : inputs) {
+      benchmark::DoNotOptimize(IsMatching(
+          AnyOf(Equals(kColumns[0]), Equals(kColumns[1]), Equals(kColumns[2]),
+                Equals(kColumns[3]), Equals(kColumns[4]), Equals(kColumns[5]),
+                Equals(kColumns[6]), Equals(kColumns[7]),
+                Equals(kColumns[8])),
+          input));
+    }
+  }
+  state.SetItemsProcessed(state.iterations() * inputs.size());
+}
+
+/// Reference: the same Equals, evaluated one by one
+void BM_Meta_AnyOfEqualsInOrder(benchmark::State& state) {
+  using namespace swstr;
+  const auto inputs = MakeColumns();
+  std::vector<EqualsMatcher> matchers;
+  for (const auto column : kColumns) {
+    matchers.push_back(Equals(column));
+  }
+
+  for (auto _ : state) {
+    for (const auto& input : inputs) {
+      benchmark::DoNotOptimize(
+          std::any_of(matchers.begin(), matchers.end(),
+                      [&](const auto& m) { return m.IsMatching(input); }));
+    }
+  }
+  state.SetItemsProcessed(state.iterations() * inputs.size());
+}
+
+BENCHMARK(BM_Meta_Nested);
+BENCHMARK(BM_Meta_NestedAnyMatcher);
+BENCHMARK(BM_Meta_HandWritten);
+BENCHMARK(BM_Meta_ScanDeclaredFirst);
+BENCHMARK(BM_Meta_ScanDeclaredFirstInOrder);
+BENCHMARK(BM_Meta_AnyOfEquals);
+BENCHMARK(BM_Meta_AnyOfEqualsPerCall);
+BENCHMARK(BM_Meta_AnyOfEqualsInOrder);
+
+// Case insensitive /////////////////////////////////////////////////////////
+
+/// HTTP header names, in the various cases found in the wild
+auto MakeHeaders() -> std::vector<std::string> {
+  constexpr std::string_view kNames[] = {
+      "Host",
+      "content-type",
+      "Content-Length",
+      "ACCEPT",
+      "User-Agent",
+      "accept-encoding",
+      "X-Forwarded-For",
+      "Cache-Control",
+      "CONNECTION",
+      "x-request-id-of-the-upstream-load-balancer",
+  };
+
+  std::mt19937 rng(42);
+  std::uniform_int_distribution<std::size_t> pick(0, std::size(kNames) - 1);
+  std::vector<std::string> headers(4096);
+  for (auto& header : headers) {
+    header = kNames[pick(rng)];
+  }
+  return headers;
+}
+
+/// Reference: lower case a copy of the string, then use the matcher
+void BM_ICase_LowerThenEquals(benchmark::State& state) {
+  const auto headers = MakeHeaders();
+  const auto matcher = swstr::Equals("x-forwarded-for");
+
+  for (auto _ : state) {
+    for (const auto& header : headers) {
+      std::string lower(header);
+      std::transform(lower.begin(), lower.end(), lower.begin(),
+                     [](unsigned char c) { return std::tolower(c); });
+      benchmark::DoNotOptimize(IsMatching(matcher, lower));
+    }
+  }
+  state.SetItemsProcessed(state.iterations() * headers.size());
+}
+
+void BM_ICase_IEquals(benchmark::State& state) {
+  const auto headers = MakeHeaders();
+  const auto matcher = swstr::IEquals("X-Forwarded-For");
+
+  for (auto _ : state) {
+    for (const auto& header : headers) {
+      benchmark::DoNotOptimize(IsMatching(matcher, header));
+    }
+  }
+  state.SetItemsProcessed(state.iterations() * headers.size());
+}
+
+/// Reference: lower case a copy of the string, then use the matcher
+void BM_ICase_LowerThenContains(benchmark::State& state) {
+  const auto inputs =
+      MakeInputs(Where::kMiddle, "NeeDle", "NeeDlx",
+                 static_cast<std::size_t>(state.range(0)),
+                 static_cast<std::size_t>(state.range(1)));
+  const auto matcher = swstr::Contains(kPattern);
+
+  for (auto _ : state) {
+    for (const auto& input : inputs) {
+      std::string lower(input);
+      std::transform(lower.begin(), lower.end(), lower.begin(),
+                     [](unsigned char c) { return std::tolower(c); });
+      benchmark::DoNotOptimize(IsMatching(matcher, lower));
+    }
+  }
+  state.SetItemsProcessed(state.iterations() * inputs.size());
+}
+
+void BM_ICase_IContains(benchmark::State& state) {
+  const auto inputs =
+      MakeInputs(Where::kMiddle, "NeeDle", "NeeDlx",
+                 static_cast<std::size_t>(state.range(0)),
+                 static_cast<std::size_t>(state.range(1)));
+  const auto matcher = swstr::IContains(kPattern);
+
+  for (auto _ : state) {
+    for (const auto& input : inputs) {
+      benchmark::DoNotOptimize(IsMatching(matcher, input));
+    }
+  }
+  state.SetItemsProcessed(state.iterations() * inputs.size());
+}
+
+BENCHMARK(BM_ICase_LowerThenEquals);
+BENCHMARK(BM_ICase_IEquals);
+BENCHMARK(BM_ICase_LowerThenContains)->Apply(LengthsAndHits);
+BENCHMARK(BM_ICase_IContains)->Apply(LengthsAndHits);
+
+// Compile time literals ////////////////////////////////////////////////////
+
+/// HTTP header names, as sent by most clients
+auto MakeHeaderNames() -> std::vector<std::string> {
+  constexpr std::string_view kNames[] = {
+      "Host",          "Content-Type",    "Content-Length", "Accept",
+      "User-Agent",    "Accept-Encoding", "Cache-Control",  "Connection",
+      "X-Request-Id",  "Cookie",          "Authorization",  "Referer",
+      "If-None-Match", "Origin",          "Accept-Language"};
+
+  std::mt19937 rng(42);
+  std::uniform_int_distribution<std::size_t> pick(0, std::size(kNames) - 1);
+  std::vector<std::string> names(4096);
+  for (auto& name : names) {
+    name = kNames[pick(rng)];
+  }
+  return names;
+}
+
+void BM_Literal_Equals(benchmark::State& state) {
+  using swstr::Equals;
+  const auto names = MakeHeaderNames();
+
+  for (auto _ : state) {
+    for (const auto& name : names) {
+      benchmark::DoNotOptimize(swstr::SwitchStr<int>(name)
+                                   .Case(Equals("Content-Length"), 0)
+                                   .Case(Equals("Content-Type"), 1)
+                                   .Case(Equals("Connection"), 2)
+                                   .Case(Equals("Accept-Encoding"), 3)
+                                   .Case(Equals("Authorization"), 4)
+                                   .Case(Equals("Host"), 5)
+                                   .Default(-1));
+    }
+  }
+  state.SetItemsProcessed(state.iterations() * names.size());
+}
+
+void BM_Literal_FixedEquals(benchmark::State& state) {
+  using swstr::Equals;
+  const auto names = MakeHeaderNames();
+
+  for (auto _ : state) {
+    for (const auto& name : names) {
+      benchmark::DoNotOptimize(swstr::SwitchStr<int>(name)
+                                   .Case(Equals<"Content-Length">(), 0)
+                                   .Case(Equals<"Content-Type">(), 1)
+                                   .Case(Equals<"Connection">(), 2)
+                                   .Case(Equals<"Accept-Encoding">(), 3)
+                                   .Case(Equals<"Authorization">(), 4)
+                                   .Case(Equals<"Host">(), 5)
+                                   .Default(-1));
+    }
+  }
+  state.SetItemsProcessed(state.iterations() * names.size());
+}
+
+void BM_Literal_CharArray(benchmark::State& state) {
+  const auto names = MakeHeaderNames();
+
+  for (auto _ : state) {
+    for (const auto& name : names) {
+      benchmark::DoNotOptimize(swstr::SwitchStr<int>(name)
+                                   .Case("Content-Length", 0)
+                                   .Case("Content-Type", 1)
+                                   .Case("Connection", 2)
+                                   .Case("Accept-Encoding", 3)
+                                   .Case("Authorization", 4)
+                                   .Case("Host", 5)
+                                   .Default(-1));
+    }
+  }
+  state.SetItemsProcessed(state.iterations() * names.size());
+}
+
+BENCHMARK(BM_Literal_Equals);
+BENCHMARK(BM_Literal_FixedEquals);
+BENCHMARK(BM_Literal_CharArray);
+
+// Match spans //////////////////////////////////////////////////////////////
+
+/// Reference: look for the pattern again, to get what follows it
+void BM_Span_Rescan(benchmark::State& state) {
+  const auto inputs = MakeInputs(Where::kMiddle, kPattern, kNearMiss,
+                                 static_cast<std::size_t>(state.range(0)),
+                                 static_cast<std::size_t>(state.range(1)));
+  const auto matcher = swstr::Contains(kPattern);
+
+  for (auto _ : state) {
+    for (const auto& input : inputs) {
+      if (IsMatching(matcher, input)) {
+        const std::string_view str(input);
+        benchmark::DoNotOptimize(
+            str.substr(str.find(kPattern) + kPattern.size()));
+      }
+    }
+  }
+  state.SetItemsProcessed(state.iterations() * inputs.size());
+}
+
+void BM_Span_Match(benchmark::State& state) {
+  const auto inputs = MakeInputs(Where::kMiddle, kPattern, kNearMiss,
+                                 static_cast<std::size_t>(state.range(0)),
+                                 static_cast<std::size_t>(state.range(1)));
+  const auto matcher = swstr::Contains(kPattern);
+
+  for (auto _ : state) {
+    for (const auto& input : inputs) {
+      if (const auto span = Match(matcher, input)) {
+        benchmark::DoNotOptimize(span->After(input));
+      }
+    }
+  }
+  state.SetItemsProcessed(state.iterations() * inputs.size());
+}
+
+BENCHMARK(BM_Span_Rescan)->Apply(LengthsAndHits);
+BENCHMARK(BM_Span_Match)->Apply(LengthsAndHits);
+
+}  // namespace
@@ -0,0 +1,88 @@
+#include <algorithm>
+#include <cstdint>
+#include <random>
+#include <string>
+#include <string_view>
+#include <thread>
+#include <vector>
+
+#include "SwitchStr/Parallel.hpp"
+#include "SwitchStr/SwitchTable.hpp"
+#include "benchmark/benchmark.h"
+
+namespace {
+
+/// Random lowercase log lines, 1 out of 4 containing "error"
+auto MakeLines(std::size_t count) -> std::vector<std::string> {
+  std::mt19937 rng(42);
+  std::uniform_int_distribution<int> letter('a', 'z');
+  std::uniform_int_distribution<std::size_t> length(16, 128);
+
+  std::vector<std::string> lines(count);
+  for (std::size_t i = 0; i < count; ++i) {
+    auto& line = lines[i];
+    line.resize(length(rng));
+    std::generate(line.begin(), line.end(), [&] { return letter(rng); });
+    if (i % 4 == 0) line.replace(line.size() / 2, 5, "error");
+  }
+  std::shuffle(lines.begin(), lines.end(), rng);
+  return lines;
+}
+
+constexpr std::size_t kInputSize = 4 << 20;
+
+/// All thread counts from 1 to the number of cores (doubling)
+void ThreadCounts(benchmark::internal::Benchmark* bench) {
+  const int cores =
+      static_cast<int>(std::max(1u, std::thread::hardware_concurrency()));
+  for (int threads = 1; threads < cores; threads *= 2) {
+    bench->Arg(threads);
+  }
+  bench->Arg(cores);
+}
+
+void BM_ParallelClassify_Contains(benchmark::State& state) {
+  const auto lines = MakeLines(kInputSize);
+  const std::vector<std::string_view> strs(lines.begin(), lines.end());
+  std::vector<std::uint8_t> out(strs.size());
+
+  const auto matcher = swstr::Contains("error");
+  const auto threads = static_cast<std::size_t>(state.range(0));
+
+  for (auto _ : state) {
+    swstr::ParallelClassify(matcher, strs, out, threads);
+    benchmark::DoNotOptimize(out.data());
+    benchmark::ClobberMemory();
+  }
+  state.SetItemsProcessed(state.iterations() * strs.size());
+}
+
+void BM_ParallelClassify_SwitchTable(benchmark::State& state) {
+  const auto lines = MakeLines(kInputSize);
+  const std::vector<std::string_view> strs(lines.begin(), lines.end());
+  std::vector<std::size_t> out(strs.size());
+
+  const auto table =
+      swstr::SwitchTable<int, swstr::AnyShareableMatcher>::Builder()
+          .Case(swstr::StartsWith("abc"), 0)
+          .Case(swstr::StartsWith("error"), 1)
+          .Case(swstr::EndsWith("xyz"), 2)
+          .Case(swstr::Contains("error"), 3)
+          .Case(swstr::EndsWith("zz"), 4)
+          .Build();
+  const auto threads = static_cast<std::size_t>(state.range(0));
+
+  for (auto _ : state) {
+    swstr::ParallelClassify(table, strs, out, threads);
+    benchmark::DoNotOptimize(out.data());
+    benchmark::ClobberMemory();
+  }
+  state.SetItemsProcessed(state.iterations() * strs.size());
+}
+
+BENCHMARK(BM_ParallelClassify_Contains)->Apply(ThreadCounts)->UseRealTime();
+BENCHMARK(BM_ParallelClassify_SwitchTable)
+    ->Apply(ThreadCounts)
+    ->UseRealTime();
+
+}  // namespace
@@ -0,0 +1,75 @@
+#include <random>
+#include <regex>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include "SwitchStr/Pattern.hpp"
+#include "benchmark/benchmark.h"
+
+namespace {
+
+/// 1024 user names, half of them being "user-<digits>"
+auto MakeUsers() -> std::vector<std::string> {
+  std::mt19937 rng(42);
+  std::uniform_int_distribution<int> digits(1, 9);
+  std::uniform_int_distribution<int> coin(0, 1);
+
+  std::vector<std::string> users(1024);
+  for (auto& user : users) {
+    user = coin(rng) ? "user-" : "admin-";
+    for (int i = digits(rng); i > 0; --i) {
+      user += static_cast<char>('0' + digits(rng));
+    }
+  }
+  return users;
+}
+
+void BM_Pattern_StdRegex(benchmark::State& state) {
+  const auto users = MakeUsers();
+  const std::regex regex("user-[0-9]+");
+
+  for (auto _ : state) {
+    for (const auto& user : users) {
+      benchmark::DoNotOptimize(std::regex_match(user, regex));
+    }
+  }
+  state.SetItemsProcessed(state.iterations() * users.size());
+}
+
+void BM_Pattern_Regex(benchmark::State& state) {
+  const auto users = MakeUsers();
+  const auto& regex = swstr::Regex<"user-[0-9]+">;
+
+  for (auto _ : state) {
+    for (const auto& user : users) {
+      benchmark::DoNotOptimize(regex.IsMatching(user));
+    }
+  }
+  state.SetItemsProcessed(state.iterations() * users.size());
+}
+
+/// Reference: the same pattern, hand written
+void BM_Pattern_HandWritten(benchmark::State& state) {
+  const auto users = MakeUsers();
+  const auto matcher = [](std::string_view str) {
+    if (not str.starts_with("user-") or (str.size() == 5)) return false;
+    for (const char c : str.substr(5)) {
+      if ((c < '0') or (c > '9')) return false;
+    }
+    return true;
+  };
+
+  for (auto _ : state) {
+    for (const auto& user : users) {
+      benchmark::DoNotOptimize(matcher(user));
+    }
+  }
+  state.SetItemsProcessed(state.iterations() * users.size());
+}
+
+BENCHMARK(BM_Pattern_StdRegex);
+BENCHMARK(BM_Pattern_Regex);
+BENCHMARK(BM_Pattern_HandWritten);
+
+}  // namespace
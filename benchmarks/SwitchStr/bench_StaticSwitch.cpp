@@ -0,0 +1,150 @@
+#include <random>
+#include <string_view>
+#include <vector>
+
+#include "SwitchStr/StaticSwitch.hpp"
+#include "SwitchStr/SwitchStr.hpp"
+#include "benchmark/benchmark.h"
+
+namespace {
+
+constexpr swstr::StaticSwitch<
+    int,
+    "SELECT", "FROM", "WHERE", "INSERT", "UPDATE", "DELETE", "CREATE", "DROP",
+    "ALTER", "TABLE", "INDEX", "VIEW", "JOIN", "INNER", "OUTER", "LEFT",
+    "RIGHT", "FULL", "CROSS", "ON", "USING", "GROUP", "ORDER", "BY", "HAVING",
+    "LIMIT", "OFFSET", "UNION", "ALL", "DISTINCT", "AS", "AND", "OR", "NOT",
+    "NULL", "IS", "IN", "BETWEEN", "LIKE", "EXISTS", "CASE", "WHEN", "THEN",
+    "ELSE", "END", "BEGIN", "COMMIT", "ROLLBACK", "PRIMARY", "FOREIGN", "KEY",
+    "REFERENCES", "DEFAULT", "CHECK", "UNIQUE", "VALUES", "SET", "INTO", "ASC",
+    "DESC">
+    kKeywords{
+        0, 1, 2, 3, 4, 5, 6, 7, 8, 9, 10, 11, 12, 13, 14, 15, 16, 17, 18, 19,
+        20, 21, 22, 23, 24, 25, 26, 27, 28, 29, 30, 31, 32, 33, 34, 35, 36, 37,
+        38, 39, 40, 41, 42, 43, 44, 45, 46, 47, 48, 49, 50, 51, 52, 53, 54, 55,
+        56, 57, 58, 59};
+
+auto SequentialChain(std::string_view str) -> int {
+  return swstr::SwitchStr<int>(str)
+      .Case("SELECT", 0)
+      .Case("FROM", 1)
+      .Case("WHERE", 2)
+      .Case("INSERT", 3)
+      .Case("UPDATE", 4)
+      .Case("DELETE", 5)
+      .Case("CREATE", 6)
+      .Case("DROP", 7)
+      .Case("ALTER", 8)
+      .Case("TABLE", 9)
+      .Case("INDEX", 10)
+      .Case("VIEW", 11)
+      .Case("JOIN", 12)
+      .Case("INNER", 13)
+      .Case("OUTER", 14)
+      .Case("LEFT", 15)
+      .Case("RIGHT", 16)
+      .Case("FULL", 17)
+      .Case("CROSS", 18)
+      .Case("ON", 19)
+      .Case("USING", 20)
+      .Case("GROUP", 21)
+      .Case("ORDER", 22)
+      .Case("BY", 23)
+      .Case("HAVING", 24)
+      .Case("LIMIT", 25)
+      .Case("OFFSET", 26)
+      .Case("UNION", 27)
+      .Case("ALL", 28)
+      .Case("DISTINCT", 29)
+      .Case("AS", 30)
+      .Case("AND", 31)
+      .Case("OR", 32)
+      .Case("NOT", 33)
+      .Case("NULL", 34)
+      .Case("IS", 35)
+      .Case("IN", 36)
+      .Case("BETWEEN", 37)
+      .Case("LIKE", 38)
+      .Case("EXISTS", 39)
+      .Case("CASE", 40)
+      .Case("WHEN", 41)
+      .Case("THEN", 42)
+      .Case("ELSE", 43)
+      .Case("END", 44)
+      .Case("BEGIN", 45)
+      .Case("COMMIT", 46)
+      .Case("ROLLBACK", 47)
+      .Case("PRIMARY", 48)
+      .Case("FOREIGN", 49)
+      .Case("KEY", 50)
+      .Case("REFERENCES", 51)
+      .Case("DEFAULT", 52)
+      .Case("CHECK", 53)
+      .Case("UNIQUE", 54)
+      .Case("VALUES", 55)
+      .Case("SET", 56)
+      .Case("INTO", 57)
+      .Case("ASC", 58)
+      .Case("DESC", 59)
+      .Default(-1);
+}
+
+auto StaticTable(std::string_view str) -> int {
+  return kKeywords.LookupOr(str, -1);
+}
+
+/// Every keyword, once
+const std::vector<std::string_view> kHits = {
+    "SELECT", "FROM", "WHERE", "INSERT", "UPDATE", "DELETE", "CREATE", "DROP",
+    "ALTER", "TABLE", "INDEX", "VIEW", "JOIN", "INNER", "OUTER", "LEFT",
+    "RIGHT", "FULL", "CROSS", "ON", "USING", "GROUP", "ORDER", "BY", "HAVING",
+    "LIMIT", "OFFSET", "UNION", "ALL", "DISTINCT", "AS", "AND", "OR", "NOT",
+    "NULL", "IS", "IN", "BETWEEN", "LIKE", "EXISTS", "CASE", "WHEN", "THEN",
+    "ELSE", "END", "BEGIN", "COMMIT", "ROLLBACK", "PRIMARY", "FOREIGN", "KEY",
+    "REFERENCES", "DEFAULT", "CHECK", "UNIQUE", "VALUES", "SET", "INTO", "ASC",
+    "DESC"};
+
+/// Identifiers looking like keywords
+const std::vector<std::string_view> kMisses = {
+    "select", "customers", "orders", "SELECTS", "DELETED", "price", "VALUE",
+    "amount", "t1", "CREATED_AT", "user_id", "EXIST", "INNERS", "total", "name",
+    "FROM_", "WHEREAS", "status", "LEFTS", "COUNT"};
+
+/// Draw \a count strings out of \a words, in a pseudo random order, such that
+/// the branch predictor can't learn the sequence
+auto Draw(const std::vector<std::string_view>& words, std::size_t count)
+    -> std::vector<std::string_view> {
+  std::mt19937 rng(42);
+  std::uniform_int_distribution<std::size_t> pick(0, words.size() - 1);
+
+  std::vector<std::string_view> drawn;
+  drawn.reserve(count);
+  for (std::size_t i = 0; i < count; ++i) {
+    drawn.push_back(words[pick(rng)]);
+  }
+  return drawn;
+}
+
+const std::vector<std::string_view> kHitsInputs = Draw(kHits, 4096);
+const std::vector<std::string_view> kMissesInputs = Draw(kMisses, 4096);
+
+template <auto Switch, const std::vector<std::string_view>* Inputs>
+void BM_Keywords(benchmark::State& state) {
+  for (auto _ : state) {
+    for (const auto str : *Inputs) {
+      benchmark::DoNotOptimize(Switch(str));
+    }
+  }
+  state.SetItemsProcessed(state.iterations() * Inputs->size());
+}
+
+BENCHMARK_TEMPLATE(BM_Keywords, SequentialChain, &kHitsInputs)
+    ->Name("Keywords60/Hits/SwitchStr");
+BENCHMARK_TEMPLATE(BM_Keywords, StaticTable, &kHitsInputs)
+    ->Name("Keywords60/Hits/StaticSwitch");
+BENCHMARK_TEMPLATE(BM_Keywords, SequentialChain, &kMissesInputs)
+    ->Name("Keywords60/Misses/SwitchStr");
+BENCHMARK_TEMPLATE(BM_Keywords, StaticTable, &kMissesInputs)
+    ->Name("Keywords60/Misses/StaticSwitch");
+
+}  // namespace
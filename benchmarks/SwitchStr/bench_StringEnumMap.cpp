@@ -0,0 +1,160 @@
+#include <optional>
+#include <random>
+#include <string_view>
+#include <vector>
+
+#include "SwitchStr/StringEnumMap.hpp"
+#include "SwitchStr/SwitchStr.hpp"
+#include "benchmark/benchmark.h"
+
+namespace {
+
+enum class Method {
+  kGet,
+  kHead,
+  kPost,
+  kPut,
+  kDelete,
+  kConnect,
+  kOptions,
+  kTrace,
+  kPatch,
+};
+
+constexpr auto kMethods = swstr::MakeStringEnumMap<Method>({
+    {"GET", Method::kGet},
+    {"HEAD", Method::kHead},
+    {"POST", Method::kPost},
+    {"PUT", Method::kPut},
+    {"DELETE", Method::kDelete},
+    {"CONNECT", Method::kConnect},
+    {"OPTIONS", Method::kOptions},
+    {"TRACE", Method::kTrace},
+    {"PATCH", Method::kPatch},
+});
+
+auto ParseChain(std::string_view str) -> std::optional<Method> {
+  return swstr::SwitchStr<std::optional<Method>>(str)
+      .Case("GET", Method::kGet)
+      .Case("HEAD", Method::kHead)
+      .Case("POST", Method::kPost)
+      .Case("PUT", Method::kPut)
+      .Case("DELETE", Method::kDelete)
+      .Case("CONNECT", Method::kConnect)
+      .Case("OPTIONS", Method::kOptions)
+      .Case("TRACE", Method::kTrace)
+      .Case("PATCH", Method::kPatch)
+      .Default(std::nullopt);
+}
+
+auto ParseMap(std::string_view str) -> std::optional<Method> {
+  return kMethods.FromString(str);
+}
+
+auto IParseChain(std::string_view str) -> std::optional<Method> {
+  using swstr::IEquals;
+  return swstr::SwitchStr<std::optional<Method>>(str)
+      .Case(IEquals("GET"), Method::kGet)
+      .Case(IEquals("HEAD"), Method::kHead)
+      .Case(IEquals("POST"), Method::kPost)
+      .Case(IEquals("PUT"), Method::kPut)
+      .Case(IEquals("DELETE"), Method::kDelete)
+      .Case(IEquals("CONNECT"), Method::kConnect)
+      .Case(IEquals("OPTIONS"), Method::kOptions)
+      .Case(IEquals("TRACE"), Method::kTrace)
+      .Case(IEquals("PATCH"), Method::kPatch)
+      .Default(std::nullopt);
+}
+
+auto IParseMap(std::string_view str) -> std::optional<Method> {
+  return kMethods.FromStringIgnoreCase(str);
+}
+
+/// Draw \a count methods names, in a pseudo random order, some of them in
+/// lower case or unknown
+auto DrawNames(std::size_t count) -> std::vector<std::string_view> {
+  static constexpr std::string_view kNames[] = {
+      "GET",     "HEAD",    "POST",  "PUT",   "DELETE", "CONNECT",
+      "OPTIONS", "TRACE",   "PATCH", "get",   "post",   "Delete",
+      "PURGE",   "PROPFIND"};
+
+  std::mt19937 rng(42);
+  std::uniform_int_distribution<std::size_t> pick(0, std::size(kNames) - 1);
+
+  std::vector<std::string_view> drawn;
+  drawn.reserve(count);
+  for (std::size_t i = 0; i < count; ++i) {
+    drawn.push_back(kNames[pick(rng)]);
+  }
+  return drawn;
+}
+
+const std::vector<std::string_view> kNamesInputs = DrawNames(4096);
+
+template <auto Parse>
+void BM_EnumParse(benchmark::State& state) {
+  for (auto _ : state) {
+    for (const auto str : kNamesInputs) {
+      benchmark::DoNotOptimize(Parse(str));
+    }
+  }
+  state.SetItemsProcessed(state.iterations() * kNamesInputs.size());
+}
+
+BENCHMARK_TEMPLATE(BM_EnumParse, ParseChain)->Name("EnumParse/SwitchStr");
+BENCHMARK_TEMPLATE(BM_EnumParse, ParseMap)->Name("EnumParse/StringEnumMap");
+BENCHMARK_TEMPLATE(BM_EnumParse, IParseChain)
+    ->Name("EnumParseIgnoreCase/SwitchStr");
+BENCHMARK_TEMPLATE(BM_EnumParse, IParseMap)
+    ->Name("EnumParseIgnoreCase/StringEnumMap");
+
+/// Hand written enum -> string table, the usual companion of ParseChain
+auto NameSwitch(Method method) -> std::string_view {
+  switch (method) {
+    case Method::kGet:
+      return "GET";
+    case Method::kHead:
+      return "HEAD";
+    case Method::kPost:
+      return "POST";
+    case Method::kPut:
+      return "PUT";
+    case Method::kDelete:
+      return "DELETE";
+    case Method::kConnect:
+      return "CONNECT";
+    case Method::kOptions:
+      return "OPTIONS";
+    case Method::kTrace:
+      return "TRACE";
+    case Method::kPatch:
+      return "PATCH";
+  }
+  return {};
+}
+
+auto NameMap(Method method) -> std::string_view {
+  return kMethods.ToString(method);
+}
+
+template <auto Name>
+void BM_EnumName(benchmark::State& state) {
+  std::mt19937 rng(42);
+  std::uniform_int_distribution<int> pick(0, 8);
+  std::vector<Method> methods(4096);
+  for (Method& method : methods) {
+    method = static_cast<Method>(pick(rng));
+  }
+
+  for (auto _ : state) {
+    for (const Method method : methods) {
+      benchmark::DoNotOptimize(Name(method));
+    }
+  }
+  state.SetItemsProcessed(state.iterations() * methods.size());
+}
+
+BENCHMARK_TEMPLATE(BM_EnumName, NameSwitch)->Name("EnumName/switch");
+BENCHMARK_TEMPLATE(BM_EnumName, NameMap)->Name("EnumName/StringEnumMap");
+
+}  // namespace
@@ -0,0 +1,140 @@
+#include <array>
+#include <cstdint>
+#include <random>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+#include "SwitchStr/SwitchStr.hpp"
+#include "SwitchStr/SwitchTable.hpp"
+#include "benchmark/benchmark.h"
+
+namespace {
+
+constexpr std::size_t kMaxCases = 512;
+constexpr std::size_t kMaxKeyLength = 12;
+
+/// Storage of kMaxCases lowercase keys, of 4 to kMaxKeyLength chars
+struct Keys {
+  std::array<char, kMaxCases * kMaxKeyLength> chars{};
+  std::array<std::size_t, kMaxCases> sizes{};
+};
+
+/// Generate the keys at compile time, such that switches are unrolled on them
+constexpr auto MakeKeys() -> Keys {
+  Keys keys;
+  std::uint64_t state = 42;
+  const auto next = [&state] {
+    state = state * 6364136223846793005u + 1442695040888963407u;
+    return static_cast<std::size_t>(state >> 33);
+  };
+
+  for (std::size_t i = 0; i < kMaxCases; ++i) {
+    keys.sizes[i] = 4 + next() % (kMaxKeyLength - 3);
+    for (std::size_t j = 0; j < keys.sizes[i]; ++j) {
+      keys.chars[i * kMaxKeyLength + j] = static_cast<char>('a' + next() % 26);
+    }
+  }
+  return keys;
+}
+
+constexpr Keys kKeys = MakeKeys();
+
+/// The key of the I-th case
+constexpr auto Key(std::size_t i) -> std::string_view {
+  return {kKeys.chars.data() + i * kMaxKeyLength, kKeys.sizes[i]};
+}
+
+/**
+ *  \brief 4096 inputs drawn from the \a cases first keys, \a hit_percent of
+ *         them being a key, the others a near miss (last char changed)
+ */
+auto MakeInputs(std::size_t cases, std::size_t hit_percent)
+    -> std::vector<std::string> {
+  std::mt19937 rng(42);
+  std::uniform_int_distribution<std::size_t> pick(0, cases - 1);
+  std::uniform_int_distribution<std::size_t> percent(0, 99);
+
+  std::vector<std::string> inputs(4096);
+  for (auto& input : inputs) {
+    input = Key(pick(rng));
+    if (percent(rng) >= hit_percent) input.back() = 'X';
+  }
+  return inputs;
+}
+
+/// A SwitchStr chain of one Case() per key, unrolled at compile time
+template <std::size_t... I>
+auto ChainOf(std::string_view str, std::index_sequence<I...>) -> int {
+  swstr::SwitchStr<int> sw(str);
+  (sw.Case(Key(I), static_cast<int>(I)), ...);
+  return sw.Default(-1);
+}
+
+template <std::size_t Cases>
+void BM_Switch_SwitchStr(benchmark::State& state) {
+  const auto inputs = MakeInputs(Cases, state.range(0));
+
+  for (auto _ : state) {
+    for (const auto& input : inputs) {
+      benchmark::DoNotOptimize(
+          ChainOf(input, std::make_index_sequence<Cases>{}));
+    }
+  }
+  state.SetItemsProcessed(state.iterations() * inputs.size());
+}
+
+template <std::size_t Cases>
+void BM_Switch_SwitchTable(benchmark::State& state) {
+  const auto inputs = MakeInputs(Cases, state.range(0));
+
+  auto builder = swstr::SwitchTable<int>::Builder();
+  for (std::size_t i = 0; i < Cases; ++i) {
+    builder.Case(swstr::Equals(Key(i)), static_cast<int>(i));
+  }
+  const auto table = std::move(builder).Build();
+
+  for (auto _ : state) {
+    for (const auto& input : inputs) {
+      benchmark::DoNotOptimize(table.LookupOr(input, -1));
+    }
+  }
+  state.SetItemsProcessed(state.iterations() * inputs.size());
+}
+
+template <std::size_t Cases>
+void BM_Switch_UnorderedMap(benchmark::State& state) {
+  const auto inputs = MakeInputs(Cases, state.range(0));
+
+  std::unordered_map<std::string_view, int> map;
+  for (std::size_t i = 0; i < Cases; ++i) {
+    map.emplace(Key(i), static_cast<int>(i));
+  }
+
+  for (auto _ : state) {
+    for (const auto& input : inputs) {
+      const auto found = map.find(input);
+      benchmark::DoNotOptimize(found == map.end() ? -1 : found->second);
+    }
+  }
+  state.SetItemsProcessed(state.iterations() * inputs.size());
+}
+
+/// Hit percents {100, 50, 0}
+void Hits(benchmark::internal::Benchmark* bench) {
+  bench->ArgName("hit%")->Arg(100)->Arg(50)->Arg(0);
+}
+
+BENCHMARK_TEMPLATE(BM_Switch_SwitchStr, 4)->Apply(Hits);
+BENCHMARK_TEMPLATE(BM_Switch_SwitchStr, 32)->Apply(Hits);
+BENCHMARK_TEMPLATE(BM_Switch_SwitchStr, 512)->Apply(Hits);
+BENCHMARK_TEMPLATE(BM_Switch_SwitchTable, 4)->Apply(Hits);
+BENCHMARK_TEMPLATE(BM_Switch_SwitchTable, 32)->Apply(Hits);
+BENCHMARK_TEMPLATE(BM_Switch_SwitchTable, 512)->Apply(Hits);
+BENCHMARK_TEMPLATE(BM_Switch_UnorderedMap, 4)->Apply(Hits);
+BENCHMARK_TEMPLATE(BM_Switch_UnorderedMap, 32)->Apply(Hits);
+BENCHMARK_TEMPLATE(BM_Switch_UnorderedMap, 512)->Apply(Hits);
+
+}  // namespace
@@ -0,0 +1,130 @@
+#include <random>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include "SwitchStr/Matcher.hpp"
+#include "SwitchStr/SwitchTable.hpp"
+#include "benchmark/benchmark.h"
+
+namespace {
+
+/// 40 HTTP header names
+const std::vector<std::string> kHeaders = {
+    "Accept", "Accept-Charset", "Accept-Encoding", "Accept-Language",
+    "Accept-Ranges", "Age", "Allow", "Authorization", "Cache-Control",
+    "Connection", "Content-Encoding", "Content-Language", "Content-Length",
+    "Content-Location", "Content-Range", "Content-Type", "Cookie", "Date",
+    "ETag", "Expect", "Expires", "From", "Host", "If-Match",
+    "If-Modified-Since", "If-None-Match", "If-Range", "If-Unmodified-Since",
+    "Last-Modified", "Location", "Max-Forwards", "Pragma",
+    "Proxy-Authenticate", "Proxy-Authorization", "Range", "Referer",
+    "Retry-After", "Server", "User-Agent", "Vary"};
+
+/// 1 out of 4 inputs doesn't match any header
+auto MakeInputs(std::size_t count) -> std::vector<std::string> {
+  std::mt19937 rng(42);
+  std::uniform_int_distribution<std::size_t> pick(0, kHeaders.size() - 1);
+
+  std::vector<std::string> inputs;
+  inputs.reserve(count);
+  for (std::size_t i = 0; i < count; ++i) {
+    inputs.push_back(kHeaders[pick(rng)] + (i % 4 == 0 ? "-X" : ""));
+  }
+  return inputs;
+}
+
+void BM_Headers_Sequential(benchmark::State& state) {
+  const auto inputs = MakeInputs(4096);
+
+  std::vector<std::pair<swstr::EqualsMatcher, int>> cases;
+  for (std::size_t i = 0; i < kHeaders.size(); ++i) {
+    cases.emplace_back(swstr::Equals(kHeaders[i]), static_cast<int>(i));
+  }
+
+  for (auto _ : state) {
+    for (const auto& str : inputs) {
+      int res = -1;
+      for (const auto& [matcher, value] : cases) {
+        if (swstr::IsMatching(matcher, str)) {
+          res = value;
+          break;
+        }
+      }
+      benchmark::DoNotOptimize(res);
+    }
+  }
+  state.SetItemsProcessed(state.iterations() * inputs.size());
+}
+
+void BM_Headers_SwitchTable(benchmark::State& state) {
+  const auto inputs = MakeInputs(4096);
+
+  auto builder = swstr::SwitchTable<int>::Builder();
+  for (std::size_t i = 0; i < kHeaders.size(); ++i) {
+    builder.Case(swstr::Equals(kHeaders[i]), static_cast<int>(i));
+  }
+  const auto table = std::move(builder).Build();
+
+  for (auto _ : state) {
+    for (const auto& str : inputs) {
+      benchmark::DoNotOptimize(table.LookupOr(str, -1));
+    }
+  }
+  state.SetItemsProcessed(state.iterations() * inputs.size());
+}
+
+void BM_HeaderPrefixes_Sequential(benchmark::State& state) {
+  const auto inputs = MakeInputs(4096);
+
+  std::vector<std::pair<swstr::AnyMatcher, int>> cases;
+  for (std::size_t i = 0; i < kHeaders.size(); ++i) {
+    if (i % 2 == 0) {
+      cases.emplace_back(swstr::StartsWith(kHeaders[i]), static_cast<int>(i));
+    } else {
+      cases.emplace_back(swstr::Equals(kHeaders[i]), static_cast<int>(i));
+    }
+  }
+
+  for (auto _ : state) {
+    for (const auto& str : inputs) {
+      int res = -1;
+      for (const auto& [matcher, value] : cases) {
+        if (matcher.IsMatching(str)) {
+          res = value;
+          break;
+        }
+      }
+      benchmark::DoNotOptimize(res);
+    }
+  }
+  state.SetItemsProcessed(state.iterations() * inputs.size());
+}
+
+void BM_HeaderPrefixes_SwitchTable(benchmark::State& state) {
+  const auto inputs = MakeInputs(4096);
+
+  auto builder = swstr::SwitchTable<int>::Builder();
+  for (std::size_t i = 0; i < kHeaders.size(); ++i) {
+    if (i % 2 == 0) {
+      builder.Case(swstr::StartsWith(kHeaders[i]), static_cast<int>(i));
+    } else {
+      builder.Case(swstr::Equals(kHeaders[i]), static_cast<int>(i));
+    }
+  }
+  const auto table = std::move(builder).Build();
+
+  for (auto _ : state) {
+    for (const auto& str : inputs) {
+      benchmark::DoNotOptimize(table.LookupOr(str, -1));
+    }
+  }
+  state.SetItemsProcessed(state.iterations() * inputs.size());
+}
+
+BENCHMARK(BM_Headers_Sequential);
+BENCHMARK(BM_Headers_SwitchTable);
+BENCHMARK(BM_HeaderPrefixes_Sequential);
+BENCHMARK(BM_HeaderPrefixes_SwitchTable);
+
+}  // namespace
@@ -0,0 +1,110 @@
+#include <algorithm>
+#include <random>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include "SwitchStr/Matcher.hpp"
+#include "SwitchStr/SwitchStr.hpp"
+#include "SwitchStr/TokenSwitch.hpp"
+#include "benchmark/benchmark.h"
+
+namespace {
+
+/// Key/value store like commands, 1 out of 8 being unknown
+auto MakeCommands() -> std::vector<std::string> {
+  const std::vector<std::string> commands = {
+      "GET user:1234:name",
+      "SET user:1234:name John Doe",
+      "DEL session:abcdef0123456789",
+      "INCR counter:page:views",
+      "EXPIRE session:abcdef0123456789 3600",
+      "CONFIG SET maxmemory 100mb",
+      "CONFIG GET maxmemory",
+      "FLUSH all"};
+
+  std::mt19937 rng(42);
+  std::uniform_int_distribution<std::size_t> pick(0, commands.size() - 1);
+
+  std::vector<std::string> inputs(1024);
+  for (auto& input : inputs) {
+    input = commands[pick(rng)];
+  }
+  return inputs;
+}
+
+/// A handler, only reading its arguments
+auto Handle(int command, std::string_view args) -> int {
+  return command + static_cast<int>(args.size());
+}
+
+/// Reference: find the delimiter, copy the token and the rest, switch again
+void BM_Token_CopyThenSwitch(benchmark::State& state) {
+  using swstr::SwitchStr;
+  const auto inputs = MakeCommands();
+
+  const auto config = [](const std::string& args) {
+    std::size_t pos = args.size();
+    IsMatching(swstr::ContainsOneOf(" \t", &pos), args);
+    const std::string sub = args.substr(0, pos);
+    const std::string rest = args.substr(std::min(pos + 1, args.size()));
+    return SwitchStr<int>(sub)
+        .Case("GET", [&] { return Handle(10, rest); })
+        .Case("SET", [&] { return Handle(11, rest); })
+        .Default(-2);
+  };
+
+  for (auto _ : state) {
+    for (const auto& input : inputs) {
+      std::size_t pos = input.size();
+      IsMatching(swstr::ContainsOneOf(" \t", &pos), input);
+      const std::string token = input.substr(0, pos);
+      const std::string rest = input.substr(std::min(pos + 1, input.size()));
+
+      benchmark::DoNotOptimize(
+          SwitchStr<int>(token)
+              .Case("GET", [&] { return Handle(0, rest); })
+              .Case("SET", [&] { return Handle(1, rest); })
+              .Case("DEL", [&] { return Handle(2, rest); })
+              .Case("INCR", [&] { return Handle(3, rest); })
+              .Case("EXPIRE", [&] { return Handle(4, rest); })
+              .Case("CONFIG", [&] { return config(rest); })
+              .Default(-1));
+    }
+  }
+  state.SetItemsProcessed(state.iterations() * inputs.size());
+}
+
+void BM_Token_TokenSwitch(benchmark::State& state) {
+  using swstr::TokenSwitch;
+  const auto inputs = MakeCommands();
+
+  const auto handler = [](int command) {
+    return [command](std::string_view rest) { return Handle(command, rest); };
+  };
+  const auto config = [&handler](std::string_view args) {
+    return TokenSwitch<int>(args)
+        .Case("GET", handler(10))
+        .Case("SET", handler(11))
+        .Default(-2);
+  };
+
+  for (auto _ : state) {
+    for (const auto& input : inputs) {
+      benchmark::DoNotOptimize(TokenSwitch<int>(input)
+                                   .Case("GET", handler(0))
+                                   .Case("SET", handler(1))
+                                   .Case("DEL", handler(2))
+                                   .Case("INCR", handler(3))
+                                   .Case("EXPIRE", handler(4))
+                                   .Case("CONFIG", config)
+                                   .Default(-1));
+    }
+  }
+  state.SetItemsProcessed(state.iterations() * inputs.size());
+}
+
+BENCHMARK(BM_Token_CopyThenSwitch);
+BENCHMARK(BM_Token_TokenSwitch);
+
+}  // namespace
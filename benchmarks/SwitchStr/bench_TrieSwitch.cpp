@@ -0,0 +1,83 @@
+#include <random>
+#include <string>
+#include <string_view>
+#include <utility>
+#include <vector>
+
+#include "SwitchStr/Matcher.hpp"
+#include "SwitchStr/TrieSwitch.hpp"
+#include "benchmark/benchmark.h"
+
+namespace {
+
+/// Route like prefixes: "/api/v<V>/<resource><R>/"
+auto MakePrefixes(std::size_t count) -> std::vector<std::string> {
+  std::vector<std::string> prefixes;
+  prefixes.reserve(count);
+  for (std::size_t i = 0; i < count; ++i) {
+    prefixes.push_back("/api/v" + std::to_string(i % 4) + "/resource" +
+                       std::to_string(i) + "/");
+  }
+  return prefixes;
+}
+
+auto MakeInputs(const std::vector<std::string>& prefixes, std::size_t count)
+    -> std::vector<std::string> {
+  std::mt19937 rng(42);
+  std::uniform_int_distribution<std::size_t> pick(0, prefixes.size() - 1);
+
+  std::vector<std::string> inputs;
+  inputs.reserve(count);
+  for (std::size_t i = 0; i < count; ++i) {
+    // 1 out of 4 inputs doesn't match any prefix
+    inputs.push_back((i % 4 == 0 ? "/static" : prefixes[pick(rng)]) +
+                     "items/1234?sort=asc");
+  }
+  return inputs;
+}
+
+void BM_Prefixes_Sequential(benchmark::State& state) {
+  const auto prefixes = MakePrefixes(state.range(0));
+  const auto inputs = MakeInputs(prefixes, 1024);
+
+  std::vector<std::pair<swstr::StartsWithMatcher, int>> cases;
+  for (std::size_t i = 0; i < prefixes.size(); ++i) {
+    cases.emplace_back(swstr::StartsWith(prefixes[i]), static_cast<int>(i));
+  }
+
+  for (auto _ : state) {
+    for (const auto& str : inputs) {
+      int res = -1;
+      for (const auto& [matcher, value] : cases) {
+        if (swstr::IsMatching(matcher, str)) {
+          res = value;
+          break;
+        }
+      }
+      benchmark::DoNotOptimize(res);
+    }
+  }
+  state.SetItemsProcessed(state.iterations() * inputs.size());
+}
+
+void BM_Prefixes_TrieSwitch(benchmark::State& state) {
+  const auto prefixes = MakePrefixes(state.range(0));
+  const auto inputs = MakeInputs(prefixes, 1024);
+
+  auto trie = swstr::TrieSwitch<int>();
+  for (std::size_t i = 0; i < prefixes.size(); ++i) {
+    trie.Case(swstr::StartsWith(prefixes[i]), static_cast<int>(i));
+  }
+
+  for (auto _ : state) {
+    for (const auto& str : inputs) {
+      benchmark::DoNotOptimize(trie.LookupOr(str, -1));
+    }
+  }
+  state.SetItemsProcessed(state.iterations() * inputs.size());
+}
+
+BENCHMARK(BM_Prefixes_Sequential)->Arg(8)->Arg(64)->Arg(512);
+BENCHMARK(BM_Prefixes_TrieSwitch)->Arg(8)->Arg(64)->Arg(512);
+
+}  // namespace
@@ -6,8 +6,13 @@
 # provide the testing related options
 #
 # It declares the following options, prefixed by ${PROJECT_NAME}:
-#  ${PROJECT_NAME}_ENABLE_TESTING    - BOOL   - Enable unittests
-#  ${PROJECT_NAME}_TESTING_GTEST_URL - STRING - GTest URL location
+#  ${PROJECT_NAME}_ENABLE_TESTING          - BOOL   - Enable unittests
+#  ${PROJECT_NAME}_TESTING_GTEST_URL       - STRING - GTest URL location
+#  ${PROJECT_NAME}_ENABLE_BENCHMARKS       - BOOL   - Enable benchmarks
+#  ${PROJECT_NAME}_BENCHMARKS_BENCHMARK_URL - STRING - Google Benchmark URL
+#  ${PROJECT_NAME}_BENCHMARKS_JSON_OUTPUT  - PATH   - JSON results of the
+#                                                     ${PROJECT_NAME}-bench-json
+#                                                     target
 
 include(CMakePrintHelpers)
 
@@ -25,6 +30,25 @@ set(${PROJECT_NAME}_TESTING_GTEST_URL
   )
 cmake_print_variables(${PROJECT_NAME}_TESTING_GTEST_URL)
 
+option(${PROJECT_NAME}_ENABLE_BENCHMARKS
+  "Enable benchmarks build of ${PROJECT_NAME}"
+  OFF)
+cmake_print_variables(${PROJECT_NAME}_ENABLE_BENCHMARKS)
+
+set(${PROJECT_NAME}_BENCHMARKS_BENCHMARK_URL
+  "https://github.com/google/benchmark/archive/v1.8.3.zip"
+  CACHE STRING
+  "Points towards the benchmark.zip URL that will be fetch, if Google Benchmark is not installed on the system."
+  )
+cmake_print_variables(${PROJECT_NAME}_BENCHMARKS_BENCHMARK_URL)
+
+set(${PROJECT_NAME}_BENCHMARKS_JSON_OUTPUT
+  "${PROJECT_BINARY_DIR}/${PROJECT_NAME}-bench.json"
+  CACHE FILEPATH
+  "Where the ${PROJECT_NAME}-bench-json target writes the benchmarks results (JSON)."
+  )
+cmake_print_variables(${PROJECT_NAME}_BENCHMARKS_JSON_OUTPUT)
+
 function(find_gtest)
   find_package(GTest)
 
@@ -45,3 +69,23 @@ function(find_gtest)
     message(STATUS "Fetching GTest @ \"${${PROJECT_NAME}_TESTING_GTEST_URL}\": DONE")
   endif()
 endfunction()
+
+function(find_benchmark)
+  find_package(benchmark)
+
+  if(NOT benchmark_FOUND)
+    message(STATUS "Fetching benchmark @ \"${${PROJECT_NAME}_BENCHMARKS_BENCHMARK_URL}\": ...")
+
+    set(BENCHMARK_ENABLE_TESTING OFF CACHE BOOL "" FORCE)
+    set(BENCHMARK_ENABLE_INSTALL OFF CACHE BOOL "" FORCE)
+
+    include(FetchContent)
+    FetchContent_Declare(
+      benchmark
+      URL ${${PROJECT_NAME}_BENCHMARKS_BENCHMARK_URL}
+      )
+    FetchContent_MakeAvailable(benchmark)
+
+    message(STATUS "Fetching benchmark @ \"${${PROJECT_NAME}_BENCHMARKS_BENCHMARK_URL}\": DONE")
+  endif()
+endfunction()
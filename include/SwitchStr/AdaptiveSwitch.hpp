@@ -0,0 +1,303 @@
+#pragma once
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <span>
+#include <string_view>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+#include "SwitchStr/Matcher.hpp"
+#include "SwitchStr/details/CaseList.hpp"
+
+namespace swstr {
+
+/**
+ *  \brief Runtime switch evaluating its cases in turn, hottest cases first
+ *
+ *  Cases are split into segments of consecutive cases which are pairwise
+ *  disjoint (no string can match 2 of them). Inside a segment, the evaluation
+ *  order doesn't change the result, such that the switch counts the hits of
+ *  each case and, every ReorderEvery() lookups, sorts each segment by hits
+ *  (the counts are then halved, to follow traffic changes).
+ *  Segments themselves are never reordered: the winning case is always the
+ *  first one matching, in declaration order.
+ *
+ *  Disjointness is either:
+ *  - proven, between Equals/StartsWith/EndsWith (and string like) cases, from
+ *    their patterns (i.e. Equals("a") and Equals("b"), StartsWith("ab") and
+ *    StartsWith("ac"), Equals("abc") and EndsWith("x"), ...);
+ *  - or told, with Builder::AssumeDisjoint(), which the caller guarantees for
+ *    all cases (including opaque matchers).
+ *  Any other pair of cases is assumed to overlap, ending the segment.
+ *
+ *  \note Lookups update the hit counts (and the order), such that the switch
+ *        is not thread shareable
+ *
+ *  Example:
+ *  \code
+ *  auto keywords = AdaptiveSwitch<int>::Builder()
+ *                      .Case(Equals("SELECT"), 0)
+ *                      .Case(Equals("FROM"), 1)
+ *                      ...
+ *                      .Build();
+ *  keywords.LookupOr(token, -1);
+ *  \endcode
+ *
+ *  \tparam ResultType The type of values returned by the switch
+ *  \tparam ErasedMatcher The type erased matcher storing the opaque matchers
+ */
+template <typename ResultType, typename ErasedMatcher = AnyMatcher>
+class AdaptiveSwitch {
+  using Kind = details::CaseKind;
+  using CaseEntry = details::CaseEntry;
+
+ public:
+  /// Lookups mutate the order of evaluation
+  static constexpr bool is_thread_shareable = false;
+
+  /// Index returned when no case matches
+  static constexpr std::size_t npos = std::numeric_limits<std::size_t>::max();
+
+  /// Default number of lookups between 2 reorders
+  static constexpr std::size_t kDefaultReorderPeriod = 1024;
+
+  /**
+   *  \brief Builder of the AdaptiveSwitch, gathering its cases
+   */
+  class Builder {
+   public:
+    Builder() = default;
+
+    /**
+     *  \brief Add a case to the switch
+     *
+     *  \param[in] m The matcher of the case
+     *  \param[in] value The value returned when the case wins
+     */
+    template <typename Matcher, typename T = ResultType>
+    auto Case(Matcher&& m, T&& value) & -> Builder& {
+      m_cases.Add(std::forward<Matcher>(m));
+      m_values.emplace_back(std::forward<T>(value));
+      return *this;
+    }
+
+    template <typename Matcher, typename T = ResultType>
+    auto Case(Matcher&& m, T&& value) && -> Builder&& {
+      Case(std::forward<Matcher>(m), std::forward<T>(value));
+      return std::move(*this);
+    }
+
+    /**
+     *  \brief Declare that no string can match 2 cases of the switch, such
+     *         that all cases can be reordered
+     *
+     *  \warning Nothing is checked: when wrong, a later case may win instead
+     *           of the first matching one
+     */
+    auto AssumeDisjoint() & -> Builder& {
+      m_assume_disjoint = true;
+      return *this;
+    }
+
+    auto AssumeDisjoint() && -> Builder&& {
+      AssumeDisjoint();
+      return std::move(*this);
+    }
+
+    /**
+     *  \brief Set the number of lookups between 2 reorders (0 to never
+     *         reorder automatically, see AdaptiveSwitch::Reorder())
+     */
+    auto ReorderEvery(std::size_t lookups) & -> Builder& {
+      m_period = lookups;
+      return *this;
+    }
+
+    auto ReorderEvery(std::size_t lookups) && -> Builder&& {
+      ReorderEvery(lookups);
+      return std::move(*this);
+    }
+
+    /// Build the switch, leaving the builder empty
+    auto Build() && -> AdaptiveSwitch {
+      return AdaptiveSwitch(std::move(*this));
+    }
+
+    /// Build the switch, keeping the builder untouched
+    auto Build() const& -> AdaptiveSwitch {
+      return AdaptiveSwitch(Builder(*this));
+    }
+
+   private:
+    friend class AdaptiveSwitch;
+
+    details::CaseList<ErasedMatcher> m_cases;
+    std::vector<ResultType> m_values;
+    bool m_assume_disjoint = false;
+    std::size_t m_period = kDefaultReorderPeriod;
+  };
+
+  /// Number of cases
+  auto Size() const noexcept -> std::size_t { return m_values.size(); }
+
+  /**
+   *  \brief Current evaluation order (case indexes, in declaration order)
+   */
+  auto Order() const noexcept -> std::span<const std::uint32_t> {
+    return m_order;
+  }
+
+  /**
+   *  \brief Number of segments, i.e. groups of consecutive cases reordered
+   *         together (1 when all cases are disjoint)
+   */
+  auto Segments() const noexcept -> std::size_t {
+    return m_segment_ends.size();
+  }
+
+  /**
+   *  \brief Index of the first case matching \a str (in declaration order)
+   *
+   *  \return std::size_t The index of the winning case, npos if none
+   */
+  auto IndexOf(std::string_view str) -> std::size_t {
+    std::size_t found = npos;
+    for (const std::uint32_t index : m_order) {
+      if (m_cases.IsMatching(m_cases[index], str)) {
+        ++m_hits[index];
+        found = index;
+        break;
+      }
+    }
+
+    if (++m_lookups == m_period) Reorder();
+    return found;
+  }
+
+  /// Value of the case \a index
+  auto ValueAt(std::size_t index) const -> const ResultType& {
+    return m_values[index];
+  }
+
+  /**
+   *  \brief Look for the value of the first case matching \a str
+   *
+   *  \return const ResultType* The value of the winning case, nullptr if none
+   */
+  auto Lookup(std::string_view str) -> const ResultType* {
+    const std::size_t index = IndexOf(str);
+    return (index == npos) ? nullptr : &m_values[index];
+  }
+
+  /**
+   *  \brief Look for the value of the first case matching \a str, or
+   *         \a default_value
+   */
+  template <typename T>
+  auto LookupOr(std::string_view str, T&& default_value) -> ResultType {
+    const ResultType* const value = Lookup(str);
+    if (value == nullptr) {
+      return ResultType(std::forward<T>(default_value));
+    } else {
+      return *value;
+    }
+  }
+
+  /**
+   *  \brief Sort each segment by hits (most hit first), then halve the hits
+   *
+   *  \note Called automatically every ReorderEvery() lookups
+   */
+  void Reorder() {
+    auto begin = m_order.begin();
+    for (const std::uint32_t end : m_segment_ends) {
+      std::stable_sort(begin, m_order.begin() + end,
+                       [this](std::uint32_t lhs, std::uint32_t rhs) {
+                         return m_hits[lhs] > m_hits[rhs];
+                       });
+      begin = m_order.begin() + end;
+    }
+
+    for (auto& hits : m_hits) {
+      hits /= 2;
+    }
+    m_lookups = 0;
+  }
+
+ private:
+  explicit AdaptiveSwitch(Builder&& builder)
+      : m_cases(std::move(builder.m_cases)),
+        m_values(std::move(builder.m_values)),
+        m_period(builder.m_period),
+        m_hits(m_cases.Size(), 0) {
+    m_order.resize(m_cases.Size());
+    for (std::size_t i = 0; i < m_order.size(); ++i) {
+      m_order[i] = static_cast<std::uint32_t>(i);
+    }
+
+    // Greedy segments: a case joins the current segment when disjoint from
+    // all of its cases
+    std::size_t segment_begin = 0;
+    for (std::size_t i = 0; i < m_cases.Size(); ++i) {
+      for (std::size_t j = segment_begin; j < i; ++j) {
+        if (not builder.m_assume_disjoint and
+            not AreDisjoint(m_cases[i], m_cases[j])) {
+          m_segment_ends.push_back(static_cast<std::uint32_t>(i));
+          segment_begin = i;
+          break;
+        }
+      }
+    }
+    if (m_cases.Size() != 0) {
+      m_segment_ends.push_back(static_cast<std::uint32_t>(m_cases.Size()));
+    }
+  }
+
+  /// True when no string can match both \a lhs and \a rhs
+  auto AreDisjoint(const CaseEntry& lhs, const CaseEntry& rhs) const noexcept
+      -> bool {
+    if (lhs.kind > rhs.kind) return AreDisjoint(rhs, lhs);
+
+    const std::string_view l = m_cases.PatternOf(lhs);
+    const std::string_view r = m_cases.PatternOf(rhs);
+
+    switch (lhs.kind) {
+      case Kind::kEquals:
+        switch (rhs.kind) {
+          case Kind::kEquals:
+            return l != r;
+          case Kind::kStartsWith:
+            return not l.starts_with(r);
+          case Kind::kEndsWith:
+            return not l.ends_with(r);
+          case Kind::kOpaque:
+            return false;
+        }
+        break;
+      case Kind::kStartsWith:
+        return (rhs.kind == Kind::kStartsWith) and not l.starts_with(r) and
+               not r.starts_with(l);
+      case Kind::kEndsWith:
+        return (rhs.kind == Kind::kEndsWith) and not l.ends_with(r) and
+               not r.ends_with(l);
+      case Kind::kOpaque:
+        return false;
+    }
+    return false;
+  }
+
+  details::CaseList<ErasedMatcher> m_cases; /*!< In declaration order */
+  std::vector<ResultType> m_values; /*!< Values, indexed by case index */
+
+  std::size_t m_period;                      /*!< Lookups between reorders */
+  std::size_t m_lookups = 0;                 /*!< Lookups since last reorder */
+  std::vector<std::uint64_t> m_hits;         /*!< Hits, per case index */
+  std::vector<std::uint32_t> m_order;        /*!< Case indexes, as evaluated */
+  std::vector<std::uint32_t> m_segment_ends; /*!< End of each segment */
+};
+
+}  // namespace swstr
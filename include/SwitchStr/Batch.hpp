@@ -0,0 +1,159 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <optional>
+#include <span>
+#include <string_view>
+#include <type_traits>
+#include <utility>
+
+#include "SwitchStr/Matcher.hpp"
+
+namespace swstr {
+
+namespace details {
+
+/**
+ *  \brief Meta function use to detect the batch matcher interface:
+ *         IsMatching(std::span<const std::string_view>, std::span<Out>)
+ */
+template <typename T, typename Out, typename = void>
+struct HasBatchIsMatchingInterface : std::false_type {};
+
+template <typename T, typename Out>
+struct HasBatchIsMatchingInterface<
+    T, Out,
+    std::void_t<decltype(std::declval<const T&>().IsMatching(
+        std::declval<std::span<const std::string_view>>(),
+        std::declval<std::span<Out>>()))>> : std::true_type {};
+
+/**
+ *  \brief Meta function use to detect the batch Match interface:
+ *         Match(std::span<const std::string_view>,
+ *               std::span<std::optional<MatchSpan>>)
+ */
+template <typename T, typename = void>
+struct HasBatchMatchInterface : std::false_type {};
+
+template <typename T>
+struct HasBatchMatchInterface<
+    T, std::void_t<decltype(std::declval<const T&>().Match(
+           std::declval<std::span<const std::string_view>>(),
+           std::declval<std::span<std::optional<MatchSpan>>>()))>>
+    : std::true_type {};
+
+/**
+ *  \brief Meta function use to detect the batch switch interface:
+ *         IndexOf(std::span<const std::string_view>, std::span<std::size_t>)
+ */
+template <typename T, typename = void>
+struct HasBatchIndexOfInterface : std::false_type {};
+
+template <typename T>
+struct HasBatchIndexOfInterface<
+    T, std::void_t<decltype(std::declval<const T&>().IndexOf(
+           std::declval<std::span<const std::string_view>>(),
+           std::declval<std::span<std::size_t>>()))>> : std::true_type {};
+
+template <typename Matcher, typename Out>
+void BatchIsMatching(Matcher&& m, std::span<const std::string_view> strs,
+                     std::span<Out> out) {
+  using M = std::remove_cvref_t<Matcher>;
+  if constexpr (HasBatchIsMatchingInterface<M, Out>::value) {
+    m.IsMatching(strs, out);
+  } else {
+    for (std::size_t i = 0; i < strs.size(); ++i) {
+      out[i] = ::swstr::IsMatching(m, strs[i]);
+    }
+  }
+}
+
+}  // namespace details
+
+/**
+ *  \brief Match all \a strs at once: out[i] = IsMatching(m, strs[i])
+ *
+ *  \note The built-in Equals/StartsWith/EndsWith/Contains/ContainsR matchers
+ *        use specialized loops. Any other matcher can provide its own by
+ *        defining IsMatching(std::span<const std::string_view>,
+ *        std::span<Out>) const, otherwise the matcher is called on each
+ *        string.
+ *
+ *  \pre out.size() >= strs.size()
+ *
+ *  \param[in] m The matcher to use
+ *  \param[in] strs All strings to match
+ *  \param[out] out The result of each match (1 when matching, 0 otherwise)
+ */
+template <typename Matcher>
+void IsMatching(Matcher&& m, std::span<const std::string_view> strs,
+                std::span<std::uint8_t> out) {
+  details::BatchIsMatching(std::forward<Matcher>(m), strs, out);
+}
+
+/// Same as above, writing the results as bool
+template <typename Matcher>
+void IsMatching(Matcher&& m, std::span<const std::string_view> strs,
+                std::span<bool> out) {
+  details::BatchIsMatching(std::forward<Matcher>(m), strs, out);
+}
+
+/**
+ *  \brief Match all \a strs at once, reporting what matched inside each of
+ *         them: out[i] = Match(m, strs[i])
+ *
+ *  \note Use it instead of the 'where' pointers when batching: there is one
+ *        position per string (the batch IsMatching() of the built-in
+ *        matchers rejects them)
+ *  \note Contains/ContainsR use a specialized loop. Any other matcher can
+ *        provide its own by defining Match(std::span<const std::string_view>,
+ *        std::span<std::optional<MatchSpan>>) const, otherwise Match() is
+ *        called on each string.
+ *
+ *  \pre out.size() >= strs.size()
+ *
+ *  \param[in] m The matcher to use
+ *  \param[in] strs All strings to match
+ *  \param[out] out The part of each string matched (nullopt when none)
+ */
+template <typename Matcher>
+void Match(Matcher&& m, std::span<const std::string_view> strs,
+           std::span<std::optional<MatchSpan>> out) {
+  if constexpr (details::HasBatchMatchInterface<
+                    std::remove_cvref_t<Matcher>>::value) {
+    m.Match(strs, out);
+  } else {
+    for (std::size_t i = 0; i < strs.size(); ++i) {
+      out[i] = ::swstr::Match(m, strs[i]);
+    }
+  }
+}
+
+/**
+ *  \brief Lookup all \a strs at once: out[i] = s.IndexOf(strs[i])
+ *
+ *  \note Switches can provide a specialized loop by defining
+ *        IndexOf(std::span<const std::string_view>, std::span<std::size_t>)
+ *        const (i.e. SwitchTable), otherwise s.IndexOf() is called on each
+ *        string (i.e. StaticSwitch)
+ *
+ *  \pre out.size() >= strs.size()
+ *
+ *  \param[in] s The switch to use
+ *  \param[in] strs All strings to switch on
+ *  \param[out] out Index of the case matching each string (npos if none)
+ */
+template <typename Switch>
+void IndexOf(const Switch& s, std::span<const std::string_view> strs,
+             std::span<std::size_t> out) {
+  if constexpr (details::HasBatchIndexOfInterface<Switch>::value) {
+    s.IndexOf(strs, out);
+  } else {
+    for (std::size_t i = 0; i < strs.size(); ++i) {
+      out[i] = s.IndexOf(strs[i]);
+    }
+  }
+}
+
+}  // namespace swstr
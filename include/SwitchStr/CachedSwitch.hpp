@@ -0,0 +1,385 @@
+#pragma once
+
+#include <algorithm>
+#include <atomic>
+#include <bit>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <string_view>
+#include <type_traits>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+#include "SwitchStr/details/PerfectHash.hpp"
+#include "SwitchStr/details/Probe.hpp"
+
+namespace swstr {
+
+/// Counters of a CachedSwitch (see CachedSwitch::Stats())
+struct CacheStats {
+  std::uint64_t hits = 0;      /*!< Results found in the cache */
+  std::uint64_t misses = 0;    /*!< Results computed, then cached */
+  std::uint64_t evictions = 0; /*!< Entries replaced by a miss */
+  std::uint64_t bypasses = 0;  /*!< Results computed, keys too long */
+
+  /// Number of strings switched on
+  constexpr auto Lookups() const noexcept -> std::uint64_t {
+    return hits + misses + bypasses;
+  }
+
+  /// Hits / Lookups(), 0 when nothing was looked up
+  constexpr auto HitRate() const noexcept -> double {
+    return (Lookups() == 0) ? 0.
+                            : static_cast<double>(hits) /
+                                  static_cast<double>(Lookups());
+  }
+
+  constexpr auto operator+=(const CacheStats& other) noexcept
+      -> CacheStats& {
+    hits += other.hits;
+    misses += other.misses;
+    evictions += other.evictions;
+    bypasses += other.bypasses;
+    return *this;
+  }
+};
+
+/**
+ *  \brief Memoize a switch (or a table, or any function of a string) whose
+ *         inputs repeat, in a bounded cache of its results
+ *
+ *  Each string is hashed, then looked up in the cache: only misses run the
+ *  switch, whose result is then cached. The cache is set associative (sets
+ *  of kWays entries, picked by the hash), each set being evicted using the
+ *  CLOCK algorithm (second chance: an entry hit since the hand last passed
+ *  survives).
+ *
+ *  All the memory is allocated at construction: keys are COPIED into a
+ *  fixed buffer of max_key_size bytes per entry (longer strings bypass the
+ *  cache), such that the cache never holds views on the strings switched
+ *  on.
+ *
+ *  Example:
+ *  \code
+ *  CachedSwitch classify(
+ *      [](std::string_view ua) {
+ *        return SwitchStr<Agent>(ua)
+ *            .Case(Contains("Googlebot"), Agent::kBot)
+ *            ... // Hundreds of cases
+ *            .Default(Agent::kUnknown);
+ *      },
+ *      4096);
+ *  classify(user_agent);
+ *  \endcode
+ *
+ *  \note The switch must be a pure function of the string (the same string
+ *        always giving the same result), otherwise cached results are stale
+ *  \note NOT thread safe, see ThreadLocalCachedSwitch to share one switch
+ *        between threads
+ *
+ *  \tparam ResultType The type returned by the switch (copied out of the
+ *                     cache on hits)
+ *  \tparam Switch The switch, callable as ResultType(std::string_view)
+ */
+template <typename ResultType, typename Switch>
+class CachedSwitch {
+  static_assert(std::is_invocable_r_v<ResultType, const Switch&,
+                                      std::string_view>,
+                "The CachedSwitch switch must be callable as "
+                "ResultType(std::string_view).");
+  static_assert(std::is_copy_constructible_v<ResultType>,
+                "The CachedSwitch results must be copyable.");
+
+ public:
+  /// Number of entries of a set, compared on each lookup
+  static constexpr std::size_t kWays = 8;
+
+  /// Longest string cached by default
+  static constexpr std::size_t kDefaultMaxKeySize = 256;
+
+  /**
+   *  \brief Construct the cache in front of \a s
+   *
+   *  \param[in] s The switch memoized
+   *  \param[in] capacity Minimum number of results cached (rounded up to a
+   *                      power of 2 multiple of kWays)
+   *  \param[in] max_key_size Longest string cached, the key bytes
+   *                          allocated are capacity * max_key_size
+   */
+  CachedSwitch(Switch s, std::size_t capacity,
+               std::size_t max_key_size = kDefaultMaxKeySize)
+      : m_switch(std::move(s)),
+        m_max_key_size(max_key_size),
+        m_set_mask(std::bit_ceil(std::max<std::size_t>(
+                       (capacity + kWays - 1) / kWays, 1)) -
+                   1),
+        m_hashes(Capacity(), 0),
+        m_referenced(Capacity(), 0),
+        m_hands(m_set_mask + 1, 0),
+        m_key_sizes(Capacity(), 0),
+        m_keys(std::make_unique<char[]>(Capacity() * m_max_key_size)),
+        m_values(Capacity()) {}
+
+  /// Number of results the cache can hold
+  auto Capacity() const noexcept -> std::size_t {
+    return (m_set_mask + 1) * kWays;
+  }
+
+  /**
+   *  \brief Result of the switch on \a str, computed only when not cached
+   */
+  auto operator()(std::string_view str) -> ResultType {
+    if (str.size() > m_max_key_size) {
+      m_bypasses.Add(1);
+      return std::invoke(m_switch, str);
+    }
+
+    // 0 marks the free entries
+    const std::uint64_t h = details::WordHashStr(str) | 1;
+    const std::size_t set = (h >> 32) & m_set_mask;
+    const std::size_t first = set * kWays;
+
+    for (std::size_t entry = first; entry < first + kWays; ++entry) {
+      if ((m_hashes[entry] == h) and (m_key_sizes[entry] == str.size()) and
+          details::EqualBytes(KeyOf(entry), str.data(), str.size())) {
+        m_referenced[entry] = 1;
+        m_hits.Add(1);
+        return *m_values[entry];
+      }
+    }
+
+    ResultType result = std::invoke(m_switch, str);
+    m_misses.Add(1);
+
+    const std::size_t entry = Victim(set);
+    if (m_hashes[entry] != 0) m_evictions.Add(1);
+
+    m_values[entry].emplace(result);
+    m_hashes[entry] = h;
+    m_referenced[entry] = 0;
+    m_key_sizes[entry] = str.size();
+    std::memcpy(KeyOf(entry), str.data(), str.size());
+    return result;
+  }
+
+  /// Counters since the construction (or the last Clear())
+  auto Stats() const noexcept -> CacheStats {
+    return CacheStats{.hits = m_hits.Load(),
+                      .misses = m_misses.Load(),
+                      .evictions = m_evictions.Load(),
+                      .bypasses = m_bypasses.Load()};
+  }
+
+  /// Empty the cache and reset the counters
+  void Clear() {
+    std::fill(m_hashes.begin(), m_hashes.end(), 0);
+    std::fill(m_referenced.begin(), m_referenced.end(), 0);
+    std::fill(m_hands.begin(), m_hands.end(), 0);
+    for (auto& value : m_values) {
+      value.reset();
+    }
+    m_hits.Reset();
+    m_misses.Reset();
+    m_evictions.Reset();
+    m_bypasses.Reset();
+  }
+
+ private:
+  auto KeyOf(std::size_t entry) const noexcept -> char* {
+    return m_keys.get() + entry * m_max_key_size;
+  }
+
+  /// Entry of \a set replaced: a free one, otherwise the CLOCK victim
+  auto Victim(std::size_t set) noexcept -> std::size_t {
+    const std::size_t first = set * kWays;
+    for (std::size_t entry = first; entry < first + kWays; ++entry) {
+      if (m_hashes[entry] == 0) return entry;
+    }
+
+    std::uint8_t& hand = m_hands[set];
+    while (m_referenced[first + hand] != 0) {
+      m_referenced[first + hand] = 0;
+      hand = (hand + 1) % kWays;
+    }
+
+    const std::size_t entry = first + hand;
+    hand = (hand + 1) % kWays;
+    return entry;
+  }
+
+  Switch m_switch;
+  std::size_t m_max_key_size;
+  std::size_t m_set_mask;
+
+  std::vector<std::uint64_t> m_hashes;    /*!< Hash | 1 of keys, 0 if free */
+  std::vector<std::uint8_t> m_referenced; /*!< Hit since the hand passed */
+  std::vector<std::uint8_t> m_hands;      /*!< CLOCK hand of each set */
+  std::vector<std::size_t> m_key_sizes;
+  std::unique_ptr<char[]> m_keys; /*!< max_key_size bytes per entry */
+  std::vector<std::optional<ResultType>> m_values;
+
+  instrument::details::Counter m_hits;
+  instrument::details::Counter m_misses;
+  instrument::details::Counter m_evictions;
+  instrument::details::Counter m_bypasses;
+};
+
+template <typename Switch>
+CachedSwitch(Switch, std::size_t)
+    -> CachedSwitch<std::invoke_result_t<const Switch&, std::string_view>,
+                    Switch>;
+
+template <typename Switch>
+CachedSwitch(Switch, std::size_t, std::size_t)
+    -> CachedSwitch<std::invoke_result_t<const Switch&, std::string_view>,
+                    Switch>;
+
+namespace details {
+
+/// Cache of a ThreadLocalCachedSwitch, held by the map of a thread
+struct ThreadCacheEntry {
+  std::weak_ptr<const void> owner; /*!< Expired once the switch is destroyed */
+  void* cache;
+};
+
+/// Caches of the current thread, by ThreadLocalCachedSwitch ID
+inline auto ThreadCaches()
+    -> std::unordered_map<std::uint64_t, ThreadCacheEntry>& {
+  thread_local std::unordered_map<std::uint64_t, ThreadCacheEntry> caches;
+  return caches;
+}
+
+/// Unique ThreadLocalCachedSwitch ID, never reused
+inline auto NextCacheOwnerId() noexcept -> std::uint64_t {
+  static std::atomic<std::uint64_t> next = 1;
+  return next.fetch_add(1, std::memory_order_relaxed);
+}
+
+}  // namespace details
+
+/**
+ *  \brief CachedSwitch shared by many threads: each thread gets its OWN
+ *         cache (created on its first lookup), such that a lookup never
+ *         takes any lock nor shares any cache line with other threads
+ *
+ *  The switch itself is shared: it is called by all threads at once,
+ *  through a const reference (see IsThreadShareable).
+ *
+ *  \note The caches live as long as the ThreadLocalCachedSwitch (even when
+ *        their thread exits), such that Stats() sums all of them. Memory
+ *        used is at most threads * capacity entries.
+ *  \note Each thread only holds a weak handle on the caches: the entries of
+ *        the switches destroyed are dropped by the thread the next time it
+ *        uses a new switch
+ *
+ *  \tparam ResultType The type returned by the switch
+ *  \tparam Switch The switch, callable as ResultType(std::string_view)
+ */
+template <typename ResultType, typename Switch>
+class ThreadLocalCachedSwitch {
+  using Cache =
+      CachedSwitch<ResultType, std::reference_wrapper<const Switch>>;
+
+ public:
+  /**
+   *  \brief Construct the switch, the caches are only created when used
+   *
+   *  \param[in] s The switch memoized
+   *  \param[in] capacity Minimum number of results cached PER THREAD
+   *  \param[in] max_key_size Longest string cached (see CachedSwitch)
+   */
+  ThreadLocalCachedSwitch(
+      Switch s, std::size_t capacity,
+      std::size_t max_key_size = Cache::kDefaultMaxKeySize)
+      : m_switch(std::move(s)),
+        m_capacity(capacity),
+        m_max_key_size(max_key_size) {}
+
+  ThreadLocalCachedSwitch(const ThreadLocalCachedSwitch&) = delete;
+  auto operator=(const ThreadLocalCachedSwitch&)
+      -> ThreadLocalCachedSwitch& = delete;
+
+  /**
+   *  \brief Result of the switch on \a str, using the cache of the calling
+   *         thread
+   */
+  auto operator()(std::string_view str) const -> ResultType {
+    return Local()(str);
+  }
+
+  /// Counters of all the caches, summed
+  auto Stats() const -> CacheStats {
+    const std::lock_guard lock(m_mutex);
+    CacheStats stats;
+    for (const auto& cache : m_caches) {
+      stats += cache->Stats();
+    }
+    return stats;
+  }
+
+  /// Number of caches created (i.e. threads that used the switch)
+  auto CacheCount() const -> std::size_t {
+    const std::lock_guard lock(m_mutex);
+    return m_caches.size();
+  }
+
+ private:
+  /// Cache of the calling thread, the last one used being remembered
+  auto Local() const -> Cache& {
+    thread_local std::uint64_t last_id = 0;
+    thread_local Cache* last = nullptr;
+    if (last_id == m_id) return *last;
+
+    auto& caches = details::ThreadCaches();
+    auto entry = caches.find(m_id);
+    if (entry == caches.end()) {
+      // IDs are never reused: the entries of the switches destroyed are
+      // never looked up again
+      std::erase_if(caches, [](const auto& other) {
+        return other.second.owner.expired();
+      });
+
+      auto cache = std::make_unique<Cache>(std::cref(m_switch), m_capacity,
+                                           m_max_key_size);
+      entry = caches.emplace(m_id, details::ThreadCacheEntry{m_alive,
+                                                             cache.get()})
+                  .first;
+
+      const std::lock_guard lock(m_mutex);
+      m_caches.push_back(std::move(cache));
+    }
+
+    last_id = m_id;
+    last = static_cast<Cache*>(entry->second.cache);
+    return *last;
+  }
+
+  const std::uint64_t m_id = details::NextCacheOwnerId();
+
+  /// Only referenced weakly by the threads, expiring with the switch
+  const std::shared_ptr<const void> m_alive = std::make_shared<char>();
+  Switch m_switch;
+  std::size_t m_capacity;
+  std::size_t m_max_key_size;
+
+  mutable std::mutex m_mutex;
+  mutable std::vector<std::unique_ptr<Cache>> m_caches;
+};
+
+template <typename Switch>
+ThreadLocalCachedSwitch(Switch, std::size_t)
+    -> ThreadLocalCachedSwitch<
+        std::invoke_result_t<const Switch&, std::string_view>, Switch>;
+
+template <typename Switch>
+ThreadLocalCachedSwitch(Switch, std::size_t, std::size_t)
+    -> ThreadLocalCachedSwitch<
+        std::invoke_result_t<const Switch&, std::string_view>, Switch>;
+
+}  // namespace swstr
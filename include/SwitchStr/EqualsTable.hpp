@@ -0,0 +1,271 @@
+#pragma once
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <string_view>
+#include <utility>
+#include <vector>
+
+#include "SwitchStr/Matcher.hpp"
+#include "SwitchStr/details/SwissTable.hpp"
+
+namespace swstr {
+
+/**
+ *  \brief Table mapping exact keys known at runtime only (i.e. tens of
+ *         thousands of hostnames loaded from a configuration) to values
+ *
+ *  The keys are copied into ONE contiguous buffer, indexed by a Swiss table
+ *  like hash table (see details::SwissTable): a lookup hashes the string
+ *  once (see details::WordHashStr), then compares its tag to 16 slots at
+ *  once, only comparing the bytes of the keys whose tag matches.
+ *
+ *  Used inside a switch, the whole table is a single case (see
+ *  EqualsAnyOf()), evaluated in declaration order like any other case.
+ *
+ *  Example:
+ *  \code
+ *  auto builder = EqualsTable<Policy>::Builder();
+ *  for (const auto& [host, policy] : config.hosts) {
+ *    builder.Case(host, policy);
+ *  }
+ *  const auto hosts = std::move(builder).Build();
+ *
+ *  std::size_t which = 0;
+ *  SwitchStr<Policy>(host)
+ *      .Case("localhost", Policy::kAllow)
+ *      .Case(EqualsAnyOf(hosts, &which), [&] { return hosts.ValueAt(which); })
+ *      .Case(EndsWith(".internal"), Policy::kAllow)
+ *      .Default(Policy::kDeny);
+ *  \endcode
+ *
+ *  \tparam ResultType The type of values returned by the table
+ */
+template <typename ResultType>
+class EqualsTable {
+ public:
+  /// Lookups only read the table (see IsThreadShareable)
+  static constexpr bool is_thread_shareable = true;
+
+  /// Index returned when no key matches
+  static constexpr std::size_t npos = std::numeric_limits<std::size_t>::max();
+
+  /**
+   *  \brief Builder of the EqualsTable, gathering its cases
+   */
+  class Builder {
+   public:
+    Builder() = default;
+
+    /**
+     *  \brief Make room for \a count cases, whose keys hold \a bytes bytes
+     *         overall, avoiding growing the table while adding them
+     */
+    auto Reserve(std::size_t count, std::size_t bytes = 0) & -> Builder& {
+      m_table.Reserve(count, bytes);
+      m_values.reserve(count);
+      return *this;
+    }
+
+    auto Reserve(std::size_t count, std::size_t bytes = 0) && -> Builder&& {
+      Reserve(count, bytes);
+      return std::move(*this);
+    }
+
+    /**
+     *  \brief Add a case to the table
+     *
+     *  \note When many cases share the same key, the first one wins
+     *
+     *  \param[in] key The key of the case, copied
+     *  \param[in] value The value returned when the case wins
+     *
+     *  \throw std::length_error When the keys overflow 4 GiB
+     */
+    template <typename T = ResultType>
+    auto Case(std::string_view key, T&& value) & -> Builder& {
+      const std::uint32_t index = m_table.Insert(
+          key, static_cast<std::uint32_t>(m_values.size()));
+      if (index == m_values.size()) {
+        m_lengths.min = std::min(m_lengths.min, key.size());
+        m_lengths.max = std::max(m_lengths.max, key.size());
+      }
+
+      m_values.emplace_back(std::forward<T>(value));
+      return *this;
+    }
+
+    template <typename T = ResultType>
+    auto Case(std::string_view key, T&& value) && -> Builder&& {
+      Case(key, std::forward<T>(value));
+      return std::move(*this);
+    }
+
+    /// Build the table, leaving the builder empty
+    auto Build() && -> EqualsTable { return EqualsTable(std::move(*this)); }
+
+    /// Build the table, keeping the builder untouched
+    auto Build() const& -> EqualsTable { return EqualsTable(Builder(*this)); }
+
+   private:
+    friend class EqualsTable;
+
+    details::SwissTable m_table;
+    std::vector<ResultType> m_values;
+    details::LengthRange m_lengths{std::string_view::npos, 0};
+  };
+
+  /// Number of cases
+  auto Size() const noexcept -> std::size_t { return m_values.size(); }
+
+  /// Lengths [min, max] of the keys (min > max when empty)
+  auto Lengths() const noexcept -> details::LengthRange { return m_lengths; }
+
+  /// Bytes allocated by the table (slots, keys and values)
+  auto MemoryUsage() const noexcept -> std::size_t {
+    return m_table.MemoryUsage() + (m_values.capacity() * sizeof(ResultType));
+  }
+
+  /**
+   *  \brief Index of the case whose key is \a str
+   *
+   *  \return std::size_t The index of the case (in declaration order), npos
+   *          if none
+   */
+  auto IndexOf(std::string_view str) const noexcept -> std::size_t {
+    const std::uint32_t index = m_table.Find(str);
+    return (index == details::SwissTable::kNotFound) ? npos : index;
+  }
+
+  /// Value of the case \a index
+  auto ValueAt(std::size_t index) const -> const ResultType& {
+    return m_values[index];
+  }
+
+  /**
+   *  \brief Look for the value of the case whose key is \a str
+   *
+   *  \return const ResultType* The value of the case, nullptr if none
+   */
+  auto Lookup(std::string_view str) const noexcept -> const ResultType* {
+    const std::size_t index = IndexOf(str);
+    return (index == npos) ? nullptr : &m_values[index];
+  }
+
+  /**
+   *  \brief Look for the value of the case whose key is \a str, or
+   *         \a default_value
+   */
+  template <typename T>
+  auto LookupOr(std::string_view str, T&& default_value) const -> ResultType {
+    const ResultType* const value = Lookup(str);
+    if (value == nullptr) {
+      return ResultType(std::forward<T>(default_value));
+    } else {
+      return *value;
+    }
+  }
+
+ private:
+  explicit EqualsTable(Builder&& builder)
+      : m_table(std::move(builder.m_table)),
+        m_values(std::move(builder.m_values)),
+        m_lengths(builder.m_lengths) {}
+
+  details::SwissTable m_table;
+  std::vector<ResultType> m_values; /*!< Values, indexed by case index */
+  details::LengthRange m_lengths;
+};
+
+/**
+ *  \brief Matcher checking if a string equals one of the keys of an
+ *         EqualsTable
+ *
+ *  \note The table is referenced: it must outlive the matcher
+ *
+ *  \tparam ResultType The type of values of the table
+ *  \tparam WithWhich When true, the index of the case found is written to a
+ *                    'which' pointer (the matcher is then NOT thread
+ *                    shareable)
+ */
+template <typename ResultType, bool WithWhich>
+class EqualsAnyOfMatcher {
+ public:
+  /// Matching writes to 'which', when any
+  static constexpr bool is_thread_shareable = not WithWhich;
+
+  /// Cost of matching a string (see MatchCost): the string is hashed
+  static constexpr std::size_t match_cost = details::kCostScan;
+
+  /**
+   *  \brief Construct the matcher
+   *
+   *  \param[in] table The table whose keys are matched
+   *  \param[inout] which Set to the index of the case found (see
+   *                      EqualsTable::ValueAt())
+   */
+  EqualsAnyOfMatcher(const EqualsTable<ResultType>& table,
+                     details::MatchOutputPtr<WithWhich> which) noexcept
+      : m_table(&table), m_which(which) {}
+
+  /// Lengths of the strings matched
+  auto Lengths() const noexcept -> details::LengthRange {
+    return m_table->Lengths();
+  }
+
+  auto IsMatching(std::string_view str) const noexcept -> bool {
+    const std::size_t index = m_table->IndexOf(str);
+    if (index == EqualsTable<ResultType>::npos) return false;
+
+    m_which.Set(index);
+    return true;
+  }
+
+  auto operator()(std::string_view str) const noexcept -> bool {
+    return IsMatching(str);
+  }
+
+ private:
+  const EqualsTable<ResultType>* m_table;
+  [[no_unique_address]] details::MatchOutput<WithWhich> m_which;
+};
+
+/**
+ *  \brief Matches when the string equals ONE OF the keys of \a table
+ *
+ *  Equivalent to AnyOf(Equals(key0), Equals(key1), ...), with a single hash
+ *  lookup whatever the number of keys.
+ *
+ *  \param[in] table The table whose keys are matched, must outlive the
+ *                   matcher
+ */
+template <typename ResultType>
+auto EqualsAnyOf(const EqualsTable<ResultType>& table) noexcept {
+  return EqualsAnyOfMatcher<ResultType, false>(table, nullptr);
+}
+
+/**
+ *  \brief Same as above, reporting the case found
+ *
+ *  \param[in] table The table whose keys are matched, must outlive the
+ *                   matcher
+ *  \param[inout] which Set to the index of the case found (see
+ *                      EqualsTable::ValueAt())
+ */
+template <typename ResultType>
+auto EqualsAnyOf(const EqualsTable<ResultType>& table,
+                 std::size_t* const which) noexcept {
+  return EqualsAnyOfMatcher<ResultType, true>(table, which);
+}
+
+/// Temporaries are not allowed, they would dangle
+template <typename ResultType>
+auto EqualsAnyOf(const EqualsTable<ResultType>&& table) = delete;
+
+template <typename ResultType>
+auto EqualsAnyOf(const EqualsTable<ResultType>&& table,
+                 std::size_t* const which) = delete;
+
+}  // namespace swstr
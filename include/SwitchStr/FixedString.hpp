@@ -0,0 +1,54 @@
+#pragma once
+
+#include <cstddef>
+#include <string>
+#include <string_view>
+
+namespace swstr {
+
+/**
+ *  \brief Compile time string, usable as a Non Type Template Parameter (NTTP)
+ *
+ *  \note Constructed implicitly from a string literal, such that one can write
+ *        Foo<"bar">, with Foo declared as template <FixedString S> struct Foo;
+ *
+ *  \tparam N Size of the underlying char array, INCLUDING the '\0'
+ */
+template <std::size_t N>
+struct FixedString {
+  static_assert(N > 0, "FixedString must at least contains the '\\0'");
+
+  /**
+   *  \brief Construct the FixedString copying the \a str literal
+   *
+   *  \param[in] str The string literal we wish to copy
+   */
+  constexpr FixedString(const char (&str)[N]) noexcept {
+    for (std::size_t i = 0; i < N; ++i) {
+      data[i] = str[i];
+    }
+  }
+
+  /**
+   *  \brief Number of chars, EXCLUDING the '\0'
+   *
+   *  \note Same as std::string_view{literal}, and any literal used at runtime
+   *        (see details::EqualsLiteral()), the chars stop at the first '\0'
+   *        (i.e. "a\0b" holds "a")
+   */
+  constexpr auto size() const noexcept -> std::size_t {
+    const char* const end = std::char_traits<char>::find(data, N - 1, '\0');
+    return (end == nullptr) ? N - 1 : static_cast<std::size_t>(end - data);
+  }
+
+  /// View over the chars, EXCLUDING the '\0' (see size())
+  constexpr auto view() const noexcept -> std::string_view {
+    return std::string_view{data, size()};
+  }
+
+  constexpr operator std::string_view() const noexcept { return view(); }
+
+  char data[N] = {}; /*!< Underlying chars, public in order to be an NTTP */
+};
+
+}  // namespace swstr
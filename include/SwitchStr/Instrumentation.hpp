@@ -0,0 +1,378 @@
+#pragma once
+
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <map>
+#include <mutex>
+#include <ostream>
+#include <source_location>
+#include <string_view>
+#include <tuple>
+#include <type_traits>
+#include <vector>
+
+#include "SwitchStr/details/Cpu.hpp"
+#include "SwitchStr/details/Probe.hpp"
+
+/**
+ *  \file
+ *  \brief Optional instrumentation of SwitchStr and AnyMatcher
+ *
+ *  When SwitchStr_ENABLE_INSTRUMENTATION is 1 (see the CMake option of the
+ *  same name), each SwitchStr and AnyMatcher records, per call site (where
+ *  the switch/matcher is constructed) and per case:
+ *  - how many times the case is evaluated (i.e. how deep inputs go into the
+ *    chain of cases);
+ *  - how many times it matches;
+ *  - optionally, the CPU cycles spent evaluating it (see EnableCycles()).
+ *
+ *  Counters are kept per thread, such that threads never contend on them, and
+ *  are merged on demand by Collect()/Dump().
+ *
+ *  When 0 (the default), probes are compiled out: SwitchStr and AnyMatcher are
+ *  token for token the same as without instrumentation, and Collect() is
+ *  always empty.
+ *
+ *  \warning All translation units of a program must agree on the value of
+ *           SwitchStr_ENABLE_INSTRUMENTATION, which changes the layout of
+ *           SwitchStr and AnyMatcher.
+ *
+ *  \note SwitchStr and the matchers only include details/Probe.hpp, which
+ *        includes this header when the instrumentation is enabled
+ */
+
+namespace swstr::instrument {
+
+/// Counters of a single case of a site
+struct CaseStats {
+  std::uint64_t evaluations = 0; /*!< Number of times the case was evaluated */
+  std::uint64_t hits = 0;        /*!< Number of times the case matched */
+  std::uint64_t cycles = 0;      /*!< Cycles spent in it (see EnableCycles()) */
+};
+
+/// Counters of a call site, merged over all threads
+struct SiteStats {
+  std::string_view kind;          /*!< "SwitchStr" or "AnyMatcher" */
+  std::string_view file;          /*!< Where the site is constructed */
+  std::string_view function;      /*!< Function constructing the site */
+  std::uint_least32_t line = 0;   /*!< Line of the site in file */
+  std::uint_least32_t column = 0; /*!< Column of the site in file */
+  std::vector<CaseStats> cases;   /*!< Counters, in the cases order */
+};
+
+namespace details {
+
+struct CaseCounters {
+  Counter evaluations;
+  Counter hits;
+  Counter cycles;
+};
+
+inline auto CyclesFlag() noexcept -> std::atomic<bool>& {
+  static std::atomic<bool> enabled = false;
+  return enabled;
+}
+
+/// Cycles counter (TSC on x86, nanoseconds otherwise)
+inline auto Cycles() noexcept -> std::uint64_t {
+#if SwitchStr_X86_DISPATCH
+  return __rdtsc();
+#else
+  return static_cast<std::uint64_t>(
+      std::chrono::steady_clock::now().time_since_epoch().count());
+#endif
+}
+
+class ThreadCounters;
+
+/**
+ *  \brief All the sites of the program, and the counters of all threads
+ *
+ *  \note Lock order: Registry::m_mutex, then ThreadCounters::m_mutex
+ */
+class Registry {
+ public:
+  static auto Get() -> Registry& {
+    static Registry registry;
+    return registry;
+  }
+
+  /// Id of the site (\a kind, \a location), registering it the first time
+  auto SiteId(std::string_view kind, const std::source_location& location)
+      -> std::size_t {
+    const std::lock_guard lock(m_mutex);
+
+    const auto [it, inserted] = m_ids.try_emplace(
+        Key(kind, location.file_name(), location.line(), location.column()),
+        m_sites.size());
+    if (inserted) {
+      m_sites.push_back(SiteStats{.kind = kind,
+                                  .file = location.file_name(),
+                                  .function = location.function_name(),
+                                  .line = location.line(),
+                                  .column = location.column(),
+                                  .cases = {}});
+    }
+    return it->second;
+  }
+
+  inline void Register(ThreadCounters* counters);
+  inline void Retire(ThreadCounters* counters);
+  inline auto Collect() -> std::vector<SiteStats>;
+  inline void Reset();
+
+ private:
+  using Key = std::tuple<std::string_view, std::string_view,
+                         std::uint_least32_t, std::uint_least32_t>;
+
+  Registry() = default;
+
+  std::mutex m_mutex;
+  std::map<Key, std::size_t> m_ids;        /*!< Id of each site */
+  std::vector<SiteStats> m_sites;          /*!< Counters of exited threads */
+  std::vector<ThreadCounters*> m_threads;  /*!< Counters of running threads */
+};
+
+/// Counters of the current thread, per site and per case
+class ThreadCounters {
+ public:
+  static auto Get() -> ThreadCounters& {
+    thread_local ThreadCounters counters;
+    return counters;
+  }
+
+  ThreadCounters(const ThreadCounters&) = delete;
+  ThreadCounters& operator=(const ThreadCounters&) = delete;
+
+  /**
+   *  \brief Id of the site (\a kind, \a location), cached per thread
+   *
+   *  \note A SwitchStr looks its site up each time it is constructed, hence
+   *        the direct mapped cache in front of the map
+   */
+  auto SiteId(std::string_view kind, const std::source_location& location)
+      -> std::size_t {
+    const CacheKey key(kind.data(), location.file_name(), location.line(),
+                       location.column());
+
+    CacheSlot& slot =
+        m_cache[(location.line() * 31 + location.column()) % kCacheSize];
+    if (slot.key == key) return slot.id;
+
+    auto found = m_ids.find(key);
+    if (found == m_ids.end()) {
+      found = m_ids.emplace(key, Registry::Get().SiteId(kind, location)).first;
+    }
+
+    slot = CacheSlot{key, found->second};
+    return found->second;
+  }
+
+  /**
+   *  \brief Counters of the \a index-th case of \a site
+   *
+   *  \warning The reference is invalidated by the next call
+   */
+  SwitchStr_PROBE_INLINE auto Case(std::size_t site, std::size_t index)
+      -> CaseCounters& {
+    if ((site < m_sites.size()) and (index < m_sites[site].size())) {
+      return m_sites[site][index];
+    }
+    return Grow(site, index);
+  }
+
+ private:
+  friend class Registry;
+
+  using CacheKey = std::tuple<const void*, const void*, std::uint_least32_t,
+                              std::uint_least32_t>;
+
+  /// Slow path of Case()
+  SwitchStr_PROBE_NOINLINE auto Grow(std::size_t site, std::size_t index)
+      -> CaseCounters& {
+    // Only the structure is guarded: the counters themselves are atomics
+    const std::lock_guard lock(m_mutex);
+    if (m_sites.size() <= site) m_sites.resize(site + 1);
+    if (m_sites[site].size() <= index) m_sites[site].resize(index + 1);
+    return m_sites[site][index];
+  }
+
+  ThreadCounters() { Registry::Get().Register(this); }
+  ~ThreadCounters() { Registry::Get().Retire(this); }
+
+  static constexpr std::size_t kCacheSize = 64;
+
+  struct CacheSlot {
+    CacheKey key = {};
+    std::size_t id = 0;
+  };
+
+  std::array<CacheSlot, kCacheSize> m_cache = {};
+  std::map<CacheKey, std::size_t> m_ids;
+  std::mutex m_mutex;
+  std::vector<std::vector<CaseCounters>> m_sites;
+};
+
+/// Merge \a counters into \a stats
+inline void Merge(const std::vector<CaseCounters>& counters, SiteStats& stats) {
+  if (stats.cases.size() < counters.size()) {
+    stats.cases.resize(counters.size());
+  }
+  for (std::size_t i = 0; i < counters.size(); ++i) {
+    stats.cases[i].evaluations += counters[i].evaluations.Load();
+    stats.cases[i].hits += counters[i].hits.Load();
+    stats.cases[i].cycles += counters[i].cycles.Load();
+  }
+}
+
+inline void Registry::Register(ThreadCounters* counters) {
+  const std::lock_guard lock(m_mutex);
+  m_threads.push_back(counters);
+}
+
+inline void Registry::Retire(ThreadCounters* counters) {
+  const std::lock_guard lock(m_mutex);
+  const std::lock_guard thread_lock(counters->m_mutex);
+  for (std::size_t site = 0; site < counters->m_sites.size(); ++site) {
+    Merge(counters->m_sites[site], m_sites[site]);
+  }
+  m_threads.erase(std::find(m_threads.begin(), m_threads.end(), counters));
+}
+
+inline auto Registry::Collect() -> std::vector<SiteStats> {
+  const std::lock_guard lock(m_mutex);
+  std::vector<SiteStats> sites = m_sites;
+  for (ThreadCounters* counters : m_threads) {
+    const std::lock_guard thread_lock(counters->m_mutex);
+    for (std::size_t site = 0; site < counters->m_sites.size(); ++site) {
+      Merge(counters->m_sites[site], sites[site]);
+    }
+  }
+  return sites;
+}
+
+inline void Registry::Reset() {
+  const std::lock_guard lock(m_mutex);
+  for (auto& site : m_sites) {
+    site.cases.clear();
+  }
+  for (ThreadCounters* counters : m_threads) {
+    const std::lock_guard thread_lock(counters->m_mutex);
+    for (auto& site : counters->m_sites) {
+      for (auto& counter : site) {
+        counter.evaluations.Reset();
+        counter.hits.Reset();
+        counter.cycles.Reset();
+      }
+    }
+  }
+}
+
+/// Evaluate the case \a index of \a site, recording it
+template <typename Evaluate>
+SwitchStr_PROBE_INLINE auto Record(std::size_t site, std::size_t index,
+                                   Evaluate& evaluate) -> bool {
+  const bool with_cycles = CyclesFlag().load(std::memory_order_relaxed);
+  const std::uint64_t start = with_cycles ? Cycles() : 0;
+  const bool hit = evaluate();
+  const std::uint64_t cycles = with_cycles ? Cycles() - start : 0;
+
+  // Only retrieved now: evaluate() may record (and grow) other sites
+  CaseCounters& counters = ThreadCounters::Get().Case(site, index);
+  counters.evaluations.Add(1);
+  counters.cycles.Add(cycles);
+  if (hit) counters.hits.Add(1);
+  return hit;
+}
+
+/**
+ *  \brief Probe of a SwitchStr, each evaluation of Record() being the next
+ *         case of the chain
+ */
+class SwitchProbe {
+ public:
+  constexpr SwitchProbe(std::string_view kind,
+                        const std::source_location& location) {
+    if (not std::is_constant_evaluated()) {
+      m_site = ThreadCounters::Get().SiteId(kind, location);
+    }
+  }
+
+  template <typename Evaluate>
+  SwitchStr_PROBE_INLINE constexpr auto Record(Evaluate&& evaluate) -> bool {
+    if (std::is_constant_evaluated()) return evaluate();
+    return details::Record(m_site, m_next_case++, evaluate);
+  }
+
+ private:
+  std::size_t m_site = 0;
+  std::size_t m_next_case = 0;
+};
+
+/**
+ *  \brief Probe of a matcher, recording all its evaluations as a single case
+ */
+class MatcherProbe {
+ public:
+  MatcherProbe(std::string_view kind, const std::source_location& location)
+      : m_site(ThreadCounters::Get().SiteId(kind, location)) {}
+
+  template <typename Evaluate>
+  SwitchStr_PROBE_INLINE auto Record(Evaluate&& evaluate) const -> bool {
+    return details::Record(m_site, 0, evaluate);
+  }
+
+ private:
+  std::size_t m_site;
+};
+
+}  // namespace details
+
+/**
+ *  \brief Enable (or disable) the cycles count of each evaluation
+ *
+ *  \note Disabled by default, reading the cycles counter twice per evaluation
+ *        being much more expensive than the evaluations/hits counters
+ */
+inline void EnableCycles(bool enabled = true) noexcept {
+  details::CyclesFlag().store(enabled, std::memory_order_relaxed);
+}
+
+/**
+ *  \brief The counters of all sites, merged over all threads (running or
+ *         exited)
+ *
+ *  \note Counters of running threads are read while being written: each
+ *        counter is exact, but may be a few evaluations behind the others
+ *
+ *  \return One SiteStats per site, in the order they were first constructed
+ *          (always empty when SwitchStr_ENABLE_INSTRUMENTATION is 0)
+ */
+inline auto Collect() -> std::vector<SiteStats> {
+  return details::Registry::Get().Collect();
+}
+
+/**
+ *  \brief Reset all the counters to 0
+ */
+inline void Reset() { details::Registry::Get().Reset(); }
+
+/**
+ *  \brief Write all the counters, one line per case, to \a out:
+ *         "<file>:<line>:<column> <kind> #<case> <evaluations> <hits> <cycles>"
+ */
+inline void Dump(std::ostream& out) {
+  for (const SiteStats& site : Collect()) {
+    for (std::size_t i = 0; i < site.cases.size(); ++i) {
+      out << site.file << ':' << site.line << ':' << site.column << ' '
+          << site.kind << " #" << i << ' ' << site.cases[i].evaluations << ' '
+          << site.cases[i].hits << ' ' << site.cases[i].cycles << '\n';
+    }
+  }
+}
+
+}  // namespace swstr::instrument
@@ -0,0 +1,618 @@
+#pragma once
+
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <bit>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <functional>
+#include <limits>
+#include <memory>
+#include <mutex>
+#include <stdexcept>
+#include <string_view>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+#include "SwitchStr/details/PerfectHash.hpp"
+#include "SwitchStr/details/SwitchResult.hpp"
+
+namespace swstr {
+
+/**
+ *  \brief Dense 32 bits ID of a string interned by an Interner
+ *
+ *  Two symbols of the same Interner are equal if and only if their strings
+ *  are, such that comparing strings boils down to comparing integers.
+ */
+class Symbol {
+ public:
+  /// ID of the invalid symbol, never handed out by an Interner
+  static constexpr std::uint32_t kInvalidId =
+      std::numeric_limits<std::uint32_t>::max();
+
+  /// The invalid symbol
+  constexpr Symbol() = default;
+
+  constexpr explicit Symbol(std::uint32_t id) noexcept : m_id(id) {}
+
+  /// The ID, symbols being handed out as 0, 1, 2, ... in interning order
+  constexpr auto Id() const noexcept -> std::uint32_t { return m_id; }
+
+  /// False for the invalid symbol (i.e. returned by Interner::Find() misses)
+  constexpr auto IsValid() const noexcept -> bool {
+    return m_id != kInvalidId;
+  }
+
+  constexpr auto operator==(const Symbol&) const noexcept -> bool = default;
+
+ private:
+  std::uint32_t m_id = kInvalidId;
+};
+
+/// Memory used by an Interner (see Interner::Memory())
+struct InternerMemory {
+  std::size_t symbols = 0;         /*!< Number of strings interned */
+  std::size_t string_bytes = 0;    /*!< Bytes of the strings interned */
+  std::size_t arena_bytes = 0;     /*!< Bytes allocated to store them */
+  std::size_t directory_bytes = 0; /*!< Symbol -> string entries */
+  std::size_t table_bytes = 0;     /*!< String -> symbol hash table */
+  std::size_t retired_bytes = 0;   /*!< Tables replaced when growing */
+
+  /// All bytes allocated by the Interner
+  constexpr auto Total() const noexcept -> std::size_t {
+    return arena_bytes + directory_bytes + table_bytes + retired_bytes;
+  }
+};
+
+/**
+ *  \brief Maps strings to dense 32 bits Symbol, such that strings matched
+ *         again and again can be interned ONCE and then compared/switched on
+ *         as integers (see SymbolSwitch and SymbolTable)
+ *
+ *  - The strings are copied into an arena of kChunkSize chunks, never moved
+ *    nor freed until the Interner is destroyed: View() stays valid;
+ *  - Symbol -> string: segmented array of entries (segment s holding
+ *    kFirstSegmentSize << s entries), never reallocated;
+ *  - String -> symbol: flat open addressing (linear probing) hash table, each
+ *    slot packing 32 bits of the string hash and the symbol, such that most
+ *    probes never touch the strings. It is doubled when half full.
+ *
+ *  Find(), View() and the first lookup of Intern() are LOCK FREE: they only
+ *  perform acquire loads, and can run concurrently with Intern(). Inserting
+ *  is serialized by a mutex. When growing, the new table is published
+ *  atomically and the previous one is kept alive (readers may still probe
+ *  it) until the Interner is destroyed, which costs at most as much memory
+ *  as the current table.
+ *
+ *  \note A concurrent Find() may miss a string whose Intern() didn't return
+ *        yet, never a string already interned
+ */
+class Interner {
+ public:
+  /// Size of the arena chunks (longer strings get a chunk of their own)
+  static constexpr std::size_t kChunkSize = 64 * 1024;
+
+  /// Number of entries of the first directory segment
+  static constexpr std::size_t kFirstSegmentSize = 1024;
+
+  Interner() : Interner(0) {}
+
+  /**
+   *  \brief Construct an empty Interner, whose table won't grow before
+   *         \a expected_symbols are interned
+   */
+  explicit Interner(std::size_t expected_symbols) {
+    m_tables.push_back(std::make_unique<Table>(
+        std::bit_ceil(std::max<std::size_t>(2 * expected_symbols, 16))));
+    m_table.store(m_tables.back().get(), std::memory_order_release);
+  }
+
+  Interner(const Interner&) = delete;
+  auto operator=(const Interner&) -> Interner& = delete;
+
+  /**
+   *  \brief Symbol of \a str, interning it first when needed
+   *
+   *  \throw std::length_error When all the 2^32 - 1 symbols are used
+   */
+  auto Intern(std::string_view str) -> Symbol {
+    const std::uint64_t h = details::WordHashStr(str);
+    if (const Symbol found = Find(str, h); found.IsValid()) {
+      return found;
+    }
+
+    const std::lock_guard lock(m_mutex);
+
+    // Some other thread may have interned it meanwhile
+    if (const Symbol found = Find(str, h); found.IsValid()) {
+      return found;
+    }
+    return Insert(str, h);
+  }
+
+  /**
+   *  \brief Symbol of \a str, WITHOUT interning it (lock free)
+   *
+   *  \return Symbol The symbol of \a str, the invalid Symbol when \a str
+   *          is not interned
+   */
+  auto Find(std::string_view str) const noexcept -> Symbol {
+    return Find(str, details::WordHashStr(str));
+  }
+
+  /**
+   *  \brief String of \a symbol (lock free)
+   *
+   *  \pre \a symbol is a valid symbol handed out by this Interner
+   */
+  auto View(Symbol symbol) const noexcept -> std::string_view {
+    const Entry& entry = EntryOf(symbol.Id());
+    return std::string_view(entry.data, entry.size);
+  }
+
+  /// Number of strings interned
+  auto Size() const noexcept -> std::size_t {
+    return m_size.load(std::memory_order_acquire);
+  }
+
+  /// Memory used, all allocations included
+  auto Memory() const -> InternerMemory {
+    const std::lock_guard lock(m_mutex);
+
+    InternerMemory memory;
+    memory.symbols = m_size.load(std::memory_order_relaxed);
+    memory.string_bytes = m_string_bytes;
+    memory.arena_bytes = m_arena_bytes;
+    for (std::size_t s = 0; s < m_directory.size(); ++s) {
+      memory.directory_bytes += sizeof(Entry) * (kFirstSegmentSize << s);
+    }
+    for (const auto& table : m_tables) {
+      memory.retired_bytes += table->Bytes();
+    }
+    memory.table_bytes = m_tables.back()->Bytes();
+    memory.retired_bytes -= memory.table_bytes;
+    return memory;
+  }
+
+ private:
+  /// Location of an interned string
+  struct Entry {
+    const char* data = nullptr;
+    std::size_t size = 0;
+  };
+
+  /// Open addressing table, a slot packs (hash >> 32) << 32 | (id + 1)
+  struct Table {
+    explicit Table(std::size_t size)
+        : mask(size - 1),
+          slots(std::make_unique<std::atomic<std::uint64_t>[]>(size)) {}
+
+    auto Bytes() const noexcept -> std::size_t {
+      return (mask + 1) * sizeof(std::atomic<std::uint64_t>);
+    }
+
+    std::size_t mask;
+    std::unique_ptr<std::atomic<std::uint64_t>[]> slots; /*!< 0 when free */
+  };
+
+  static constexpr std::size_t kFirstSegmentBits =
+      std::countr_zero(kFirstSegmentSize);
+  static constexpr std::size_t kSegments = 33 - kFirstSegmentBits;
+
+  static constexpr auto TagOf(std::uint64_t h) noexcept -> std::uint64_t {
+    return h & 0xffffffff00000000ull;
+  }
+
+  auto Find(std::string_view str, std::uint64_t h) const noexcept -> Symbol {
+    const Table* const table = m_table.load(std::memory_order_acquire);
+
+    for (std::size_t slot = h & table->mask;;
+         slot = (slot + 1) & table->mask) {
+      const std::uint64_t packed =
+          table->slots[slot].load(std::memory_order_acquire);
+      if (packed == 0) {
+        return Symbol();
+      } else if (TagOf(packed) == TagOf(h)) {
+        const auto id = static_cast<std::uint32_t>(packed) - 1;
+        const Entry& entry = EntryOf(id);
+        if ((entry.size == str.size()) and
+            details::EqualBytes(entry.data, str.data(), str.size())) {
+          return Symbol(id);
+        }
+      }
+    }
+  }
+
+  /// Segment and offset inside it of the entry \a id
+  static constexpr auto LocationOf(std::uint32_t id) noexcept
+      -> std::pair<std::size_t, std::size_t> {
+    const std::uint64_t x = std::uint64_t{id} + kFirstSegmentSize;
+    const std::size_t segment = std::bit_width(x) - 1 - kFirstSegmentBits;
+    return {segment, x - (std::uint64_t{kFirstSegmentSize} << segment)};
+  }
+
+  auto EntryOf(std::uint32_t id) const noexcept -> const Entry& {
+    const auto [segment, offset] = LocationOf(id);
+    return m_segments[segment].load(std::memory_order_acquire)[offset];
+  }
+
+  /// Called with m_mutex held
+  auto Insert(std::string_view str, std::uint64_t h) -> Symbol {
+    const std::uint32_t id = m_size.load(std::memory_order_relaxed);
+    if (id == Symbol::kInvalidId) {
+      throw std::length_error("swstr::Interner: no more symbols available");
+    }
+
+    Table* table = m_tables.back().get();
+    if (2 * (std::size_t{id} + 1) > (table->mask + 1)) {
+      table = Grow();
+    }
+
+    const auto [segment, offset] = LocationOf(id);
+    if (segment == m_directory.size()) {
+      m_directory.push_back(
+          std::make_unique<Entry[]>(kFirstSegmentSize << segment));
+      m_segments[segment].store(m_directory.back().get(),
+                                std::memory_order_release);
+    }
+    m_directory[segment][offset] = Entry{Store(str), str.size()};
+
+    // Publishing the slot publishes the entry (and the string bytes)
+    Place(*table, h, id, std::memory_order_release);
+    m_size.store(id + 1, std::memory_order_release);
+    return Symbol(id);
+  }
+
+  static void Place(Table& table, std::uint64_t h, std::uint32_t id,
+                    std::memory_order order) noexcept {
+    std::size_t slot = h & table.mask;
+    while (table.slots[slot].load(std::memory_order_relaxed) != 0) {
+      slot = (slot + 1) & table.mask;
+    }
+    table.slots[slot].store(TagOf(h) | (std::uint64_t{id} + 1), order);
+  }
+
+  /// Double the table, the previous one being retired (still readable)
+  auto Grow() -> Table* {
+    const Table& current = *m_tables.back();
+    auto grown = std::make_unique<Table>(2 * (current.mask + 1));
+
+    const std::uint32_t size = m_size.load(std::memory_order_relaxed);
+    for (std::uint32_t id = 0; id < size; ++id) {
+      const auto [segment, offset] = LocationOf(id);
+      const Entry& entry = m_directory[segment][offset];
+      Place(*grown, details::WordHashStr({entry.data, entry.size}), id,
+            std::memory_order_relaxed);
+    }
+
+    m_tables.push_back(std::move(grown));
+    m_table.store(m_tables.back().get(), std::memory_order_release);
+    return m_tables.back().get();
+  }
+
+  /// Copy \a str into the arena
+  auto Store(std::string_view str) -> const char* {
+    // No chunk may exist yet, and memcpy() from/to nullptr is UB
+    if (str.empty()) return "";
+
+    m_string_bytes += str.size();
+
+    if (str.size() > kChunkSize / 4) {
+      m_chunks.push_back(std::make_unique_for_overwrite<char[]>(str.size()));
+      m_arena_bytes += str.size();
+      std::memcpy(m_chunks.back().get(), str.data(), str.size());
+      return m_chunks.back().get();
+    }
+
+    if (str.size() > m_chunk_left) {
+      m_chunks.push_back(std::make_unique_for_overwrite<char[]>(kChunkSize));
+      m_arena_bytes += kChunkSize;
+      m_chunk_cursor = m_chunks.back().get();
+      m_chunk_left = kChunkSize;
+    }
+
+    char* const data = m_chunk_cursor;
+    std::memcpy(data, str.data(), str.size());
+    m_chunk_cursor += str.size();
+    m_chunk_left -= str.size();
+    return data;
+  }
+
+  // Read by everyone, lock free
+  std::atomic<const Table*> m_table = nullptr;
+  std::array<std::atomic<const Entry*>, kSegments> m_segments = {};
+  std::atomic<std::uint32_t> m_size = 0;
+
+  // Guarded by m_mutex
+  mutable std::mutex m_mutex;
+  std::vector<std::unique_ptr<Table>> m_tables; /*!< The last is current */
+  std::vector<std::unique_ptr<Entry[]>> m_directory;
+  std::vector<std::unique_ptr<char[]>> m_chunks;
+  char* m_chunk_cursor = nullptr;
+  std::size_t m_chunk_left = 0;
+  std::size_t m_string_bytes = 0;
+  std::size_t m_arena_bytes = 0;
+};
+
+/**
+ *  \brief Matches ONE symbol, comparing the IDs
+ *
+ *  \note The invalid Symbol never matches, such that interning nothing when
+ *        looking up an unknown string (see Interner::Find()) is safe
+ */
+class SymbolMatcher {
+ public:
+  /// Matching only reads the symbol
+  static constexpr bool is_thread_shareable = true;
+
+  constexpr explicit SymbolMatcher(Symbol symbol) noexcept
+      : m_symbol(symbol) {}
+
+  /// The symbol matched
+  constexpr auto GetSymbol() const noexcept -> Symbol { return m_symbol; }
+
+  constexpr auto IsMatching(Symbol symbol) const noexcept -> bool {
+    return m_symbol.IsValid() and (symbol == m_symbol);
+  }
+
+  constexpr auto operator()(Symbol symbol) const noexcept -> bool {
+    return IsMatching(symbol);
+  }
+
+ private:
+  Symbol m_symbol;
+};
+
+/**
+ *  \brief Matches \a symbol, an O(1) comparison of the IDs (see SymbolSwitch)
+ */
+constexpr auto Equals(Symbol symbol) noexcept -> SymbolMatcher {
+  return SymbolMatcher(symbol);
+}
+
+namespace details {
+
+/**
+ *  \brief Meta function use to detect the Symbol Matcher IsMatching interface
+ */
+template <typename T, typename = void>
+struct HasSymbolMatcherInterface : std::false_type {};
+
+template <typename T>
+struct HasSymbolMatcherInterface<
+    T, std::void_t<decltype(std::declval<T>().IsMatching(Symbol{}))>>
+    : std::is_convertible<decltype(std::declval<T>().IsMatching(Symbol{})),
+                          bool> {};
+
+/// True when \a symbol matches \a m: a Symbol, or a Symbol matcher/predicate
+template <typename Matcher>
+constexpr auto IsMatchingSymbol(Matcher&& m, Symbol symbol) -> bool {
+  using M = std::remove_cvref_t<Matcher>;
+  if constexpr (std::is_same_v<M, Symbol>) {
+    return SymbolMatcher(m).IsMatching(symbol);
+  } else if constexpr (HasSymbolMatcherInterface<M>::value) {
+    return m.IsMatching(symbol);
+  } else {
+    static_assert(std::is_invocable_r_v<bool, Matcher, Symbol>,
+                  "A SymbolSwitch matcher must either be a Symbol, have an "
+                  "IsMatching(Symbol) method, or be a Symbol predicate.");
+    return std::invoke(std::forward<Matcher>(m), symbol);
+  }
+}
+
+}  // namespace details
+
+/**
+ *  \brief SwitchStr over a Symbol: each case compares IDs instead of bytes
+ *
+ *  Example:
+ *  \code
+ *  const Symbol kCpu = interner.Intern("cpu.load");
+ *  const Symbol kMem = interner.Intern("mem.used");
+ *  ...
+ *  SymbolSwitch<int>(interner.Find(name))
+ *      .Case(kCpu, 0)
+ *      .Case(Equals(kMem), 1)
+ *      .Default(-1);
+ *  \endcode
+ *
+ *  \tparam ResultType The type used and returned by the switch
+ */
+template <typename ResultType>
+class SymbolSwitch : public details::SwitchResult<ResultType> {
+ public:
+  constexpr SymbolSwitch() = delete;
+
+  constexpr explicit SymbolSwitch(Symbol symbol) : m_symbol(symbol) {}
+
+  /**
+   *  \brief Add a case to the switch
+   *
+   *  \param[in] m A Symbol, a matcher with an IsMatching(Symbol) method (see
+   *               Equals(Symbol)) or a predicate taking a Symbol
+   *  \param[in] value Either a value convertible to ResultType, or a factory
+   *                   returning it, only converted (or invoked) when the case
+   *                   wins
+   */
+  template <typename Matcher, typename T = ResultType>
+  constexpr auto Case(Matcher&& m, T&& value) & -> SymbolSwitch& {
+    if (not HasResult() and
+        details::IsMatchingSymbol(std::forward<Matcher>(m), m_symbol)) {
+      SetResult(std::forward<T>(value));
+    }
+
+    return *this;
+  }
+
+  template <typename Matcher, typename T = ResultType>
+  constexpr auto Case(Matcher&& m, T&& value) && -> SymbolSwitch&& {
+    Case(std::forward<Matcher>(m), std::forward<T>(value));
+    return std::move(*this);
+  }
+
+ private:
+  using Result = details::SwitchResult<ResultType>;
+  using Result::HasResult;
+  using Result::SetResult;
+
+  Symbol m_symbol;
+};
+
+/**
+ *  \brief Immutable table mapping symbols to values, looked up with ONE
+ *         array access (a jump table indexed by the symbol IDs)
+ *
+ *  The table spans the IDs of its cases, from the lowest to the highest: it
+ *  is the most compact when the cases strings are interned together (i.e.
+ *  when building the table).
+ *
+ *  Example:
+ *  \code
+ *  const auto table = SymbolTable<Handler>::Builder(interner)
+ *                         .Case("cpu.load", OnCpuLoad)
+ *                         .Case("mem.used", OnMemUsed)
+ *                         .Build();
+ *  table.LookupOr(interner.Find(name), OnUnknown);
+ *  \endcode
+ *
+ *  \tparam ResultType The type of values returned by the table
+ */
+template <typename ResultType>
+class SymbolTable {
+ public:
+  /// Lookup() only reads the table
+  static constexpr bool is_thread_shareable = true;
+
+  /// Index returned when no case matches
+  static constexpr std::size_t npos = std::numeric_limits<std::size_t>::max();
+
+  /**
+   *  \brief Builder of the SymbolTable, gathering its cases
+   */
+  class Builder {
+   public:
+    /// Strings cases are interned into \a interner
+    explicit Builder(Interner& interner) : m_interner(&interner) {}
+
+    /**
+     *  \brief Add a case to the table
+     *
+     *  \note When many cases share the same symbol, the first one wins
+     *
+     *  \param[in] key The symbol (or string, interned) of the case
+     *  \param[in] value The value returned when the case wins
+     */
+    template <typename T = ResultType>
+    auto Case(Symbol key, T&& value) & -> Builder& {
+      m_keys.push_back(key);
+      m_values.emplace_back(std::forward<T>(value));
+      return *this;
+    }
+
+    template <typename T = ResultType>
+    auto Case(std::string_view key, T&& value) & -> Builder& {
+      return Case(m_interner->Intern(key), std::forward<T>(value));
+    }
+
+    template <typename Key, typename T = ResultType>
+    auto Case(Key&& key, T&& value) && -> Builder&& {
+      Case(std::forward<Key>(key), std::forward<T>(value));
+      return std::move(*this);
+    }
+
+    /// Build the table, leaving the builder empty
+    auto Build() && -> SymbolTable { return SymbolTable(std::move(*this)); }
+
+    /// Build the table, keeping the builder untouched
+    auto Build() const& -> SymbolTable { return SymbolTable(Builder(*this)); }
+
+   private:
+    friend class SymbolTable;
+
+    Interner* m_interner;
+    std::vector<Symbol> m_keys;
+    std::vector<ResultType> m_values;
+  };
+
+  /// Number of cases
+  auto Size() const noexcept -> std::size_t { return m_values.size(); }
+
+  /**
+   *  \brief Index of the case of \a symbol
+   *
+   *  \return std::size_t The index of the case (in declaration order), npos
+   *          if none
+   */
+  auto IndexOf(Symbol symbol) const noexcept -> std::size_t {
+    const std::uint32_t offset = symbol.Id() - m_first_id;
+    if (offset < m_case_of.size()) {
+      const std::uint32_t case_index = m_case_of[offset];
+      return (case_index == kNoCase) ? npos : case_index;
+    }
+    return npos;
+  }
+
+  /// Value of the case \a index
+  auto ValueAt(std::size_t index) const -> const ResultType& {
+    return m_values[index];
+  }
+
+  /**
+   *  \brief Look for the value of \a symbol
+   *
+   *  \return const ResultType* The value of the case, nullptr if none
+   */
+  auto Lookup(Symbol symbol) const noexcept -> const ResultType* {
+    const std::size_t index = IndexOf(symbol);
+    return (index == npos) ? nullptr : &m_values[index];
+  }
+
+  /**
+   *  \brief Look for the value of \a symbol, or \a default_value
+   */
+  template <typename T>
+  auto LookupOr(Symbol symbol, T&& default_value) const -> ResultType {
+    const ResultType* const value = Lookup(symbol);
+    if (value == nullptr) {
+      return ResultType(std::forward<T>(default_value));
+    } else {
+      return *value;
+    }
+  }
+
+ private:
+  static constexpr std::uint32_t kNoCase =
+      std::numeric_limits<std::uint32_t>::max();
+
+  explicit SymbolTable(Builder&& builder)
+      : m_values(std::move(builder.m_values)) {
+    std::uint32_t last_id = 0;
+    m_first_id = std::numeric_limits<std::uint32_t>::max();
+    for (const Symbol key : builder.m_keys) {
+      if (key.IsValid()) {
+        m_first_id = std::min(m_first_id, key.Id());
+        last_id = std::max(last_id, key.Id());
+      }
+    }
+
+    if (m_first_id <= last_id) {
+      m_case_of.assign(std::size_t{last_id - m_first_id} + 1, kNoCase);
+    }
+    for (std::size_t i = builder.m_keys.size(); i-- > 0;) {
+      const Symbol key = builder.m_keys[i];
+      if (key.IsValid()) {
+        m_case_of[key.Id() - m_first_id] = static_cast<std::uint32_t>(i);
+      }
+    }
+  }
+
+  std::uint32_t m_first_id = 0;
+  std::vector<std::uint32_t> m_case_of; /*!< Case of ID m_first_id + i */
+  std::vector<ResultType> m_values;     /*!< Values, indexed by case */
+};
+
+}  // namespace swstr
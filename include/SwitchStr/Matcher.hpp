@@ -1,10 +1,30 @@
 #pragma once
 
+#include <algorithm>
+#include <array>
+#include <cstddef>
+#include <initializer_list>
 #include <memory>
+#include <new>
+#include <optional>
+#include <source_location>
+#include <span>
+#include <string>
 #include <string_view>
+#include <tuple>
 #include <type_traits>
+#include <utility>
 #include <variant>
 
+#include "SwitchStr/FixedString.hpp"
+#include "SwitchStr/details/AhoCorasick.hpp"
+#include "SwitchStr/details/Ascii.hpp"
+#include "SwitchStr/details/ByteSet.hpp"
+#include "SwitchStr/details/Find.hpp"
+#include "SwitchStr/details/FixedBytes.hpp"
+#include "SwitchStr/details/PerfectHash.hpp"
+#include "SwitchStr/details/Probe.hpp"
+
 namespace swstr {
 
 namespace details {
@@ -41,6 +61,21 @@ template <typename T>
 constexpr bool HasStrMatcherOperatorInterface_v =
     HasStrMatcherOperatorInterface<T>::value;
 
+/**
+ *  \brief Meta function use to detect the String Matcher Match() interface
+ */
+template <typename T, typename = void>
+struct HasStrMatcherMatchInterface : std::false_type {};
+
+template <typename T>
+struct HasStrMatcherMatchInterface<
+    T, std::void_t<decltype(std::declval<T>().Match(std::string_view{}))>>
+    : std::true_type {};
+
+template <typename T>
+constexpr bool HasStrMatcherMatchInterface_v =
+    HasStrMatcherMatchInterface<T>::value;
+
 }  // namespace details
 
 /**
@@ -56,6 +91,11 @@ struct MatcherTraits {
   static constexpr bool has_Operator =
       details::HasStrMatcherOperatorInterface_v<Matcher>;
 
+  /// True if the underlying Matcher has the .Match(sv) -> optional<MatchSpan>
+  /// interface, reporting WHAT matched (see Match())
+  static constexpr bool has_Match =
+      details::HasStrMatcherMatchInterface_v<Matcher>;
+
   /// True if std::string_view{Matcher{}} is possible
   static constexpr bool is_convertible =
       std::is_convertible_v<Matcher, std::string_view>;
@@ -83,6 +123,240 @@ struct MatcherTraits {
   };
 };
 
+namespace details {
+
+/**
+ *  \brief Meta function use to detect the T::is_thread_shareable flag
+ */
+template <typename T, typename = void>
+struct HasThreadShareableFlag : std::false_type {};
+
+template <typename T>
+struct HasThreadShareableFlag<T, std::void_t<decltype(T::is_thread_shareable)>>
+    : std::true_type {};
+
+template <typename T>
+constexpr auto DeduceThreadShareable() noexcept -> bool {
+  if constexpr (HasThreadShareableFlag<T>::value) {
+    return T::is_thread_shareable;
+  } else if constexpr (std::is_convertible_v<T, std::string_view>) {
+    return true;
+  } else if constexpr (std::is_pointer_v<T>) {
+    return std::is_function_v<std::remove_pointer_t<T>>;
+  } else {
+    return std::is_empty_v<T> and
+           (HasStrMatcherIsMatchingInterface_v<const T&> or
+            HasStrMatcherOperatorInterface_v<const T&>);
+  }
+}
+
+}  // namespace details
+
+/**
+ *  \brief Tells if a matcher (or a switch) \a T can be used, through a const
+ *         reference, by many threads at once
+ *
+ *  It is the case when matching never writes anything outside the call. By
+ *  default:
+ *  - Types defining a 'static constexpr bool is_thread_shareable' use it
+ *    (all the built-in matchers and switches do);
+ *  - String like matchers and function pointers are shareable;
+ *  - Stateless (empty) matchers, callable through a const reference, are
+ *    shareable;
+ *  - Anything else (i.e. lambdas capturing references) is NOT;
+ *
+ *  \note Specialize it for your own matchers when needed
+ */
+template <typename T>
+struct IsThreadShareable
+    : std::bool_constant<details::DeduceThreadShareable<T>()> {};
+
+template <typename T>
+constexpr bool IsThreadShareable_v =
+    IsThreadShareable<std::remove_cvref_t<T>>::value;
+
+namespace details {
+
+/**
+ *  \brief Relative costs of matching a string (see MatchCost), use by the
+ *         meta matchers to evaluate the cheapest matchers first
+ */
+inline constexpr std::size_t kCostCompare = 1;       /*!< Bounded compare */
+inline constexpr std::size_t kCostFoldedCompare = 2; /*!< Same, folding case */
+inline constexpr std::size_t kCostScan = 8;          /*!< Scan the string */
+inline constexpr std::size_t kCostAutomaton = 16;    /*!< Run an automaton */
+inline constexpr std::size_t kCostOpaque = 64;       /*!< Unknown */
+
+/**
+ *  \brief Meta function use to detect the T::match_cost value
+ */
+template <typename T, typename = void>
+struct HasMatchCost : std::false_type {};
+
+template <typename T>
+struct HasMatchCost<T, std::void_t<decltype(T::match_cost)>>
+    : std::true_type {};
+
+/// True for the string like matchers (i.e. "foo", compared with ==)
+template <typename T>
+constexpr bool IsStringLikeMatcher_v =
+    MatcherTraits<T>::is_convertible and
+    not MatcherTraits<T>::has_IsMatching and not MatcherTraits<T>::has_Operator;
+
+template <typename T>
+constexpr auto DeduceMatchCost() noexcept -> std::size_t {
+  if constexpr (HasMatchCost<T>::value) {
+    return T::match_cost;
+  } else if constexpr (IsStringLikeMatcher_v<T>) {
+    return kCostCompare;
+  } else {
+    return kCostOpaque;
+  }
+}
+
+}  // namespace details
+
+/**
+ *  \brief Relative cost of matching a string with a matcher \a T, use by the
+ *         meta matchers (AllOf/AnyOf) to evaluate the cheapest ones first
+ *
+ *  By default:
+ *  - Types defining a 'static constexpr std::size_t match_cost' use it (all
+ *    the built-in matchers do, see details::kCost*);
+ *  - String like matchers cost a bounded compare;
+ *  - Anything else is opaque (the most expensive);
+ *
+ *  \note Specialize it for your own matchers when needed
+ */
+template <typename T>
+struct MatchCost
+    : std::integral_constant<std::size_t, details::DeduceMatchCost<T>()> {};
+
+template <typename T>
+constexpr std::size_t MatchCost_v = MatchCost<std::remove_cvref_t<T>>::value;
+
+namespace details {
+
+/**
+ *  \brief Meta function use to detect the T::is_reorderable flag
+ */
+template <typename T, typename = void>
+struct HasReorderableFlag : std::false_type {};
+
+template <typename T>
+struct HasReorderableFlag<T, std::void_t<decltype(T::is_reorderable)>>
+    : std::true_type {};
+
+template <typename T>
+constexpr auto DeduceReorderable() noexcept -> bool {
+  if constexpr (HasReorderableFlag<T>::value) {
+    return T::is_reorderable;
+  } else if constexpr (IsStringLikeMatcher_v<T>) {
+    return true;
+  } else if constexpr (HasMatchCost<T>::value) {
+    return IsThreadShareable_v<T>;
+  } else {
+    return false;
+  }
+}
+
+}  // namespace details
+
+/**
+ *  \brief Tells if the meta matchers (AllOf/AnyOf) may evaluate a matcher
+ *         \a T out of the order of declaration, or skip it entirely
+ *
+ *  Only matchers WITHOUT any side effect are, such that user predicates
+ *  (i.e. logging or counting the strings seen) are always called exactly
+ *  when declared. By default:
+ *  - Types defining a 'static constexpr bool is_reorderable' use it;
+ *  - String like matchers are reorderable;
+ *  - Thread shareable types defining a 'static constexpr std::size_t
+ *    match_cost' are (all the built-in matchers, but the ones writing to a
+ *    'where' output);
+ *  - Anything else (function pointers, lambdas, type erased matchers, ...)
+ *    is NOT;
+ *
+ *  \note Specialize it for your own matchers when needed
+ */
+template <typename T>
+struct IsReorderable : std::bool_constant<details::DeduceReorderable<T>()> {};
+
+template <typename T>
+constexpr bool IsReorderable_v = IsReorderable<std::remove_cvref_t<T>>::value;
+
+namespace details {
+
+/// Lengths [min, max] of the strings a matcher may match
+struct LengthRange {
+  std::size_t min = 0;
+  std::size_t max = std::string_view::npos;
+
+  constexpr auto Contains(std::size_t length) const noexcept -> bool {
+    return (min <= length) and (length <= max);
+  }
+};
+
+/**
+ *  \brief Meta function use to detect the T{}.Lengths() -> LengthRange
+ *         interface
+ */
+template <typename T, typename = void>
+struct HasLengths : std::false_type {};
+
+template <typename T>
+struct HasLengths<T, std::void_t<decltype(std::declval<const T&>().Lengths())>>
+    : std::true_type {};
+
+/// True when the lengths of the strings matched by \a T are known
+template <typename T>
+constexpr bool HasLengths_v = HasLengths<T>::value or IsStringLikeMatcher_v<T>;
+
+/// Lengths of the strings matched by \a m, [0, npos] when unknown
+template <typename Matcher>
+constexpr auto LengthsOf(const Matcher& m) noexcept -> LengthRange {
+  if constexpr (HasLengths<Matcher>::value) {
+    return m.Lengths();
+  } else if constexpr (IsStringLikeMatcher_v<Matcher>) {
+    const std::size_t size = std::string_view{m}.size();
+    return {size, size};
+  } else {
+    (void)m;
+    return {};
+  }
+}
+
+/// True for string literals, i.e. const char[N]
+template <typename T>
+struct IsCharLiteral : std::false_type {};
+
+template <std::size_t N>
+struct IsCharLiteral<const char[N]> : std::true_type {};
+
+/**
+ *  \brief Compare \a str against a string \a literal, using its array
+ *         length instead of looking for its '\0'
+ *
+ *  \note Arrays holding a '\0' before their last char (i.e. zero padded
+ *        buffers, "a\0b") are compared up to their first '\0' instead, as
+ *        std::string_view{literal} does. The lookup is folded away by the
+ *        compiler for literals
+ */
+template <std::size_t N>
+constexpr auto EqualsLiteral(std::string_view str,
+                             const char (&literal)[N]) noexcept -> bool {
+  if constexpr (N < 2) {
+    return str.empty();
+  } else {
+    if (std::char_traits<char>::find(literal, N - 1, '\0') != nullptr) {
+      return str == std::string_view{literal};
+    }
+    return (str.size() == N - 1) and EqualBytes(str.data(), literal, N - 1);
+  }
+}
+
+}  // namespace details
+
 /**
  *  \brief Main function use to dispatch the correct function call to the
  *         matcher \a m  with \a str
@@ -102,6 +376,9 @@ constexpr auto IsMatching(Matcher&& m, std::string_view str) -> bool {
     return m.IsMatching(str);
   } else if constexpr (Traits::has_Operator) {
     return m(str);
+  } else if constexpr (details::IsCharLiteral<
+                           std::remove_reference_t<Matcher>>::value) {
+    return details::EqualsLiteral(str, m);
   } else if constexpr (Traits::is_convertible) {
     return str == std::string_view{m};
   } else {
@@ -114,6 +391,76 @@ constexpr auto IsMatching(Matcher&& m, std::string_view str) -> bool {
   }
 }
 
+/**
+ *  \brief Part of a string matched by a matcher (see Match())
+ */
+struct MatchSpan {
+  std::size_t offset = 0; /*!< Index of the first char matched */
+  std::size_t length = 0; /*!< Number of chars matched */
+
+  /// Index following the last char matched
+  constexpr auto End() const noexcept -> std::size_t { return offset + length; }
+
+  /// The chars of \a str matched
+  constexpr auto In(std::string_view str) const noexcept -> std::string_view {
+    return str.substr(offset, length);
+  }
+
+  /// The chars of \a str preceding the ones matched
+  constexpr auto Before(std::string_view str) const noexcept
+      -> std::string_view {
+    return str.substr(0, offset);
+  }
+
+  /// The chars of \a str following the ones matched
+  constexpr auto After(std::string_view str) const noexcept
+      -> std::string_view {
+    return str.substr(End());
+  }
+
+  friend constexpr auto operator==(const MatchSpan&,
+                                   const MatchSpan&) noexcept -> bool = default;
+};
+
+/**
+ *  \brief Same as IsMatching(), also reporting WHAT matched inside \a str,
+ *         such that the caller doesn't need to look for it again
+ *
+ *  Matchers may define a '.Match(std::string_view) ->
+ *  std::optional<MatchSpan>' member (all lookup matchers do, reporting the
+ *  pattern found). Any other matcher reports the whole string.
+ *
+ *  Example:
+ *  \code
+ *  if (const auto span = Match(Contains(": "), line)) {
+ *    Header(span->Before(line), span->After(line));
+ *  }
+ *  \endcode
+ *
+ *  \param m The matcher
+ *  \param str The string to test
+ *
+ *  \return std::optional<MatchSpan> The part of \a str matched, nullopt when
+ *          the matcher doesn't match
+ */
+template <typename Matcher>
+constexpr auto Match(Matcher&& m, std::string_view str)
+    -> std::optional<MatchSpan> {
+  if constexpr (MatcherTraits<Matcher>::has_Match) {
+    return m.Match(str);
+  } else if (IsMatching(std::forward<Matcher>(m), str)) {
+    return MatchSpan{0, str.size()};
+  } else {
+    return std::nullopt;
+  }
+}
+
+/**
+ *  \brief Streaming version of a matcher, fed chunk by chunk (see Stream.hpp)
+ */
+template <typename Matcher>
+class StreamMatcher;
+
 // Simple ///////////////////////////////////////////////////////////////////
 
 /**
@@ -124,301 +471,1947 @@ constexpr auto NeverMatches() {
 }
 
 /**
- *  \brief Create a matcher that always matches to everything
+ *  \brief Create a matcher that always matches to everything
+ */
+constexpr auto AlwaysMatches() {
+  return [](std::string_view) noexcept -> bool { return true; };
+}
+
+/**
+ *  \brief Matcher checking if a string equals a given string
+ */
+class EqualsMatcher {
+ public:
+  /// Matching only reads the pattern
+  static constexpr bool is_thread_shareable = true;
+
+  /// Cost of matching a string (see MatchCost)
+  static constexpr std::size_t match_cost = details::kCostCompare;
+
+  /**
+   *  \brief Construct the matcher
+   *
+   *  \param[in] match The string we are expecting the match against
+   */
+  constexpr explicit EqualsMatcher(std::string_view match) noexcept
+      : m_match(match) {}
+
+  /// The string we are expecting the match against
+  constexpr auto Pattern() const noexcept -> std::string_view {
+    return m_match;
+  }
+
+  /// Lengths of the strings matched
+  constexpr auto Lengths() const noexcept -> details::LengthRange {
+    return {m_match.size(), m_match.size()};
+  }
+
+  constexpr auto IsMatching(std::string_view str) const noexcept -> bool {
+    return str == m_match;
+  }
+
+  constexpr auto operator()(std::string_view str) const noexcept -> bool {
+    return IsMatching(str);
+  }
+
+  /**
+   *  \brief Batch version of IsMatching(), out[i] = IsMatching(strs[i])
+   *
+   *  \pre out.size() >= strs.size()
+   */
+  template <typename Out>
+  void IsMatching(std::span<const std::string_view> strs,
+                  std::span<Out> out) const noexcept {
+    const details::PatternBytes pattern(m_match);
+    for (std::size_t i = 0; i < strs.size(); ++i) {
+      out[i] = (strs[i].size() == pattern.Size()) and
+               pattern.IsAt(strs[i].data());
+    }
+  }
+
+ private:
+  std::string_view m_match;
+};
+
+/**
+ *  \brief Matcher checking if a string STARTS with a given prefix
+ */
+class StartsWithMatcher {
+ public:
+  /// Matching only reads the pattern
+  static constexpr bool is_thread_shareable = true;
+
+  /// Cost of matching a string (see MatchCost)
+  static constexpr std::size_t match_cost = details::kCostCompare;
+
+  /**
+   *  \brief Construct the matcher
+   *
+   *  \param[in] prefix The prefix we are looking for
+   */
+  constexpr explicit StartsWithMatcher(std::string_view prefix) noexcept
+      : m_prefix(prefix) {}
+
+  /// The prefix we are looking for
+  constexpr auto Pattern() const noexcept -> std::string_view {
+    return m_prefix;
+  }
+
+  /// Lengths of the strings matched
+  constexpr auto Lengths() const noexcept -> details::LengthRange {
+    return {m_prefix.size(), std::string_view::npos};
+  }
+
+  constexpr auto IsMatching(std::string_view str) const noexcept -> bool {
+    if (m_prefix.size() > str.size()) {
+      return false;
+    } else {
+      return str.substr(0, m_prefix.size()) == m_prefix;
+    }
+  }
+
+  constexpr auto operator()(std::string_view str) const noexcept -> bool {
+    return IsMatching(str);
+  }
+
+  /// Same as IsMatching(), reporting the prefix (see swstr::Match())
+  constexpr auto Match(std::string_view str) const noexcept
+      -> std::optional<MatchSpan> {
+    if (not IsMatching(str)) return std::nullopt;
+    return MatchSpan{0, m_prefix.size()};
+  }
+
+  /**
+   *  \brief Batch version of IsMatching(), out[i] = IsMatching(strs[i])
+   *
+   *  \pre out.size() >= strs.size()
+   */
+  template <typename Out>
+  void IsMatching(std::span<const std::string_view> strs,
+                  std::span<Out> out) const noexcept {
+    const details::PatternBytes pattern(m_prefix);
+    for (std::size_t i = 0; i < strs.size(); ++i) {
+      details::PrefetchAhead(strs, i);
+      out[i] = (strs[i].size() >= pattern.Size()) and
+               pattern.IsAt(strs[i].data());
+    }
+  }
+
+ private:
+  std::string_view m_prefix;
+};
+
+/**
+ *  \brief Matcher checking if a string ENDS with a given suffix
+ */
+class EndsWithMatcher {
+ public:
+  /// Matching only reads the pattern
+  static constexpr bool is_thread_shareable = true;
+
+  /// Cost of matching a string (see MatchCost)
+  static constexpr std::size_t match_cost = details::kCostCompare;
+
+  /**
+   *  \brief Construct the matcher
+   *
+   *  \param[in] suffix The suffix we are looking for
+   */
+  constexpr explicit EndsWithMatcher(std::string_view suffix) noexcept
+      : m_suffix(suffix) {}
+
+  /// The suffix we are looking for
+  constexpr auto Pattern() const noexcept -> std::string_view {
+    return m_suffix;
+  }
+
+  /// Lengths of the strings matched
+  constexpr auto Lengths() const noexcept -> details::LengthRange {
+    return {m_suffix.size(), std::string_view::npos};
+  }
+
+  constexpr auto IsMatching(std::string_view str) const noexcept -> bool {
+    if (m_suffix.size() > str.size()) {
+      return false;
+    } else {
+      return str.substr(str.size() - m_suffix.size(), m_suffix.size()) ==
+             m_suffix;
+    }
+  }
+
+  constexpr auto operator()(std::string_view str) const noexcept -> bool {
+    return IsMatching(str);
+  }
+
+  /// Same as IsMatching(), reporting the suffix (see swstr::Match())
+  constexpr auto Match(std::string_view str) const noexcept
+      -> std::optional<MatchSpan> {
+    if (not IsMatching(str)) return std::nullopt;
+    return MatchSpan{str.size() - m_suffix.size(), m_suffix.size()};
+  }
+
+  /**
+   *  \brief Batch version of IsMatching(), out[i] = IsMatching(strs[i])
+   *
+   *  \pre out.size() >= strs.size()
+   */
+  template <typename Out>
+  void IsMatching(std::span<const std::string_view> strs,
+                  std::span<Out> out) const noexcept {
+    const details::PatternBytes pattern(m_suffix);
+    for (std::size_t i = 0; i < strs.size(); ++i) {
+      details::PrefetchAhead(strs, i);
+      out[i] = (strs[i].size() >= pattern.Size()) and
+               pattern.IsAt(strs[i].data() + strs[i].size() - pattern.Size());
+    }
+  }
+
+ private:
+  std::string_view m_suffix;
+};
+
+/**
+ *  \brief Create a matcher use to check if a string equals \a match
+ *
+ *  \param[in] match The string we are expecting the match against
+ */
+constexpr auto Equals(std::string_view match) {
+  return EqualsMatcher(match);
+}
+
+/**
+ *  \brief Create a matcher use to check if a string STARTS with \a prefix
+ *
+ *  \param[in] prefix The prefix we are looking for
+ */
+constexpr auto StartsWith(std::string_view prefix) {
+  return StartsWithMatcher(prefix);
+}
+
+/**
+ *  \brief Create a matcher use to check if a string ENDS with \a suffix
+ *
+ *  \param[in] suffix The suffix we are looking for
+ */
+constexpr auto EndsWith(std::string_view suffix) {
+  return EndsWithMatcher(suffix);
+}
+
+// Compile time literals ////////////////////////////////////////////////////
+
+/**
+ *  \brief Same as EqualsMatcher, the string being a compile time \a Literal
+ *
+ *  \note The literal length is a constant, and its bytes are compared as a
+ *        few constant words (see details/FixedBytes.hpp)
+ */
+template <FixedString Literal>
+class FixedEqualsMatcher {
+ public:
+  /// Matching only reads the pattern
+  static constexpr bool is_thread_shareable = true;
+
+  /// Cost of matching a string (see MatchCost)
+  static constexpr std::size_t match_cost = details::kCostCompare;
+
+  /// The string we are expecting the match against
+  static constexpr auto Pattern() noexcept -> std::string_view {
+    return Literal.view();
+  }
+
+  /// Lengths of the strings matched
+  static constexpr auto Lengths() noexcept -> details::LengthRange {
+    return {Literal.size(), Literal.size()};
+  }
+
+  constexpr auto IsMatching(std::string_view str) const noexcept -> bool {
+    return (str.size() == Literal.size()) and kBytes.IsAt(str.data());
+  }
+
+  constexpr auto operator()(std::string_view str) const noexcept -> bool {
+    return IsMatching(str);
+  }
+
+ private:
+  static constexpr details::FixedBytes<Literal.size()> kBytes{Literal.data};
+};
+
+/**
+ *  \brief Same as StartsWithMatcher, the prefix being a compile time
+ *         \a Literal (see FixedEqualsMatcher)
+ */
+template <FixedString Literal>
+class FixedStartsWithMatcher {
+ public:
+  /// Matching only reads the pattern
+  static constexpr bool is_thread_shareable = true;
+
+  /// Cost of matching a string (see MatchCost)
+  static constexpr std::size_t match_cost = details::kCostCompare;
+
+  /// The prefix we are looking for
+  static constexpr auto Pattern() noexcept -> std::string_view {
+    return Literal.view();
+  }
+
+  /// Lengths of the strings matched
+  static constexpr auto Lengths() noexcept -> details::LengthRange {
+    return {Literal.size(), std::string_view::npos};
+  }
+
+  constexpr auto IsMatching(std::string_view str) const noexcept -> bool {
+    return (str.size() >= Literal.size()) and kBytes.IsAt(str.data());
+  }
+
+  constexpr auto operator()(std::string_view str) const noexcept -> bool {
+    return IsMatching(str);
+  }
+
+  /// Same as IsMatching(), reporting the prefix (see swstr::Match())
+  constexpr auto Match(std::string_view str) const noexcept
+      -> std::optional<MatchSpan> {
+    if (not IsMatching(str)) return std::nullopt;
+    return MatchSpan{0, Literal.size()};
+  }
+
+ private:
+  static constexpr details::FixedBytes<Literal.size()> kBytes{Literal.data};
+};
+
+/**
+ *  \brief Same as EndsWithMatcher, the suffix being a compile time
+ *         \a Literal (see FixedEqualsMatcher)
+ */
+template <FixedString Literal>
+class FixedEndsWithMatcher {
+ public:
+  /// Matching only reads the pattern
+  static constexpr bool is_thread_shareable = true;
+
+  /// Cost of matching a string (see MatchCost)
+  static constexpr std::size_t match_cost = details::kCostCompare;
+
+  /// The suffix we are looking for
+  static constexpr auto Pattern() noexcept -> std::string_view {
+    return Literal.view();
+  }
+
+  /// Lengths of the strings matched
+  static constexpr auto Lengths() noexcept -> details::LengthRange {
+    return {Literal.size(), std::string_view::npos};
+  }
+
+  constexpr auto IsMatching(std::string_view str) const noexcept -> bool {
+    return (str.size() >= Literal.size()) and
+           kBytes.IsAt(str.data() + str.size() - Literal.size());
+  }
+
+  constexpr auto operator()(std::string_view str) const noexcept -> bool {
+    return IsMatching(str);
+  }
+
+  /// Same as IsMatching(), reporting the suffix (see swstr::Match())
+  constexpr auto Match(std::string_view str) const noexcept
+      -> std::optional<MatchSpan> {
+    if (not IsMatching(str)) return std::nullopt;
+    return MatchSpan{str.size() - Literal.size(), Literal.size()};
+  }
+
+ private:
+  static constexpr details::FixedBytes<Literal.size()> kBytes{Literal.data};
+};
+
+/**
+ *  \brief Create a matcher use to check if a string equals the compile time
+ *         \a Literal
+ *
+ *  Example:
+ *  \code
+ *  SwitchStr<int>(header).Case(Equals<"Content-Length">(), 0).Default(-1);
+ *  \endcode
+ */
+template <FixedString Literal>
+constexpr auto Equals() noexcept {
+  return FixedEqualsMatcher<Literal>{};
+}
+
+/**
+ *  \brief Create a matcher use to check if a string STARTS with the compile
+ *         time \a Literal
+ */
+template <FixedString Literal>
+constexpr auto StartsWith() noexcept {
+  return FixedStartsWithMatcher<Literal>{};
+}
+
+/**
+ *  \brief Create a matcher use to check if a string ENDS with the compile
+ *         time \a Literal
+ */
+template <FixedString Literal>
+constexpr auto EndsWith() noexcept {
+  return FixedEndsWithMatcher<Literal>{};
+}
+
+namespace details {
+
+/// True for the matchers checking that the string equals a pattern
+template <typename T>
+struct IsEqualsMatcher : std::is_same<T, EqualsMatcher> {};
+
+template <FixedString Literal>
+struct IsEqualsMatcher<FixedEqualsMatcher<Literal>> : std::true_type {};
+
+template <typename T>
+constexpr bool IsEqualsMatcher_v = IsEqualsMatcher<T>::value;
+
+/// True for the matchers checking that the string starts with a pattern
+template <typename T>
+struct IsStartsWithMatcher : std::is_same<T, StartsWithMatcher> {};
+
+template <FixedString Literal>
+struct IsStartsWithMatcher<FixedStartsWithMatcher<Literal>> : std::true_type {
+};
+
+template <typename T>
+constexpr bool IsStartsWithMatcher_v = IsStartsWithMatcher<T>::value;
+
+/// True for the matchers checking that the string ends with a pattern
+template <typename T>
+struct IsEndsWithMatcher : std::is_same<T, EndsWithMatcher> {};
+
+template <FixedString Literal>
+struct IsEndsWithMatcher<FixedEndsWithMatcher<Literal>> : std::true_type {};
+
+template <typename T>
+constexpr bool IsEndsWithMatcher_v = IsEndsWithMatcher<T>::value;
+
+}  // namespace details
+
+// Lookup ///////////////////////////////////////////////////////////////////
+
+namespace details {
+
+/**
+ *  \brief Output of a lookup matcher (i.e. the position found), written
+ *         through a pointer when not null
+ *
+ *  \note When disabled, the output holds nothing and writes nothing: the
+ *        matcher doesn't modify anything when matching, making it thread
+ *        shareable
+ */
+template <bool Enabled>
+class MatchOutput {
+ public:
+  constexpr MatchOutput(std::size_t* const ptr) noexcept : m_ptr(ptr) {}
+
+  constexpr void Set(std::size_t value) const noexcept {
+    if (m_ptr != nullptr) *m_ptr = value;
+  }
+
+ private:
+  std::size_t* m_ptr;
+};
+
+template <>
+class MatchOutput<false> {
+ public:
+  constexpr MatchOutput(std::nullptr_t) noexcept {}
+
+  constexpr void Set(std::size_t) const noexcept {}
+};
+
+/// Type of the output pointer given to the matchers constructor
+template <bool Enabled>
+using MatchOutputPtr =
+    std::conditional_t<Enabled, std::size_t*, std::nullptr_t>;
+
+}  // namespace details
+
+/**
+ *  \brief Matcher looking for a char/string pattern inside the string
+ *
+ *  \note The lookup uses the SIMD first/last byte filter kernels (see
+ *        details/Find.hpp) when available, such that long strings are
+ *        scanned 16/32 positions at a time
+ *
+ *  \tparam Reverse When true, look for the LAST occurrence instead of the
+ *                  FIRST one
+ *  \tparam WithWhere When true, the position found is written to a 'where'
+ *                    pointer (the matcher is then NOT thread shareable)
+ */
+template <bool Reverse, bool WithWhere>
+class ContainsMatcher {
+ public:
+  /// Matching writes to 'where', when any
+  static constexpr bool is_thread_shareable = not WithWhere;
+
+  /// Cost of matching a string (see MatchCost)
+  static constexpr std::size_t match_cost = details::kCostScan;
+
+  /**
+   *  \brief Construct the matcher
+   *
+   *  \param[in] pattern The char/string pattern we wish to look for
+   *  \param[inout] where Set to the index of the start of the pattern found
+   */
+  constexpr ContainsMatcher(std::variant<std::string_view, char> pattern,
+                            details::MatchOutputPtr<WithWhere> where) noexcept
+      : m_pattern(pattern), m_where(where) {}
+
+  /// Lengths of the strings matched
+  constexpr auto Lengths() const noexcept -> details::LengthRange {
+    return {Needle().size(), std::string_view::npos};
+  }
+
+  constexpr auto IsMatching(std::string_view str) const noexcept -> bool {
+    return Match(str).has_value();
+  }
+
+  constexpr auto operator()(std::string_view str) const noexcept -> bool {
+    return IsMatching(str);
+  }
+
+  /// Same as IsMatching(), reporting the pattern found (see swstr::Match())
+  constexpr auto Match(std::string_view str) const noexcept
+      -> std::optional<MatchSpan> {
+    const std::size_t pos =
+        Reverse ? details::RFind(str, Needle()) : details::Find(str, Needle());
+    if (pos == std::string_view::npos) return std::nullopt;
+
+    m_where.Set(pos);
+    return MatchSpan{pos, Needle().size()};
+  }
+
+  /**
+   *  \brief Batch version of IsMatching(), out[i] = IsMatching(strs[i])
+   *
+   *  \pre out.size() >= strs.size()
+   */
+  template <typename Out>
+  void IsMatching(std::span<const std::string_view> strs,
+                  std::span<Out> out) const noexcept {
+    static_assert(not WithWhere,
+                  "A single 'where' can't hold the position found in each "
+                  "string: use the batch Match() instead");
+    details::FindEach<Reverse>(strs, Needle(),
+                               [&](std::size_t i, std::size_t pos) {
+                                 out[i] = (pos != std::string_view::npos);
+                               });
+  }
+
+  /**
+   *  \brief Batch version of Match(), out[i] = Match(strs[i])
+   *
+   *  \note 'where' is never written: each pattern found is in out
+   *
+   *  \pre out.size() >= strs.size()
+   */
+  void Match(std::span<const std::string_view> strs,
+             std::span<std::optional<MatchSpan>> out) const noexcept {
+    details::FindEach<Reverse>(strs, Needle(),
+                               [&](std::size_t i, std::size_t pos) {
+                                 if (pos == std::string_view::npos) {
+                                   out[i] = std::nullopt;
+                                 } else {
+                                   out[i] = MatchSpan{pos, Needle().size()};
+                                 }
+                               });
+  }
+
+ private:
+  /// The pattern, as a string
+  constexpr auto Needle() const noexcept -> std::string_view {
+    return std::holds_alternative<char>(m_pattern)
+               ? std::string_view(&std::get<char>(m_pattern), 1)
+               : std::get<std::string_view>(m_pattern);
+  }
+
+  std::variant<std::string_view, char> m_pattern;
+  [[no_unique_address]] details::MatchOutput<WithWhere> m_where;
+
+  template <typename>
+  friend class StreamMatcher;
+};
+
+/**
+ *  \brief Matches when the given \a pattern appears inside the string
+ *
+ *  \param[in] pattern The char/string pattern we wish to look for
+ */
+constexpr auto Contains(std::variant<std::string_view, char> pattern) noexcept {
+  return ContainsMatcher<false, false>(pattern, nullptr);
+}
+
+/**
+ *  \brief Matches when the given \a pattern appears inside the string
+ *
+ *  \param[in] pattern The char/string pattern we wish to look for
+ *  \param[inout] where Set to the index of the start of the FIRST pattern found
+ */
+constexpr auto Contains(std::variant<std::string_view, char> pattern,
+                        std::size_t* const where) noexcept {
+  return ContainsMatcher<false, true>(pattern, where);
+}
+
+/**
+ *  \brief Matches when the given \a pattern appears inside the string
+ *
+ *  \note Perform reverse lookup
+ *
+ *  \param[in] pattern The char/string pattern we wish to look for
+ */
+constexpr auto ContainsR(
+    std::variant<std::string_view, char> pattern) noexcept {
+  return ContainsMatcher<true, false>(pattern, nullptr);
+}
+
+/**
+ *  \brief Matches when the given \a pattern appears inside the string
+ *
+ *  \note Perform reverse lookup
+ *
+ *  \param[in] pattern The char/string pattern we wish to look for
+ *  \param[inout] where Set to the index of the start of the LAST pattern found
+ */
+constexpr auto ContainsR(std::variant<std::string_view, char> pattern,
+                         std::size_t* const where) noexcept {
+  return ContainsMatcher<true, true>(pattern, where);
+}
+
+/**
+ *  \brief Matcher looking for ONE OF the chars of a pattern inside the string
+ *
+ *  \note The chars are stored into a ByteSet at construction, such that the
+ *        lookup doesn't depend on the number of chars in the pattern, and
+ *        scans 16/32 bytes at a time when SIMD is available
+ *
+ *  \tparam Reverse When true, look for the LAST char found instead of the
+ *                  FIRST one
+ *  \tparam WithWhere When true, the position found is written to a 'where'
+ *                    pointer (the matcher is then NOT thread shareable)
+ */
+template <bool Reverse, bool WithWhere>
+class ContainsOneOfMatcher {
+ public:
+  /// Matching writes to 'where', when any
+  static constexpr bool is_thread_shareable = not WithWhere;
+
+  /// Cost of matching a string (see MatchCost)
+  static constexpr std::size_t match_cost = details::kCostScan;
+
+  /**
+   *  \brief Construct the matcher
+   *
+   *  \param[in] pattern The char/string pattern we wish to look for
+   *  \param[inout] where Set to the index of the char found
+   */
+  constexpr ContainsOneOfMatcher(
+      std::variant<std::string_view, char> pattern,
+      details::MatchOutputPtr<WithWhere> where) noexcept
+      : m_where(where) {
+    if (std::holds_alternative<char>(pattern)) {
+      m_set.Insert(std::get<char>(pattern));
+    } else {
+      m_set = details::ByteSet(std::get<std::string_view>(pattern));
+    }
+  }
+
+  /**
+   *  \brief Construct the matcher from the set of chars we wish to look for
+   *
+   *  \param[in] set The chars we wish to look for
+   *  \param[inout] where Set to the index of the char found
+   */
+  constexpr ContainsOneOfMatcher(
+      const details::ByteSet& set,
+      details::MatchOutputPtr<WithWhere> where) noexcept
+      : m_set(set), m_where(where) {}
+
+  /// Lengths of the strings matched
+  constexpr auto Lengths() const noexcept -> details::LengthRange {
+    return {1, std::string_view::npos};
+  }
+
+  constexpr auto IsMatching(std::string_view str) const noexcept -> bool {
+    return Match(str).has_value();
+  }
+
+  constexpr auto operator()(std::string_view str) const noexcept -> bool {
+    return IsMatching(str);
+  }
+
+  /// Same as IsMatching(), reporting the char found (see swstr::Match())
+  constexpr auto Match(std::string_view str) const noexcept
+      -> std::optional<MatchSpan> {
+    const std::size_t pos =
+        Reverse ? m_set.FindLast(str) : m_set.FindFirst(str);
+    if (pos == std::string_view::npos) return std::nullopt;
+
+    m_where.Set(pos);
+    return MatchSpan{pos, 1};
+  }
+
+ private:
+  details::ByteSet m_set;
+  [[no_unique_address]] details::MatchOutput<WithWhere> m_where;
+
+  template <typename>
+  friend class StreamMatcher;
+};
+
+/**
+ *  \brief Matches when ONE OF the character in \a pattern is found inside str
+ *
+ *  \param[in] pattern The char/string pattern we wish to look for
+ */
+constexpr auto ContainsOneOf(
+    std::variant<std::string_view, char> pattern) noexcept {
+  return ContainsOneOfMatcher<false, false>(pattern, nullptr);
+}
+
+/**
+ *  \brief Matches when ONE OF the character in \a pattern is found inside str
+ *
+ *  \param[in] pattern The char/string pattern we wish to look for
+ *  \param[inout] where Set to the index of the FIRST char found
+ */
+constexpr auto ContainsOneOf(std::variant<std::string_view, char> pattern,
+                             std::size_t* const where) noexcept {
+  return ContainsOneOfMatcher<false, true>(pattern, where);
+}
+
+/**
+ *  \brief Matches when ONE OF the character in \a pattern is found inside str
+ *
+ *  \note Perform reverse lookup
+ *
+ *  \param[in] pattern The char/string pattern we wish to look for
+ */
+constexpr auto ContainsOneOfR(
+    std::variant<std::string_view, char> pattern) noexcept {
+  return ContainsOneOfMatcher<true, false>(pattern, nullptr);
+}
+
+/**
+ *  \brief Matches when ONE OF the character in \a pattern is found inside str
+ *
+ *  \note Perform reverse lookup
+ *
+ *  \param[in] pattern The char/string pattern we wish to look for
+ *  \param[inout] where Set to the index of the LAST char found
+ */
+constexpr auto ContainsOneOfR(std::variant<std::string_view, char> pattern,
+                              std::size_t* const where) noexcept {
+  return ContainsOneOfMatcher<true, true>(pattern, where);
+}
+
+/**
+ *  \brief Matcher looking for many needles at once, scanning the string ONCE
+ *
+ *  \note The underlying automaton is shared (immutable) between copies, such
+ *        that copying the matcher is cheap
+ *
+ *  \tparam WithOutputs When true, the needle found is written to the 'where'
+ *                      and 'which' pointers (the matcher is then NOT thread
+ *                      shareable)
+ */
+template <bool WithOutputs>
+class ContainsAnyOfMatcher {
+ public:
+  /// Matching writes to 'where'/'which', when any
+  static constexpr bool is_thread_shareable = not WithOutputs;
+
+  /// Cost of matching a string (see MatchCost)
+  static constexpr std::size_t match_cost = details::kCostAutomaton;
+
+  /**
+   *  \brief Construct the matcher, building the automaton over \a needles
+   *
+   *  \param[in] needles All string patterns we wish to look for
+   *  \param[inout] where Set to the index of the start of the needle found
+   *  \param[inout] which Set to the index of the needle found (inside
+   *                      \a needles)
+   */
+  template <typename Needles>
+  ContainsAnyOfMatcher(const Needles& needles,
+                       details::MatchOutputPtr<WithOutputs> where,
+                       details::MatchOutputPtr<WithOutputs> which)
+      : m_automaton(std::make_shared<const details::AhoCorasick>(needles)),
+        m_where(where),
+        m_which(which) {}
+
+  inline auto IsMatching(std::string_view str) const noexcept -> bool {
+    return Match(str).has_value();
+  }
+
+  inline auto operator()(std::string_view str) const noexcept -> bool {
+    return IsMatching(str);
+  }
+
+  /// Same as IsMatching(), reporting the needle found (see swstr::Match())
+  inline auto Match(std::string_view str) const noexcept
+      -> std::optional<MatchSpan> {
+    const auto hit = m_automaton->Find(str);
+    if (hit.which == std::string_view::npos) return std::nullopt;
+
+    m_where.Set(hit.where);
+    m_which.Set(hit.which);
+    return MatchSpan{hit.where, m_automaton->Length(hit.which)};
+  }
+
+ private:
+  std::shared_ptr<const details::AhoCorasick> m_automaton;
+  [[no_unique_address]] details::MatchOutput<WithOutputs> m_where;
+  [[no_unique_address]] details::MatchOutput<WithOutputs> m_which;
+};
+
+/**
+ *  \brief Matches when ONE OF the \a needles appears inside the string
+ *
+ *  Equivalent to AnyOf(Contains(needles[0]), Contains(needles[1]), ...), but
+ *  using an Aho-Corasick automaton built once, such that the string is
+ *  scanned a single time whatever the number of needles.
+ *
+ *  \note The occurrence reported is the one ENDING first in the string. When
+ *        many needles end at the same position, the first declared wins.
+ *
+ *  \param[in] needles All string patterns we wish to look for
+ */
+inline auto ContainsAnyOf(std::initializer_list<std::string_view> needles) {
+  return ContainsAnyOfMatcher<false>(needles, nullptr, nullptr);
+}
+
+/**
+ *  \brief Same as above, reporting the needle found
+ *
+ *  \param[in] needles All string patterns we wish to look for
+ *  \param[inout] where Set to the index of the start of the needle found
+ *  \param[inout] which Set to the index of the needle found
+ */
+inline auto ContainsAnyOf(std::initializer_list<std::string_view> needles,
+                          std::size_t* const where,
+                          std::size_t* const which = nullptr) {
+  return ContainsAnyOfMatcher<true>(needles, where, which);
+}
+
+/**
+ *  \brief Matches when ONE OF the \a needles appears inside the string
+ *
+ *  \note Same as above, using any range of string like \a needles (i.e.
+ *        std::vector<std::string> loaded at runtime)
+ *
+ *  \param[in] needles All string patterns we wish to look for
+ */
+template <typename Needles>
+inline auto ContainsAnyOf(const Needles& needles) {
+  return ContainsAnyOfMatcher<false>(needles, nullptr, nullptr);
+}
+
+/**
+ *  \brief Same as above, reporting the needle found
+ *
+ *  \param[in] needles All string patterns we wish to look for
+ *  \param[inout] where Set to the index of the start of the needle found
+ *  \param[inout] which Set to the index of the needle found
+ */
+template <typename Needles>
+inline auto ContainsAnyOf(const Needles& needles, std::size_t* const where,
+                          std::size_t* const which = nullptr) {
+  return ContainsAnyOfMatcher<true>(needles, where, which);
+}
+
+// Case insensitive /////////////////////////////////////////////////////////
+
+/**
+ *  \brief Matcher checking if a string equals a given string, ignoring the
+ *         ASCII case
+ *
+ *  \note The pattern is only viewed (never copied): both the pattern and the
+ *        string are folded on the fly, 16/32 bytes at a time (see
+ *        details/Ascii.hpp), without any allocation whatever their size
+ */
+class IEqualsMatcher {
+ public:
+  /// Matching only reads the pattern
+  static constexpr bool is_thread_shareable = true;
+
+  /// Cost of matching a string (see MatchCost)
+  static constexpr std::size_t match_cost = details::kCostFoldedCompare;
+
+  /**
+   *  \brief Construct the matcher
+   *
+   *  \param[in] match The string we are expecting the match against
+   */
+  constexpr explicit IEqualsMatcher(std::string_view match) noexcept
+      : m_match(match) {}
+
+  /// The string we are expecting the match against
+  constexpr auto Pattern() const noexcept -> std::string_view {
+    return m_match;
+  }
+
+  /// Lengths of the strings matched
+  constexpr auto Lengths() const noexcept -> details::LengthRange {
+    return {m_match.size(), m_match.size()};
+  }
+
+  constexpr auto IsMatching(std::string_view str) const noexcept -> bool {
+    return details::IEqualsAscii(str, m_match);
+  }
+
+  constexpr auto operator()(std::string_view str) const noexcept -> bool {
+    return IsMatching(str);
+  }
+
+ private:
+  std::string_view m_match;
+};
+
+/**
+ *  \brief Matcher checking if a string STARTS with a given prefix, ignoring
+ *         the ASCII case
+ *
+ *  \note The prefix is only viewed, never copied (see IEqualsMatcher)
+ */
+class IStartsWithMatcher {
+ public:
+  /// Matching only reads the pattern
+  static constexpr bool is_thread_shareable = true;
+
+  /// Cost of matching a string (see MatchCost)
+  static constexpr std::size_t match_cost = details::kCostFoldedCompare;
+
+  /**
+   *  \brief Construct the matcher
+   *
+   *  \param[in] prefix The prefix we are looking for
+   */
+  constexpr explicit IStartsWithMatcher(std::string_view prefix) noexcept
+      : m_prefix(prefix) {}
+
+  /// The prefix we are looking for
+  constexpr auto Pattern() const noexcept -> std::string_view {
+    return m_prefix;
+  }
+
+  /// Lengths of the strings matched
+  constexpr auto Lengths() const noexcept -> details::LengthRange {
+    return {m_prefix.size(), std::string_view::npos};
+  }
+
+  constexpr auto IsMatching(std::string_view str) const noexcept -> bool {
+    return (str.size() >= m_prefix.size()) and
+           details::IEqualBytes(str.data(), m_prefix.data(), m_prefix.size());
+  }
+
+  constexpr auto operator()(std::string_view str) const noexcept -> bool {
+    return IsMatching(str);
+  }
+
+  /// Same as IsMatching(), reporting the prefix (see swstr::Match())
+  auto Match(std::string_view str) const noexcept -> std::optional<MatchSpan> {
+    if (not IsMatching(str)) return std::nullopt;
+    return MatchSpan{0, m_prefix.size()};
+  }
+
+ private:
+  std::string_view m_prefix;
+};
+
+/**
+ *  \brief Matcher checking if a string ENDS with a given suffix, ignoring the
+ *         ASCII case
+ *
+ *  \note The suffix is only viewed, never copied (see IEqualsMatcher)
+ */
+class IEndsWithMatcher {
+ public:
+  /// Matching only reads the pattern
+  static constexpr bool is_thread_shareable = true;
+
+  /// Cost of matching a string (see MatchCost)
+  static constexpr std::size_t match_cost = details::kCostFoldedCompare;
+
+  /**
+   *  \brief Construct the matcher
+   *
+   *  \param[in] suffix The suffix we are looking for
+   */
+  constexpr explicit IEndsWithMatcher(std::string_view suffix) noexcept
+      : m_suffix(suffix) {}
+
+  /// The suffix we are looking for
+  constexpr auto Pattern() const noexcept -> std::string_view {
+    return m_suffix;
+  }
+
+  /// Lengths of the strings matched
+  constexpr auto Lengths() const noexcept -> details::LengthRange {
+    return {m_suffix.size(), std::string_view::npos};
+  }
+
+  constexpr auto IsMatching(std::string_view str) const noexcept -> bool {
+    return (str.size() >= m_suffix.size()) and
+           details::IEqualBytes(str.data() + str.size() - m_suffix.size(),
+                                m_suffix.data(), m_suffix.size());
+  }
+
+  constexpr auto operator()(std::string_view str) const noexcept -> bool {
+    return IsMatching(str);
+  }
+
+  /// Same as IsMatching(), reporting the suffix (see swstr::Match())
+  auto Match(std::string_view str) const noexcept -> std::optional<MatchSpan> {
+    if (not IsMatching(str)) return std::nullopt;
+    return MatchSpan{str.size() - m_suffix.size(), m_suffix.size()};
+  }
+
+ private:
+  std::string_view m_suffix;
+};
+
+/**
+ *  \brief Matcher looking for a string pattern inside the string, ignoring
+ *         the ASCII case
+ *
+ *  \note The lookup uses the same first/last byte filter as ContainsMatcher,
+ *        comparing each candidate against both cases of the pattern
+ *        first/last chars (see details/Ascii.hpp)
+ *
+ *  \tparam WithWhere When true, the position found is written to a 'where'
+ *                    pointer (the matcher is then NOT thread shareable)
+ */
+template <bool WithWhere>
+class IContainsMatcher {
+ public:
+  /// Matching writes to 'where', when any
+  static constexpr bool is_thread_shareable = not WithWhere;
+
+  /// Cost of matching a string (see MatchCost)
+  static constexpr std::size_t match_cost = details::kCostScan;
+
+  /**
+   *  \brief Construct the matcher
+   *
+   *  \param[in] pattern The string pattern we wish to look for
+   *  \param[inout] where Set to the index of the start of the pattern found
+   */
+  constexpr IContainsMatcher(std::string_view pattern,
+                             details::MatchOutputPtr<WithWhere> where) noexcept
+      : m_pattern(pattern), m_where(where) {}
+
+  /// The pattern we are looking for
+  constexpr auto Pattern() const noexcept -> std::string_view {
+    return m_pattern;
+  }
+
+  /// Lengths of the strings matched
+  constexpr auto Lengths() const noexcept -> details::LengthRange {
+    return {m_pattern.size(), std::string_view::npos};
+  }
+
+  constexpr auto IsMatching(std::string_view str) const noexcept -> bool {
+    return Match(str).has_value();
+  }
+
+  constexpr auto operator()(std::string_view str) const noexcept -> bool {
+    return IsMatching(str);
+  }
+
+  /// Same as IsMatching(), reporting the pattern found (see swstr::Match())
+  constexpr auto Match(std::string_view str) const noexcept
+      -> std::optional<MatchSpan> {
+    const std::size_t pos = details::IFind(str, m_pattern);
+    if (pos == std::string_view::npos) return std::nullopt;
+
+    m_where.Set(pos);
+    return MatchSpan{pos, m_pattern.size()};
+  }
+
+ private:
+  std::string_view m_pattern;
+  [[no_unique_address]] details::MatchOutput<WithWhere> m_where;
+};
+
+/**
+ *  \brief Create a matcher use to check if a string equals \a match,
+ *         ignoring the ASCII case
+ *
+ *  \param[in] match The string we are expecting the match against
+ */
+constexpr auto IEquals(std::string_view match) noexcept {
+  return IEqualsMatcher(match);
+}
+
+/**
+ *  \brief Create a matcher use to check if a string STARTS with \a prefix,
+ *         ignoring the ASCII case
+ *
+ *  \param[in] prefix The prefix we are looking for
  */
-constexpr auto AlwaysMatches() {
-  return [](std::string_view) noexcept -> bool { return true; };
+constexpr auto IStartsWith(std::string_view prefix) noexcept {
+  return IStartsWithMatcher(prefix);
 }
 
 /**
- *  \brief Create a matcher use to check if a string equals \a match
+ *  \brief Create a matcher use to check if a string ENDS with \a suffix,
+ *         ignoring the ASCII case
  *
- *  \param[in] match The string we are expecting the match against
+ *  \param[in] suffix The suffix we are looking for
  */
-constexpr auto Equals(std::string_view match) {
-  return
-      [match](std::string_view str) noexcept -> bool { return str == match; };
+constexpr auto IEndsWith(std::string_view suffix) noexcept {
+  return IEndsWithMatcher(suffix);
 }
 
 /**
- *  \brief Create a matcher use to check if a string STARTS with \a prefix
+ *  \brief Matches when \a pattern is found inside str, ignoring the ASCII
+ *         case
  *
- *  \param[in] prefix The prefix we are looking for
+ *  \param[in] pattern The string pattern we wish to look for
  */
-constexpr auto StartsWith(std::string_view prefix) {
-  return [prefix](std::string_view str) noexcept -> bool {
-    if (prefix.size() > str.size()) {
-      return false;
-    } else {
-      return str.substr(0, prefix.size()) == prefix;
-    }
-  };
+constexpr auto IContains(std::string_view pattern) noexcept {
+  return IContainsMatcher<false>(pattern, nullptr);
 }
 
 /**
- *  \brief Create a matcher use to check if a string ENDS with \a suffix
+ *  \brief Matches when \a pattern is found inside str, ignoring the ASCII
+ *         case
  *
- *  \param[in] suffix The suffix we are looking for
+ *  \param[in] pattern The string pattern we wish to look for
+ *  \param[inout] where Set to the index of the start of the FIRST pattern
+ *                      found
  */
-constexpr auto EndsWith(std::string_view suffix) {
-  return [suffix](std::string_view str) noexcept -> bool {
-    if (suffix.size() > str.size()) {
-      return false;
-    } else {
-      return str.substr(str.size() - suffix.size(), suffix.size()) == suffix;
-    }
-  };
+constexpr auto IContains(std::string_view pattern,
+                         std::size_t* const where) noexcept {
+  return IContainsMatcher<true>(pattern, where);
 }
 
-// Lookup ///////////////////////////////////////////////////////////////////
 namespace details {
 
-template <typename Lookup>
-constexpr auto DoLookup(Lookup&& do_lookup,
-                        std::variant<std::string_view, char> pattern,
-                        std::size_t* const where = nullptr) noexcept -> bool {
-  const std::size_t pos = std::visit(std::forward<Lookup>(do_lookup), pattern);
-  const bool found = (pos != std::string_view::npos);
-
-  if ((where != nullptr) and found) {
-    *where = pos;
+/// Set of the chars of \a pattern, in both lower and upper case
+constexpr auto FoldedByteSet(
+    std::variant<std::string_view, char> pattern) noexcept -> ByteSet {
+  if (std::holds_alternative<char>(pattern)) {
+    const char c = std::get<char>(pattern);
+    return FoldedByteSet(std::string_view(&c, 1));
+  } else {
+    return FoldedByteSet(std::get<std::string_view>(pattern));
   }
-
-  return found;
 }
 
 }  // namespace details
 
 /**
- *  \brief Matches when the given \a pattern appears inside the string
+ *  \brief Matches when ONE OF the character in \a pattern is found inside str,
+ *         ignoring the ASCII case
+ *
+ *  \note Both cases of each letter are inserted into the ByteSet, such that
+ *        the lookup costs exactly the same as ContainsOneOf()
  *
  *  \param[in] pattern The char/string pattern we wish to look for
- *  \param[inout] where Set to the index of the start of the FIRST pattern found
  */
-constexpr auto Contains(std::variant<std::string_view, char> pattern,
-                        std::size_t* const where = nullptr) noexcept {
-  return [pattern, where](std::string_view str) noexcept -> bool {
-    return details::DoLookup([str](const auto& p) { return str.find(p); },
-                             pattern, where);
-  };
+constexpr auto IContainsOneOf(
+    std::variant<std::string_view, char> pattern) noexcept {
+  return ContainsOneOfMatcher<false, false>(details::FoldedByteSet(pattern),
+                                            nullptr);
 }
 
 /**
- *  \brief Matches when the given \a pattern appears inside the string
- *
- *  \note Perform reverse lookup
+ *  \brief Matches when ONE OF the character in \a pattern is found inside str,
+ *         ignoring the ASCII case
  *
  *  \param[in] pattern The char/string pattern we wish to look for
- *  \param[inout] where Set to the index of the start of the LAST pattern found
+ *  \param[inout] where Set to the index of the FIRST char found
  */
-constexpr auto ContainsR(std::variant<std::string_view, char> pattern,
-                         std::size_t* const where = nullptr) noexcept {
-  return [pattern, where](std::string_view str) noexcept -> bool {
-    return details::DoLookup([str](const auto& p) { return str.rfind(p); },
-                             pattern, where);
-  };
+constexpr auto IContainsOneOf(std::variant<std::string_view, char> pattern,
+                              std::size_t* const where) noexcept {
+  return ContainsOneOfMatcher<false, true>(details::FoldedByteSet(pattern),
+                                           where);
 }
 
+// Meta matcher /////////////////////////////////////////////////////////////
+
+namespace details {
+
 /**
- *  \brief Matches when ONE OF the character in \a pattern is found inside str
+ *  \brief Order in which a meta matcher evaluates its \a Matchers: the
+ *         cheapest first (see MatchCost), keeping the order of declaration
+ *         for equal costs
  *
- *  \param[in] pattern The char/string pattern we wish to look for
- *  \param[inout] where Set to the index of the FIRST char found
+ *  \note A NON reorderable matcher (see IsReorderable) may have side effects
+ *        (i.e. writing to 'where', logging): no matcher is ever moved across
+ *        it, such that it's called exactly when it would have been in the
+ *        order of declaration
  */
-constexpr auto ContainsOneOf(std::variant<std::string_view, char> pattern,
-                             std::size_t* const where = nullptr) noexcept {
-  return [pattern, where](std::string_view str) noexcept -> bool {
-    return details::DoLookup(
-        [str](const auto& p) { return str.find_first_of(p); }, pattern, where);
+template <typename... Matchers>
+constexpr auto EvaluationOrder() noexcept
+    -> std::array<std::size_t, sizeof...(Matchers)> {
+  constexpr std::size_t kCount = sizeof...(Matchers);
+  constexpr std::array<std::size_t, kCount> costs = {MatchCost_v<Matchers>...};
+  constexpr std::array<bool, kCount> reorderable = {
+      IsReorderable_v<Matchers>...};
+
+  std::array<std::size_t, kCount> order = {};
+  for (std::size_t i = 0; i < kCount; ++i) {
+    order[i] = i;
+  }
+
+  // Stable insertion sort of each run of reorderable matchers
+  std::size_t run_begin = 0;
+  for (std::size_t i = 0; i < kCount; ++i) {
+    if (not reorderable[i]) {
+      run_begin = i + 1;
+      continue;
+    }
+    for (std::size_t j = i; (j > run_begin) and
+                            (costs[order[j]] < costs[order[j - 1]]);
+         --j) {
+      std::swap(order[j], order[j - 1]);
+    }
+  }
+
+  return order;
+}
+
+/**
+ *  \brief Length bounds checked by a meta matcher before evaluating any of
+ *         its matchers (nothing when disabled)
+ */
+template <bool Enabled>
+class LengthCheck {
+ public:
+  constexpr explicit LengthCheck(LengthRange range) noexcept
+      : m_range(range) {}
+
+  constexpr auto Accepts(std::size_t length) const noexcept -> bool {
+    return m_range.Contains(length);
+  }
+
+ private:
+  LengthRange m_range;
+};
+
+template <>
+class LengthCheck<false> {
+ public:
+  constexpr explicit LengthCheck(LengthRange) noexcept {}
+
+  constexpr auto Accepts(std::size_t) const noexcept -> bool { return true; }
+};
+
+/// True for the matchers compared with == against a pattern they don't own
+template <typename T>
+constexpr bool IsEqualsLike_v =
+    IsEqualsMatcher_v<T> or std::is_same_v<T, std::string_view> or
+    std::is_same_v<T, const char*> or std::is_same_v<T, char*>;
+
+/// Minimum number of Equals inside an AnyOf collapsed into an EqualsSet
+inline constexpr std::size_t kMinEqualsSetSize = 8;
+
+/**
+ *  \brief Set of the patterns of the Equals of an AnyOf, looked up with ONE
+ *         hash instead of N comparisons
+ *
+ *  \note Building the PerfectHash is far more expensive than a lookup: the
+ *        set is only built when the AnyOf is constant evaluated (i.e. a
+ *        static constexpr matcher), never when it's constructed at runtime
+ *        (i.e. inline in a SwitchStr, on every call)
+ *  \note The set is only used when its PerfectHash could be built (i.e. the
+ *        patterns are distinct), the Equals being evaluated one by one
+ *        otherwise
+ */
+template <std::size_t N>
+class EqualsSet {
+ public:
+  /// Disabled set, the Equals being evaluated one by one
+  constexpr EqualsSet() noexcept = default;
+
+  constexpr explicit EqualsSet(const std::array<std::string_view, N>& keys) {
+    m_table.emplace(keys, PerfectHash<N>::OnFailure::kReport);
+    if (not m_table->IsValid()) m_table.reset();
+  }
+
+  /// True when the set is used, replacing the Equals
+  constexpr auto IsEnabled() const noexcept -> bool {
+    return m_table.has_value();
+  }
+
+  constexpr auto Contains(std::string_view str) const noexcept -> bool {
+    return m_table.has_value() and
+           (m_table->Find(str) != std::string_view::npos);
+  }
+
+ private:
+  std::optional<PerfectHash<N>> m_table;
+};
+
+template <>
+class EqualsSet<0> {
+ public:
+  constexpr EqualsSet() noexcept = default;
+
+  constexpr explicit EqualsSet(const std::array<std::string_view, 0>&) {}
+
+  constexpr auto IsEnabled() const noexcept -> bool { return false; }
+
+  constexpr auto Contains(std::string_view) const noexcept -> bool {
+    return false;
+  }
+};
+
+/// The patterns of the Equals like \a matchers, in order of declaration
+template <std::size_t N, typename... Matchers>
+constexpr auto EqualsPatterns(const std::tuple<Matchers...>& matchers)
+    -> std::array<std::string_view, N> {
+  std::array<std::string_view, N> patterns = {};
+  std::size_t i = 0;
+
+  const auto collect = [&](const auto& m) {
+    using M = std::remove_cvref_t<decltype(m)>;
+    if constexpr ((N > 0) and IsEqualsLike_v<M>) {
+      if constexpr (IsEqualsMatcher_v<M>) {
+        patterns[i++] = m.Pattern();
+      } else {
+        patterns[i++] = std::string_view{m};
+      }
+    }
   };
+  std::apply([&](const auto&... m) { (collect(m), ...); }, matchers);
+
+  return patterns;
 }
 
+}  // namespace details
+
 /**
- *  \brief Matches when ONE OF the character in \a pattern is found inside str
+ *  \brief Meta matcher returning the negation of the wrapped matcher
+ */
+template <typename Matcher>
+class DoNotMatcher {
+ public:
+  /// Shareable when the wrapped matcher is
+  static constexpr bool is_thread_shareable = IsThreadShareable_v<Matcher>;
+
+  /// Same cost as the wrapped matcher
+  static constexpr std::size_t match_cost = MatchCost_v<Matcher>;
+
+  /// Reorderable when the wrapped matcher is
+  static constexpr bool is_reorderable = IsReorderable_v<Matcher>;
+
+  constexpr explicit DoNotMatcher(Matcher m) : m_matcher(std::move(m)) {}
+
+  constexpr auto IsMatching(std::string_view str) const -> bool {
+    return not ::swstr::IsMatching(m_matcher, str);
+  }
+
+  constexpr auto operator()(std::string_view str) const -> bool {
+    return IsMatching(str);
+  }
+
+  /// The wrapped matcher
+  constexpr auto Operand() const& noexcept -> const Matcher& {
+    return m_matcher;
+  }
+
+  constexpr auto Operand() && noexcept -> Matcher&& {
+    return std::move(m_matcher);
+  }
+
+ private:
+  Matcher m_matcher;
+};
+
+/**
+ *  \brief Meta matcher returning true if ALL wrapped matchers matched
  *
- *  \note Perform reverse lookup
+ *  \note The matchers are evaluated cheapest first (see EvaluationOrder), and
+ *        when all of them are side effects free (see IsReorderable), the
+ *        string length is first checked against the lengths they may match
+ *        (i.e. AllOf(StartsWith(a), EndsWith(b)) needs max(|a|, |b|) chars)
+ */
+template <typename... Matchers>
+class AllOfMatcher {
+ public:
+  /// Shareable when all wrapped matchers are
+  static constexpr bool is_thread_shareable =
+      (IsThreadShareable_v<Matchers> and ...);
+
+  /// All the wrapped matchers may be evaluated
+  static constexpr std::size_t match_cost =
+      (std::size_t{0} + ... + MatchCost_v<Matchers>);
+
+  /// Reorderable when all wrapped matchers are
+  static constexpr bool is_reorderable = (IsReorderable_v<Matchers> and ...);
+
+  constexpr explicit AllOfMatcher(Matchers... matchers)
+      : m_matchers(std::move(matchers)...),
+        m_length_check(kCheckLengths ? Lengths() : details::LengthRange{}) {}
+
+  constexpr auto IsMatching(std::string_view str) const -> bool {
+    return m_length_check.Accepts(str.size()) and
+           MatchInOrder(str, std::index_sequence_for<Matchers...>{});
+  }
+
+  constexpr auto operator()(std::string_view str) const -> bool {
+    return IsMatching(str);
+  }
+
+  /**
+   *  \brief Same as IsMatching(), reporting the smallest span covering the
+   *         spans of all the wrapped matchers (see swstr::Match())
+   *
+   *  \note AllOf(StartsWith("GET "), Contains(" HTTP/")) reports "GET ...
+   *        HTTP/", the whole string when there is no wrapped matcher
+   */
+  constexpr auto Match(std::string_view str) const
+      -> std::optional<MatchSpan> {
+    if (not m_length_check.Accepts(str.size())) return std::nullopt;
+
+    if constexpr (sizeof...(Matchers) == 0) {
+      return MatchSpan{0, str.size()};
+    } else {
+      std::size_t begin = str.size();
+      std::size_t end = 0;
+      if (not SpanInOrder(str, begin, end,
+                          std::index_sequence_for<Matchers...>{})) {
+        return std::nullopt;
+      }
+      return MatchSpan{begin, end - begin};
+    }
+  }
+
+  /// Lengths of the strings ALL the wrapped matchers may match
+  constexpr auto Lengths() const noexcept -> details::LengthRange {
+    details::LengthRange lengths;
+    std::apply(
+        [&lengths](const auto&... matchers) {
+          [[maybe_unused]] const auto intersect =
+              [&lengths](details::LengthRange range) {
+                lengths.min = std::max(lengths.min, range.min);
+                lengths.max = std::min(lengths.max, range.max);
+              };
+          (intersect(details::LengthsOf(matchers)), ...);
+        },
+        m_matchers);
+    return lengths;
+  }
+
+  /// The wrapped matchers, in the order of declaration
+  constexpr auto Operands() const& noexcept -> const std::tuple<Matchers...>& {
+    return m_matchers;
+  }
+
+  constexpr auto Operands() && noexcept -> std::tuple<Matchers...>&& {
+    return std::move(m_matchers);
+  }
+
+ private:
+  static constexpr auto kOrder = details::EvaluationOrder<Matchers...>();
+
+  /// Only when skipping all matchers has no side effect
+  static constexpr bool kCheckLengths =
+      is_reorderable and (details::HasLengths_v<Matchers> or ...);
+
+  template <std::size_t... I>
+  constexpr auto MatchInOrder(std::string_view str,
+                              std::index_sequence<I...>) const -> bool {
+    return (... and ::swstr::IsMatching(std::get<kOrder[I]>(m_matchers), str));
+  }
+
+  /// Grow [begin, end) to cover the spans of all matchers, false on mismatch
+  template <std::size_t... I>
+  constexpr auto SpanInOrder(std::string_view str, std::size_t& begin,
+                             std::size_t& end, std::index_sequence<I...>) const
+      -> bool {
+    const auto cover = [&](const std::optional<MatchSpan>& span) {
+      if (not span.has_value()) return false;
+      begin = std::min(begin, span->offset);
+      end = std::max(end, span->End());
+      return true;
+    };
+    return (... and
+            cover(::swstr::Match(std::get<kOrder[I]>(m_matchers), str)));
+  }
+
+  std::tuple<Matchers...> m_matchers;
+  [[no_unique_address]] details::LengthCheck<kCheckLengths> m_length_check;
+};
+
+/**
+ *  \brief Meta matcher returning true if ONE wrapped matcher matched
  *
- *  \param[in] pattern The char/string pattern we wish to look for
- *  \param[inout] where Set to the index of the LAST char found
+ *  \note The matchers are evaluated cheapest first (see EvaluationOrder), and
+ *        when all of them are side effects free (see IsReorderable):
+ *        - The string length is first checked against the lengths they may
+ *          match, when they are all known;
+ *        - Many Equals are collapsed into ONE set lookup, when the AnyOf is
+ *          constant evaluated (see EqualsSet);
  */
-constexpr auto ContainsOneOfR(std::variant<std::string_view, char> pattern,
-                              std::size_t* const where = nullptr) noexcept {
-  return [pattern, where](std::string_view str) noexcept -> bool {
-    return details::DoLookup(
-        [str](const auto& p) { return str.find_last_of(p); }, pattern, where);
-  };
+template <typename... Matchers>
+class AnyOfMatcher {
+ public:
+  /// Shareable when all wrapped matchers are
+  static constexpr bool is_thread_shareable =
+      (IsThreadShareable_v<Matchers> and ...);
+
+  /// All the wrapped matchers may be evaluated
+  static constexpr std::size_t match_cost =
+      (std::size_t{0} + ... + MatchCost_v<Matchers>);
+
+  /// Reorderable when all wrapped matchers are
+  static constexpr bool is_reorderable = (IsReorderable_v<Matchers> and ...);
+
+  constexpr explicit AnyOfMatcher(Matchers... matchers)
+      : m_matchers(std::move(matchers)...),
+        m_length_check(kCheckLengths ? Lengths() : details::LengthRange{}),
+        m_equals(std::is_constant_evaluated()
+                     ? details::EqualsSet<kEqualsSetSize>(
+                           details::EqualsPatterns<kEqualsSetSize>(m_matchers))
+                     : details::EqualsSet<kEqualsSetSize>()) {}
+
+  constexpr auto IsMatching(std::string_view str) const -> bool {
+    return m_length_check.Accepts(str.size()) and
+           (m_equals.Contains(str) or
+            MatchInOrder(str, std::index_sequence_for<Matchers...>{}));
+  }
+
+  constexpr auto operator()(std::string_view str) const -> bool {
+    return IsMatching(str);
+  }
+
+  /**
+   *  \brief Same as IsMatching(), reporting the span of the FIRST wrapped
+   *         matcher matching (see swstr::Match())
+   *
+   *  \note The matchers are evaluated in the order of declaration here, such
+   *        that the span reported doesn't depend on their costs
+   */
+  constexpr auto Match(std::string_view str) const
+      -> std::optional<MatchSpan> {
+    std::optional<MatchSpan> span;
+    if (m_length_check.Accepts(str.size())) {
+      bool equals_looked_up = false;
+      SpanInOrder(str, span, equals_looked_up,
+                  std::index_sequence_for<Matchers...>{});
+    }
+    return span;
+  }
+
+  /// Lengths of the strings ONE of the wrapped matchers may match
+  constexpr auto Lengths() const noexcept -> details::LengthRange {
+    if constexpr (not(details::HasLengths_v<Matchers> and ...)) {
+      return {};
+    } else {
+      details::LengthRange lengths{std::string_view::npos, 0};
+      std::apply(
+          [&lengths](const auto&... matchers) {
+            [[maybe_unused]] const auto unite =
+                [&lengths](details::LengthRange range) {
+                  lengths.min = std::min(lengths.min, range.min);
+                  lengths.max = std::max(lengths.max, range.max);
+                };
+            (unite(details::LengthsOf(matchers)), ...);
+          },
+          m_matchers);
+      return lengths;
+    }
+  }
+
+  /// The wrapped matchers, in the order of declaration
+  constexpr auto Operands() const& noexcept -> const std::tuple<Matchers...>& {
+    return m_matchers;
+  }
+
+  constexpr auto Operands() && noexcept -> std::tuple<Matchers...>&& {
+    return std::move(m_matchers);
+  }
+
+ private:
+  static constexpr auto kOrder = details::EvaluationOrder<Matchers...>();
+
+  /// Only when skipping all matchers has no side effect
+  static constexpr bool kCheckLengths =
+      is_reorderable and (sizeof...(Matchers) > 0) and
+      (details::HasLengths_v<Matchers> and ...);
+
+  static constexpr std::size_t kEqualsCount =
+      (std::size_t{0} + ... + details::IsEqualsLike_v<Matchers>);
+
+  static constexpr std::size_t kEqualsSetSize =
+      (is_reorderable and (kEqualsCount >= details::kMinEqualsSetSize))
+          ? kEqualsCount
+          : 0;
+
+  template <std::size_t... I>
+  constexpr auto MatchInOrder(std::string_view str,
+                              std::index_sequence<I...>) const -> bool {
+    return (... or MatchAt<kOrder[I]>(str));
+  }
+
+  template <std::size_t I>
+  constexpr auto MatchAt(std::string_view str) const -> bool {
+    using Matcher = std::tuple_element_t<I, std::tuple<Matchers...>>;
+    if constexpr ((kEqualsSetSize > 0) and details::IsEqualsLike_v<Matcher>) {
+      // Already looked up inside the set
+      if (m_equals.IsEnabled()) return false;
+    }
+    return ::swstr::IsMatching(std::get<I>(m_matchers), str);
+  }
+
+  template <std::size_t... I>
+  constexpr auto SpanInOrder(std::string_view str,
+                             std::optional<MatchSpan>& span,
+                             bool& equals_looked_up,
+                             std::index_sequence<I...>) const -> bool {
+    return (... or SpanAt<I>(str, span, equals_looked_up));
+  }
+
+  template <std::size_t I>
+  constexpr auto SpanAt(std::string_view str, std::optional<MatchSpan>& span,
+                        bool& equals_looked_up) const -> bool {
+    using Matcher = std::tuple_element_t<I, std::tuple<Matchers...>>;
+    if constexpr ((kEqualsSetSize > 0) and details::IsEqualsLike_v<Matcher>) {
+      if (m_equals.IsEnabled()) {
+        // All Equals match the whole string: look them up once, at the first
+        if (std::exchange(equals_looked_up, true)) return false;
+        if (m_equals.Contains(str)) span = MatchSpan{0, str.size()};
+        return span.has_value();
+      }
+    }
+    span = ::swstr::Match(std::get<I>(m_matchers), str);
+    return span.has_value();
+  }
+
+  std::tuple<Matchers...> m_matchers;
+  [[no_unique_address]] details::LengthCheck<kCheckLengths> m_length_check;
+  [[no_unique_address]] details::EqualsSet<kEqualsSetSize> m_equals;
+};
+
+namespace details {
+
+/// True when T is Meta<...>
+template <template <typename...> class Meta, typename T>
+struct IsMetaMatcher : std::false_type {};
+
+template <template <typename...> class Meta, typename... Matchers>
+struct IsMetaMatcher<Meta, Meta<Matchers...>> : std::true_type {};
+
+/**
+ *  \brief The operands of \a m when it's a Meta matcher (flattening
+ *         AllOf(AllOf(a, b), c) into AllOf(a, b, c)), \a m otherwise, as a
+ *         tuple
+ */
+template <template <typename...> class Meta, typename Matcher>
+constexpr auto OperandsOf(Matcher&& m) {
+  if constexpr (IsMetaMatcher<Meta, std::decay_t<Matcher>>::value) {
+    return std::forward<Matcher>(m).Operands();
+  } else {
+    return std::tuple<std::decay_t<Matcher>>(std::forward<Matcher>(m));
+  }
 }
 
-// Meta matcher /////////////////////////////////////////////////////////////
+/// Build a Meta matcher of all \a operands (a tuple of matchers)
+template <template <typename...> class Meta, typename Operands>
+constexpr auto MakeMetaMatcher(Operands&& operands) {
+  return std::apply(
+      [](auto&&... matchers) {
+        return Meta<std::decay_t<decltype(matchers)>...>(
+            std::forward<decltype(matchers)>(matchers)...);
+      },
+      std::forward<Operands>(operands));
+}
+
+}  // namespace details
 
 /**
  *  \brief Meta matcher returning the negation of the given matcher \a m
  *
+ *  \note DoNot(DoNot(m)) is simplified into m
  *  \note Matchers must be copyable
  *
  *  \param[in] m Matcher to negate
  */
 template <typename Matcher>
 constexpr auto DoNot(Matcher&& m) {
-  return [=](std::string_view str) -> bool { return not IsMatching(m, str); };
+  using M = std::decay_t<Matcher>;
+  if constexpr (details::IsMetaMatcher<DoNotMatcher, M>::value) {
+    return std::decay_t<decltype(std::declval<M>().Operand())>(
+        std::forward<Matcher>(m).Operand());
+  } else {
+    return DoNotMatcher<M>(std::forward<Matcher>(m));
+  }
 }
 
 /**
  *  \brief Meta matcher returning true if ALL matcher matched the string
  *
- *  \note Matchers are called in the order of declaration
+ *  \note Nested AllOf are flattened, and matchers are evaluated cheapest
+ *        first, without changing the calls of the matchers with side effects
+ *        (see AllOfMatcher)
  *  \note Matchers must be copyable
  *
  *  \param[in] ...matchers All matcher to match
  */
 template <typename... Matchers>
 constexpr auto AllOf(Matchers&&... matchers) {
-  return [=](std::string_view str) -> bool {
-    return (... and IsMatching(matchers, str));
-  };
+  return details::MakeMetaMatcher<AllOfMatcher>(std::tuple_cat(
+      details::OperandsOf<AllOfMatcher>(std::forward<Matchers>(matchers))...));
 }
 
 /**
  *  \brief Meta matcher returning true if ONE matcher matched the string
  *
- *  \note Matchers are called in the order of declaration
+ *  \note Nested AnyOf are flattened, and matchers are evaluated cheapest
+ *        first, without changing the calls of the matchers with side effects
+ *        (see AnyOfMatcher)
  *  \note Matchers must be copyable
  *
  *  \param[in] ...matchers All matcher to match
  */
 template <typename... Matchers>
 constexpr auto AnyOf(Matchers&&... matchers) {
-  return [=](std::string_view str) -> bool {
-    return (... or IsMatching(matchers, str));
-  };
+  return details::MakeMetaMatcher<AnyOfMatcher>(std::tuple_cat(
+      details::OperandsOf<AnyOfMatcher>(std::forward<Matchers>(matchers))...));
 }
 
 // Type erasure /////////////////////////////////////////////////////////////
 /**
  *  \brief Type erased matcher use as a runtime polymorphic matcher
+ *
+ *  \note Small matchers (all the built-in ones) are stored inline, without any
+ *        allocation: constructing, copying and moving an AnyMatcher wrapping
+ *        them never allocates. Bigger matchers are stored on the heap.
+ *  \note The wrapped matcher is called through a static table of function
+ *        pointers, one per matcher type, instead of a heap allocated virtual
+ *        object
+ *
+ *  \tparam ThreadShareable When true, only thread shareable matchers (see
+ *                          IsThreadShareable) are accepted (checked at
+ *                          compile time), and they are only called through a
+ *                          const reference, such that the BasicAnyMatcher
+ *                          itself is thread shareable
  */
-class AnyMatcher {
-  /// Internal virtual string matcher interface declaration
-  struct StrMatcherInterface {
-    virtual ~StrMatcherInterface() noexcept = default;
-    virtual constexpr auto Clone() const
-        -> std::unique_ptr<StrMatcherInterface> = 0;
-    virtual constexpr auto IsMatching(std::string_view) -> bool = 0;
+template <bool ThreadShareable>
+class BasicAnyMatcher {
+ public:
+  /// Only accepts shareable matchers, when ThreadShareable
+  static constexpr bool is_thread_shareable = ThreadShareable;
+
+  /// Matchers up to this size (and aligned as std::max_align_t) are inline
+  static constexpr std::size_t kInlineSize = 48;
+
+ private:
+  static constexpr std::size_t kInlineAlign = alignof(std::max_align_t);
+
+  /// Storage of the wrapped matcher, either inline or on the heap
+  union Storage {
+    alignas(kInlineAlign) unsigned char buffer[kInlineSize];
+    void* heap;
   };
 
-  /// String matcher templated wrapper, defining the StrMatcherInterface for any
-  /// \a InnerMatcher
+  /// Operations on the wrapped matcher, erasing its type
+  struct Operations {
+    auto (*is_matching)(Storage&, std::string_view) -> bool;
+    void (*copy)(const Storage& from, Storage& to);
+    /// Move \a from into \a to, then destroy \a from
+    void (*relocate)(Storage& from, Storage& to) noexcept;
+    void (*destroy)(Storage&) noexcept;
+  };
+
+  /// True when \a Matcher is stored inside the inline buffer
+  template <typename Matcher>
+  static constexpr bool kIsInline =
+      (sizeof(Matcher) <= kInlineSize) and
+      (alignof(Matcher) <= kInlineAlign) and
+      std::is_nothrow_move_constructible_v<Matcher>;
+
+  /// Operations implementation for a given \a InnerMatcher
   template <typename InnerMatcher>
-  struct StrMatcherWrapper final : StrMatcherInterface {
-    /**
-     *  \brief Construct the Wrapper inplace, forwarding \a args to the
-     *         underlying InnerMatcher constructor
-     */
+  struct OperationsOf {
+    static auto Get(Storage& storage) noexcept -> InnerMatcher& {
+      if constexpr (kIsInline<InnerMatcher>) {
+        return *std::launder(reinterpret_cast<InnerMatcher*>(storage.buffer));
+      } else {
+        return *static_cast<InnerMatcher*>(storage.heap);
+      }
+    }
+
+    static auto Get(const Storage& storage) noexcept -> const InnerMatcher& {
+      if constexpr (kIsInline<InnerMatcher>) {
+        return *std::launder(
+            reinterpret_cast<const InnerMatcher*>(storage.buffer));
+      } else {
+        return *static_cast<const InnerMatcher*>(storage.heap);
+      }
+    }
+
     template <typename... Args>
-    constexpr StrMatcherWrapper(Args&&... args)
-        : m_matcher(std::forward<Args>(args)...) {}
-
-    /**
-     *  \brief Clone the current Wrapper
-     *
-     *  \return An unique copy of the current Wrapper, as StrMatcherInterface
-     */
-    inline auto Clone() const -> std::unique_ptr<StrMatcherInterface> override {
-      return std::make_unique<StrMatcherWrapper>(*this);
+    static void Construct(Storage& storage, Args&&... args) {
+      if constexpr (kIsInline<InnerMatcher>) {
+        ::new (static_cast<void*>(storage.buffer))
+            InnerMatcher(std::forward<Args>(args)...);
+      } else {
+        storage.heap = new InnerMatcher(std::forward<Args>(args)...);
+      }
     }
 
-    /**
-     *  \brief Implement the IsMatching interface using IsMatching() function
-     *
-     *  \param[in] str The string we wish to matches against
-     *
-     *  \return True when the matches succeed, false otherwise
-     */
-    constexpr auto IsMatching(std::string_view str) -> bool override {
+    static auto IsMatching(Storage& storage, std::string_view str) -> bool {
       // The full path namespace is used in order to desambiguate between the
       // function and the method
-      return ::swstr::IsMatching(m_matcher, str);
+      if constexpr (ThreadShareable) {
+        return ::swstr::IsMatching(Get(std::as_const(storage)), str);
+      } else {
+        return ::swstr::IsMatching(Get(storage), str);
+      }
+    }
+
+    static void Copy(const Storage& from, Storage& to) {
+      Construct(to, Get(from));
+    }
+
+    static void Relocate(Storage& from, Storage& to) noexcept {
+      if constexpr (kIsInline<InnerMatcher>) {
+        Construct(to, std::move(Get(from)));
+        Destroy(from);
+      } else {
+        to.heap = from.heap;
+      }
+    }
+
+    static void Destroy(Storage& storage) noexcept {
+      if constexpr (kIsInline<InnerMatcher>) {
+        Get(storage).~InnerMatcher();
+      } else {
+        delete &Get(storage);
+      }
     }
 
-   private:
-    InnerMatcher m_matcher; /*!< Inner matcher wrapped */
+    static constexpr Operations kOperations = {&IsMatching, &Copy, &Relocate,
+                                               &Destroy};
   };
 
  public:
+  /**
+   *  \brief True when a \a Matcher is stored inline (without allocation)
+   */
+  template <typename Matcher>
+  static constexpr auto IsStoredInline() noexcept -> bool {
+    return kIsInline<std::decay_t<Matcher>>;
+  }
+
   /**
    *  \brief Construct a new AnyMatcher from any other matcher type
    *
-   *  \note If using an lvalue Matcher, Matcher must be copy constructible
+   *  \note The matcher is always copied/moved inside the AnyMatcher, such that
+   *        Matcher must be copy constructible
    *
    *  \param[in] m The matcher we wish to wrap
    */
   template <typename Matcher,
-            std::enable_if_t<
-                not std::is_same_v<AnyMatcher, std::remove_cvref_t<Matcher>>,
-                bool> = true>
-  constexpr explicit AnyMatcher(Matcher&& m)
-      : m_interface(std::make_unique<StrMatcherWrapper<Matcher>>(
-            std::forward<Matcher>(m))) {
-    MatcherTraits<Matcher>::StaticAssertIfInvalid();
+            std::enable_if_t<not std::is_same_v<BasicAnyMatcher,
+                                                std::remove_cvref_t<Matcher>>,
+                             bool> = true>
+#if SwitchStr_ENABLE_INSTRUMENTATION
+  explicit BasicAnyMatcher(
+      Matcher&& m,
+      const std::source_location& location = std::source_location::current())
+      : m_probe("AnyMatcher", location) {
+#else
+  explicit BasicAnyMatcher(Matcher&& m) {
+#endif
+    MatcherTraits<std::decay_t<Matcher>>::StaticAssertIfInvalid();
+    static_assert(not ThreadShareable or IsThreadShareable_v<Matcher>,
+                  "Only thread shareable matchers (see IsThreadShareable) "
+                  "can be wrapped into an AnyShareableMatcher.");
+    Emplace<std::decay_t<Matcher>>(std::forward<Matcher>(m));
   }
 
   /**
    *  \brief Default construct AnyMatcher using NeverMatches()
    */
-  constexpr AnyMatcher() noexcept : AnyMatcher(NeverMatches()) {}
+  BasicAnyMatcher() noexcept : BasicAnyMatcher(NeverMatches()) {}
 
   /**
-   *  \brief Copy construct AnyMatcher cloning the \a other wrapped matcher
+   *  \brief Copy construct AnyMatcher copying the \a other wrapped matcher
    *
    *  \param[in] other An lvalue AnyMatcher we wish to copy
    */
-  inline explicit AnyMatcher(const AnyMatcher& other)
-      : m_interface(other.m_interface->Clone()) {}
+  inline explicit BasicAnyMatcher(const BasicAnyMatcher& other)
+      : m_operations(other.m_operations)
+#if SwitchStr_ENABLE_INSTRUMENTATION
+      , m_probe(other.m_probe)
+#endif
+  {
+    m_operations->copy(other.m_storage, m_storage);
+  }
 
   /**
-   *  \brief Copy assign cloning the \a other wrapped matcher
+   *  \brief Copy assign copying the \a other wrapped matcher
    *
    *  \param[in] other An lvalue AnyMatcher we wish to copy
    */
-  inline AnyMatcher& operator=(const AnyMatcher& other) {
-    m_interface = other.m_interface->Clone();
+  inline BasicAnyMatcher& operator=(const BasicAnyMatcher& other) {
+    if (this != &other) {
+      *this = BasicAnyMatcher(other);
+    }
     return *this;
   }
 
   /**
    *  \brief Move construct AnyMatcher using \a other wrapped matcher
    *
+   *  \note \a other is left with NeverMatches()
+   *
    *  \param[in] other An rvalue AnyMatcher we are constructing from
    */
-  inline explicit AnyMatcher(AnyMatcher&& other) noexcept
-      : m_interface(std::move(other.m_interface)) {}
+  inline explicit BasicAnyMatcher(BasicAnyMatcher&& other) noexcept
+      : m_operations(other.m_operations)
+#if SwitchStr_ENABLE_INSTRUMENTATION
+      , m_probe(other.m_probe)
+#endif
+  {
+    m_operations->relocate(other.m_storage, m_storage);
+    other.Emplace<decltype(NeverMatches())>();
+  }
 
   /**
    *  \brief Move assign AnyMatcher using \a other wrapped matcher
    *
+   *  \note \a other is left with NeverMatches()
+   *
    *  \param[in] other An rvalue AnyMatcher
    */
-  inline AnyMatcher& operator=(AnyMatcher&& other) noexcept {
-    m_interface = std::move(other.m_interface);
+  inline BasicAnyMatcher& operator=(BasicAnyMatcher&& other) noexcept {
+    if (this != &other) {
+      m_operations->destroy(m_storage);
+      m_operations = other.m_operations;
+      m_operations->relocate(other.m_storage, m_storage);
+#if SwitchStr_ENABLE_INSTRUMENTATION
+      m_probe = other.m_probe;
+#endif
+      other.Emplace<decltype(NeverMatches())>();
+    }
     return *this;
   }
 
-  /// Default destructor
-  virtual ~AnyMatcher() noexcept = default;
+  /// Destroy the wrapped matcher
+  ~BasicAnyMatcher() noexcept { m_operations->destroy(m_storage); }
 
   /**
    *  \brief Assigns a Matcher to the AnyMatcher
    *
-   *  \note If using an lvalue Matcher, Matcher must be copy constructible
+   *  \note Matcher must be copy constructible
    *
    *  \param[in] m The matcher we wish to wrap
    */
-  template <
-      typename Matcher,
-      std::enable_if_t<not std::is_same_v<AnyMatcher, std::decay_t<Matcher>>,
-                       bool> = true>
-  constexpr AnyMatcher& operator=(Matcher&& m) {
-    *this = AnyMatcher(std::forward<Matcher>(m));
+  template <typename Matcher,
+            std::enable_if_t<
+                not std::is_same_v<BasicAnyMatcher, std::decay_t<Matcher>>,
+                bool> = true>
+  BasicAnyMatcher& operator=(Matcher&& m) {
+    *this = BasicAnyMatcher(std::forward<Matcher>(m));
     return *this;
   }
 
@@ -431,12 +2424,31 @@ class AnyMatcher {
    *  \return True when the underlying matcher matched, false otherwise
    */
   inline auto IsMatching(std::string_view str) const -> bool {
-    return m_interface->IsMatching(str);
+    return SwitchStr_PROBE(m_probe, m_operations->is_matching(m_storage, str));
   }
 
  private:
-  std::unique_ptr<StrMatcherInterface>
-      m_interface; /*!< Generic wrapper pointer */
+  /// Construct the wrapped \a InnerMatcher from \a args, without destroying
+  /// the current one
+  template <typename InnerMatcher, typename... Args>
+  void Emplace(Args&&... args) {
+    OperationsOf<InnerMatcher>::Construct(m_storage,
+                                          std::forward<Args>(args)...);
+    m_operations = &OperationsOf<InnerMatcher>::kOperations;
+  }
+
+  const Operations* m_operations; /*!< Operations of the wrapped matcher */
+  mutable Storage m_storage;      /*!< The wrapped matcher */
+#if SwitchStr_ENABLE_INSTRUMENTATION
+  /// Records the evaluations, per site where the AnyMatcher is constructed
+  instrument::details::MatcherProbe m_probe;
+#endif
 };
 
+/// Type erased matcher, accepting any matcher
+using AnyMatcher = BasicAnyMatcher<false>;
+
+/// Type erased matcher, accepting only thread shareable matchers
+using AnyShareableMatcher = BasicAnyMatcher<true>;
+
 }  // namespace swstr
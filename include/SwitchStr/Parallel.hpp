@@ -0,0 +1,272 @@
+#pragma once
+
+#include <algorithm>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <exception>
+#include <memory>
+#include <span>
+#include <string_view>
+#include <thread>
+#include <utility>
+#include <vector>
+
+#include "SwitchStr/Batch.hpp"
+#include "SwitchStr/Matcher.hpp"
+
+namespace swstr {
+
+namespace details {
+
+/// Number of strings processed by a thread each time it grabs some work
+inline constexpr std::size_t kParallelChunkSize = 4096;
+
+/// State of a ParallelChunks() call, shared with its helpers (an executor
+/// may only start them after the call returned)
+struct ParallelChunksState {
+  std::atomic<std::size_t> next_chunk = 0; /*!< Next chunk to hand out */
+  std::atomic<std::size_t> done_chunks = 0;
+  std::atomic<bool> failed = false;
+  std::exception_ptr error; /*!< First exception thrown */
+};
+
+/**
+ *  \brief Call process(begin, end) over all chunks of [0, size), using up to
+ *         \a helpers helpers along the calling thread
+ *
+ *  Chunks are handed out one at a time through an atomic counter, such that
+ *  a thread stuck on long strings doesn't delay the others: the threads done
+ *  early simply grab more chunks. Each chunk writes a contiguous part of the
+ *  outputs, such that threads only share cache lines at the chunk borders.
+ *
+ *  The calling thread processes chunks too, then waits for the chunks taken
+ *  by the helpers only: the chunks no helper took yet are its own, such that
+ *  helpers started late (or never) by a busy executor never deadlock.
+ *
+ *  \note The first exception thrown by \a process is rethrown once all
+ *        chunks are done (the remaining chunks are then skipped)
+ *
+ *  \param[in] size Number of items to process
+ *  \param[in] chunk_size Number of items of each chunk
+ *  \param[in] helpers Max number of helpers started
+ *  \param[in] process The function called on each chunk
+ *  \param[in] spawn Called with each helper (a noexcept void() callable) to
+ *                   run it on another thread. Stops starting helpers when it
+ *                   throws, the started ones doing the work.
+ */
+template <typename Process, typename Spawn>
+void ParallelChunks(std::size_t size, std::size_t chunk_size,
+                    std::size_t helpers, const Process& process,
+                    Spawn&& spawn) {
+  const std::size_t chunks = (size + chunk_size - 1) / chunk_size;
+  helpers = std::min(helpers, std::max<std::size_t>(chunks, 1) - 1);
+
+  if (helpers == 0) {
+    if (size != 0) process(std::size_t{0}, size);
+    return;
+  }
+
+  const auto state = std::make_shared<ParallelChunksState>();
+  const auto work = [state, chunks, chunk_size, size, &process]() noexcept {
+    // Once all chunks are handed out, process is never used again: it's
+    // gone when a late helper starts
+    for (std::size_t chunk = state->next_chunk.fetch_add(1); chunk < chunks;
+         chunk = state->next_chunk.fetch_add(1)) {
+      if (not state->failed.load(std::memory_order_relaxed)) {
+        try {
+          const std::size_t begin = chunk * chunk_size;
+          process(begin, std::min(size, begin + chunk_size));
+        } catch (...) {
+          if (not state->failed.exchange(true)) {
+            state->error = std::current_exception();
+          }
+        }
+      }
+
+      if (state->done_chunks.fetch_add(1) + 1 == chunks) {
+        state->done_chunks.notify_all();
+      }
+    }
+  };
+
+  for (std::size_t i = 0; i < helpers; ++i) {
+    try {
+      spawn(work);
+    } catch (...) {
+      // Can't start more helpers: the ones already running do the work
+      break;
+    }
+  }
+
+  work();
+  for (std::size_t done = state->done_chunks.load(); done != chunks;
+       done = state->done_chunks.load()) {
+    state->done_chunks.wait(done);
+  }
+
+  if (state->error) std::rethrow_exception(state->error);
+}
+
+/**
+ *  \brief Same as above, starting up to \a threads - 1 std::thread
+ *
+ *  \note Threads are started on each call, and joined before returning.
+ *        This costs tens of microseconds per thread: when called often,
+ *        prefer an executor reusing its threads (i.e. a thread pool).
+ *
+ *  \param[in] threads Max number of threads, the calling one included (0 for
+ *                     std::thread::hardware_concurrency())
+ */
+template <typename Process>
+void ParallelChunks(std::size_t size, std::size_t chunk_size,
+                    std::size_t threads, const Process& process) {
+  if (threads == 0) {
+    threads = std::max(1u, std::thread::hardware_concurrency());
+  }
+
+  std::vector<std::thread> workers;
+  std::exception_ptr error;
+  try {
+    ParallelChunks(size, chunk_size, threads - 1, process,
+                   [&](const auto& work) {
+                     if (workers.empty()) workers.reserve(threads - 1);
+                     workers.emplace_back(work);
+                   });
+  } catch (...) {
+    error = std::current_exception();
+  }
+
+  for (auto& worker : workers) {
+    worker.join();
+  }
+
+  if (error) std::rethrow_exception(error);
+}
+
+}  // namespace details
+
+/**
+ *  \brief Parallel version of IsMatching(m, strs, out), for very large inputs
+ *
+ *  The strings are split into chunks processed by up to \a threads threads,
+ *  each using the batch interface of the matcher (see Batch.hpp).
+ *
+ *  \note The matcher is used by all threads at once, such that it must be
+ *        thread shareable (see IsThreadShareable), which is checked at
+ *        compile time. In particular, the Contains* matchers must not use any
+ *        'where'/'which' output, and type erased matchers must be
+ *        AnyShareableMatcher.
+ *  \note The threads are started on each call: when called often, prefer
+ *        the overload taking an executor (i.e. a thread pool)
+ *
+ *  \pre out.size() >= strs.size()
+ *
+ *  \param[in] m The matcher to use
+ *  \param[in] strs All strings to match
+ *  \param[out] out The result of each match (1 when matching, 0 otherwise)
+ *  \param[in] threads Max number of threads used, the calling one included
+ *                     (0 for std::thread::hardware_concurrency())
+ */
+template <typename Matcher>
+void ParallelClassify(const Matcher& m, std::span<const std::string_view> strs,
+                      std::span<std::uint8_t> out, std::size_t threads = 0) {
+  static_assert(IsThreadShareable_v<Matcher>,
+                "ParallelClassify() requires a thread shareable matcher (see "
+                "IsThreadShareable).");
+
+  details::ParallelChunks(strs.size(), details::kParallelChunkSize, threads,
+                          [&](std::size_t begin, std::size_t end) {
+                            IsMatching(m, strs.subspan(begin, end - begin),
+                                       out.subspan(begin, end - begin));
+                          });
+}
+
+/**
+ *  \brief Same as above, running the other threads on \a executor (i.e. a
+ *         thread pool) instead of starting new ones
+ *
+ *  Example:
+ *  \code
+ *  ParallelClassify(m, strs, out, pool.Size() + 1,
+ *                   [&pool](auto task) { pool.Post(std::move(task)); });
+ *  \endcode
+ *
+ *  \param[in] threads Max number of threads used, the calling one included
+ *  \param[in] executor Called with up to \a threads - 1 tasks (copyable,
+ *                      noexcept, void() callables) to run on its threads. The
+ *                      calling thread does the work of the tasks not started
+ *                      in time: they may run after the call returned, doing
+ *                      nothing then.
+ */
+template <typename Matcher, typename Executor>
+void ParallelClassify(const Matcher& m, std::span<const std::string_view> strs,
+                      std::span<std::uint8_t> out, std::size_t threads,
+                      Executor&& executor) {
+  static_assert(IsThreadShareable_v<Matcher>,
+                "ParallelClassify() requires a thread shareable matcher (see "
+                "IsThreadShareable).");
+
+  details::ParallelChunks(strs.size(), details::kParallelChunkSize,
+                          std::max<std::size_t>(threads, 1) - 1,
+                          [&](std::size_t begin, std::size_t end) {
+                            IsMatching(m, strs.subspan(begin, end - begin),
+                                       out.subspan(begin, end - begin));
+                          },
+                          std::forward<Executor>(executor));
+}
+
+/**
+ *  \brief Parallel version of IndexOf(s, strs, out), for very large inputs
+ *
+ *  \note The switch is used by all threads at once, such that it must be
+ *        thread shareable (see IsThreadShareable), which is checked at
+ *        compile time (i.e. StaticSwitch, or SwitchTable using
+ *        AnyShareableMatcher).
+ *  \note The threads are started on each call: when called often, prefer
+ *        the overload taking an executor (i.e. a thread pool)
+ *
+ *  \pre out.size() >= strs.size()
+ *
+ *  \param[in] s The switch to use
+ *  \param[in] strs All strings to switch on
+ *  \param[out] out Index of the case matching each string (npos if none)
+ *  \param[in] threads Max number of threads used, the calling one included
+ *                     (0 for std::thread::hardware_concurrency())
+ */
+template <typename Switch>
+void ParallelClassify(const Switch& s, std::span<const std::string_view> strs,
+                      std::span<std::size_t> out, std::size_t threads = 0) {
+  static_assert(IsThreadShareable_v<Switch>,
+                "ParallelClassify() requires a thread shareable switch (see "
+                "IsThreadShareable).");
+
+  details::ParallelChunks(strs.size(), details::kParallelChunkSize, threads,
+                          [&](std::size_t begin, std::size_t end) {
+                            IndexOf(s, strs.subspan(begin, end - begin),
+                                    out.subspan(begin, end - begin));
+                          });
+}
+
+/**
+ *  \brief Same as above, running the other threads on \a executor (see
+ *         ParallelClassify(m, strs, out, threads, executor))
+ */
+template <typename Switch, typename Executor>
+void ParallelClassify(const Switch& s, std::span<const std::string_view> strs,
+                      std::span<std::size_t> out, std::size_t threads,
+                      Executor&& executor) {
+  static_assert(IsThreadShareable_v<Switch>,
+                "ParallelClassify() requires a thread shareable switch (see "
+                "IsThreadShareable).");
+
+  details::ParallelChunks(strs.size(), details::kParallelChunkSize,
+                          std::max<std::size_t>(threads, 1) - 1,
+                          [&](std::size_t begin, std::size_t end) {
+                            IndexOf(s, strs.subspan(begin, end - begin),
+                                    out.subspan(begin, end - begin));
+                          },
+                          std::forward<Executor>(executor));
+}
+
+}  // namespace swstr
@@ -0,0 +1,140 @@
+#pragma once
+
+#include <cstddef>
+#include <string_view>
+
+#include "SwitchStr/FixedString.hpp"
+#include "SwitchStr/Matcher.hpp"
+#include "SwitchStr/details/Dfa.hpp"
+
+namespace swstr {
+
+/**
+ *  \brief Matcher of a glob/regex pattern, compiled at compile time into a
+ *         minimal DFA (see details/Dfa.hpp)
+ *
+ *  Matching runs the DFA over the string, ONE table lookup per byte, without
+ *  any allocation nor backtracking, and stops as soon as the result is known
+ *  (i.e. no pattern can match anymore, or everything matches from there).
+ *
+ *  The pattern always matches the WHOLE string (like std::regex_match).
+ *
+ *  \note Any pattern that can't be compiled (invalid or unsupported syntax)
+ *        is a compile error, there is no fallback
+ *
+ *  \tparam Syntax The syntax of the pattern
+ *  \tparam Expression The pattern
+ */
+template <details::PatternSyntax Syntax, FixedString Expression>
+class PatternMatcher {
+  static constexpr details::PatternInfo kInfo =
+      details::CompilePattern(Syntax, Expression.view()).Info();
+
+  static_assert(kInfo.error != details::PatternError::kUnbalancedGroup,
+                "Pattern: unbalanced group, missing/extra ')' or '}'");
+  static_assert(kInfo.error != details::PatternError::kUnterminatedClass,
+                "Pattern: unterminated [class], missing ']'");
+  static_assert(kInfo.error != details::PatternError::kInvalidRange,
+                "Pattern: invalid [class] range, the first char must be "
+                "lower or equal to the last one");
+  static_assert(kInfo.error != details::PatternError::kInvalidRepetition,
+                "Pattern: invalid repetition, expecting {n}, {n,} or {n,m} "
+                "with n <= m <= 255");
+  static_assert(kInfo.error != details::PatternError::kNothingToRepeat,
+                "Pattern: quantifier without anything to repeat");
+  static_assert(kInfo.error != details::PatternError::kInvalidEscape,
+                "Pattern: invalid escape sequence");
+  static_assert(kInfo.error != details::PatternError::kUnsupported,
+                "Pattern: unsupported syntax (back references, lookarounds, "
+                "anchors elsewhere than at the edges, word boundaries, "
+                "POSIX classes, ...)");
+  static_assert(kInfo.error != details::PatternError::kTooManyStates,
+                "Pattern: too complex, the automaton has too many states");
+
+  static constexpr bool kIsValid =
+      (kInfo.error == details::PatternError::kNone);
+
+  static constexpr auto kTables =
+      details::MakeDfaTables<kIsValid ? kInfo.state_count : 1,
+                             kIsValid ? kInfo.class_count : 1>(
+          details::CompilePattern(Syntax, Expression.view()));
+
+ public:
+  /// Matching only reads the (static) tables
+  static constexpr bool is_thread_shareable = true;
+
+  /// Cost of matching a string (see MatchCost)
+  static constexpr std::size_t match_cost = details::kCostAutomaton;
+
+  /// The pattern matched
+  static constexpr auto Pattern() noexcept -> std::string_view {
+    return Expression.view();
+  }
+
+  /// Number of states of the (minimal) DFA
+  static constexpr auto StateCount() noexcept -> std::size_t {
+    return kInfo.state_count;
+  }
+
+  /// Number of byte classes (i.e. the size of a DFA row)
+  static constexpr auto ClassCount() noexcept -> std::size_t {
+    return kInfo.class_count;
+  }
+
+  constexpr auto IsMatching(std::string_view str) const noexcept -> bool {
+    return kTables.IsMatching(str);
+  }
+
+  constexpr auto operator()(std::string_view str) const noexcept -> bool {
+    return IsMatching(str);
+  }
+};
+
+/**
+ *  \brief Matcher of a glob pattern:
+ *  - '*' matches any sequence of bytes (including '/'), '?' any byte;
+ *  - [abc], [a-z], [!a-z] (or [^a-z]) match one byte of/not of the class;
+ *  - {foo,bar} matches one of the (comma separated) sub patterns;
+ *  - '\' escapes the next char;
+ */
+template <FixedString Expression>
+using GlobMatcher = PatternMatcher<details::PatternSyntax::kGlob, Expression>;
+
+/**
+ *  \brief Matcher of a regular expression, supporting the ECMAScript subset
+ *         that compiles to a DFA:
+ *  - Alternations a|b, (non capturing) groups (...) and (?:...);
+ *  - Quantifiers *, +, ?, {n}, {n,}, {n,m} (lazy ones are accepted, as they
+ *    match the same whole strings), never stacked ("a**" is rejected);
+ *  - '.' (any byte but '\n' and '\r', the UTF-8 line terminators U+2028
+ *    and U+2029 are NOT excluded), [classes], [^negated classes];
+ *  - Escapes \d \D \w \W \s \S \n \t \r \f \v \0 \xHH and \<punctuation>;
+ *  - '^' and '$' only at the very start/end, where they are implied;
+ */
+template <FixedString Expression>
+using RegexMatcher =
+    PatternMatcher<details::PatternSyntax::kRegex, Expression>;
+
+/**
+ *  \brief Matches the whole string against the glob \a Expression
+ *
+ *  Example:
+ *  \code
+ *  SwitchStr<int>(file).Case(Glob<"*.{log,txt}">, 0).Default(-1);
+ *  \endcode
+ */
+template <FixedString Expression>
+inline constexpr GlobMatcher<Expression> Glob{};
+
+/**
+ *  \brief Matches the whole string against the regex \a Expression
+ *
+ *  Example:
+ *  \code
+ *  SwitchStr<int>(user).Case(Regex<"user-[0-9]+">, 0).Default(-1);
+ *  \endcode
+ */
+template <FixedString Expression>
+inline constexpr RegexMatcher<Expression> Regex{};
+
+}  // namespace swstr
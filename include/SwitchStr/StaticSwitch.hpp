@@ -0,0 +1,163 @@
+#pragma once
+
+#include <array>
+#include <string_view>
+#include <utility>
+
+#include "SwitchStr/FixedString.hpp"
+#include "SwitchStr/details/PerfectHash.hpp"
+
+namespace swstr {
+
+namespace details {
+
+/**
+ *  \brief Return true when all \a Literals are distinct
+ */
+template <FixedString... Literals>
+constexpr auto AreAllDistinct() noexcept -> bool {
+  constexpr std::array<std::string_view, sizeof...(Literals)> literals = {
+      Literals.view()...};
+
+  for (std::size_t i = 0; i < literals.size(); ++i) {
+    for (std::size_t j = i + 1; j < literals.size(); ++j) {
+      if (literals[i] == literals[j]) return false;
+    }
+  }
+
+  return true;
+}
+
+/**
+ *  \brief Holds the compile time perfect hash table of \a Literals
+ *
+ *  \note Literals views are pointing to the NTTP objects, which have static
+ *        storage duration
+ */
+template <FixedString... Literals>
+struct StaticCaseTable {
+  static constexpr PerfectHash<sizeof...(Literals)> table{
+      std::array<std::string_view, sizeof...(Literals)>{Literals.view()...}};
+};
+
+}  // namespace details
+
+/**
+ *  \brief Switch table over a fixed set of string literals, known at compile
+ *         time, each associated to a value
+ *
+ *  This is the equivalent of a SwitchStr<ResultType> where every Case() uses
+ *  one of the \a Literals as matcher. Instead of comparing the string against
+ *  each literal in turn, a perfect hash of the \a Literals is built at compile
+ *  time, such that a lookup performs ONE hash, ONE verifying comparison and
+ *  returns the value associated to the literal.
+ *
+ *  Example:
+ *  \code
+ *  constexpr StaticSwitch<int, "GET", "POST"> kMethods{0, 1};
+ *  // Same as SwitchStr<int>(method).Case("GET", 0).Case("POST", 1).Default(42)
+ *  kMethods.LookupOr(method, 42);
+ *  \endcode
+ *
+ *  \tparam ResultType The type of values returned by the switch
+ *  \tparam Literals All literals of the switch (must be distinct)
+ */
+template <typename ResultType, FixedString... Literals>
+struct StaticSwitch {
+  static_assert(details::AreAllDistinct<Literals...>(),
+                "StaticSwitch literals must be distinct.");
+
+  /// The lookup only reads the literals (see IsThreadShareable)
+  static constexpr bool is_thread_shareable = true;
+
+  /// Returned by IndexOf() when the string is not one of the Literals
+  static constexpr std::size_t npos = std::string_view::npos;
+
+  /// Type of the value associated to a literal (use to expand Literals)
+  template <FixedString>
+  using ValueOf = ResultType;
+
+  /**
+   *  \brief Return the index of \a str inside the Literals
+   *
+   *  \param[in] str The string we are looking for
+   *
+   *  \return std::size_t The index of the literal equals to \a str, npos if
+   *          none
+   */
+  static constexpr auto IndexOf(std::string_view str) noexcept -> std::size_t {
+    return details::StaticCaseTable<Literals...>::table.Find(str);
+  }
+
+  /**
+   *  \brief Compile time index of \a Literal inside the Literals
+   */
+  template <FixedString Literal>
+  static constexpr auto IndexOf() noexcept -> std::size_t {
+    constexpr std::array<bool, sizeof...(Literals)> is_same = {
+        (Literal.view() == Literals.view())...};
+
+    for (std::size_t i = 0; i < is_same.size(); ++i) {
+      if (is_same[i]) return i;
+    }
+    return npos;
+  }
+
+  /**
+   *  \brief Construct the switch table from one value per literal
+   *
+   *  \param[in] values All values, in the order of the Literals
+   */
+  constexpr explicit StaticSwitch(ValueOf<Literals>... values)
+      : m_values{std::move(values)...} {}
+
+  /**
+   *  \brief Look for the value associated to \a str
+   *
+   *  \param[in] str The string to switch on
+   *
+   *  \return const ResultType* The value of the literal equals to \a str,
+   *          nullptr if none
+   */
+  constexpr auto Lookup(std::string_view str) const noexcept
+      -> const ResultType* {
+    const std::size_t index = IndexOf(str);
+    return (index == npos) ? nullptr : &m_values[index];
+  }
+
+  /**
+   *  \brief Look for the value associated to \a str, or \a default_value
+   *
+   *  \param[in] str The string to switch on
+   *  \param[in] default_value Value returned when \a str is not a literal
+   *
+   *  \return ResultType The value of the literal equals to \a str,
+   *          \a default_value if none
+   */
+  template <typename T>
+  constexpr auto LookupOr(std::string_view str, T&& default_value) const
+      -> ResultType {
+    const ResultType* const value = Lookup(str);
+    if (value == nullptr) {
+      return ResultType(std::forward<T>(default_value));
+    } else {
+      return *value;
+    }
+  }
+
+  /**
+   *  \brief Access the value associated to \a Literal
+   */
+  template <FixedString Literal>
+  constexpr auto Get() const noexcept -> const ResultType& {
+    constexpr std::size_t index = IndexOf<Literal>();
+    static_assert(index != npos,
+                  "The literal is not part of the StaticSwitch ones.");
+    return m_values[index];
+  }
+
+ private:
+  std::array<ResultType, sizeof...(Literals)> m_values;
+};
+
+}  // namespace swstr
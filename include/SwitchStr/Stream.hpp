@@ -0,0 +1,325 @@
+#pragma once
+
+#include <algorithm>
+#include <cstddef>
+#include <string>
+#include <string_view>
+
+#include "SwitchStr/Matcher.hpp"
+
+namespace swstr {
+
+/**
+ *  \file
+ *  \brief Streaming matchers, matching strings received in many chunks
+ *         (i.e. network payloads) WITHOUT reassembling them
+ *
+ *  A StreamMatcher is created from a matcher, fed with all the chunks of the
+ *  string in order, then finished:
+ *  \code
+ *  std::size_t where = 0;
+ *  auto stream = Stream(Contains("needle", &where));
+ *  while (...) {
+ *    stream.Feed(chunk);
+ *  }
+ *  if (stream.Finish()) {
+ *    // 'where' is the offset of "needle" from the start of the FIRST chunk
+ *  }
+ *  \endcode
+ *
+ *  Finish() returns the same result as the matcher would on the contiguous
+ *  string, 'where' outputs being set to absolute offsets.
+ *  Matches spanning chunk boundaries are found using a small carried-over
+ *  state (at most the size of the pattern).
+ *
+ *  \note Streams keep the matcher patterns (by view), such that they must
+ *        outlive the stream, like for the matcher itself
+ *  \note Reset() allows to reuse a stream (and its buffers) for a new string
+ */
+
+namespace details {
+
+/// Keep, inside \a tail, the last \a size bytes of (tail + chunk)
+inline void KeepTail(std::string& tail, std::string_view chunk,
+                     std::size_t size) {
+  if (chunk.size() >= size) {
+    tail.assign(chunk.substr(chunk.size() - size));
+  } else {
+    tail.append(chunk);
+    if (tail.size() > size) tail.erase(0, tail.size() - size);
+  }
+}
+
+/**
+ *  \brief Streaming comparison against a prefix (Exact: against a whole
+ *         string)
+ *
+ *  \note Only the number of bytes fed is carried between chunks
+ */
+template <bool Exact>
+class PrefixStream {
+ public:
+  constexpr explicit PrefixStream(std::string_view pattern) noexcept
+      : m_pattern(pattern) {}
+
+  constexpr void Feed(std::string_view chunk) noexcept {
+    if (not m_mismatch) {
+      const std::size_t offset = std::min(m_size, m_pattern.size());
+      const std::size_t compared =
+          std::min(m_pattern.size() - offset, chunk.size());
+
+      m_mismatch = (chunk.substr(0, compared) !=
+                    m_pattern.substr(offset, compared)) or
+                   (Exact and (compared < chunk.size()));
+    }
+    m_size += chunk.size();
+  }
+
+  constexpr auto Finish() const noexcept -> bool {
+    return not m_mismatch and (Exact ? (m_size == m_pattern.size())
+                                     : (m_size >= m_pattern.size()));
+  }
+
+  constexpr void Reset() noexcept {
+    m_size = 0;
+    m_mismatch = false;
+  }
+
+ private:
+  std::string_view m_pattern;
+  std::size_t m_size = 0;  /*!< Number of bytes fed */
+  bool m_mismatch = false; /*!< True once the bytes fed can't match */
+};
+
+}  // namespace details
+
+/**
+ *  \brief Streaming version of Equals()
+ */
+template <>
+class StreamMatcher<EqualsMatcher> : public details::PrefixStream<true> {
+ public:
+  constexpr explicit StreamMatcher(const EqualsMatcher& m) noexcept
+      : details::PrefixStream<true>(m.Pattern()) {}
+};
+
+/**
+ *  \brief Streaming version of StartsWith()
+ */
+template <>
+class StreamMatcher<StartsWithMatcher> : public details::PrefixStream<false> {
+ public:
+  constexpr explicit StreamMatcher(const StartsWithMatcher& m) noexcept
+      : details::PrefixStream<false>(m.Pattern()) {}
+};
+
+/**
+ *  \brief Streaming version of EndsWith()
+ *
+ *  \note Carries the last suffix.size() bytes fed
+ */
+template <>
+class StreamMatcher<EndsWithMatcher> {
+ public:
+  explicit StreamMatcher(const EndsWithMatcher& m) : m_suffix(m.Pattern()) {
+    m_tail.reserve(m_suffix.size());
+  }
+
+  void Feed(std::string_view chunk) {
+    details::KeepTail(m_tail, chunk, m_suffix.size());
+  }
+
+  auto Finish() const noexcept -> bool { return m_tail == m_suffix; }
+
+  void Reset() noexcept { m_tail.clear(); }
+
+ private:
+  std::string_view m_suffix;
+  std::string m_tail; /*!< The last (up to) m_suffix.size() bytes fed */
+};
+
+/**
+ *  \brief Streaming versions of the compile time literals matchers, same as
+ *         their runtime counterparts
+ */
+template <FixedString Literal>
+class StreamMatcher<FixedEqualsMatcher<Literal>>
+    : public StreamMatcher<EqualsMatcher> {
+ public:
+  constexpr explicit StreamMatcher(const FixedEqualsMatcher<Literal>& m)
+      : StreamMatcher<EqualsMatcher>(EqualsMatcher(m.Pattern())) {}
+};
+
+template <FixedString Literal>
+class StreamMatcher<FixedStartsWithMatcher<Literal>>
+    : public StreamMatcher<StartsWithMatcher> {
+ public:
+  constexpr explicit StreamMatcher(const FixedStartsWithMatcher<Literal>& m)
+      : StreamMatcher<StartsWithMatcher>(StartsWithMatcher(m.Pattern())) {}
+};
+
+template <FixedString Literal>
+class StreamMatcher<FixedEndsWithMatcher<Literal>>
+    : public StreamMatcher<EndsWithMatcher> {
+ public:
+  explicit StreamMatcher(const FixedEndsWithMatcher<Literal>& m)
+      : StreamMatcher<EndsWithMatcher>(EndsWithMatcher(m.Pattern())) {}
+};
+
+/**
+ *  \brief Streaming version of Contains()/ContainsR()
+ *
+ *  \note Carries the last (pattern.size() - 1) bytes fed, the only ones that
+ *        can start an occurrence spanning the next chunk
+ *  \note Contains() stops looking once an occurrence is found, while
+ *        ContainsR() looks at all chunks, keeping the last occurrence
+ */
+template <bool Reverse, bool WithWhere>
+class StreamMatcher<ContainsMatcher<Reverse, WithWhere>> {
+ public:
+  explicit StreamMatcher(const ContainsMatcher<Reverse, WithWhere>& m)
+      : m_matcher(m) {
+    const std::size_t carried = std::max<std::size_t>(Needle().size(), 1) - 1;
+    m_carry.reserve(carried);
+    m_window.reserve(2 * carried);
+  }
+
+  void Feed(std::string_view chunk) {
+    const std::string_view needle = Needle();
+    if (needle.empty() or (not Reverse and (m_found != kNotFound))) {
+      m_size += chunk.size();
+      return;
+    }
+
+    if constexpr (Reverse) {
+      const std::size_t pos = details::RFind(chunk, needle);
+      if (pos != std::string_view::npos) {
+        m_found = m_size + pos;
+      } else {
+        // Any occurrence found before ended inside the previous chunks
+        const std::size_t across = FindAcross(chunk, needle);
+        if (across != kNotFound) m_found = across;
+      }
+    } else {
+      m_found = FindAcross(chunk, needle);
+      if (m_found == kNotFound) {
+        const std::size_t pos = details::Find(chunk, needle);
+        if (pos != std::string_view::npos) m_found = m_size + pos;
+      }
+    }
+
+    details::KeepTail(m_carry, chunk, needle.size() - 1);
+    m_size += chunk.size();
+  }
+
+  auto Finish() const noexcept -> bool {
+    std::size_t found = m_found;
+    if (Needle().empty()) {
+      // Like std::string_view::find/rfind
+      found = Reverse ? m_size : 0;
+    }
+
+    if (found != kNotFound) {
+      m_matcher.m_where.Set(found);
+    }
+    return found != kNotFound;
+  }
+
+  void Reset() noexcept {
+    m_carry.clear();
+    m_size = 0;
+    m_found = kNotFound;
+  }
+
+ private:
+  static constexpr std::size_t kNotFound = std::string_view::npos;
+
+  auto Needle() const noexcept -> std::string_view {
+    return m_matcher.Needle();
+  }
+
+  /// Absolute offset of the occurrence starting inside the carried bytes
+  /// and ending inside \a chunk (the first one, or the last when Reverse)
+  auto FindAcross(std::string_view chunk, std::string_view needle)
+      -> std::size_t {
+    if (m_carry.empty()) return kNotFound;
+
+    // Any occurrence inside the window starts in the carried bytes, since
+    // the part of the chunk is smaller than the needle
+    m_window.assign(m_carry);
+    m_window.append(chunk.substr(0, needle.size() - 1));
+
+    const std::size_t pos = Reverse ? details::RFind(m_window, needle)
+                                    : details::Find(m_window, needle);
+    if (pos == std::string_view::npos) {
+      return kNotFound;
+    } else {
+      return m_size - m_carry.size() + pos;
+    }
+  }
+
+  ContainsMatcher<Reverse, WithWhere> m_matcher;
+  std::string m_carry;  /*!< The last (up to) needle.size() - 1 bytes fed */
+  std::string m_window; /*!< Carried bytes followed by the new chunk ones */
+  std::size_t m_size = 0;          /*!< Number of bytes fed */
+  std::size_t m_found = kNotFound; /*!< Offset of the occurrence found */
+};
+
+/**
+ *  \brief Streaming version of ContainsOneOf()/ContainsOneOfR()
+ *
+ *  \note Nothing but the offset of the char found is carried
+ */
+template <bool Reverse, bool WithWhere>
+class StreamMatcher<ContainsOneOfMatcher<Reverse, WithWhere>> {
+ public:
+  constexpr explicit StreamMatcher(
+      const ContainsOneOfMatcher<Reverse, WithWhere>& m) noexcept
+      : m_matcher(m) {}
+
+  constexpr void Feed(std::string_view chunk) noexcept {
+    if (Reverse or (m_found == kNotFound)) {
+      const std::size_t pos = Reverse ? m_matcher.m_set.FindLast(chunk)
+                                      : m_matcher.m_set.FindFirst(chunk);
+      if (pos != std::string_view::npos) m_found = m_size + pos;
+    }
+    m_size += chunk.size();
+  }
+
+  constexpr auto Finish() const noexcept -> bool {
+    if (m_found != kNotFound) {
+      m_matcher.m_where.Set(m_found);
+    }
+    return m_found != kNotFound;
+  }
+
+  constexpr void Reset() noexcept {
+    m_size = 0;
+    m_found = kNotFound;
+  }
+
+ private:
+  static constexpr std::size_t kNotFound = std::string_view::npos;
+
+  ContainsOneOfMatcher<Reverse, WithWhere> m_matcher;
+  std::size_t m_size = 0;          /*!< Number of bytes fed */
+  std::size_t m_found = kNotFound; /*!< Offset of the char found */
+};
+
+/**
+ *  \brief Create the streaming version of the matcher \a m
+ *
+ *  \note Available for Equals, StartsWith, EndsWith, Contains(R) and
+ *        ContainsOneOf(R)
+ *
+ *  \param[in] m The matcher, copied inside the stream
+ *
+ *  \return StreamMatcher<Matcher> A stream, to Feed() with all chunks before
+ *          calling Finish()
+ */
+template <typename Matcher>
+auto Stream(const Matcher& m) -> StreamMatcher<Matcher> {
+  return StreamMatcher<Matcher>(m);
+}
+
+}  // namespace swstr
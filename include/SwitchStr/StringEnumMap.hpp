@@ -0,0 +1,243 @@
+#pragma once
+
+#include <algorithm>
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <optional>
+#include <string_view>
+#include <type_traits>
+
+#include "SwitchStr/details/Ascii.hpp"
+#include "SwitchStr/details/PerfectHash.hpp"
+
+namespace swstr {
+
+/// A name of an enum value (see StringEnumMap)
+template <typename Enum>
+struct StringEnumEntry {
+  std::string_view name; /*!< The name, viewed: must outlive the map */
+  Enum value;            /*!< The value named */
+};
+
+namespace details {
+
+/**
+ *  \brief NOT constexpr on purpose: reaching it during constant evaluation
+ *         turns a duplicated StringEnumMap name into a compile error
+ */
+inline void StringEnumMapDuplicateName() {}
+
+}  // namespace details
+
+/**
+ *  \brief Bidirectional map between the names and the values of an enum,
+ *         defined ONCE, usually as a constexpr variable:
+ *  - Name -> value: perfect hash of the names (see details::PerfectHash), ONE
+ *    hash and ONE verifying comparison, either exact (FromString()) or
+ *    ignoring the ASCII case (FromStringIgnoreCase());
+ *  - Value -> name: array indexed by the value when the values are contiguous
+ *    (i.e. the enum default numbering), binary search otherwise;
+ *
+ *  Many names may share the same value (aliases), ToString() then returns the
+ *  FIRST name declared.
+ *
+ *  Example:
+ *  \code
+ *  enum class Level { kDebug, kInfo, kWarning, kError };
+ *
+ *  constexpr auto kLevels = MakeStringEnumMap<Level>({
+ *      {"debug", Level::kDebug},
+ *      {"info", Level::kInfo},
+ *      {"warning", Level::kWarning},
+ *      {"warn", Level::kWarning},
+ *      {"error", Level::kError},
+ *  });
+ *
+ *  kLevels.FromStringIgnoreCase("WARN");  // Level::kWarning
+ *  kLevels.ToString(Level::kWarning);     // "warning"
+ *  \endcode
+ *
+ *  \note Everything is computed at construction: a constexpr map lives in
+ *        read only data, without any static initialisation. Names must be
+ *        distinct (ignoring the ASCII case), otherwise the construction is a
+ *        compile error when constant evaluated.
+ *
+ *  \tparam Enum The enum type
+ *  \tparam N Number of names
+ */
+template <typename Enum, std::size_t N>
+class StringEnumMap {
+  static_assert(std::is_enum_v<Enum>, "StringEnumMap values must be enums.");
+
+  using Underlying = std::underlying_type_t<Enum>;
+
+ public:
+  /// Type of the entries the map is constructed from
+  using Entry = StringEnumEntry<Enum>;
+
+  /// Lookups only read the map (see IsThreadShareable)
+  static constexpr bool is_thread_shareable = true;
+
+  /**
+   *  \brief Construct the map from all \a entries
+   *
+   *  \param[in] entries All names and their values. Names must be distinct,
+   *                     ignoring the ASCII case.
+   */
+  constexpr explicit StringEnumMap(const std::array<Entry, N>& entries)
+      : m_names(NamesOf(entries)) {
+    for (std::size_t i = 0; i < N; ++i) {
+      m_values[i] = entries[i].value;
+    }
+
+    // Distinct values, sorted, keeping the first name declared of each
+    std::array<std::uint32_t, N> order = {};
+    for (std::size_t i = 0; i < N; ++i) {
+      order[i] = static_cast<std::uint32_t>(i);
+    }
+    std::sort(order.begin(), order.end(),
+              [&](std::uint32_t lhs, std::uint32_t rhs) {
+                return (m_values[lhs] != m_values[rhs])
+                           ? (ToUnderlying(m_values[lhs]) <
+                              ToUnderlying(m_values[rhs]))
+                           : (lhs < rhs);
+              });
+
+    for (std::size_t i = 0; i < N; ++i) {
+      if ((m_value_count == 0) or
+          (m_values[m_by_value[m_value_count - 1]] != m_values[order[i]])) {
+        m_by_value[m_value_count++] = order[i];
+      }
+    }
+
+    m_is_dense = (m_value_count != 0) and
+                 (OffsetOf(m_values[m_by_value[m_value_count - 1]]) ==
+                  m_value_count - 1);
+  }
+
+  /// Number of names
+  static constexpr auto size() noexcept -> std::size_t { return N; }
+
+  /**
+   *  \brief Look for the value named \a str
+   *
+   *  \param[in] str The name we are looking for (case sensitive)
+   *
+   *  \return std::optional<Enum> The value named \a str, nullopt if none
+   */
+  constexpr auto FromString(std::string_view str) const noexcept
+      -> std::optional<Enum> {
+    return ValueAt(m_names.Find(str));
+  }
+
+  /**
+   *  \brief Look for the value named \a str, ignoring the ASCII case
+   *
+   *  \param[in] str The name we are looking for
+   *
+   *  \return std::optional<Enum> The value named \a str, nullopt if none
+   */
+  constexpr auto FromStringIgnoreCase(std::string_view str) const noexcept
+      -> std::optional<Enum> {
+    return ValueAt(m_names.IFind(str));
+  }
+
+  /**
+   *  \brief Name of \a value
+   *
+   *  \param[in] value The value we are looking for
+   *
+   *  \return std::string_view The first name declared of \a value, an empty
+   *          view when \a value has no name
+   */
+  constexpr auto ToString(Enum value) const noexcept -> std::string_view {
+    const std::size_t index = IndexOf(value);
+    return (index == npos) ? std::string_view{} : m_names.Keys()[index];
+  }
+
+  /// True when \a value has a name
+  constexpr auto Contains(Enum value) const noexcept -> bool {
+    return IndexOf(value) != npos;
+  }
+
+  /// True when ToString() is a direct array access
+  constexpr auto IsDense() const noexcept -> bool { return m_is_dense; }
+
+ private:
+  static constexpr std::size_t npos = std::string_view::npos;
+
+  static constexpr auto NamesOf(const std::array<Entry, N>& entries)
+      -> std::array<std::string_view, N> {
+    std::array<std::string_view, N> names = {};
+    for (std::size_t i = 0; i < N; ++i) {
+      names[i] = entries[i].name;
+      for (std::size_t j = 0; j < i; ++j) {
+        if (details::IEqualsAscii(names[i], names[j])) {
+          details::StringEnumMapDuplicateName();
+        }
+      }
+    }
+    return names;
+  }
+
+  static constexpr auto ToUnderlying(Enum value) noexcept -> Underlying {
+    return static_cast<Underlying>(value);
+  }
+
+  /// Distance between \a value and the lowest value (wrapping when lower)
+  constexpr auto OffsetOf(Enum value) const noexcept -> std::size_t {
+    using Unsigned = std::make_unsigned_t<Underlying>;
+    return static_cast<std::size_t>(static_cast<Unsigned>(
+        static_cast<Unsigned>(ToUnderlying(value)) -
+        static_cast<Unsigned>(ToUnderlying(m_values[m_by_value[0]]))));
+  }
+
+  /// Index of the first name of \a value, npos if none
+  constexpr auto IndexOf(Enum value) const noexcept -> std::size_t {
+    if (m_is_dense) {
+      const std::size_t offset = OffsetOf(value);
+      return (offset < m_value_count) ? m_by_value[offset] : npos;
+    }
+
+    const auto last = m_by_value.begin() + m_value_count;
+    const auto found = std::lower_bound(
+        m_by_value.begin(), last, value, [&](std::uint32_t index, Enum v) {
+          return ToUnderlying(m_values[index]) < ToUnderlying(v);
+        });
+    return ((found != last) and (m_values[*found] == value)) ? *found : npos;
+  }
+
+  constexpr auto ValueAt(std::size_t index) const noexcept
+      -> std::optional<Enum> {
+    if (index == npos) {
+      return std::nullopt;
+    } else {
+      return m_values[index];
+    }
+  }
+
+  details::PerfectHash<N, true> m_names;
+  std::array<Enum, N> m_values = {};
+  std::array<std::uint32_t, N> m_by_value = {}; /*!< Sorted distinct values */
+  std::size_t m_value_count = 0;
+  bool m_is_dense = false;
+};
+
+/**
+ *  \brief Construct a StringEnumMap, deducing the number of \a entries
+ *
+ *  \code
+ *  constexpr auto kColors = MakeStringEnumMap<Color>({
+ *      {"red", Color::kRed},
+ *      {"green", Color::kGreen},
+ *  });
+ *  \endcode
+ */
+template <typename Enum, std::size_t N>
+constexpr auto MakeStringEnumMap(const StringEnumEntry<Enum> (&entries)[N])
+    -> StringEnumMap<Enum, N> {
+  return StringEnumMap<Enum, N>(std::to_array(entries));
+}
+
+}  // namespace swstr
@@ -1,8 +1,14 @@
 #pragma once
 
+#include <functional>
 #include <optional>
+#include <source_location>
+#include <type_traits>
+#include <utility>
 
 #include "SwitchStr/Matcher.hpp"
+#include "SwitchStr/details/Probe.hpp"
+#include "SwitchStr/details/SwitchResult.hpp"
 
 namespace swstr {
 
@@ -18,36 +24,192 @@ namespace swstr {
 /**
  *  \brief Construct use to perform a Switch of a string
  *
+ *  \note The value of a case is only constructed when the case wins: values
+ *        are forwarded (or built by a factory, or emplaced) and converted to
+ *        ResultType only then. Once a case won, the following matchers are
+ *        never evaluated.
+ *
  *  \tparam ResultType The type used and returned by the switch
  */
 template <typename ResultType>
-struct SwitchStr {
+struct SwitchStr : details::SwitchResult<ResultType> {
   constexpr SwitchStr() = delete;
-  constexpr SwitchStr(std::string_view str) : m_str(str), m_res(std::nullopt){};
+#if SwitchStr_ENABLE_INSTRUMENTATION
+  constexpr SwitchStr(
+      std::string_view str,
+      const std::source_location& location = std::source_location::current())
+      : m_str(str), m_probe("SwitchStr", location){};
+#else
+  constexpr SwitchStr(std::string_view str) : m_str(str){};
+#endif
+
+  /**
+   *  \brief Add a case to the switch
+   *
+   *  Example, reusing what the matcher found instead of looking for it again:
+   *  \code
+   *  SwitchStr<Header>(line)
+   *      .Case(Contains(": "), [&](MatchSpan sep) {
+   *        return Header{sep.Before(line), sep.After(line)};
+   *      })
+   *      .Case(Contains(':'), [](std::string_view sep) { ... })
+   *      .Default(Header{});
+   *  \endcode
+   *
+   *  \param[in] m The matcher of the case
+   *  \param[in] value Either a value convertible to ResultType, or a factory
+   *                   returning it. It is only converted (or invoked) when the
+   *                   case wins. The factory is invoked either:
+   *                   - Without argument;
+   *                   - With the MatchSpan found by the matcher (see Match());
+   *                   - With the chars of the span, as a std::string_view;
+   */
+  template <typename Matcher, typename T = ResultType>
+  constexpr auto Case(Matcher&& m, T&& value) & -> SwitchStr& {
+    if constexpr (IsSpanFactory<T>() or IsSpanViewFactory<T>()) {
+      std::optional<MatchSpan> span;
+      if (not HasResult() and
+          SwitchStr_PROBE(
+              m_probe,
+              (span = Match(std::forward<Matcher>(m), m_str)).has_value())) {
+        if constexpr (IsSpanFactory<T>()) {
+          m_res.emplace(std::invoke(std::forward<T>(value), *span));
+        } else {
+          m_res.emplace(std::invoke(std::forward<T>(value), span->In(m_str)));
+        }
+      }
+    } else if (not HasResult() and
+               SwitchStr_PROBE(m_probe,
+                               IsMatching(std::forward<Matcher>(m), m_str))) {
+      SetResult(std::forward<T>(value));
+    }
+
+    return *this;
+  }
 
-  template <typename T = ResultType>
-  constexpr operator T() const noexcept {
-    static_assert(sizeof(T) == 0, "Missing a Default() switch statement.");
-    return std::move(*m_res);
+  template <typename Matcher, typename T = ResultType>
+  constexpr auto Case(Matcher&& m, T&& value) && -> SwitchStr&& {
+    Case(std::forward<Matcher>(m), std::forward<T>(value));
+    return std::move(*this);
   }
 
+  /**
+   *  \brief Add a case to the switch, whose value is constructed in place from
+   *         \a args when the case wins
+   *
+   *  \param[in] m The matcher of the case
+   *  \param[in] args Arguments forwarded to the ResultType constructor
+   */
+  template <typename Matcher, typename... Args>
+  constexpr auto Emplace(Matcher&& m, Args&&... args) & -> SwitchStr& {
+    if (not HasResult() and
+        SwitchStr_PROBE(m_probe, IsMatching(std::forward<Matcher>(m), m_str))) {
+      m_res.emplace(std::forward<Args>(args)...);
+    }
+
+    return *this;
+  }
+
+  template <typename Matcher, typename... Args>
+  constexpr auto Emplace(Matcher&& m, Args&&... args) && -> SwitchStr&& {
+    Emplace(std::forward<Matcher>(m), std::forward<Args>(args)...);
+    return std::move(*this);
+  }
+
+ private:
+  using Result = details::SwitchResult<ResultType>;
+  using Result::HasResult;
+  using Result::m_res;
+  using Result::SetResult;
+
+  /// True when T is a factory of ResultType, taking the MatchSpan found
   template <typename T>
-  constexpr decltype(auto) Default(T&& val) const noexcept {
-    return m_res.value_or(std::forward<T>(val));
+  static constexpr auto IsSpanFactory() noexcept -> bool {
+    return Result::template IsFactory<T, MatchSpan>() and
+           not Result::template IsFactory<T>();
   }
 
+  /// True when T is a factory of ResultType, taking the chars matched
+  template <typename T>
+  static constexpr auto IsSpanViewFactory() noexcept -> bool {
+    return Result::template IsFactory<T, std::string_view>() and
+           not Result::template IsFactory<T>() and not IsSpanFactory<T>();
+  }
+
+  std::string_view m_str;
+#if SwitchStr_ENABLE_INSTRUMENTATION
+  instrument::details::SwitchProbe m_probe;
+#endif
+};
+
+/**
+ *  \brief Reference mode of SwitchStr, selecting one of many EXISTING objects
+ *
+ *  Nothing is ever copied: the switch only keeps the address of the value of
+ *  the winning case.
+ *
+ *  Example:
+ *  \code
+ *  const Handler& handler = SwitchStr<const Handler&>(cmd)
+ *                             .Case("get", kGetHandler)
+ *                             .Case("set", kSetHandler)
+ *                             .Default(kUnknownHandler);
+ *  \endcode
+ *
+ *  \tparam ResultType The type referenced by the switch
+ */
+template <typename ResultType>
+struct SwitchStr<ResultType&> {
+  constexpr SwitchStr() = delete;
+#if SwitchStr_ENABLE_INSTRUMENTATION
+  constexpr SwitchStr(
+      std::string_view str,
+      const std::source_location& location = std::source_location::current())
+      : m_str(str), m_res(nullptr), m_probe("SwitchStr", location){};
+#else
+  constexpr SwitchStr(std::string_view str) : m_str(str), m_res(nullptr){};
+#endif
+
+  constexpr auto Default(ResultType& val) const noexcept -> ResultType& {
+    return (m_res == nullptr) ? val : *m_res;
+  }
+
+  /// Temporaries are not allowed, they would dangle
+  constexpr auto Default(ResultType&& val) const noexcept
+      -> ResultType& = delete;
+
+  /**
+   *  \brief Add a case to the switch
+   *
+   *  \param[in] m The matcher of the case
+   *  \param[in] value The object referenced when the case wins
+   */
   template <typename Matcher>
-  constexpr SwitchStr& Case(Matcher&& m, ResultType value) {
-    if (not m_res.has_value() and IsMatching(std::forward<Matcher>(m), m_str)) {
-      m_res = std::move(value);
+  constexpr auto Case(Matcher&& m, ResultType& value) & -> SwitchStr& {
+    if ((m_res == nullptr) and
+        SwitchStr_PROBE(m_probe, IsMatching(std::forward<Matcher>(m), m_str))) {
+      m_res = &value;
     }
 
     return *this;
   }
 
+  template <typename Matcher>
+  constexpr auto Case(Matcher&& m, ResultType& value) && -> SwitchStr&& {
+    Case(std::forward<Matcher>(m), value);
+    return std::move(*this);
+  }
+
+  /// Temporaries are not allowed, they would dangle
+  template <typename Matcher>
+  auto Case(Matcher&& m, ResultType&& value) -> SwitchStr& = delete;
+
  private:
   std::string_view m_str;
-  std::optional<ResultType> m_res;
+  ResultType* m_res;
+#if SwitchStr_ENABLE_INSTRUMENTATION
+  instrument::details::SwitchProbe m_probe;
+#endif
 };
 
 }  // namespace swstr
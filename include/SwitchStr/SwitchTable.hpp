@@ -0,0 +1,425 @@
+#pragma once
+
+#include <algorithm>
+#include <array>
+#include <bit>
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <span>
+#include <string>
+#include <string_view>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+#include "SwitchStr/Matcher.hpp"
+#include "SwitchStr/TrieSwitch.hpp"
+#include "SwitchStr/details/CaseList.hpp"
+#include "SwitchStr/details/PerfectHash.hpp"
+
+namespace swstr {
+
+namespace details {
+
+/**
+ *  \brief Open addressing (linear probing) hash table, mapping exact keys to
+ *         the index of their case
+ *
+ *  Keys are copied into a single contiguous buffer. Each slot stores the
+ *  location of its key, its case index and 32 bits of its hash, use to skip
+ *  most of the string comparisons while probing.
+ *
+ *  \note Like PerfectHash, the cheap QuickHashStr is used unless it collides
+ *        on the keys (i.e. keys sharing their length and first/last 8 bytes),
+ *        in which case the full HashStr is used
+ */
+class CaseHashTable {
+ public:
+  /// Case index used when there is no case
+  static constexpr std::uint32_t kNoCase = CaseTrie::kNoCase;
+
+  CaseHashTable() = default;
+
+  /**
+   *  \brief Build the table such that keys[i] is the key of the case i
+   *
+   *  \note When the same key is found multiple time, the lowest case index is
+   *        kept
+   *
+   *  \param[in] keys All keys, ordered by case index
+   */
+  template <typename Keys>
+  explicit CaseHashTable(const Keys& keys) {
+    m_quick = AreQuickHashesDistinct(keys);
+    m_slots.resize(std::bit_ceil(std::max<std::size_t>(2 * keys.size(), 8)));
+    m_mask = m_slots.size() - 1;
+
+    for (std::size_t i = 0; i < keys.size(); ++i) {
+      const std::string_view key = keys[i];
+      const std::uint64_t h = Hash(key);
+
+      for (std::size_t slot = h & m_mask;; slot = (slot + 1) & m_mask) {
+        Slot& current = m_slots[slot];
+        if (current.case_index == kNoCase) {
+          current.offset = static_cast<std::uint32_t>(m_bytes.size());
+          current.size = static_cast<std::uint32_t>(key.size());
+          current.case_index = static_cast<std::uint32_t>(i);
+          current.tag = static_cast<std::uint32_t>(h >> 32);
+          m_bytes.append(key);
+          break;
+        } else if (IsKeyOf(current, key, h)) {
+          break;
+        }
+      }
+    }
+  }
+
+  /**
+   *  \brief Look for the case whose key is \a str
+   *
+   *  \return std::uint32_t The case index of \a str, kNoCase if none
+   */
+  auto Find(std::string_view str) const noexcept -> std::uint32_t {
+    return Probe(str, Hash(str));
+  }
+
+  /**
+   *  \brief Batch version of Find(), calling on_result(i, case_index) with the
+   *         result of each strs[i]
+   *
+   *  \note The strings are hashed by blocks, prefetching their first slot,
+   *        before probing the table, such that the cache misses of a block
+   *        overlap
+   */
+  template <typename OnResult>
+  void FindEach(std::span<const std::string_view> strs,
+                OnResult&& on_result) const {
+    constexpr std::size_t kBlock = 16;
+    std::array<std::uint64_t, kBlock> hashes;
+
+    for (std::size_t begin = 0; begin < strs.size(); begin += kBlock) {
+      const std::size_t end = std::min(begin + kBlock, strs.size());
+
+      for (std::size_t i = begin; i < end; ++i) {
+        hashes[i - begin] = Hash(strs[i]);
+        cpu::Prefetch(&m_slots[hashes[i - begin] & m_mask]);
+      }
+
+      for (std::size_t i = begin; i < end; ++i) {
+        on_result(i, Probe(strs[i], hashes[i - begin]));
+      }
+    }
+  }
+
+ private:
+  struct Slot {
+    std::uint32_t offset = 0;           /*!< Start of the key in m_bytes */
+    std::uint32_t size = 0;             /*!< Size of the key */
+    std::uint32_t case_index = kNoCase; /*!< kNoCase when the slot is free */
+    std::uint32_t tag = 0;              /*!< High bits of the key hash */
+  };
+
+  template <typename Keys>
+  static auto AreQuickHashesDistinct(const Keys& keys) -> bool {
+    std::vector<std::pair<std::uint64_t, std::string_view>> hashes;
+    hashes.reserve(keys.size());
+    for (const std::string_view key : keys) {
+      hashes.emplace_back(QuickHashStr(key), key);
+    }
+
+    std::sort(hashes.begin(), hashes.end());
+    return std::adjacent_find(hashes.begin(), hashes.end(),
+                              [](const auto& lhs, const auto& rhs) {
+                                return (lhs.first == rhs.first) and
+                                       (lhs.second != rhs.second);
+                              }) == hashes.end();
+  }
+
+  auto Probe(std::string_view str, std::uint64_t h) const noexcept
+      -> std::uint32_t {
+    for (std::size_t slot = h & m_mask;; slot = (slot + 1) & m_mask) {
+      const Slot& current = m_slots[slot];
+      if ((current.case_index == kNoCase) or IsKeyOf(current, str, h)) {
+        return current.case_index;
+      }
+    }
+  }
+
+  auto Hash(std::string_view str) const noexcept -> std::uint64_t {
+    return m_quick ? QuickHashStr(str) : MixHash(HashStr(str));
+  }
+
+  auto IsKeyOf(const Slot& slot, std::string_view str,
+               std::uint64_t h) const noexcept -> bool {
+    return (slot.tag == static_cast<std::uint32_t>(h >> 32)) and
+           (slot.size == str.size()) and
+           EqualBytes(m_bytes.data() + slot.offset, str.data(), str.size());
+  }
+
+  bool m_quick = true;
+  std::size_t m_mask = 0;
+  std::vector<Slot> m_slots = std::vector<Slot>(1);
+  std::string m_bytes; /*!< All keys, contiguous */
+};
+
+}  // namespace details
+
+/**
+ *  \brief Immutable switch, built once from (matcher, value) cases, then
+ *         looked up any number of times
+ *
+ *  Depending on the kind of matchers it is built with, the table selects one
+ *  lookup strategy:
+ *  - Linear: a handful of cases, or only opaque matchers, evaluated in
+ *    declaration order;
+ *  - Hash: only exact cases (Equals and string like matchers), found with a
+ *    single hash table probe;
+ *  - Trie: Equals/StartsWith/EndsWith cases merged into tries (like
+ *    TrieSwitch), opaque matchers being evaluated only when declared before
+ *    the best trie match;
+ *
+ *  All patterns are copied into the table (they don't need to outlive it)
+ *  and all values/cases are stored contiguously.
+ *
+ *  \note Lookup() never modifies the table. It is thread shareable (see
+ *        IsThreadShareable) when its opaque matchers are erased into an
+ *        AnyShareableMatcher, only accepting thread shareable matchers:
+ *        SwitchTable<int, AnyShareableMatcher>
+ *
+ *  Example:
+ *  \code
+ *  const auto table = SwitchTable<int>::Builder()
+ *                         .Case(Equals("GET"), 0)
+ *                         .Case(Equals("POST"), 1)
+ *                         ...
+ *                         .Build();
+ *  table.LookupOr(method, -1);
+ *  \endcode
+ *
+ *  \tparam ResultType The type of values returned by the switch
+ *  \tparam ErasedMatcher The type erased matcher storing the opaque matchers
+ */
+template <typename ResultType, typename ErasedMatcher = AnyMatcher>
+class SwitchTable {
+  using Kind = details::CaseKind;
+  using CaseEntry = details::CaseEntry;
+
+ public:
+  /// Shareable when the opaque matchers are
+  static constexpr bool is_thread_shareable =
+      IsThreadShareable_v<ErasedMatcher>;
+
+  /// Lookup strategy selected by the table
+  enum class Strategy { kLinear, kHash, kTrie };
+
+  /// Index returned when no case matches
+  static constexpr std::size_t npos = std::numeric_limits<std::size_t>::max();
+
+  /// Up to this number of cases, the Linear strategy is always used
+  static constexpr std::size_t kLinearMaxCases = 4;
+
+  /**
+   *  \brief Builder of the SwitchTable, gathering its cases
+   */
+  class Builder {
+   public:
+    Builder() = default;
+
+    /**
+     *  \brief Add a case to the table
+     *
+     *  \param[in] m The matcher of the case
+     *  \param[in] value The value returned when the case wins
+     */
+    template <typename Matcher, typename T = ResultType>
+    auto Case(Matcher&& m, T&& value) & -> Builder& {
+      m_cases.Add(std::forward<Matcher>(m));
+      m_values.emplace_back(std::forward<T>(value));
+      return *this;
+    }
+
+    template <typename Matcher, typename T = ResultType>
+    auto Case(Matcher&& m, T&& value) && -> Builder&& {
+      Case(std::forward<Matcher>(m), std::forward<T>(value));
+      return std::move(*this);
+    }
+
+    /// Build the table, leaving the builder empty
+    auto Build() && -> SwitchTable { return SwitchTable(std::move(*this)); }
+
+    /// Build the table, keeping the builder untouched
+    auto Build() const& -> SwitchTable { return SwitchTable(Builder(*this)); }
+
+   private:
+    friend class SwitchTable;
+
+    details::CaseList<ErasedMatcher> m_cases;
+    std::vector<ResultType> m_values;
+  };
+
+  /// Strategy used by Lookup()
+  auto GetStrategy() const noexcept -> Strategy { return m_strategy; }
+
+  /// Number of cases
+  auto Size() const noexcept -> std::size_t { return m_values.size(); }
+
+  /**
+   *  \brief Index of the first case matching \a str
+   *
+   *  \param[in] str The string to switch on
+   *
+   *  \return std::size_t The index of the winning case (in declaration order),
+   *          npos if none
+   */
+  auto IndexOf(std::string_view str) const -> std::size_t {
+    std::uint32_t best = details::CaseTrie::kNoCase;
+
+    switch (m_strategy) {
+      case Strategy::kLinear:
+        for (std::size_t i = 0; i < m_cases.Size(); ++i) {
+          if (m_cases.IsMatching(m_cases[i], str)) {
+            best = static_cast<std::uint32_t>(i);
+            break;
+          }
+        }
+        break;
+
+      case Strategy::kHash:
+        best = m_hash.Find(str);
+        break;
+
+      case Strategy::kTrie:
+        best = m_prefixes.Walk(str);
+        best = std::min(best, m_suffixes.Walk(str, best));
+        for (const std::uint32_t index : m_opaque_cases) {
+          if (index >= best) break;
+          if (m_cases.IsMatching(m_cases[index], str)) {
+            best = index;
+            break;
+          }
+        }
+        break;
+    }
+
+    return ToIndex(best);
+  }
+
+  /**
+   *  \brief Batch version of IndexOf(), out[i] = IndexOf(strs[i])
+   *
+   *  \pre out.size() >= strs.size()
+   */
+  void IndexOf(std::span<const std::string_view> strs,
+               std::span<std::size_t> out) const {
+    if (m_strategy == Strategy::kHash) {
+      m_hash.FindEach(strs, [&](std::size_t i, std::uint32_t case_index) {
+        out[i] = ToIndex(case_index);
+      });
+    } else {
+      for (std::size_t i = 0; i < strs.size(); ++i) {
+        out[i] = IndexOf(strs[i]);
+      }
+    }
+  }
+
+  /// Value of the case \a index
+  auto ValueAt(std::size_t index) const -> const ResultType& {
+    return m_values[index];
+  }
+
+  /**
+   *  \brief Look for the value of the first case matching \a str
+   *
+   *  \param[in] str The string to switch on
+   *
+   *  \return const ResultType* The value of the winning case, nullptr if none
+   */
+  auto Lookup(std::string_view str) const -> const ResultType* {
+    const std::size_t index = IndexOf(str);
+    return (index == npos) ? nullptr : &m_values[index];
+  }
+
+  /**
+   *  \brief Look for the value of the first case matching \a str, or
+   *         \a default_value
+   *
+   *  \param[in] str The string to switch on
+   *  \param[in] default_value Value returned when no case matches
+   *
+   *  \return ResultType The value of the winning case, \a default_value if
+   *          none
+   */
+  template <typename T>
+  auto LookupOr(std::string_view str, T&& default_value) const -> ResultType {
+    const ResultType* const value = Lookup(str);
+    if (value == nullptr) {
+      return ResultType(std::forward<T>(default_value));
+    } else {
+      return *value;
+    }
+  }
+
+ private:
+  explicit SwitchTable(Builder&& builder)
+      : m_cases(std::move(builder.m_cases)),
+        m_values(std::move(builder.m_values)) {
+    const auto count_of = [this](Kind kind) {
+      return std::count_if(
+          m_cases.begin(), m_cases.end(),
+          [kind](const CaseEntry& entry) { return entry.kind == kind; });
+    };
+
+    const auto cases = static_cast<std::ptrdiff_t>(m_cases.Size());
+    if ((m_cases.Size() <= kLinearMaxCases) or
+        (count_of(Kind::kOpaque) == cases)) {
+      m_strategy = Strategy::kLinear;
+    } else if (count_of(Kind::kEquals) == cases) {
+      m_strategy = Strategy::kHash;
+
+      std::vector<std::string_view> keys;
+      keys.reserve(m_cases.Size());
+      for (const CaseEntry& entry : m_cases) {
+        keys.push_back(m_cases.PatternOf(entry));
+      }
+      m_hash = details::CaseHashTable(keys);
+    } else {
+      m_strategy = Strategy::kTrie;
+
+      for (std::size_t i = 0; i < m_cases.Size(); ++i) {
+        const CaseEntry& entry = m_cases[i];
+        const auto index = static_cast<std::uint32_t>(i);
+        switch (entry.kind) {
+          case Kind::kEquals:
+            m_prefixes.Insert(m_cases.PatternOf(entry), index, true);
+            break;
+          case Kind::kStartsWith:
+            m_prefixes.Insert(m_cases.PatternOf(entry), index, false);
+            break;
+          case Kind::kEndsWith:
+            m_suffixes.Insert(m_cases.PatternOf(entry), index, false);
+            break;
+          case Kind::kOpaque:
+            m_opaque_cases.push_back(index);
+            break;
+        }
+      }
+    }
+  }
+
+  static constexpr auto ToIndex(std::uint32_t case_index) noexcept
+      -> std::size_t {
+    return (case_index == details::CaseTrie::kNoCase) ? npos : case_index;
+  }
+
+  Strategy m_strategy = Strategy::kLinear;
+  details::CaseList<ErasedMatcher> m_cases; /*!< In declaration order */
+  std::vector<ResultType> m_values; /*!< Values, indexed by case index */
+
+  details::CaseHashTable m_hash; /*!< Strategy::kHash only */
+  details::CaseTrie m_prefixes = details::CaseTrie(false); /*!< kTrie only */
+  details::CaseTrie m_suffixes = details::CaseTrie(true);  /*!< kTrie only */
+  std::vector<std::uint32_t> m_opaque_cases;               /*!< kTrie only */
+};
+
+}  // namespace swstr
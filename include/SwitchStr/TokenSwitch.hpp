@@ -0,0 +1,172 @@
+#pragma once
+
+#include <algorithm>
+#include <functional>
+#include <source_location>
+#include <string_view>
+#include <utility>
+
+#include "SwitchStr/Matcher.hpp"
+#include "SwitchStr/details/ByteSet.hpp"
+#include "SwitchStr/details/Probe.hpp"
+#include "SwitchStr/details/SwitchResult.hpp"
+
+namespace swstr {
+
+namespace details {
+
+/// A token and what follows it (see SplitToken())
+struct TokenSplit {
+  std::string_view token; /*!< The first token */
+  std::string_view rest;  /*!< What follows, without the leading delimiters */
+};
+
+/**
+ *  \brief Split \a str on its FIRST token, delimited by one (or many) of the
+ *         \a delimiters
+ *
+ *  \note Delimiters around the token are skipped, such that " get  key "
+ *        splits into "get" and "key ". The token end is found using the
+ *        ByteSet SIMD kernels, the delimiters runs are expected to be short.
+ *
+ *  \param[in] str The string to split
+ *  \param[in] delimiters The set of delimiters
+ *
+ *  \return TokenSplit Views on \a str, nothing is copied
+ */
+constexpr auto SplitToken(std::string_view str,
+                          const ByteSet& delimiters) noexcept -> TokenSplit {
+  std::size_t begin = 0;
+  while ((begin < str.size()) and delimiters.Contains(str[begin])) {
+    ++begin;
+  }
+  str.remove_prefix(begin);
+
+  const std::size_t end = std::min(delimiters.FindFirst(str), str.size());
+
+  std::size_t rest = end;
+  while ((rest < str.size()) and delimiters.Contains(str[rest])) {
+    ++rest;
+  }
+
+  return {str.substr(0, end), str.substr(rest)};
+}
+
+}  // namespace details
+
+/**
+ *  \brief Switch on the FIRST token of a string, handing what follows the
+ *         token to the case winning
+ *
+ *  The string is split once, at construction, then each case matcher is
+ *  evaluated against the token only. Both the token and the rest are views on
+ *  the input: nothing is copied, and the rest is never scanned again.
+ *
+ *  Commands trees (i.e. "git remote add <name> <url>") are dispatched by
+ *  nesting switches on the rest, each level starting where the previous one
+ *  stopped:
+ *  \code
+ *  const int res =
+ *      TokenSwitch<int>(line)
+ *          .Case("status", [](std::string_view args) { return Status(args); })
+ *          .Case("remote",
+ *                [](std::string_view args) {
+ *                  return TokenSwitch<int>(args)
+ *                      .Case("add", RemoteAdd)
+ *                      .Case("remove", RemoteRemove)
+ *                      .Default(kUnknownRemoteCommand);
+ *                })
+ *          .Default(kUnknownCommand);
+ *  \endcode
+ *
+ *  \note Same as SwitchStr, the value of a case is only constructed when the
+ *        case wins, and the following matchers are never evaluated
+ *
+ *  \tparam ResultType The type used and returned by the switch
+ */
+template <typename ResultType>
+class TokenSwitch : public details::SwitchResult<ResultType> {
+ public:
+  /// Delimiters used by default: spaces and tabs
+  static constexpr std::string_view kBlanks = " \t";
+
+  constexpr TokenSwitch() = delete;
+
+  /**
+   *  \brief Construct the switch, splitting \a str on its first token
+   *
+   *  \param[in] str The string to switch on
+   *  \param[in] delimiters All chars delimiting the tokens
+   */
+#if SwitchStr_ENABLE_INSTRUMENTATION
+  constexpr TokenSwitch(
+      std::string_view str, std::string_view delimiters = kBlanks,
+      const std::source_location& location = std::source_location::current())
+      : m_split(details::SplitToken(str, details::ByteSet(delimiters))),
+        m_probe("TokenSwitch", location) {}
+#else
+  constexpr TokenSwitch(std::string_view str,
+                        std::string_view delimiters = kBlanks)
+      : m_split(details::SplitToken(str, details::ByteSet(delimiters))) {}
+#endif
+
+  /// The token switched on
+  constexpr auto Token() const noexcept -> std::string_view {
+    return m_split.token;
+  }
+
+  /// What follows the token, without the leading delimiters
+  constexpr auto Rest() const noexcept -> std::string_view {
+    return m_split.rest;
+  }
+
+  /**
+   *  \brief Add a case to the switch, matching the token
+   *
+   *  \param[in] m The matcher of the token
+   *  \param[in] value Either a value convertible to ResultType, or a factory
+   *                   returning it, invoked either without argument or with
+   *                   the rest of the string. It is only converted (or
+   *                   invoked) when the case wins.
+   */
+  template <typename Matcher, typename T = ResultType>
+  constexpr auto Case(Matcher&& m, T&& value) & -> TokenSwitch& {
+    if (not HasResult() and
+        SwitchStr_PROBE(m_probe,
+                        IsMatching(std::forward<Matcher>(m), m_split.token))) {
+      if constexpr (IsRestFactory<T>()) {
+        m_res.emplace(std::invoke(std::forward<T>(value), m_split.rest));
+      } else {
+        SetResult(std::forward<T>(value));
+      }
+    }
+
+    return *this;
+  }
+
+  template <typename Matcher, typename T = ResultType>
+  constexpr auto Case(Matcher&& m, T&& value) && -> TokenSwitch&& {
+    Case(std::forward<Matcher>(m), std::forward<T>(value));
+    return std::move(*this);
+  }
+
+ private:
+  using Result = details::SwitchResult<ResultType>;
+  using Result::HasResult;
+  using Result::m_res;
+  using Result::SetResult;
+
+  /// True when T is a factory of ResultType, taking the rest of the string
+  template <typename T>
+  static constexpr auto IsRestFactory() noexcept -> bool {
+    return Result::template IsFactory<T, std::string_view>() and
+           not Result::template IsFactory<T>();
+  }
+
+  details::TokenSplit m_split;
+#if SwitchStr_ENABLE_INSTRUMENTATION
+  instrument::details::SwitchProbe m_probe;
+#endif
+};
+
+}  // namespace swstr
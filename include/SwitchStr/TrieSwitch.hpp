@@ -0,0 +1,299 @@
+#pragma once
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <string_view>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+#include "SwitchStr/Matcher.hpp"
+
+namespace swstr {
+
+namespace details {
+
+/**
+ *  \brief Byte trie whose nodes are tagged with the index of the cases
+ *         ending on them
+ *
+ *  Each key inserted is either:
+ *  - EXACT: the case matches when the whole string has been consumed;
+ *  - PARTIAL: the case matches as soon as the key has been consumed;
+ *
+ *  Walking a string returns the LOWEST case index matching it, such that
+ *  the first declared case always wins.
+ *
+ *  \note When Reversed, keys and strings are walked from their end, turning
+ *        PARTIAL keys into suffixes
+ */
+class CaseTrie {
+ public:
+  /// Case index used when there is no case
+  static constexpr std::uint32_t kNoCase =
+      std::numeric_limits<std::uint32_t>::max();
+
+  /**
+   *  \brief Construct an empty trie
+   *
+   *  \param[in] reversed When true, keys and strings are walked from the end
+   */
+  explicit CaseTrie(bool reversed = false)
+      : m_reversed(reversed), m_nodes(1) {}
+
+  /// True when the trie doesn't contain any key
+  auto IsEmpty() const noexcept -> bool {
+    return m_nodes.front().subtree_case == kNoCase;
+  }
+
+  /**
+   *  \brief Insert \a key, associated to \a case_index
+   *
+   *  \note When the same key is inserted multiple time, the lowest case index
+   *        is kept
+   *
+   *  \param[in] key The key to insert
+   *  \param[in] case_index The index of the case associated to \a key
+   *  \param[in] exact True when the case matches only when the key is the
+   *                   whole string, false when it's only a prefix (suffix)
+   */
+  void Insert(std::string_view key, std::uint32_t case_index, bool exact) {
+    std::uint32_t node = 0;
+    KeepLowest(m_nodes[node].subtree_case, case_index);
+
+    for (std::size_t i = 0; i < key.size(); ++i) {
+      node = FindOrAddChild(node, ByteAt(key, i));
+      KeepLowest(m_nodes[node].subtree_case, case_index);
+    }
+
+    KeepLowest(exact ? m_nodes[node].exact_case : m_nodes[node].partial_case,
+               case_index);
+  }
+
+  /**
+   *  \brief Walk \a str and return the lowest case index matching it
+   *
+   *  \param[in] str The string to walk
+   *  \param[in] bound Only cases with an index strictly lower than \a bound
+   *                   are considered (use to stop the walk early)
+   *
+   *  \return std::uint32_t The lowest case index matching \a str, lower than
+   *          \a bound, kNoCase if none
+   */
+  auto Walk(std::string_view str, std::uint32_t bound = kNoCase) const noexcept
+      -> std::uint32_t {
+    std::uint32_t best = bound;
+    std::uint32_t node = 0;
+
+    for (std::size_t i = 0;; ++i) {
+      const Node& current = m_nodes[node];
+      if (current.subtree_case >= best) break;
+
+      KeepLowest(best, current.partial_case);
+
+      if (i == str.size()) {
+        KeepLowest(best, current.exact_case);
+        break;
+      }
+
+      node = FindChild(node, ByteAt(str, i));
+      if (node == kNoNode) break;
+    }
+
+    return (best == bound) ? kNoCase : best;
+  }
+
+ private:
+  static constexpr std::uint32_t kNoNode =
+      std::numeric_limits<std::uint32_t>::max();
+
+  /// Node of the trie, children are stored as a sorted, singly linked list
+  struct Node {
+    std::uint32_t first_child = kNoNode;
+    std::uint32_t next_sibling = kNoNode;
+    std::uint32_t partial_case = kNoCase; /*!< Prefix/Suffix ending here */
+    std::uint32_t exact_case = kNoCase;   /*!< Equals ending here */
+    std::uint32_t subtree_case = kNoCase; /*!< Lowest case of the subtree */
+    unsigned char byte = 0;               /*!< Byte of the edge to this node */
+  };
+
+  static constexpr void KeepLowest(std::uint32_t& current,
+                                   std::uint32_t candidate) noexcept {
+    if (candidate < current) current = candidate;
+  }
+
+  auto ByteAt(std::string_view str, std::size_t i) const noexcept
+      -> unsigned char {
+    return static_cast<unsigned char>(
+        m_reversed ? str[str.size() - 1 - i] : str[i]);
+  }
+
+  auto FindChild(std::uint32_t node, unsigned char byte) const noexcept
+      -> std::uint32_t {
+    std::uint32_t child = m_nodes[node].first_child;
+    while ((child != kNoNode) and (m_nodes[child].byte < byte)) {
+      child = m_nodes[child].next_sibling;
+    }
+
+    if ((child != kNoNode) and (m_nodes[child].byte == byte)) {
+      return child;
+    } else {
+      return kNoNode;
+    }
+  }
+
+  auto FindOrAddChild(std::uint32_t node, unsigned char byte)
+      -> std::uint32_t {
+    std::uint32_t previous = kNoNode;
+    std::uint32_t child = m_nodes[node].first_child;
+    while ((child != kNoNode) and (m_nodes[child].byte < byte)) {
+      previous = child;
+      child = m_nodes[child].next_sibling;
+    }
+
+    if ((child != kNoNode) and (m_nodes[child].byte == byte)) {
+      return child;
+    }
+
+    const auto added = static_cast<std::uint32_t>(m_nodes.size());
+    Node new_node;
+    new_node.next_sibling = child;
+    new_node.byte = byte;
+    m_nodes.push_back(new_node);
+
+    if (previous == kNoNode) {
+      m_nodes[node].first_child = added;
+    } else {
+      m_nodes[previous].next_sibling = added;
+    }
+
+    return added;
+  }
+
+  bool m_reversed;
+  std::vector<Node> m_nodes; /*!< All nodes, the root being the first one */
+};
+
+}  // namespace details
+
+/**
+ *  \brief Switch engine merging the built-in Equals/StartsWith/EndsWith cases
+ *         into tries, walked once per lookup
+ *
+ *  Contrary to SwitchStr, which is a one-shot builder evaluating each case in
+ *  turn, the TrieSwitch is first built with all its cases, then used to
+ *  lookup any number of strings:
+ *  - Equals/StartsWith cases (and string like matchers) are merged into one
+ *    prefix trie;
+ *  - EndsWith cases are merged into one suffix trie;
+ *  - Any other matcher (opaque) is kept, type erased, in declaration order;
+ *
+ *  A lookup walks both tries ONCE, then evaluates, in order, only the opaque
+ *  cases declared before the best trie match (if any). The first declared
+ *  case matching always wins, like SwitchStr.
+ *
+ *  Example:
+ *  \code
+ *  const auto routes = TrieSwitch<int>()
+ *                        .Case(StartsWith("/api/"), 0)
+ *                        .Case(Equals("/"), 1)
+ *                        .Case(EndsWith(".html"), 2);
+ *  routes.LookupOr(path, 42);
+ *  \endcode
+ *
+ *  \tparam ResultType The type of values returned by the switch
+ */
+template <typename ResultType>
+class TrieSwitch {
+ public:
+  TrieSwitch() = default;
+
+  /**
+   *  \brief Add a case to the switch
+   *
+   *  \param[in] m The matcher of the case
+   *  \param[in] value The value returned when the case wins
+   */
+  template <typename Matcher>
+  auto Case(Matcher&& m, ResultType value) & -> TrieSwitch& {
+    using M = std::remove_cvref_t<Matcher>;
+    MatcherTraits<M>::StaticAssertIfInvalid();
+
+    const auto index = static_cast<std::uint32_t>(m_values.size());
+    m_values.push_back(std::move(value));
+
+    if constexpr (details::IsEqualsMatcher_v<M>) {
+      m_prefixes.Insert(m.Pattern(), index, true);
+    } else if constexpr (details::IsStartsWithMatcher_v<M>) {
+      m_prefixes.Insert(m.Pattern(), index, false);
+    } else if constexpr (details::IsEndsWithMatcher_v<M>) {
+      m_suffixes.Insert(m.Pattern(), index, false);
+    } else if constexpr (MatcherTraits<M>::is_convertible and
+                         not MatcherTraits<M>::has_IsMatching and
+                         not MatcherTraits<M>::has_Operator) {
+      m_prefixes.Insert(std::string_view{m}, index, true);
+    } else {
+      m_opaques.emplace_back(index, AnyMatcher(std::forward<Matcher>(m)));
+    }
+
+    return *this;
+  }
+
+  template <typename Matcher>
+  auto Case(Matcher&& m, ResultType value) && -> TrieSwitch&& {
+    Case(std::forward<Matcher>(m), std::move(value));
+    return std::move(*this);
+  }
+
+  /**
+   *  \brief Look for the value of the first case matching \a str
+   *
+   *  \param[in] str The string to switch on
+   *
+   *  \return const ResultType* The value of the winning case, nullptr if none
+   */
+  auto Lookup(std::string_view str) const -> const ResultType* {
+    std::uint32_t best = m_prefixes.Walk(str);
+    best = std::min(best, m_suffixes.Walk(str, best));
+
+    for (const auto& [index, matcher] : m_opaques) {
+      if (index >= best) break;
+      if (matcher.IsMatching(str)) {
+        best = index;
+        break;
+      }
+    }
+
+    return (best == details::CaseTrie::kNoCase) ? nullptr : &m_values[best];
+  }
+
+  /**
+   *  \brief Look for the value of the first case matching \a str, or
+   *         \a default_value
+   *
+   *  \param[in] str The string to switch on
+   *  \param[in] default_value Value returned when no case matches
+   *
+   *  \return ResultType The value of the winning case, \a default_value if
+   *          none
+   */
+  template <typename T>
+  auto LookupOr(std::string_view str, T&& default_value) const -> ResultType {
+    const ResultType* const value = Lookup(str);
+    if (value == nullptr) {
+      return ResultType(std::forward<T>(default_value));
+    } else {
+      return *value;
+    }
+  }
+
+ private:
+  details::CaseTrie m_prefixes = details::CaseTrie(false);
+  details::CaseTrie m_suffixes = details::CaseTrie(true);
+  std::vector<std::pair<std::uint32_t, AnyMatcher>> m_opaques;
+  std::vector<ResultType> m_values; /*!< Values, indexed by case index */
+};
+
+}  // namespace swstr
@@ -0,0 +1,179 @@
+#pragma once
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <string_view>
+#include <vector>
+
+namespace swstr::details {
+
+/**
+ *  \brief Aho-Corasick automaton, looking for many needles at once
+ *
+ *  The automaton is a complete DFA (failure links are resolved at
+ *  construction), such that a scan costs exactly one table read per byte of
+ *  the string.
+ *
+ *  In order to keep the transition table small (cache friendly), bytes are
+ *  first mapped to equivalence classes: all bytes not appearing in any needle
+ *  share the same class. The table then has (states x classes) entries,
+ *  instead of (states x 256).
+ */
+class AhoCorasick {
+ public:
+  /// Result of a Find(), where/which are npos when nothing is found
+  struct Hit {
+    std::size_t where = std::string_view::npos; /*!< Start of the needle */
+    std::size_t which = std::string_view::npos; /*!< Index of the needle */
+  };
+
+  /**
+   *  \brief Build the automaton over all \a needles
+   *
+   *  \note Needles are copied inside the automaton, they don't need to outlive
+   *        it
+   *
+   *  \param[in] needles All needles we are looking for
+   */
+  template <typename Needles>
+  explicit AhoCorasick(const Needles& needles) {
+    m_class_of.fill(0);
+    for (const std::string_view needle : needles) {
+      for (const char c : needle) {
+        auto& cls = m_class_of[static_cast<unsigned char>(c)];
+        if (cls == 0) cls = static_cast<std::uint16_t>(++m_classes);
+      }
+    }
+    ++m_classes;  // Class 0, for all bytes not found in the needles
+
+    // 1. Build the trie, with kNoState for missing transitions
+    m_delta.assign(m_classes, kNoState);
+    m_output.assign(1, kNoNeedle);
+
+    for (const std::string_view needle : needles) {
+      std::uint32_t state = 0;
+      for (const char c : needle) {
+        std::uint32_t& next = At(state, ClassOf(c));
+        if (next == kNoState) {
+          next = static_cast<std::uint32_t>(m_output.size());
+          m_output.push_back(kNoNeedle);
+          m_delta.resize(m_delta.size() + m_classes, kNoState);
+        }
+        state = At(state, ClassOf(c));
+      }
+
+      const auto which = static_cast<std::uint32_t>(m_lengths.size());
+      if (m_output[state] == kNoNeedle) m_output[state] = which;
+      m_lengths.push_back(needle.size());
+    }
+
+    // 2. Resolve failure links in BFS order, completing the DFA
+    std::vector<std::uint32_t> fail(m_output.size(), 0);
+    std::vector<std::uint32_t> queue;
+    queue.reserve(m_output.size());
+
+    for (std::uint32_t cls = 0; cls < m_classes; ++cls) {
+      std::uint32_t& next = At(0, cls);
+      if (next == kNoState) {
+        next = 0;
+      } else {
+        queue.push_back(next);
+      }
+    }
+
+    for (std::size_t i = 0; i < queue.size(); ++i) {
+      const std::uint32_t state = queue[i];
+
+      // Output is the first declared needle among the ones ending here
+      if (m_output[fail[state]] < m_output[state]) {
+        m_output[state] = m_output[fail[state]];
+      }
+
+      for (std::uint32_t cls = 0; cls < m_classes; ++cls) {
+        std::uint32_t& next = At(state, cls);
+        if (next == kNoState) {
+          next = At(fail[state], cls);
+        } else {
+          fail[next] = At(fail[state], cls);
+          queue.push_back(next);
+        }
+      }
+    }
+
+    // 3. Store transitions as row offsets (no multiplication while
+    //    scanning), flagging the ones leading to an output state, such that
+    //    the scan doesn't need to read m_output on every byte
+    for (std::uint32_t& next : m_delta) {
+      const bool has_output = (m_output[next] != kNoNeedle);
+      next *= m_classes;
+      if (has_output) next |= kOutputFlag;
+    }
+  }
+
+  /// Number of states of the automaton
+  auto States() const noexcept -> std::size_t { return m_output.size(); }
+
+  /// Number of byte equivalence classes (columns of the transition table)
+  auto Classes() const noexcept -> std::size_t { return m_classes; }
+
+  /// Length of the \a which -th needle
+  auto Length(std::size_t which) const noexcept -> std::size_t {
+    return m_lengths[which];
+  }
+
+  /**
+   *  \brief Scan \a str once, looking for the first needle occurrence
+   *
+   *  \note The occurrence returned is the one ENDING first. When many needles
+   *        end at the same position, the first declared one is returned.
+   *
+   *  \param[in] str The string we are looking into
+   *
+   *  \return Hit Position and index of the needle found
+   */
+  auto Find(std::string_view str) const noexcept -> Hit {
+    if (m_output[0] != kNoNeedle) {
+      return MakeHit(0, m_output[0]);
+    }
+
+    std::uint32_t row = 0;
+    for (std::size_t i = 0; i < str.size(); ++i) {
+      const std::uint32_t next = m_delta[row + ClassOf(str[i])];
+      row = next & ~kOutputFlag;
+      if ((next & kOutputFlag) != 0) {
+        return MakeHit(i + 1, m_output[row / m_classes]);
+      }
+    }
+
+    return Hit{};
+  }
+
+ private:
+  static constexpr std::uint32_t kNoState =
+      std::numeric_limits<std::uint32_t>::max();
+  static constexpr std::uint32_t kNoNeedle =
+      std::numeric_limits<std::uint32_t>::max();
+  static constexpr std::uint32_t kOutputFlag = 1u << 31;
+
+  auto ClassOf(char c) const noexcept -> std::uint32_t {
+    return m_class_of[static_cast<unsigned char>(c)];
+  }
+
+  auto At(std::uint32_t state, std::uint32_t cls) -> std::uint32_t& {
+    return m_delta[state * m_classes + cls];
+  }
+
+  auto MakeHit(std::size_t end, std::uint32_t which) const noexcept -> Hit {
+    return Hit{end - m_lengths[which], which};
+  }
+
+  std::array<std::uint16_t, 256> m_class_of; /*!< Byte -> class */
+  std::uint32_t m_classes = 0;               /*!< Number of classes */
+  std::vector<std::uint32_t> m_delta;  /*!< Row offsets, states x classes */
+  std::vector<std::uint32_t> m_output; /*!< State -> needle found */
+  std::vector<std::size_t> m_lengths;  /*!< Needle -> length */
+};
+
+}  // namespace swstr::details
@@ -0,0 +1,365 @@
+#pragma once
+
+#include <bit>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <string_view>
+#include <type_traits>
+
+#include "SwitchStr/details/ByteSet.hpp"
+#include "SwitchStr/details/Cpu.hpp"
+
+namespace swstr::details {
+
+/**
+ *  \file
+ *  \brief ASCII case folding kernels, used by the case insensitive matchers
+ *         (IEquals, IStartsWith, IEndsWith, IContains, IContainsOneOf)
+ *
+ *  Only the ASCII letters are folded (to lower case), any other byte (UTF-8
+ *  sequences included) must match exactly.
+ *
+ *  Both the pattern and the string matched are folded on the fly, never
+ *  copied, such that the matchers only hold a view on their pattern (no
+ *  allocation, whatever its size):
+ *  - 32/16 bytes at a time with AVX2/SSE2: 2 signed compares give the mask of
+ *    the upper case letters, AND 0x20 / OR folds them;
+ *  - 8 bytes at a time otherwise (SWAR), the tail being handled with a last
+ *    block overlapping the previous one;
+ */
+
+/// \a c in lower case, when it's an ASCII letter
+constexpr auto ToLowerAscii(char c) noexcept -> char {
+  return ((c >= 'A') and (c <= 'Z')) ? static_cast<char>(c | 0x20) : c;
+}
+
+/// \a c in upper case, when it's an ASCII letter
+constexpr auto ToUpperAscii(char c) noexcept -> char {
+  return ((c >= 'a') and (c <= 'z')) ? static_cast<char>(c & ~0x20) : c;
+}
+
+/// Set of the chars of \a chars, in both lower and upper case
+constexpr auto FoldedByteSet(std::string_view chars) noexcept -> ByteSet {
+  ByteSet set;
+  for (const char c : chars) {
+    set.Insert(ToLowerAscii(c));
+    set.Insert(ToUpperAscii(c));
+  }
+  return set;
+}
+
+/// The 8 bytes at \a data
+inline auto Load8(const char* data) noexcept -> std::uint64_t {
+  std::uint64_t word;
+  std::memcpy(&word, data, sizeof(word));
+  return word;
+}
+
+/// The 8 bytes at \a data, with their ASCII letters in lower case (SWAR)
+inline auto LoadFolded8(const char* data) noexcept -> std::uint64_t {
+  constexpr std::uint64_t kOnes = 0x0101010101010101u;
+  constexpr std::uint64_t kHigh = kOnes * 0x80;
+
+  // Bytes >= 0x80 are cleared first, such that the adds never carry over to
+  // the next byte. The high bit of each byte is then set when:
+  // - ge_a: byte >= 'A';
+  // - gt_z: byte > 'Z';
+  const std::uint64_t word = Load8(data);
+  const std::uint64_t ascii = word & ~kHigh;
+  const std::uint64_t ge_a = ascii + kOnes * (0x80 - 'A');
+  const std::uint64_t gt_z = ascii + kOnes * (0x80 - 'Z' - 1);
+  const std::uint64_t upper = (ge_a ^ gt_z) & ~word & kHigh;
+
+  return word | (upper >> 2);
+}
+
+/// True when \a str folded equals \a pattern folded, reading 8 bytes at a
+/// time
+inline auto IEqualBytesSwar(const char* str, const char* pattern,
+                            std::size_t n) noexcept -> bool {
+  if (n < 8) {
+    for (std::size_t i = 0; i < n; ++i) {
+      if (ToLowerAscii(str[i]) != ToLowerAscii(pattern[i])) return false;
+    }
+    return true;
+  }
+
+  for (std::size_t i = 0; i + 8 < n; i += 8) {
+    if (LoadFolded8(str + i) != LoadFolded8(pattern + i)) return false;
+  }
+
+  // Last block overlaps the previous one
+  return LoadFolded8(str + n - 8) == LoadFolded8(pattern + n - 8);
+}
+
+#if SwitchStr_X86_DISPATCH
+/// \a block with its ASCII letters in lower case
+SwitchStr_TARGET("sse2")
+inline auto FoldSse2(__m128i block) noexcept -> __m128i {
+  // Signed compares: bytes >= 0x80 are negative, hence never folded
+  const __m128i upper =
+      _mm_and_si128(_mm_cmpgt_epi8(block, _mm_set1_epi8('A' - 1)),
+                    _mm_cmplt_epi8(block, _mm_set1_epi8('Z' + 1)));
+  return _mm_or_si128(block, _mm_and_si128(upper, _mm_set1_epi8(0x20)));
+}
+
+/// True when the 16 bytes at \a str folded equal the ones at \a pattern
+/// folded
+SwitchStr_TARGET("sse2")
+inline auto IEqual16Sse2(const char* str, const char* pattern) noexcept
+    -> bool {
+  const __m128i block =
+      FoldSse2(_mm_loadu_si128(reinterpret_cast<const __m128i*>(str)));
+  const __m128i expected =
+      FoldSse2(_mm_loadu_si128(reinterpret_cast<const __m128i*>(pattern)));
+  return _mm_movemask_epi8(_mm_cmpeq_epi8(block, expected)) == 0xFFFF;
+}
+
+/// \pre n >= 16
+SwitchStr_TARGET("sse2")
+inline auto IEqualBytesSse2(const char* str, const char* pattern,
+                            std::size_t n) noexcept -> bool {
+  for (std::size_t i = 0; i + 16 < n; i += 16) {
+    if (not IEqual16Sse2(str + i, pattern + i)) return false;
+  }
+
+  // Last block overlaps the previous one
+  return IEqual16Sse2(str + n - 16, pattern + n - 16);
+}
+
+/// \a block with its ASCII letters in lower case
+SwitchStr_TARGET("avx2")
+inline auto FoldAvx2(__m256i block) noexcept -> __m256i {
+  // Signed compares: bytes >= 0x80 are negative, hence never folded
+  const __m256i upper =
+      _mm256_and_si256(_mm256_cmpgt_epi8(block, _mm256_set1_epi8('A' - 1)),
+                       _mm256_cmpgt_epi8(_mm256_set1_epi8('Z' + 1), block));
+  return _mm256_or_si256(block,
+                         _mm256_and_si256(upper, _mm256_set1_epi8(0x20)));
+}
+
+/// True when the 32 bytes at \a str folded equal the ones at \a pattern
+/// folded
+SwitchStr_TARGET("avx2")
+inline auto IEqual32Avx2(const char* str, const char* pattern) noexcept
+    -> bool {
+  const __m256i block =
+      FoldAvx2(_mm256_loadu_si256(reinterpret_cast<const __m256i*>(str)));
+  const __m256i expected =
+      FoldAvx2(_mm256_loadu_si256(reinterpret_cast<const __m256i*>(pattern)));
+  return _mm256_movemask_epi8(_mm256_cmpeq_epi8(block, expected)) == -1;
+}
+
+/// \pre n >= 32
+SwitchStr_TARGET("avx2")
+inline auto IEqualBytesAvx2(const char* str, const char* pattern,
+                            std::size_t n) noexcept -> bool {
+  for (std::size_t i = 0; i + 32 < n; i += 32) {
+    if (not IEqual32Avx2(str + i, pattern + i)) return false;
+  }
+
+  // Last block overlaps the previous one
+  return IEqual32Avx2(str + n - 32, pattern + n - 32);
+}
+#endif
+
+/**
+ *  \brief True when the \a n bytes of \a str equal the \a n bytes of
+ *         \a pattern, ignoring the case of the ASCII letters of BOTH
+ *
+ *  \note Select the best kernel available at runtime
+ */
+constexpr auto IEqualBytes(const char* str, const char* pattern,
+                           std::size_t n) noexcept -> bool {
+  if (not std::is_constant_evaluated()) {
+#if SwitchStr_X86_DISPATCH
+    if ((n >= 32) and cpu::HasAvx2()) {
+      return IEqualBytesAvx2(str, pattern, n);
+    } else if (n >= 16) {
+      return IEqualBytesSse2(str, pattern, n);
+    }
+#endif
+    return IEqualBytesSwar(str, pattern, n);
+  }
+
+  for (std::size_t i = 0; i < n; ++i) {
+    if (ToLowerAscii(str[i]) != ToLowerAscii(pattern[i])) return false;
+  }
+  return true;
+}
+
+/**
+ *  \brief True when \a lhs equals \a rhs, ignoring the case of the ASCII
+ *         letters of BOTH strings (none of them needs to be folded)
+ */
+constexpr auto IEqualsAscii(std::string_view lhs,
+                            std::string_view rhs) noexcept -> bool {
+  return (lhs.size() == rhs.size()) and
+         IEqualBytes(lhs.data(), rhs.data(), lhs.size());
+}
+
+/// Verify that the needle middle chars match at \a candidate
+inline auto IVerifyMiddle(const char* candidate,
+                          std::string_view needle) noexcept -> bool {
+  return (needle.size() <= 2) or
+         IEqualBytes(candidate + 1, needle.data() + 1, needle.size() - 2);
+}
+
+/// \pre 0 < needle.size() <= hay.size()
+constexpr auto IFindScalar(std::string_view hay,
+                           std::string_view needle) noexcept -> std::size_t {
+  const char first = ToLowerAscii(needle.front());
+  const std::size_t candidates = hay.size() - needle.size() + 1;
+  for (std::size_t i = 0; i < candidates; ++i) {
+    if ((ToLowerAscii(hay[i]) == first) and
+        IEqualBytes(hay.data() + i + 1, needle.data() + 1,
+                    needle.size() - 1)) {
+      return i;
+    }
+  }
+  return std::string_view::npos;
+}
+
+#if SwitchStr_X86_DISPATCH
+/**
+ *  \brief Mask of the candidates [i, i + 16) whose first AND last chars match,
+ *         in any case
+ *
+ *  \note Both cases are compared (2 compares + OR), cheaper than folding the
+ *        blocks
+ */
+SwitchStr_TARGET("sse2")
+inline auto ICandidatesMaskSse2(const char* data, std::size_t i,
+                                std::string_view needle) noexcept
+    -> std::uint32_t {
+  const __m128i block_first =
+      _mm_loadu_si128(reinterpret_cast<const __m128i*>(data + i));
+  const __m128i block_last = _mm_loadu_si128(
+      reinterpret_cast<const __m128i*>(data + i + needle.size() - 1));
+
+  const char first = needle.front();
+  const char last = needle.back();
+  const __m128i first_match = _mm_or_si128(
+      _mm_cmpeq_epi8(_mm_set1_epi8(ToLowerAscii(first)), block_first),
+      _mm_cmpeq_epi8(_mm_set1_epi8(ToUpperAscii(first)), block_first));
+  const __m128i last_match = _mm_or_si128(
+      _mm_cmpeq_epi8(_mm_set1_epi8(ToLowerAscii(last)), block_last),
+      _mm_cmpeq_epi8(_mm_set1_epi8(ToUpperAscii(last)), block_last));
+
+  return static_cast<std::uint32_t>(
+      _mm_movemask_epi8(_mm_and_si128(first_match, last_match)));
+}
+
+/// \pre 0 < needle.size() <= hay.size()
+SwitchStr_TARGET("sse2")
+inline auto IFindSse2(std::string_view hay, std::string_view needle) noexcept
+    -> std::size_t {
+  const std::size_t candidates = hay.size() - needle.size() + 1;
+  if (candidates < 16) return IFindScalar(hay, needle);
+
+  std::size_t i = 0;
+  for (; i + 16 <= candidates; i += 16) {
+    std::uint32_t mask = ICandidatesMaskSse2(hay.data(), i, needle);
+    while (mask != 0) {
+      const std::size_t candidate = i + std::countr_zero(mask);
+      if (IVerifyMiddle(hay.data() + candidate, needle)) return candidate;
+      mask &= mask - 1;
+    }
+  }
+
+  // Last block overlaps the previous one, whose candidates are discarded
+  if (i < candidates) {
+    const std::size_t last = candidates - 16;
+    std::uint32_t mask = ICandidatesMaskSse2(hay.data(), last, needle) &
+                         (~std::uint32_t{0} << (i - last));
+    while (mask != 0) {
+      const std::size_t candidate = last + std::countr_zero(mask);
+      if (IVerifyMiddle(hay.data() + candidate, needle)) return candidate;
+      mask &= mask - 1;
+    }
+  }
+
+  return std::string_view::npos;
+}
+
+/// Mask of the candidates [i, i + 32) whose first AND last chars match
+SwitchStr_TARGET("avx2")
+inline auto ICandidatesMaskAvx2(const char* data, std::size_t i,
+                                std::string_view needle) noexcept
+    -> std::uint32_t {
+  const __m256i block_first =
+      _mm256_loadu_si256(reinterpret_cast<const __m256i*>(data + i));
+  const __m256i block_last = _mm256_loadu_si256(
+      reinterpret_cast<const __m256i*>(data + i + needle.size() - 1));
+
+  const char first = needle.front();
+  const char last = needle.back();
+  const __m256i first_match = _mm256_or_si256(
+      _mm256_cmpeq_epi8(_mm256_set1_epi8(ToLowerAscii(first)), block_first),
+      _mm256_cmpeq_epi8(_mm256_set1_epi8(ToUpperAscii(first)), block_first));
+  const __m256i last_match = _mm256_or_si256(
+      _mm256_cmpeq_epi8(_mm256_set1_epi8(ToLowerAscii(last)), block_last),
+      _mm256_cmpeq_epi8(_mm256_set1_epi8(ToUpperAscii(last)), block_last));
+
+  return static_cast<std::uint32_t>(
+      _mm256_movemask_epi8(_mm256_and_si256(first_match, last_match)));
+}
+
+/// \pre 0 < needle.size() <= hay.size()
+SwitchStr_TARGET("avx2")
+inline auto IFindAvx2(std::string_view hay, std::string_view needle) noexcept
+    -> std::size_t {
+  const std::size_t candidates = hay.size() - needle.size() + 1;
+  if (candidates < 32) return IFindSse2(hay, needle);
+
+  std::size_t i = 0;
+  for (; i + 32 <= candidates; i += 32) {
+    std::uint32_t mask = ICandidatesMaskAvx2(hay.data(), i, needle);
+    while (mask != 0) {
+      const std::size_t candidate = i + std::countr_zero(mask);
+      if (IVerifyMiddle(hay.data() + candidate, needle)) return candidate;
+      mask &= mask - 1;
+    }
+  }
+
+  // Last block overlaps the previous one, whose candidates are discarded
+  if (i < candidates) {
+    const std::size_t last = candidates - 32;
+    std::uint32_t mask = ICandidatesMaskAvx2(hay.data(), last, needle) &
+                         (~std::uint32_t{0} << (i - last));
+    while (mask != 0) {
+      const std::size_t candidate = last + std::countr_zero(mask);
+      if (IVerifyMiddle(hay.data() + candidate, needle)) return candidate;
+      mask &= mask - 1;
+    }
+  }
+
+  return std::string_view::npos;
+}
+#endif
+
+/**
+ *  \brief Case insensitive hay.find(needle), ignoring the case of the ASCII
+ *         letters of BOTH strings
+ *
+ *  \note Select the best kernel available at runtime
+ */
+constexpr auto IFind(std::string_view hay, std::string_view needle) noexcept
+    -> std::size_t {
+  if (needle.empty()) return 0;
+  if (needle.size() > hay.size()) return std::string_view::npos;
+
+#if SwitchStr_X86_DISPATCH
+  if (not std::is_constant_evaluated()) {
+    if (cpu::HasAvx2()) {
+      return IFindAvx2(hay, needle);
+    } else {
+      return IFindSse2(hay, needle);
+    }
+  }
+#endif
+  return IFindScalar(hay, needle);
+}
+
+}  // namespace swstr::details
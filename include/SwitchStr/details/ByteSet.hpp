@@ -0,0 +1,257 @@
+#pragma once
+
+#include <array>
+#include <bit>
+#include <cstddef>
+#include <cstdint>
+#include <string_view>
+#include <type_traits>
+
+#include "SwitchStr/details/Cpu.hpp"
+
+namespace swstr::details {
+
+/**
+ *  \brief Set of bytes, looked up 16/32 bytes at a time using SIMD nibble
+ *         shuffles
+ *
+ *  The set is stored as a 256 bits bitmap, split in two 16 bytes tables (the
+ *  layout expected by the SIMD kernels):
+ *  - m_bitmap[lo]      bit hi     : byte (hi << 4 | lo) for hi in [0, 8);
+ *  - m_bitmap[16 + lo] bit hi - 8 : byte (hi << 4 | lo) for hi in [8, 16);
+ *
+ *  Such that a byte c is looked up with:
+ *  - row = m_bitmap[(c & 0xF) + (c >= 0x80 ? 16 : 0)] (1 PSHUFB per table);
+ *  - bit = 1 << ((c >> 4) & 7)                         (1 PSHUFB);
+ */
+class ByteSet {
+ public:
+  constexpr ByteSet() noexcept = default;
+
+  /**
+   *  \brief Construct the set containing all \a bytes
+   */
+  constexpr explicit ByteSet(std::string_view bytes) noexcept {
+    for (const char c : bytes) {
+      Insert(c);
+    }
+  }
+
+  constexpr void Insert(char c) noexcept {
+    const auto byte = static_cast<std::uint8_t>(c);
+    m_bitmap[RowOf(byte)] |= BitOf(byte);
+  }
+
+  constexpr auto Contains(char c) const noexcept -> bool {
+    const auto byte = static_cast<std::uint8_t>(c);
+    return (m_bitmap[RowOf(byte)] & BitOf(byte)) != 0;
+  }
+
+  /**
+   *  \brief Index of the FIRST char of \a str part of the set
+   *
+   *  \note Select the best kernel available at runtime
+   *
+   *  \return std::size_t The index found, npos if none
+   */
+  constexpr auto FindFirst(std::string_view str) const noexcept
+      -> std::size_t {
+#if SwitchStr_X86_DISPATCH
+    if (not std::is_constant_evaluated()) {
+      if ((str.size() >= 32) and cpu::HasAvx2()) {
+        return FindFirstAvx2(str);
+      } else if ((str.size() >= 16) and cpu::HasSsse3()) {
+        return FindFirstSsse3(str);
+      }
+    }
+#endif
+    return FindFirstScalar(str);
+  }
+
+  /**
+   *  \brief Index of the LAST char of \a str part of the set
+   *
+   *  \note Select the best kernel available at runtime
+   *
+   *  \return std::size_t The index found, npos if none
+   */
+  constexpr auto FindLast(std::string_view str) const noexcept -> std::size_t {
+#if SwitchStr_X86_DISPATCH
+    if (not std::is_constant_evaluated()) {
+      if ((str.size() >= 32) and cpu::HasAvx2()) {
+        return FindLastAvx2(str);
+      } else if ((str.size() >= 16) and cpu::HasSsse3()) {
+        return FindLastSsse3(str);
+      }
+    }
+#endif
+    return FindLastScalar(str);
+  }
+
+  constexpr auto FindFirstScalar(std::string_view str) const noexcept
+      -> std::size_t {
+    for (std::size_t i = 0; i < str.size(); ++i) {
+      if (Contains(str[i])) return i;
+    }
+    return std::string_view::npos;
+  }
+
+  constexpr auto FindLastScalar(std::string_view str) const noexcept
+      -> std::size_t {
+    for (std::size_t i = str.size(); i > 0; --i) {
+      if (Contains(str[i - 1])) return i - 1;
+    }
+    return std::string_view::npos;
+  }
+
+#if SwitchStr_X86_DISPATCH
+  /// \pre str.size() >= 16
+  SwitchStr_TARGET("ssse3")
+  auto FindFirstSsse3(std::string_view str) const noexcept -> std::size_t {
+    const char* const data = str.data();
+    const std::size_t size = str.size();
+
+    std::size_t i = 0;
+    for (; i + 16 <= size; i += 16) {
+      const std::uint32_t mask = Match16(data + i);
+      if (mask != 0) return i + std::countr_zero(mask);
+    }
+
+    // Last block overlaps the previous one, which didn't contain any match
+    if (i < size) {
+      const std::uint32_t mask = Match16(data + size - 16);
+      if (mask != 0) return size - 16 + std::countr_zero(mask);
+    }
+
+    return std::string_view::npos;
+  }
+
+  /// \pre str.size() >= 16
+  SwitchStr_TARGET("ssse3")
+  auto FindLastSsse3(std::string_view str) const noexcept -> std::size_t {
+    const char* const data = str.data();
+
+    std::size_t end = str.size();
+    for (; end >= 16; end -= 16) {
+      const std::uint32_t mask = Match16(data + end - 16);
+      if (mask != 0) return end - 1 - std::countl_zero(mask << 16);
+    }
+
+    // First block overlaps the next one, which didn't contain any match
+    if (end > 0) {
+      const std::uint32_t mask = Match16(data);
+      if (mask != 0) return 15 - std::countl_zero(mask << 16);
+    }
+
+    return std::string_view::npos;
+  }
+
+  /// \pre str.size() >= 32
+  SwitchStr_TARGET("avx2")
+  auto FindFirstAvx2(std::string_view str) const noexcept -> std::size_t {
+    const char* const data = str.data();
+    const std::size_t size = str.size();
+
+    std::size_t i = 0;
+    for (; i + 32 <= size; i += 32) {
+      const std::uint32_t mask = Match32(data + i);
+      if (mask != 0) return i + std::countr_zero(mask);
+    }
+
+    if (i < size) {
+      const std::uint32_t mask = Match32(data + size - 32);
+      if (mask != 0) return size - 32 + std::countr_zero(mask);
+    }
+
+    return std::string_view::npos;
+  }
+
+  /// \pre str.size() >= 32
+  SwitchStr_TARGET("avx2")
+  auto FindLastAvx2(std::string_view str) const noexcept -> std::size_t {
+    const char* const data = str.data();
+
+    std::size_t end = str.size();
+    for (; end >= 32; end -= 32) {
+      const std::uint32_t mask = Match32(data + end - 32);
+      if (mask != 0) return end - 1 - std::countl_zero(mask);
+    }
+
+    if (end > 0) {
+      const std::uint32_t mask = Match32(data);
+      if (mask != 0) return 31 - std::countl_zero(mask);
+    }
+
+    return std::string_view::npos;
+  }
+#endif
+
+ private:
+  static constexpr auto RowOf(std::uint8_t byte) noexcept -> std::size_t {
+    return (byte & 0x0F) + ((byte >> 7) << 4);
+  }
+
+  static constexpr auto BitOf(std::uint8_t byte) noexcept -> std::uint8_t {
+    return static_cast<std::uint8_t>(1u << ((byte >> 4) & 7));
+  }
+
+#if SwitchStr_X86_DISPATCH
+  /// Return the bit mask of the bytes of [data, data + 16) inside the set
+  SwitchStr_TARGET("ssse3")
+  auto Match16(const char* data) const noexcept -> std::uint32_t {
+    const __m128i low_nibbles = _mm_set1_epi8(0x0F);
+    const __m128i bits = _mm_setr_epi8(1, 2, 4, 8, 16, 32, 64, -128, 1, 2, 4,
+                                       8, 16, 32, 64, -128);
+    const __m128i low_table = _mm_loadu_si128(
+        reinterpret_cast<const __m128i*>(m_bitmap.data()));
+    const __m128i high_table = _mm_loadu_si128(
+        reinterpret_cast<const __m128i*>(m_bitmap.data() + 16));
+
+    const __m128i input =
+        _mm_loadu_si128(reinterpret_cast<const __m128i*>(data));
+    const __m128i lo = _mm_and_si128(input, low_nibbles);
+    const __m128i hi = _mm_and_si128(_mm_srli_epi16(input, 4), low_nibbles);
+
+    const __m128i is_high = _mm_cmplt_epi8(input, _mm_setzero_si128());
+    const __m128i row =
+        _mm_or_si128(_mm_andnot_si128(is_high, _mm_shuffle_epi8(low_table, lo)),
+                     _mm_and_si128(is_high, _mm_shuffle_epi8(high_table, lo)));
+    const __m128i bit = _mm_shuffle_epi8(bits, hi);
+
+    const __m128i found = _mm_cmpeq_epi8(_mm_and_si128(row, bit), bit);
+    return static_cast<std::uint32_t>(_mm_movemask_epi8(found));
+  }
+
+  /// Return the bit mask of the bytes of [data, data + 32) inside the set
+  SwitchStr_TARGET("avx2")
+  auto Match32(const char* data) const noexcept -> std::uint32_t {
+    const __m256i low_nibbles = _mm256_set1_epi8(0x0F);
+    const __m256i bits = _mm256_setr_epi8(
+        1, 2, 4, 8, 16, 32, 64, -128, 1, 2, 4, 8, 16, 32, 64, -128, 1, 2, 4, 8,
+        16, 32, 64, -128, 1, 2, 4, 8, 16, 32, 64, -128);
+    const __m256i low_table = _mm256_broadcastsi128_si256(_mm_loadu_si128(
+        reinterpret_cast<const __m128i*>(m_bitmap.data())));
+    const __m256i high_table = _mm256_broadcastsi128_si256(_mm_loadu_si128(
+        reinterpret_cast<const __m128i*>(m_bitmap.data() + 16)));
+
+    const __m256i input =
+        _mm256_loadu_si256(reinterpret_cast<const __m256i*>(data));
+    const __m256i lo = _mm256_and_si256(input, low_nibbles);
+    const __m256i hi =
+        _mm256_and_si256(_mm256_srli_epi16(input, 4), low_nibbles);
+
+    const __m256i is_high = _mm256_cmpgt_epi8(_mm256_setzero_si256(), input);
+    const __m256i row = _mm256_blendv_epi8(_mm256_shuffle_epi8(low_table, lo),
+                                           _mm256_shuffle_epi8(high_table, lo),
+                                           is_high);
+    const __m256i bit = _mm256_shuffle_epi8(bits, hi);
+
+    const __m256i found = _mm256_cmpeq_epi8(_mm256_and_si256(row, bit), bit);
+    return static_cast<std::uint32_t>(_mm256_movemask_epi8(found));
+  }
+#endif
+
+  std::array<std::uint8_t, 32> m_bitmap = {};
+};
+
+}  // namespace swstr::details
@@ -0,0 +1,112 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <string_view>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+#include "SwitchStr/Matcher.hpp"
+
+namespace swstr::details {
+
+/// Kind of a case, deduced from its matcher type
+enum class CaseKind : std::uint8_t { kEquals, kStartsWith, kEndsWith, kOpaque };
+
+/// A case of a CaseList, whose pattern is the bytes [offset, offset + size)
+/// of the list (or its opaque matcher offset, when kOpaque)
+struct CaseEntry {
+  CaseKind kind;
+  std::uint32_t offset;
+  std::uint32_t size;
+};
+
+/**
+ *  \brief Cases of the runtime switches (SwitchTable, AdaptiveSwitch), in
+ *         declaration order
+ *
+ *  Equals/StartsWith/EndsWith (and string like) cases only keep their
+ *  pattern, copied into a single contiguous buffer, such that the switches
+ *  can index them. Any other matcher is an opaque case, type erased.
+ *
+ *  \tparam ErasedMatcher The type erased matcher storing the opaque matchers
+ */
+template <typename ErasedMatcher>
+class CaseList {
+ public:
+  /// Add a case matching with \a m
+  template <typename Matcher>
+  void Add(Matcher&& m) {
+    using M = std::remove_cvref_t<Matcher>;
+    MatcherTraits<M>::StaticAssertIfInvalid();
+
+    if constexpr (IsEqualsMatcher_v<M>) {
+      AddPattern(CaseKind::kEquals, m.Pattern());
+    } else if constexpr (IsStartsWithMatcher_v<M>) {
+      AddPattern(CaseKind::kStartsWith, m.Pattern());
+    } else if constexpr (IsEndsWithMatcher_v<M>) {
+      AddPattern(CaseKind::kEndsWith, m.Pattern());
+    } else if constexpr (MatcherTraits<M>::is_convertible and
+                         not MatcherTraits<M>::has_IsMatching and
+                         not MatcherTraits<M>::has_Operator) {
+      AddPattern(CaseKind::kEquals, std::string_view{m});
+    } else {
+      m_cases.push_back(CaseEntry{
+          CaseKind::kOpaque, static_cast<std::uint32_t>(m_opaques.size()), 0});
+      m_opaques.emplace_back(std::forward<Matcher>(m));
+    }
+  }
+
+  /// Number of cases
+  auto Size() const noexcept -> std::size_t { return m_cases.size(); }
+
+  auto operator[](std::size_t index) const noexcept -> const CaseEntry& {
+    return m_cases[index];
+  }
+
+  auto begin() const noexcept { return m_cases.begin(); }
+  auto end() const noexcept { return m_cases.end(); }
+
+  /// Pattern of \a entry (empty when kOpaque)
+  auto PatternOf(const CaseEntry& entry) const noexcept -> std::string_view {
+    return std::string_view(m_bytes.data() + entry.offset, entry.size);
+  }
+
+  /// True when the case \a entry matches \a str
+  auto IsMatching(const CaseEntry& entry, std::string_view str) const
+      -> bool {
+    switch (entry.kind) {
+      case CaseKind::kEquals:
+        return (str.size() == entry.size) and
+               EqualBytes(str.data(), m_bytes.data() + entry.offset,
+                          entry.size);
+      case CaseKind::kStartsWith:
+        return (str.size() >= entry.size) and
+               EqualBytes(str.data(), m_bytes.data() + entry.offset,
+                          entry.size);
+      case CaseKind::kEndsWith:
+        return (str.size() >= entry.size) and
+               EqualBytes(str.data() + str.size() - entry.size,
+                          m_bytes.data() + entry.offset, entry.size);
+      case CaseKind::kOpaque:
+        return m_opaques[entry.offset].IsMatching(str);
+    }
+    return false;
+  }
+
+ private:
+  void AddPattern(CaseKind kind, std::string_view pattern) {
+    m_cases.push_back(CaseEntry{kind,
+                                static_cast<std::uint32_t>(m_bytes.size()),
+                                static_cast<std::uint32_t>(pattern.size())});
+    m_bytes.append(pattern);
+  }
+
+  std::vector<CaseEntry> m_cases; /*!< Cases, in declaration order */
+  std::string m_bytes;            /*!< All patterns, contiguous */
+  std::vector<ErasedMatcher> m_opaques;
+};
+
+}  // namespace swstr::details
@@ -0,0 +1,56 @@
+#pragma once
+
+/**
+ *  \file
+ *  \brief Runtime CPU features detection, use to dispatch SIMD kernels
+ *
+ *  SIMD kernels are only compiled for x86 with GCC/Clang, using the target
+ *  attribute, such that the library doesn't require any -m<arch> flag: the
+ *  best kernel available is selected at runtime.
+ *  Any other compiler/architecture only uses the scalar kernels.
+ */
+
+#if (defined(__GNUC__) || defined(__clang__)) && \
+    (defined(__x86_64__) || defined(__i386__))
+#define SwitchStr_X86_DISPATCH 1
+#include <immintrin.h>
+#else
+#define SwitchStr_X86_DISPATCH 0
+#endif
+
+#if SwitchStr_X86_DISPATCH
+#define SwitchStr_TARGET(arch) __attribute__((target(arch)))
+#else
+#define SwitchStr_TARGET(arch)
+#endif
+
+namespace swstr::details::cpu {
+
+/// True when the SSSE3 kernels can be used
+inline auto HasSsse3() noexcept -> bool {
+#if SwitchStr_X86_DISPATCH
+  return __builtin_cpu_supports("ssse3");
+#else
+  return false;
+#endif
+}
+
+/// True when the AVX2 kernels can be used
+inline auto HasAvx2() noexcept -> bool {
+#if SwitchStr_X86_DISPATCH
+  return __builtin_cpu_supports("avx2");
+#else
+  return false;
+#endif
+}
+
+/// Hint the CPU to start loading the cache line of \a ptr
+inline void Prefetch(const void* ptr) noexcept {
+#if defined(__GNUC__) || defined(__clang__)
+  __builtin_prefetch(ptr);
+#else
+  (void)ptr;
+#endif
+}
+
+}  // namespace swstr::details::cpu
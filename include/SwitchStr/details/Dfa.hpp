@@ -0,0 +1,925 @@
+#pragma once
+
+#include <algorithm>
+#include <array>
+#include <bit>
+#include <cstddef>
+#include <cstdint>
+#include <string_view>
+#include <type_traits>
+#include <vector>
+
+namespace swstr::details {
+
+/**
+ *  \file
+ *  \brief Compile time pattern (glob/regex) compiler, used by Glob/Regex (see
+ *         Pattern.hpp)
+ *
+ *  The pattern goes through the usual pipeline, entirely evaluated as a
+ *  constant expression (the std::vector used are transient):
+ *  - Thompson construction of an NFA, while parsing the pattern;
+ *  - Bytes split into equivalence classes (bytes never told apart by the
+ *    pattern share the same class), shrinking the DFA rows;
+ *  - Subset construction of the DFA, followed by a Moore minimization;
+ *
+ *  The resulting DFA is then flattened into constexpr arrays (DfaTables),
+ *  sized by a first compilation pass (PatternInfo).
+ */
+
+/// Syntax of the pattern compiled
+enum class PatternSyntax {
+  kGlob,  /*!< *, ?, [abc], [!a-z], {foo,bar}, \ escape */
+  kRegex, /*!< ECMAScript like subset, see RegexMatcher */
+};
+
+/// Reason why a pattern can't be compiled
+enum class PatternError {
+  kNone,
+  kUnbalancedGroup,    /*!< Missing/extra ')' or '}' */
+  kUnterminatedClass,  /*!< Missing ']' */
+  kInvalidRange,       /*!< [z-a] */
+  kInvalidRepetition,  /*!< Malformed {n,m}, n > m or m > 255 */
+  kNothingToRepeat,    /*!< Quantifier without anything before */
+  kInvalidEscape,      /*!< Trailing '\' or malformed \xHH */
+  kUnsupported,        /*!< Back references, lookarounds, anchors, ... */
+  kTooManyStates,      /*!< NFA/DFA bigger than kMax{Nfa,Dfa}States */
+};
+
+inline constexpr std::size_t kNoState = static_cast<std::size_t>(-1);
+inline constexpr std::size_t kMaxNfaStates = 2048;
+inline constexpr std::size_t kMaxDfaStates = 4096;
+inline constexpr std::size_t kMaxRepetition = 255;
+
+/// Set of bytes, as a 256 bits bitmap
+class CharClass {
+ public:
+  /// The class of all bytes
+  static constexpr auto Any() noexcept -> CharClass {
+    CharClass any;
+    any.Negate();
+    return any;
+  }
+
+  /// The class of the single byte \a c
+  static constexpr auto Of(char c) noexcept -> CharClass {
+    CharClass single;
+    single.Insert(c);
+    return single;
+  }
+
+  constexpr void Insert(char c) noexcept {
+    const auto byte = static_cast<std::uint8_t>(c);
+    m_bits[byte / 64] |= std::uint64_t{1} << (byte % 64);
+  }
+
+  /// Insert all bytes of [first, last]
+  constexpr void Insert(char first, char last) noexcept {
+    for (unsigned byte = static_cast<std::uint8_t>(first);
+         byte <= static_cast<std::uint8_t>(last); ++byte) {
+      Insert(static_cast<char>(byte));
+    }
+  }
+
+  constexpr void Insert(const CharClass& other) noexcept {
+    for (std::size_t i = 0; i < m_bits.size(); ++i) {
+      m_bits[i] |= other.m_bits[i];
+    }
+  }
+
+  constexpr void Negate() noexcept {
+    for (auto& bits : m_bits) {
+      bits = ~bits;
+    }
+  }
+
+  constexpr auto Contains(char c) const noexcept -> bool {
+    const auto byte = static_cast<std::uint8_t>(c);
+    return ((m_bits[byte / 64] >> (byte % 64)) & 1) != 0;
+  }
+
+ private:
+  std::array<std::uint64_t, 4> m_bits{};
+};
+
+/**
+ *  \brief NFA state: either ONE transition on a CharClass, or up to TWO
+ *         epsilon transitions
+ */
+struct NfaState {
+  CharClass on;                              /*!< Bytes leading to next */
+  std::size_t next = kNoState;               /*!< Target of 'on' */
+  std::size_t eps[2] = {kNoState, kNoState}; /*!< Epsilon transitions */
+};
+
+/**
+ *  \brief Piece of NFA matching a sub pattern, from start to end
+ *
+ *  \note All states of a fragment are allocated contiguously, from first,
+ *        such that it can be cloned (i.e. for x{n,m})
+ */
+struct NfaFragment {
+  std::size_t start = 0;
+  std::size_t end = 0; /*!< Without any outgoing transition yet */
+  std::size_t first = 0;
+};
+
+/**
+ *  \brief Recursive descent parser of a pattern, building its NFA (Thompson
+ *         construction) along the way
+ */
+class PatternParser {
+ public:
+  constexpr PatternParser(PatternSyntax syntax,
+                          std::string_view pattern) noexcept
+      : m_syntax(syntax), m_pattern(pattern) {}
+
+  /// Parse the whole pattern, returning the fragment matching it
+  constexpr auto Parse() -> NfaFragment {
+    if (m_syntax == PatternSyntax::kGlob) return ParseGlob(false);
+
+    // Matching always uses the whole string: a leading '^' is implied
+    Accept('^');
+    const NfaFragment whole = ParseAlternation();
+
+    // Only an extra ')' can stop the alternation early
+    if (not Failed() and not AtEnd()) {
+      return Fail(PatternError::kUnbalancedGroup);
+    }
+    return whole;
+  }
+
+  constexpr auto States() const noexcept -> const std::vector<NfaState>& {
+    return m_states;
+  }
+
+  constexpr auto Error() const noexcept -> PatternError { return m_error; }
+
+  /// Position of the char of the pattern where the error occurred
+  constexpr auto ErrorPosition() const noexcept -> std::size_t {
+    return m_error_position;
+  }
+
+ private:
+  constexpr auto Failed() const noexcept -> bool {
+    return m_error != PatternError::kNone;
+  }
+
+  constexpr auto Fail(PatternError error) -> NfaFragment {
+    if (not Failed()) {
+      m_error = error;
+      m_error_position = (m_pos == 0) ? 0 : m_pos - 1;
+    }
+    return {};
+  }
+
+  constexpr auto AtEnd() const noexcept -> bool {
+    return m_pos >= m_pattern.size();
+  }
+
+  constexpr auto Peek(char c) const noexcept -> bool {
+    return not AtEnd() and (m_pattern[m_pos] == c);
+  }
+
+  constexpr auto Accept(char c) noexcept -> bool {
+    const bool accepted = Peek(c);
+    if (accepted) ++m_pos;
+    return accepted;
+  }
+
+  /// \pre not AtEnd()
+  constexpr auto Next() noexcept -> char { return m_pattern[m_pos++]; }
+
+  // NFA construction ///////////////////////////////////////////////////////
+
+  constexpr auto NewState() -> std::size_t {
+    if (m_states.size() >= kMaxNfaStates) {
+      Fail(PatternError::kTooManyStates);
+      return 0;
+    }
+    m_states.push_back({});
+    return m_states.size() - 1;
+  }
+
+  constexpr void Link(std::size_t from, std::size_t to) {
+    if (Failed()) return;
+    auto& eps = m_states[from].eps;
+    (eps[0] == kNoState ? eps[0] : eps[1]) = to;
+  }
+
+  /// Matches the empty string
+  constexpr auto Empty() -> NfaFragment {
+    const std::size_t state = NewState();
+    return {state, state, state};
+  }
+
+  /// Matches one byte of \a set
+  constexpr auto Atom(const CharClass& set) -> NfaFragment {
+    const std::size_t start = NewState();
+    const std::size_t end = NewState();
+    if (Failed()) return {};
+
+    m_states[start].on = set;
+    m_states[start].next = end;
+    return {start, end, start};
+  }
+
+  constexpr auto Concatenate(NfaFragment a, NfaFragment b) -> NfaFragment {
+    Link(a.end, b.start);
+    return {a.start, b.end, std::min(a.first, b.first)};
+  }
+
+  constexpr auto Alternate(NfaFragment a, NfaFragment b) -> NfaFragment {
+    const std::size_t start = NewState();
+    const std::size_t end = NewState();
+    Link(start, a.start);
+    Link(start, b.start);
+    Link(a.end, end);
+    Link(b.end, end);
+    return {start, end, std::min(a.first, b.first)};
+  }
+
+  /// a*
+  constexpr auto Star(NfaFragment a) -> NfaFragment {
+    const std::size_t start = NewState();
+    const std::size_t end = NewState();
+    Link(start, a.start);
+    Link(start, end);
+    Link(a.end, a.start);
+    Link(a.end, end);
+    return {start, end, a.first};
+  }
+
+  /// a+
+  constexpr auto Plus(NfaFragment a) -> NfaFragment {
+    const std::size_t end = NewState();
+    Link(a.end, a.start);
+    Link(a.end, end);
+    return {a.start, end, a.first};
+  }
+
+  /// a?
+  constexpr auto Optional(NfaFragment a) -> NfaFragment {
+    const std::size_t start = NewState();
+    const std::size_t end = NewState();
+    Link(start, a.start);
+    Link(start, end);
+    Link(a.end, end);
+    return {start, end, a.first};
+  }
+
+  /// Copy of the states [a.first, last) of \a a, not linked to anything yet
+  constexpr auto Clone(NfaFragment a, std::size_t last) -> NfaFragment {
+    if (Failed()) return {};
+    if (m_states.size() + (last - a.first) > kMaxNfaStates) {
+      return Fail(PatternError::kTooManyStates);
+    }
+
+    const std::size_t offset = m_states.size() - a.first;
+    const auto shift = [offset](std::size_t state) {
+      return (state == kNoState) ? kNoState : state + offset;
+    };
+
+    for (std::size_t i = a.first; i < last; ++i) {
+      NfaState copy = m_states[i];
+      copy.next = shift(copy.next);
+      copy.eps[0] = shift(copy.eps[0]);
+      copy.eps[1] = shift(copy.eps[1]);
+      m_states.push_back(copy);
+    }
+
+    return {a.start + offset, a.end + offset, a.first + offset};
+  }
+
+  // Regex //////////////////////////////////////////////////////////////////
+
+  constexpr auto ParseAlternation() -> NfaFragment {
+    NfaFragment result = ParseConcatenation();
+    while (not Failed() and Accept('|')) {
+      const NfaFragment alternative = ParseConcatenation();
+      result = Alternate(result, alternative);
+    }
+    return result;
+  }
+
+  constexpr auto ParseConcatenation() -> NfaFragment {
+    NfaFragment result = Empty();
+    while (not Failed() and not AtEnd() and not Peek('|') and not Peek(')')) {
+      const NfaFragment next = ParseRepetition();
+      result = Concatenate(result, next);
+    }
+    return result;
+  }
+
+  constexpr auto ParseRepetition() -> NfaFragment {
+    NfaFragment atom = ParseAtom();
+    if (Failed() or AtEnd()) return atom;
+
+    if (Accept('*')) {
+      atom = Star(atom);
+    } else if (Accept('+')) {
+      atom = Plus(atom);
+    } else if (Accept('?')) {
+      atom = Optional(atom);
+    } else if (Accept('{')) {
+      atom = ParseCount(atom);
+    } else {
+      return atom;
+    }
+
+    // Lazy quantifiers match the same WHOLE strings, possessive ones don't
+    Accept('?');
+    if (Peek('+')) return Fail(PatternError::kUnsupported);
+
+    // As in ECMAScript, a quantifier can't be repeated (i.e. "a**", "a{2}?*")
+    if (Peek('*') or Peek('?') or Peek('{')) {
+      return Fail(PatternError::kNothingToRepeat);
+    }
+    return atom;
+  }
+
+  /// Parse the (positive) decimal number at the current position
+  constexpr auto ParseNumber() -> std::size_t {
+    if (AtEnd() or (m_pattern[m_pos] < '0') or (m_pattern[m_pos] > '9')) {
+      Fail(PatternError::kInvalidRepetition);
+      return 0;
+    }
+
+    std::size_t number = 0;
+    while (not AtEnd() and (m_pattern[m_pos] >= '0') and
+           (m_pattern[m_pos] <= '9')) {
+      number = number * 10 + static_cast<std::size_t>(Next() - '0');
+      if (number > kMaxRepetition) {
+        Fail(PatternError::kInvalidRepetition);
+        return 0;
+      }
+    }
+    return number;
+  }
+
+  /// atom{n}, atom{n,} or atom{n,m}, the '{' being already consumed
+  constexpr auto ParseCount(NfaFragment atom) -> NfaFragment {
+    const std::size_t min = ParseNumber();
+    std::size_t max = min;
+    if (Accept(',')) {
+      max = Peek('}') ? kNoState : ParseNumber();
+    }
+    if (not Failed() and (not Accept('}') or (min > max))) {
+      return Fail(PatternError::kInvalidRepetition);
+    }
+    if (Failed()) return {};
+
+    // All copies are cloned BEFORE being linked together
+    const std::size_t last = m_states.size();
+    const std::size_t copies = (max == kNoState) ? std::max(min, std::size_t{1})
+                                                 : max;
+    if (copies == 0) return Empty();
+
+    std::vector<NfaFragment> parts = {atom};
+    for (std::size_t i = 1; i < copies; ++i) {
+      parts.push_back(Clone(atom, last));
+    }
+
+    NfaFragment result = Empty();
+    for (std::size_t i = 0; i < copies; ++i) {
+      NfaFragment part = parts[i];
+      if ((max == kNoState) and (i + 1 == copies)) {
+        part = (min == 0) ? Star(part) : Plus(part);
+      } else if (i >= min) {
+        part = Optional(part);
+      }
+      result = Concatenate(result, part);
+    }
+    return result;
+  }
+
+  constexpr auto ParseAtom() -> NfaFragment {
+    const char c = Next();
+    switch (c) {
+      case '(': {
+        // Only non capturing groups, captures being meaningless here
+        if (Accept('?') and not Accept(':')) {
+          return Fail(PatternError::kUnsupported);
+        }
+        const NfaFragment group = ParseAlternation();
+        if (not Failed() and not Accept(')')) {
+          return Fail(PatternError::kUnbalancedGroup);
+        }
+        return group;
+      }
+      case '[': {
+        const CharClass set = ParseClass();
+        return Atom(set);
+      }
+      case '.': {
+        // ECMAScript line terminators, but the UTF-8 U+2028/U+2029
+        CharClass any_but_newline = CharClass::Of('\n');
+        any_but_newline.Insert('\r');
+        any_but_newline.Negate();
+        return Atom(any_but_newline);
+      }
+      case '*':
+      case '+':
+      case '?':
+      case '{':
+        return Fail(PatternError::kNothingToRepeat);
+      case '$':
+        // Matching always uses the whole string: a trailing '$' is implied
+        if (AtEnd()) return Empty();
+        return Fail(PatternError::kUnsupported);
+      case '^':
+        return Fail(PatternError::kUnsupported);
+      case '\\': {
+        const CharClass set = ParseEscape().set;
+        return Atom(set);
+      }
+      default:
+        return Atom(CharClass::Of(c));
+    }
+  }
+
+  /// Result of an escape sequence: its set, and its char when it's only one
+  struct Escaped {
+    CharClass set;
+    int single = -1;
+  };
+
+  static constexpr auto Single(char c) -> Escaped {
+    return {CharClass::Of(c), static_cast<std::uint8_t>(c)};
+  }
+
+  static constexpr auto HexDigit(char c) noexcept -> int {
+    if ((c >= '0') and (c <= '9')) return c - '0';
+    if ((c >= 'a') and (c <= 'f')) return c - 'a' + 10;
+    if ((c >= 'A') and (c <= 'F')) return c - 'A' + 10;
+    return -1;
+  }
+
+  /// Parse a regex escape sequence, the '\' being already consumed
+  constexpr auto ParseEscape() -> Escaped {
+    if (AtEnd()) {
+      Fail(PatternError::kInvalidEscape);
+      return {};
+    }
+
+    const char c = Next();
+    Escaped escaped;
+    switch (c) {
+      case 'd':
+      case 'D':
+        escaped.set.Insert('0', '9');
+        break;
+      case 'w':
+      case 'W':
+        escaped.set.Insert('a', 'z');
+        escaped.set.Insert('A', 'Z');
+        escaped.set.Insert('0', '9');
+        escaped.set.Insert('_');
+        break;
+      case 's':
+      case 'S':
+        for (const char space : {' ', '\t', '\n', '\r', '\f', '\v'}) {
+          escaped.set.Insert(space);
+        }
+        break;
+      case 'n':
+        return Single('\n');
+      case 't':
+        return Single('\t');
+      case 'r':
+        return Single('\r');
+      case 'f':
+        return Single('\f');
+      case 'v':
+        return Single('\v');
+      case '0':
+        return Single('\0');
+      case 'x': {
+        const int high = AtEnd() ? -1 : HexDigit(Next());
+        const int low = AtEnd() ? -1 : HexDigit(Next());
+        if ((high < 0) or (low < 0)) {
+          Fail(PatternError::kInvalidEscape);
+          return {};
+        }
+        return Single(static_cast<char>(high * 16 + low));
+      }
+      default:
+        // Back references (\1), word boundaries (\b), \p{...}, ...
+        if (((c >= 'a') and (c <= 'z')) or ((c >= 'A') and (c <= 'Z')) or
+            ((c >= '1') and (c <= '9'))) {
+          Fail(PatternError::kUnsupported);
+          return {};
+        }
+        return Single(c);
+    }
+
+    if ((c >= 'A') and (c <= 'Z')) escaped.set.Negate();
+    return escaped;
+  }
+
+  /// Parse one element of a [class]: a char or an escape sequence
+  constexpr auto ParseClassElement() -> Escaped {
+    const char c = Next();
+    if (c != '\\') return Single(c);
+
+    if (m_syntax == PatternSyntax::kRegex) return ParseEscape();
+    if (AtEnd()) {
+      Fail(PatternError::kInvalidEscape);
+      return {};
+    }
+    return Single(Next());
+  }
+
+  /// Parse a [class], the '[' being already consumed
+  constexpr auto ParseClass() -> CharClass {
+    const bool negate =
+        Accept('^') or ((m_syntax == PatternSyntax::kGlob) and Accept('!'));
+
+    CharClass set;
+    bool first = true;
+    while (not Failed()) {
+      if (AtEnd()) {
+        Fail(PatternError::kUnterminatedClass);
+        break;
+      }
+
+      // A ']' first is part of the class
+      if (not first and Accept(']')) break;
+      first = false;
+
+      // POSIX classes ([:alpha:], ...)
+      if (Peek('[') and (m_pos + 1 < m_pattern.size()) and
+          ((m_pattern[m_pos + 1] == ':') or (m_pattern[m_pos + 1] == '=') or
+           (m_pattern[m_pos + 1] == '.'))) {
+        ++m_pos;
+        Fail(PatternError::kUnsupported);
+        break;
+      }
+
+      const Escaped low = ParseClassElement();
+      if (Failed()) break;
+
+      // A '-' last is part of the class
+      const bool is_range = (low.single >= 0) and Peek('-') and
+                            (m_pos + 1 < m_pattern.size()) and
+                            (m_pattern[m_pos + 1] != ']');
+      if (not is_range) {
+        set.Insert(low.set);
+        continue;
+      }
+
+      ++m_pos;
+      const Escaped high = ParseClassElement();
+      if (Failed()) break;
+      if ((high.single < 0) or (high.single < low.single)) {
+        Fail(PatternError::kInvalidRange);
+        break;
+      }
+      set.Insert(static_cast<char>(low.single), static_cast<char>(high.single));
+    }
+
+    if (negate) set.Negate();
+    return set;
+  }
+
+  // Glob ///////////////////////////////////////////////////////////////////
+
+  /// \param[in] in_braces When true, stops at the ',' or '}' of the braces
+  constexpr auto ParseGlob(bool in_braces) -> NfaFragment {
+    NfaFragment result = Empty();
+    while (not Failed() and not AtEnd()) {
+      if (in_braces and (Peek(',') or Peek('}'))) break;
+
+      NfaFragment part;
+      switch (const char c = Next()) {
+        case '*':
+          part = Star(Atom(CharClass::Any()));
+          break;
+        case '?':
+          part = Atom(CharClass::Any());
+          break;
+        case '[': {
+          const CharClass set = ParseClass();
+          part = Atom(set);
+          break;
+        }
+        case '{':
+          part = ParseBraces();
+          break;
+        case '\\':
+          if (AtEnd()) return Fail(PatternError::kInvalidEscape);
+          part = Atom(CharClass::Of(Next()));
+          break;
+        default:
+          part = Atom(CharClass::Of(c));
+          break;
+      }
+      result = Concatenate(result, part);
+    }
+    return result;
+  }
+
+  /// {foo,bar}, the '{' being already consumed
+  constexpr auto ParseBraces() -> NfaFragment {
+    NfaFragment result = ParseGlob(true);
+    while (not Failed() and Accept(',')) {
+      const NfaFragment alternative = ParseGlob(true);
+      result = Alternate(result, alternative);
+    }
+    if (not Failed() and not Accept('}')) {
+      return Fail(PatternError::kUnbalancedGroup);
+    }
+    return result;
+  }
+
+  PatternSyntax m_syntax;
+  std::string_view m_pattern;
+  std::size_t m_pos = 0;
+
+  std::vector<NfaState> m_states;
+  PatternError m_error = PatternError::kNone;
+  std::size_t m_error_position = 0;
+};
+
+/// Sizes of a compiled pattern, used to size its DfaTables
+struct PatternInfo {
+  PatternError error = PatternError::kNone;
+  std::size_t error_position = 0;
+  std::size_t state_count = 0;
+  std::size_t class_count = 0;
+};
+
+/**
+ *  \brief Minimal DFA of a pattern, as transient vectors
+ *
+ *  States are numbered such that:
+ *  - 0 is the dead state (nothing can match anymore);
+ *  - 1 is the 'accept all' state, when any (everything matches from here);
+ *  Those are the 'decided' states, stopping the matching early.
+ */
+struct CompiledPattern {
+  PatternError error = PatternError::kNone;
+  std::size_t error_position = 0;
+
+  std::array<std::uint8_t, 256> classes{}; /*!< Class of each byte */
+  std::size_t class_count = 0;
+
+  std::size_t state_count = 0;
+  std::size_t decided_count = 1; /*!< Decided states: [0, decided_count) */
+  std::size_t start = 0;
+  std::vector<std::size_t> next; /*!< next[state * class_count + class] */
+  std::vector<bool> accepting;
+
+  constexpr auto Info() const noexcept -> PatternInfo {
+    return {error, error_position, state_count, class_count};
+  }
+};
+
+/// Add the states reachable through epsilon transitions to \a set
+constexpr void EpsilonClosure(const std::vector<NfaState>& nfa,
+                              std::vector<std::uint64_t>& set) {
+  std::vector<std::size_t> pending;
+  for (std::size_t i = 0; i < nfa.size(); ++i) {
+    if ((set[i / 64] >> (i % 64)) & 1) pending.push_back(i);
+  }
+
+  while (not pending.empty()) {
+    const std::size_t state = pending.back();
+    pending.pop_back();
+    for (const std::size_t eps : nfa[state].eps) {
+      if ((eps != kNoState) and not((set[eps / 64] >> (eps % 64)) & 1)) {
+        set[eps / 64] |= std::uint64_t{1} << (eps % 64);
+        pending.push_back(eps);
+      }
+    }
+  }
+}
+
+/**
+ *  \brief Split the bytes into classes, 2 bytes sharing a class when no
+ *         transition of the NFA tells them apart
+ *
+ *  \return std::size_t The number of classes
+ */
+constexpr auto SplitClasses(const std::vector<NfaState>& nfa,
+                            std::array<std::uint8_t, 256>& classes)
+    -> std::size_t {
+  std::size_t count = 1;
+  for (const NfaState& state : nfa) {
+    if (state.next == kNoState) continue;
+
+    // Class (old class, in/out of the set) -> new class
+    std::array<std::size_t, 512> split{};
+    std::fill(split.begin(), split.end(), kNoState);
+
+    std::size_t new_count = 0;
+    for (std::size_t byte = 0; byte < 256; ++byte) {
+      const std::size_t key =
+          classes[byte] * 2 + (state.on.Contains(static_cast<char>(byte)));
+      if (split[key] == kNoState) split[key] = new_count++;
+      classes[byte] = static_cast<std::uint8_t>(split[key]);
+    }
+    count = new_count;
+  }
+  return count;
+}
+
+/**
+ *  \brief Compile \a pattern into a minimal DFA
+ *
+ *  \note Only meant to be evaluated at compile time
+ */
+constexpr auto CompilePattern(PatternSyntax syntax, std::string_view pattern)
+    -> CompiledPattern {
+  CompiledPattern compiled;
+
+  PatternParser parser(syntax, pattern);
+  const NfaFragment whole = parser.Parse();
+  if (parser.Error() != PatternError::kNone) {
+    compiled.error = parser.Error();
+    compiled.error_position = parser.ErrorPosition();
+    return compiled;
+  }
+
+  const std::vector<NfaState>& nfa = parser.States();
+  compiled.class_count = SplitClasses(nfa, compiled.classes);
+  const std::size_t classes = compiled.class_count;
+
+  std::array<char, 256> representative{};
+  for (std::size_t byte = 256; byte-- > 0;) {
+    representative[compiled.classes[byte]] = static_cast<char>(byte);
+  }
+
+  // Subset construction, the dead state (empty set) being 0
+  using StateSet = std::vector<std::uint64_t>;
+  const std::size_t words = (nfa.size() + 63) / 64;
+  std::vector<StateSet> sets = {StateSet(words, 0)};
+  std::vector<std::size_t> next;
+  std::vector<bool> accepting;
+
+  StateSet start(words, 0);
+  start[whole.start / 64] |= std::uint64_t{1} << (whole.start % 64);
+  EpsilonClosure(nfa, start);
+  sets.push_back(start);
+
+  for (std::size_t d = 0; d < sets.size(); ++d) {
+    const StateSet current = sets[d];
+    accepting.push_back((current[whole.end / 64] >> (whole.end % 64)) & 1);
+
+    for (std::size_t c = 0; c < classes; ++c) {
+      StateSet target(words, 0);
+      for (std::size_t w = 0; w < words; ++w) {
+        for (std::uint64_t bits = current[w]; bits != 0; bits &= bits - 1) {
+          const NfaState& state = nfa[w * 64 + std::countr_zero(bits)];
+          if ((state.next != kNoState) and
+              state.on.Contains(representative[c])) {
+            target[state.next / 64] |= std::uint64_t{1} << (state.next % 64);
+          }
+        }
+      }
+      EpsilonClosure(nfa, target);
+
+      const auto found = std::find(sets.begin(), sets.end(), target);
+      if (found != sets.end()) {
+        next.push_back(static_cast<std::size_t>(found - sets.begin()));
+      } else if (sets.size() >= kMaxDfaStates) {
+        compiled.error = PatternError::kTooManyStates;
+        compiled.error_position = pattern.size();
+        return compiled;
+      } else {
+        next.push_back(sets.size());
+        sets.push_back(target);
+      }
+    }
+  }
+
+  // Moore minimization: split the states by (accepting, group of each next
+  // state) until the groups are stable
+  const std::size_t states = sets.size();
+  std::vector<std::size_t> group(states, 0);
+  std::size_t group_count = 0;
+  for (std::size_t s = 0; s < states; ++s) {
+    group[s] = accepting[s] ? 1 : 0;
+  }
+
+  while (true) {
+    std::vector<std::size_t> new_group(states, 0);
+    std::vector<std::size_t> representatives;
+
+    for (std::size_t s = 0; s < states; ++s) {
+      const auto same_group = [&](std::size_t r) {
+        if (group[r] != group[s]) return false;
+        for (std::size_t c = 0; c < classes; ++c) {
+          if (group[next[r * classes + c]] != group[next[s * classes + c]]) {
+            return false;
+          }
+        }
+        return true;
+      };
+
+      const auto found = std::find_if(representatives.begin(),
+                                      representatives.end(), same_group);
+      new_group[s] = static_cast<std::size_t>(found - representatives.begin());
+      if (found == representatives.end()) representatives.push_back(s);
+    }
+
+    group = new_group;
+    if (representatives.size() == group_count) break;
+    group_count = representatives.size();
+  }
+
+  // Renumber the groups: dead, accept all (if any), then the others
+  std::vector<std::size_t> renumber(group_count, kNoState);
+  renumber[group[0]] = 0;
+  std::size_t numbered = 1;
+
+  for (std::size_t s = 0; s < states; ++s) {
+    const auto loops = [&] {
+      for (std::size_t c = 0; c < classes; ++c) {
+        if (group[next[s * classes + c]] != group[s]) return false;
+      }
+      return true;
+    };
+    if (accepting[s] and loops()) {
+      renumber[group[s]] = numbered++;
+      break;
+    }
+  }
+  compiled.decided_count = numbered;
+
+  for (std::size_t s = 0; s < states; ++s) {
+    if (renumber[group[s]] == kNoState) renumber[group[s]] = numbered++;
+  }
+
+  compiled.state_count = group_count;
+  compiled.start = renumber[group[1]];
+  compiled.next.resize(group_count * classes);
+  compiled.accepting.resize(group_count);
+  for (std::size_t s = 0; s < states; ++s) {
+    const std::size_t state = renumber[group[s]];
+    compiled.accepting[state] = accepting[s];
+    for (std::size_t c = 0; c < classes; ++c) {
+      compiled.next[state * classes + c] =
+          renumber[group[next[s * classes + c]]];
+    }
+  }
+
+  return compiled;
+}
+
+/**
+ *  \brief DFA of a pattern, flattened into arrays
+ *
+ *  Transitions are stored premultiplied (the offset of the next state row,
+ *  instead of its index) such that each byte costs 2 loads and an add.
+ *
+ *  \tparam States Number of states of the DFA
+ *  \tparam Classes Number of byte classes
+ */
+template <std::size_t States, std::size_t Classes>
+struct DfaTables {
+  using Offset = std::conditional_t<(States * Classes <= 0x10000),
+                                    std::uint16_t, std::uint32_t>;
+
+  std::array<std::uint8_t, 256> classes{};
+  std::array<Offset, States * Classes> next{};
+  std::array<bool, States> accepting{};
+  std::size_t start = 0;       /*!< Offset of the start state */
+  std::size_t decided_end = 0; /*!< Offsets below are decided states */
+
+  constexpr auto IsMatching(std::string_view str) const noexcept -> bool {
+    std::size_t offset = start;
+    for (const char c : str) {
+      if (offset < decided_end) break;
+      offset = next[offset + classes[static_cast<std::uint8_t>(c)]];
+    }
+    return accepting[offset / Classes];
+  }
+};
+
+/**
+ *  \brief Flatten the \a compiled pattern into DfaTables
+ *
+ *  \pre compiled.Info() gives States/Classes, unless compiled.error is set
+ */
+template <std::size_t States, std::size_t Classes>
+constexpr auto MakeDfaTables(const CompiledPattern& compiled)
+    -> DfaTables<States, Classes> {
+  using Tables = DfaTables<States, Classes>;
+  Tables tables;
+  if (compiled.error != PatternError::kNone) return tables;
+
+  tables.classes = compiled.classes;
+  for (std::size_t i = 0; i < compiled.next.size(); ++i) {
+    tables.next[i] =
+        static_cast<typename Tables::Offset>(compiled.next[i] * Classes);
+  }
+  for (std::size_t s = 0; s < States; ++s) {
+    tables.accepting[s] = compiled.accepting[s];
+  }
+  tables.start = compiled.start * Classes;
+  tables.decided_end = compiled.decided_count * Classes;
+  return tables;
+}
+
+}  // namespace swstr::details
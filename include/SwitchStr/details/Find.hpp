@@ -0,0 +1,295 @@
+#pragma once
+
+#include <bit>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <span>
+#include <string_view>
+#include <type_traits>
+
+#include "SwitchStr/details/Cpu.hpp"
+
+namespace swstr::details {
+
+/**
+ *  \file
+ *  \brief Substring search kernels, used by Contains/ContainsR
+ *
+ *  The SIMD kernels implement the "first/last byte filter": for W (16/32)
+ *  candidate positions at once, the first needle char is compared against the
+ *  haystack at [i, i + W) and the last needle char against the haystack at
+ *  [i + n - 1, i + n - 1 + W). Only the positions where both match are then
+ *  verified with a memcmp, which makes long haystacks full of partial
+ *  matches of the needle (prefix only) cheap to scan.
+ *  The remaining candidates (less than W) are checked using a last block
+ *  overlapping the previous one, ignoring the candidates already checked.
+ *
+ *  All kernels return the same results as std::string_view::find/rfind.
+ */
+
+/// Verify that the needle middle chars match at \a candidate
+inline auto VerifyMiddle(const char* candidate,
+                         std::string_view needle) noexcept -> bool {
+  return (needle.size() <= 2) or
+         (std::memcmp(candidate + 1, needle.data() + 1, needle.size() - 2) ==
+          0);
+}
+
+#if SwitchStr_X86_DISPATCH
+/// Mask of the candidates [i, i + 16) whose first AND last chars match
+SwitchStr_TARGET("sse2")
+inline auto CandidatesMaskSse2(const char* data, std::size_t i,
+                               std::string_view needle) noexcept
+    -> std::uint32_t {
+  const __m128i block_first =
+      _mm_loadu_si128(reinterpret_cast<const __m128i*>(data + i));
+  const __m128i block_last = _mm_loadu_si128(
+      reinterpret_cast<const __m128i*>(data + i + needle.size() - 1));
+
+  const __m128i first_match =
+      _mm_cmpeq_epi8(_mm_set1_epi8(needle.front()), block_first);
+  const __m128i last_match =
+      _mm_cmpeq_epi8(_mm_set1_epi8(needle.back()), block_last);
+
+  return static_cast<std::uint32_t>(
+      _mm_movemask_epi8(_mm_and_si128(first_match, last_match)));
+}
+
+/// \pre 0 < needle.size() <= hay.size()
+SwitchStr_TARGET("sse2")
+inline auto FindSse2(std::string_view hay, std::string_view needle) noexcept
+    -> std::size_t {
+  const std::size_t candidates = hay.size() - needle.size() + 1;
+  if (candidates < 16) return hay.find(needle);
+
+  std::size_t i = 0;
+  for (; i + 16 <= candidates; i += 16) {
+    std::uint32_t mask = CandidatesMaskSse2(hay.data(), i, needle);
+    while (mask != 0) {
+      const std::size_t candidate = i + std::countr_zero(mask);
+      if (VerifyMiddle(hay.data() + candidate, needle)) return candidate;
+      mask &= mask - 1;
+    }
+  }
+
+  // Last block overlaps the previous one, whose candidates are discarded
+  if (i < candidates) {
+    const std::size_t last = candidates - 16;
+    std::uint32_t mask = CandidatesMaskSse2(hay.data(), last, needle) &
+                         (~std::uint32_t{0} << (i - last));
+    while (mask != 0) {
+      const std::size_t candidate = last + std::countr_zero(mask);
+      if (VerifyMiddle(hay.data() + candidate, needle)) return candidate;
+      mask &= mask - 1;
+    }
+  }
+
+  return std::string_view::npos;
+}
+
+/// \pre 0 < needle.size() <= hay.size()
+SwitchStr_TARGET("sse2")
+inline auto RFindSse2(std::string_view hay, std::string_view needle) noexcept
+    -> std::size_t {
+  const std::size_t candidates = hay.size() - needle.size() + 1;
+  if (candidates < 16) return hay.rfind(needle);
+
+  // Candidates positions left to check: [0, end)
+  std::size_t end = candidates;
+  for (; end >= 16; end -= 16) {
+    std::uint32_t mask = CandidatesMaskSse2(hay.data(), end - 16, needle);
+    while (mask != 0) {
+      const std::size_t bit = 31 - std::countl_zero(mask);
+      if (VerifyMiddle(hay.data() + end - 16 + bit, needle)) {
+        return end - 16 + bit;
+      }
+      mask &= ~(std::uint32_t{1} << bit);
+    }
+  }
+
+  // First block overlaps the next one, whose candidates are discarded
+  if (end > 0) {
+    std::uint32_t mask = CandidatesMaskSse2(hay.data(), 0, needle) &
+                         ((std::uint32_t{1} << end) - 1);
+    while (mask != 0) {
+      const std::size_t bit = 31 - std::countl_zero(mask);
+      if (VerifyMiddle(hay.data() + bit, needle)) return bit;
+      mask &= ~(std::uint32_t{1} << bit);
+    }
+  }
+
+  return std::string_view::npos;
+}
+
+/// Mask of the candidates [i, i + 32) whose first AND last chars match
+SwitchStr_TARGET("avx2")
+inline auto CandidatesMaskAvx2(const char* data, std::size_t i,
+                               std::string_view needle) noexcept
+    -> std::uint32_t {
+  const __m256i block_first =
+      _mm256_loadu_si256(reinterpret_cast<const __m256i*>(data + i));
+  const __m256i block_last = _mm256_loadu_si256(
+      reinterpret_cast<const __m256i*>(data + i + needle.size() - 1));
+
+  const __m256i first_match =
+      _mm256_cmpeq_epi8(_mm256_set1_epi8(needle.front()), block_first);
+  const __m256i last_match =
+      _mm256_cmpeq_epi8(_mm256_set1_epi8(needle.back()), block_last);
+
+  return static_cast<std::uint32_t>(
+      _mm256_movemask_epi8(_mm256_and_si256(first_match, last_match)));
+}
+
+/// \pre 0 < needle.size() <= hay.size()
+SwitchStr_TARGET("avx2")
+inline auto FindAvx2(std::string_view hay, std::string_view needle) noexcept
+    -> std::size_t {
+  const std::size_t candidates = hay.size() - needle.size() + 1;
+  if (candidates < 32) return FindSse2(hay, needle);
+
+  std::size_t i = 0;
+  for (; i + 32 <= candidates; i += 32) {
+    std::uint32_t mask = CandidatesMaskAvx2(hay.data(), i, needle);
+    while (mask != 0) {
+      const std::size_t candidate = i + std::countr_zero(mask);
+      if (VerifyMiddle(hay.data() + candidate, needle)) return candidate;
+      mask &= mask - 1;
+    }
+  }
+
+  // Last block overlaps the previous one, whose candidates are discarded
+  if (i < candidates) {
+    const std::size_t last = candidates - 32;
+    std::uint32_t mask = CandidatesMaskAvx2(hay.data(), last, needle) &
+                         (~std::uint32_t{0} << (i - last));
+    while (mask != 0) {
+      const std::size_t candidate = last + std::countr_zero(mask);
+      if (VerifyMiddle(hay.data() + candidate, needle)) return candidate;
+      mask &= mask - 1;
+    }
+  }
+
+  return std::string_view::npos;
+}
+
+/// \pre 0 < needle.size() <= hay.size()
+SwitchStr_TARGET("avx2")
+inline auto RFindAvx2(std::string_view hay, std::string_view needle) noexcept
+    -> std::size_t {
+  const std::size_t candidates = hay.size() - needle.size() + 1;
+  if (candidates < 32) return RFindSse2(hay, needle);
+
+  // Candidates positions left to check: [0, end)
+  std::size_t end = candidates;
+  for (; end >= 32; end -= 32) {
+    std::uint32_t mask = CandidatesMaskAvx2(hay.data(), end - 32, needle);
+    while (mask != 0) {
+      const std::size_t bit = 31 - std::countl_zero(mask);
+      if (VerifyMiddle(hay.data() + end - 32 + bit, needle)) {
+        return end - 32 + bit;
+      }
+      mask &= ~(std::uint32_t{1} << bit);
+    }
+  }
+
+  // First block overlaps the next one, whose candidates are discarded
+  if (end > 0) {
+    std::uint32_t mask = CandidatesMaskAvx2(hay.data(), 0, needle) &
+                         ((std::uint32_t{1} << end) - 1);
+    while (mask != 0) {
+      const std::size_t bit = 31 - std::countl_zero(mask);
+      if (VerifyMiddle(hay.data() + bit, needle)) return bit;
+      mask &= ~(std::uint32_t{1} << bit);
+    }
+  }
+
+  return std::string_view::npos;
+}
+#endif
+
+/**
+ *  \brief Same as hay.find(needle), using the best kernel available
+ */
+constexpr auto Find(std::string_view hay, std::string_view needle) noexcept
+    -> std::size_t {
+#if SwitchStr_X86_DISPATCH
+  if (not std::is_constant_evaluated() and not needle.empty() and
+      (needle.size() <= hay.size())) {
+    if (cpu::HasAvx2()) {
+      return FindAvx2(hay, needle);
+    } else {
+      return FindSse2(hay, needle);
+    }
+  }
+#endif
+  return hay.find(needle);
+}
+
+/**
+ *  \brief Same as hay.rfind(needle), using the best kernel available
+ */
+constexpr auto RFind(std::string_view hay, std::string_view needle) noexcept
+    -> std::size_t {
+#if SwitchStr_X86_DISPATCH
+  if (not std::is_constant_evaluated() and not needle.empty() and
+      (needle.size() <= hay.size())) {
+    if (cpu::HasAvx2()) {
+      return RFindAvx2(hay, needle);
+    } else {
+      return RFindSse2(hay, needle);
+    }
+  }
+#endif
+  return hay.rfind(needle);
+}
+
+/**
+ *  \brief Prefetch the data of the string processed a few iterations after
+ *         strs[i], hiding the cache misses of batches of scattered strings
+ */
+inline void PrefetchAhead(std::span<const std::string_view> strs,
+                          std::size_t i) noexcept {
+  constexpr std::size_t kDistance = 8;
+  if (i + kDistance < strs.size()) cpu::Prefetch(strs[i + kDistance].data());
+}
+
+/**
+ *  \brief Batch version of Find() (or RFind() when Reverse), calling
+ *         on_result(i, pos) with the result of each strs[i]
+ *
+ *  \note The kernel is selected once for the whole batch
+ */
+template <bool Reverse, typename OnResult>
+void FindEach(std::span<const std::string_view> strs, std::string_view needle,
+              OnResult&& on_result) {
+  const auto scan = [&](auto kernel) {
+    for (std::size_t i = 0; i < strs.size(); ++i) {
+      PrefetchAhead(strs, i);
+      const std::string_view hay = strs[i];
+      if (needle.empty() or (needle.size() > hay.size())) {
+        on_result(i, Reverse ? hay.rfind(needle) : hay.find(needle));
+      } else {
+        on_result(i, kernel(hay, needle));
+      }
+    }
+  };
+
+#if SwitchStr_X86_DISPATCH
+  if (cpu::HasAvx2()) {
+    scan([](std::string_view hay, std::string_view n) {
+      return Reverse ? RFindAvx2(hay, n) : FindAvx2(hay, n);
+    });
+  } else {
+    scan([](std::string_view hay, std::string_view n) {
+      return Reverse ? RFindSse2(hay, n) : FindSse2(hay, n);
+    });
+  }
+#else
+  scan([](std::string_view hay, std::string_view n) {
+    return Reverse ? hay.rfind(n) : hay.find(n);
+  });
+#endif
+}
+
+}  // namespace swstr::details
@@ -0,0 +1,121 @@
+#pragma once
+
+#include <algorithm>
+#include <array>
+#include <bit>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <string_view>
+#include <type_traits>
+#include <utility>
+
+namespace swstr::details {
+
+/**
+ *  \brief Read sizeof(Word) bytes starting at \a p as a little endian integer
+ */
+template <typename Word>
+constexpr auto LoadWord(const char* p) noexcept -> Word {
+  if (std::is_constant_evaluated() or
+      (std::endian::native != std::endian::little)) {
+    Word v = 0;
+    for (std::size_t i = 0; i < sizeof(Word); ++i) {
+      v |= static_cast<Word>(Word{static_cast<std::uint8_t>(p[i])} << (8 * i));
+    }
+    return v;
+  } else {
+    Word v = 0;
+    std::memcpy(&v, p, sizeof(Word));
+    return v;
+  }
+}
+
+/**
+ *  \brief Pattern of N bytes, known at compile time, compared without any
+ *         loop nor call
+ *
+ *  The pattern is split, at construction, into the words compared:
+ *  - N <= 16: 1 or 2 OVERLAPPING loads of 1/2/4/8 bytes (i.e. 11 bytes are
+ *    compared with the 8 bytes at [0, 8) and the 8 bytes at [3, 11));
+ *  - N <= kMaxUnrolled: ceil(N / 8) loads of 8 bytes, the last one
+ *    overlapping, unrolled;
+ *  - Otherwise: a memcmp() of the constant size N;
+ *
+ *  The differences of all words are OR-ed together, such that there is a
+ *  single branch per comparison.
+ *
+ *  \note Meant to be used as a static constexpr, such that the pattern words
+ *        are constants folded into the comparisons
+ *
+ *  \tparam N Number of bytes of the pattern
+ */
+template <std::size_t N>
+class FixedBytes {
+ public:
+  /// Longest pattern compared with unrolled loads
+  static constexpr std::size_t kMaxUnrolled = 64;
+
+  /**
+   *  \brief Construct the pattern from the N bytes at \a pattern
+   */
+  constexpr explicit FixedBytes(const char* pattern) noexcept {
+    for (std::size_t i = 0; i < N; ++i) {
+      m_bytes[i] = pattern[i];
+    }
+    for (std::size_t i = 0; i < m_words.size(); ++i) {
+      m_words[i] = LoadWord<Word>(m_bytes.data() + OffsetOf(i));
+    }
+  }
+
+  /// The pattern
+  constexpr auto View() const noexcept -> std::string_view {
+    return std::string_view(m_bytes.data(), N);
+  }
+
+  /**
+   *  \brief True when the N bytes starting at \a data equal the pattern
+   */
+  constexpr auto IsAt(const char* data) const noexcept -> bool {
+    if (std::is_constant_evaluated()) {
+      for (std::size_t i = 0; i < N; ++i) {
+        if (data[i] != m_bytes[i]) return false;
+      }
+      return true;
+    } else if constexpr (N == 0) {
+      return true;
+    } else if constexpr (N > kMaxUnrolled) {
+      return std::memcmp(data, m_bytes.data(), N) == 0;
+    } else {
+      return Diff(data, std::make_index_sequence<kWords>{}) == 0;
+    }
+  }
+
+ private:
+  /// The widest word not larger than the pattern
+  using Word = std::conditional_t<
+      (N >= 8), std::uint64_t,
+      std::conditional_t<
+          (N >= 4), std::uint32_t,
+          std::conditional_t<(N >= 2), std::uint16_t, std::uint8_t>>>;
+
+  static constexpr std::size_t kWords =
+      (N == 0) ? 0 : (N + sizeof(Word) - 1) / sizeof(Word);
+
+  /// Offset of the i-th word, the last one ending with the pattern
+  static constexpr auto OffsetOf(std::size_t i) noexcept -> std::size_t {
+    return std::min(i * sizeof(Word), N - sizeof(Word));
+  }
+
+  template <std::size_t... I>
+  auto Diff(const char* data, std::index_sequence<I...>) const noexcept
+      -> Word {
+    return static_cast<Word>(
+        ((LoadWord<Word>(data + OffsetOf(I)) ^ m_words[I]) | ...));
+  }
+
+  std::array<char, N> m_bytes = {};
+  std::array<Word, (N > kMaxUnrolled) ? 0 : kWords> m_words = {};
+};
+
+}  // namespace swstr::details
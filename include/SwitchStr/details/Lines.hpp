@@ -0,0 +1,113 @@
+#pragma once
+
+#include <bit>
+#include <cstddef>
+#include <cstdint>
+#include <string_view>
+
+#include "SwitchStr/details/Cpu.hpp"
+
+namespace swstr::details {
+
+/**
+ *  \file
+ *  \brief Byte/line splitting kernels, scanning the text 16/32 bytes at a time
+ *
+ *  Contrary to calling memchr() once per line, each block of the text is
+ *  loaded and compared ONCE, producing a mask of all the separators it
+ *  contains, such that short lines (i.e. logs) don't pay a call each.
+ */
+
+/// Call on_pos(i) for each text[i] == c, scalar version
+template <typename OnPos>
+void ForEachByteScalar(std::string_view text, char c, OnPos&& on_pos) {
+  for (std::size_t i = 0; i < text.size(); ++i) {
+    if (text[i] == c) on_pos(i);
+  }
+}
+
+#if SwitchStr_X86_DISPATCH
+/// Call on_pos(i) for each text[i] == c, 16 bytes at a time
+template <typename OnPos>
+SwitchStr_TARGET("sse2")
+void ForEachByteSse2(std::string_view text, char c, OnPos&& on_pos) {
+  const __m128i separator = _mm_set1_epi8(c);
+
+  std::size_t i = 0;
+  for (; i + 16 <= text.size(); i += 16) {
+    const __m128i block =
+        _mm_loadu_si128(reinterpret_cast<const __m128i*>(text.data() + i));
+    auto mask = static_cast<std::uint32_t>(
+        _mm_movemask_epi8(_mm_cmpeq_epi8(separator, block)));
+    while (mask != 0) {
+      on_pos(i + std::countr_zero(mask));
+      mask &= mask - 1;
+    }
+  }
+
+  for (; i < text.size(); ++i) {
+    if (text[i] == c) on_pos(i);
+  }
+}
+
+/// Call on_pos(i) for each text[i] == c, 32 bytes at a time
+template <typename OnPos>
+SwitchStr_TARGET("avx2")
+void ForEachByteAvx2(std::string_view text, char c, OnPos&& on_pos) {
+  const __m256i separator = _mm256_set1_epi8(c);
+
+  std::size_t i = 0;
+  for (; i + 32 <= text.size(); i += 32) {
+    const __m256i block = _mm256_loadu_si256(
+        reinterpret_cast<const __m256i*>(text.data() + i));
+    auto mask = static_cast<std::uint32_t>(
+        _mm256_movemask_epi8(_mm256_cmpeq_epi8(separator, block)));
+    while (mask != 0) {
+      on_pos(i + std::countr_zero(mask));
+      mask &= mask - 1;
+    }
+  }
+
+  auto on_tail_pos = [&](std::size_t pos) { on_pos(i + pos); };
+  ForEachByteSse2(text.substr(i), c, on_tail_pos);
+}
+#endif
+
+/**
+ *  \brief Call on_pos(i) for each text[i] == c, in order, using the best
+ *         kernel available
+ */
+template <typename OnPos>
+void ForEachByte(std::string_view text, char c, OnPos&& on_pos) {
+#if SwitchStr_X86_DISPATCH
+  if (cpu::HasAvx2()) {
+    ForEachByteAvx2(text, c, on_pos);
+  } else {
+    ForEachByteSse2(text, c, on_pos);
+  }
+#else
+  ForEachByteScalar(text, c, on_pos);
+#endif
+}
+
+/**
+ *  \brief Call on_line(line) for each '\n' terminated line of \a text (the
+ *         '\n' being excluded), without any copy
+ *
+ *  \note The last line is reported even without a trailing '\n', unless it
+ *        is empty (like std::getline)
+ */
+template <typename OnLine>
+void ForEachLine(std::string_view text, OnLine&& on_line) {
+  std::size_t begin = 0;
+  ForEachByte(text, '\n', [&](std::size_t pos) {
+    on_line(std::string_view(text.data() + begin, pos - begin));
+    begin = pos + 1;
+  });
+
+  if (begin < text.size()) {
+    on_line(std::string_view(text.data() + begin, text.size() - begin));
+  }
+}
+
+}  // namespace swstr::details
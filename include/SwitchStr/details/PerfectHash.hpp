@@ -0,0 +1,459 @@
+#pragma once
+
+#include <algorithm>
+#include <array>
+#include <bit>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <limits>
+#include <string_view>
+#include <type_traits>
+
+#include "SwitchStr/details/Ascii.hpp"
+
+namespace swstr::details {
+
+/**
+ *  \brief Seeded FNV-1a string hash, usable at compile time
+ *
+ *  \param[in] str The string to hash
+ *  \param[in] seed Value mixed into the FNV offset basis
+ *
+ *  \return std::uint64_t The hash of \a str
+ */
+constexpr auto HashStr(std::string_view str, std::uint64_t seed = 0) noexcept
+    -> std::uint64_t {
+  std::uint64_t h = 0xcbf29ce484222325ull ^ seed;
+  for (const char c : str) {
+    h ^= static_cast<std::uint8_t>(c);
+    h *= 0x100000001b3ull;
+  }
+  return h;
+}
+
+/**
+ *  \brief Same as HashStr(), ignoring the case of the ASCII letters of \a str
+ */
+constexpr auto IHashStr(std::string_view str, std::uint64_t seed = 0) noexcept
+    -> std::uint64_t {
+  std::uint64_t h = 0xcbf29ce484222325ull ^ seed;
+  for (const char c : str) {
+    h ^= static_cast<std::uint8_t>(ToLowerAscii(c));
+    h *= 0x100000001b3ull;
+  }
+  return h;
+}
+
+/**
+ *  \brief splitmix64 finalizer, use to derive well distributed bits from \a h
+ */
+constexpr auto MixHash(std::uint64_t h) noexcept -> std::uint64_t {
+  h ^= h >> 30;
+  h *= 0xbf58476d1ce4e5b9ull;
+  h ^= h >> 27;
+  h *= 0x94d049bb133111ebull;
+  h ^= h >> 31;
+  return h;
+}
+
+/**
+ *  \brief Read \a n <= 8 bytes starting at \a p as a little endian integer
+ */
+constexpr auto LoadLE(const char* p, std::size_t n) noexcept -> std::uint64_t {
+  if (std::is_constant_evaluated() or
+      (std::endian::native != std::endian::little)) {
+    std::uint64_t v = 0;
+    for (std::size_t i = 0; i < n; ++i) {
+      v |= std::uint64_t{static_cast<std::uint8_t>(p[i])} << (8 * i);
+    }
+    return v;
+  } else if (n == 8) {
+    std::uint64_t v = 0;
+    std::memcpy(&v, p, 8);
+    return v;
+  } else {
+    std::uint32_t v = 0;
+    std::memcpy(&v, p, 4);
+    return v;
+  }
+}
+
+/**
+ *  \brief Cheap string hash, looking only at the length and, at most, the
+ *         first and last 8 bytes of \a str
+ *
+ *  \note Only meant to be used on a KNOWN set of keys, after checking that it
+ *        doesn't collide on them (see PerfectHash)
+ *
+ *  \param[in] str The string to hash
+ *  \param[in] ignore_case When true, all bytes are OR-ed with 0x20 before
+ *                         hashing. This folds the ASCII letters, but also
+ *                         some other bytes together (i.e. '@' and '`'), equal
+ *                         hashes still need a verifying comparison.
+ */
+constexpr auto QuickHashStr(std::string_view str,
+                            bool ignore_case = false) noexcept
+    -> std::uint64_t {
+  const char* p = str.data();
+  const std::size_t n = str.size();
+  const std::uint64_t fold = ignore_case ? 0x2020202020202020ull : 0;
+
+  std::uint64_t a = 0;
+  std::uint64_t b = 0;
+  if (n >= 8) {
+    a = LoadLE(p, 8);
+    b = LoadLE(p + n - 8, 8);
+  } else if (n >= 4) {
+    a = LoadLE(p, 4);
+    b = LoadLE(p + n - 4, 4);
+  } else if (n > 0) {
+    a = static_cast<std::uint8_t>(p[0]) |
+        (std::uint64_t{static_cast<std::uint8_t>(p[n / 2])} << 8) |
+        (std::uint64_t{static_cast<std::uint8_t>(p[n - 1])} << 16);
+    a |= (fold & 0xffffff);
+  }
+  if (n >= 4) {
+    a |= fold;
+    b |= fold;
+  }
+
+  std::uint64_t h = (a ^ std::rotl(b, 29) ^ n) * 0x9e3779b97f4a7c15ull;
+  return h ^ (h >> 32);
+}
+
+/**
+ *  \brief String hash reading \a str 8 bytes at a time, for strings that
+ *         are NOT known in advance (unlike QuickHashStr(), every byte is
+ *         hashed)
+ */
+constexpr auto WordHashStr(std::string_view str) noexcept -> std::uint64_t {
+  constexpr std::uint64_t kMul = 0xff51afd7ed558ccdull;
+  const char* p = str.data();
+  const std::size_t n = str.size();
+
+  std::uint64_t h = 0x9e3779b97f4a7c15ull ^ n;
+  const auto mix = [&h](std::uint64_t word) {
+    h = (h ^ word) * kMul;
+    h ^= h >> 32;
+  };
+
+  if (n >= 8) {
+    for (std::size_t i = 0; i + 8 < n; i += 8) {
+      mix(LoadLE(p + i, 8));
+    }
+    // Last word overlaps the previous one
+    mix(LoadLE(p + n - 8, 8));
+  } else if (n >= 4) {
+    mix(LoadLE(p, 4) | (LoadLE(p + n - 4, 4) << 32));
+  } else if (n > 0) {
+    mix(static_cast<std::uint8_t>(p[0]) |
+        (std::uint64_t{static_cast<std::uint8_t>(p[n / 2])} << 8) |
+        (std::uint64_t{static_cast<std::uint8_t>(p[n - 1])} << 16));
+  }
+
+  return MixHash(h);
+}
+
+/**
+ *  \brief Compare \a n bytes of \a lhs and \a rhs for equality
+ *
+ *  \note Up to 16 bytes, this is done with 2 overlapping loads per operand
+ *        instead of calling memcmp
+ */
+constexpr auto EqualBytes(const char* lhs, const char* rhs,
+                          std::size_t n) noexcept -> bool {
+  if (std::is_constant_evaluated()) {
+    for (std::size_t i = 0; i < n; ++i) {
+      if (lhs[i] != rhs[i]) return false;
+    }
+    return true;
+  } else if (n >= 8 and n <= 16) {
+    return ((LoadLE(lhs, 8) ^ LoadLE(rhs, 8)) |
+            (LoadLE(lhs + n - 8, 8) ^ LoadLE(rhs + n - 8, 8))) == 0;
+  } else if (n >= 4 and n < 8) {
+    return ((LoadLE(lhs, 4) ^ LoadLE(rhs, 4)) |
+            (LoadLE(lhs + n - 4, 4) ^ LoadLE(rhs + n - 4, 4))) == 0;
+  } else if (n < 4) {
+    for (std::size_t i = 0; i < n; ++i) {
+      if (lhs[i] != rhs[i]) return false;
+    }
+    return true;
+  } else {
+    return std::memcmp(lhs, rhs, n) == 0;
+  }
+}
+
+/**
+ *  \brief Fixed pattern compared against many strings: the first/last 8 bytes
+ *         of the pattern are loaded once, such that each comparison only
+ *         loads the bytes of the string
+ */
+class PatternBytes {
+ public:
+  constexpr explicit PatternBytes(std::string_view pattern) noexcept
+      : m_pattern(pattern) {
+    const std::size_t n = pattern.size();
+    if (n >= 8) {
+      m_head = LoadLE(pattern.data(), 8);
+      m_tail = LoadLE(pattern.data() + n - 8, 8);
+    } else if (n >= 4) {
+      m_head = LoadLE(pattern.data(), 4);
+      m_tail = LoadLE(pattern.data() + n - 4, 4);
+    }
+  }
+
+  /// Size of the pattern
+  constexpr auto Size() const noexcept -> std::size_t {
+    return m_pattern.size();
+  }
+
+  /**
+   *  \brief True when the Size() bytes starting at \a data equal the pattern
+   */
+  constexpr auto IsAt(const char* data) const noexcept -> bool {
+    const std::size_t n = m_pattern.size();
+    if (n >= 8) {
+      return (((LoadLE(data, 8) ^ m_head) |
+               (LoadLE(data + n - 8, 8) ^ m_tail)) == 0) and
+             ((n <= 16) or EqualBytes(data + 8, m_pattern.data() + 8, n - 16));
+    } else if (n >= 4) {
+      return ((LoadLE(data, 4) ^ m_head) |
+              (LoadLE(data + n - 4, 4) ^ m_tail)) == 0;
+    } else {
+      return EqualBytes(data, m_pattern.data(), n);
+    }
+  }
+
+ private:
+  std::string_view m_pattern;
+  std::uint64_t m_head = 0;
+  std::uint64_t m_tail = 0;
+};
+
+/**
+ *  \brief NOT constexpr on purpose: reaching it during constant evaluation
+ *         turns the PerfectHash construction failure into a compile error
+ */
+inline void PerfectHashConstructionFailed() {}
+
+/**
+ *  \brief Minimal perfect hash table over N distinct keys, built at compile
+ *         time using the "hash, displace" scheme
+ *
+ *  Keys are first distributed into N buckets using the string hash. Then,
+ *  biggest bucket first, a displacement is searched for each bucket such that
+ *  all of its keys land in free slots of the table.
+ *
+ *  A lookup costs a single string hash, one displacement read and ONE
+ *  verifying string comparison. When the keys allow it (no collision), the
+ *  string hash used is QuickHashStr(), which only reads a few bytes of the
+ *  string, otherwise the full HashStr() is used.
+ *
+ *  When \a IgnoreCase, keys are hashed ignoring the case of their ASCII
+ *  letters, such that the same table is used by both Find() (exact) and
+ *  IFind() (ignoring the case). Keys must then be distinct ignoring the case.
+ *
+ *  \note The keys are NOT copied, only viewed: they must outlive the table
+ *        (string literals, FixedString NTTP, ...)
+ *
+ *  \tparam N Number of keys
+ *  \tparam IgnoreCase Hash the keys ignoring the ASCII case (see IFind())
+ */
+template <std::size_t N, bool IgnoreCase = false>
+struct PerfectHash {
+  /// Returned by Find() when the string is not one of the keys
+  static constexpr std::size_t npos = std::string_view::npos;
+
+  static constexpr std::size_t kBuckets = (N == 0 ? 1 : N);
+  static constexpr std::size_t kSlots = std::bit_ceil(2 * kBuckets);
+  static constexpr std::uint32_t kEmptySlot =
+      std::numeric_limits<std::uint32_t>::max();
+  static constexpr std::uint32_t kMaxDisplacement = 1u << 20;
+
+  /// What the construction does when it fails (see PerfectHash())
+  enum class OnFailure {
+    kCompileError, /*!< Compile error when constant evaluated */
+    kReport,       /*!< IsValid() is false, the caller must check it */
+  };
+
+  /**
+   *  \brief Build the table over \a keys
+   *
+   *  \note Keys MUST be distinct, otherwise (or if no displacement is found)
+   *        the construction fails: IsValid() is false and, by default, it is
+   *        a compile error when constant evaluated. An invalid table must not
+   *        be used (some keys are missing).
+   *
+   *  \param[in] keys All keys, the index of each key is returned by Find()
+   *  \param[in] on_failure What to do when the construction fails
+   */
+  constexpr explicit PerfectHash(
+      const std::array<std::string_view, N>& keys,
+      OnFailure on_failure = OnFailure::kCompileError)
+      : m_keys(keys) {
+    for (std::size_t i = 0; (i < N) and not m_full_hash; ++i) {
+      for (std::size_t j = i + 1; (j < N) and not m_full_hash; ++j) {
+        m_full_hash = (QuickHashStr(m_keys[i], IgnoreCase) ==
+                       QuickHashStr(m_keys[j], IgnoreCase));
+      }
+    }
+
+    std::array<std::size_t, N> bucket_of = {};
+    std::array<std::size_t, kBuckets> bucket_size = {};
+    for (std::size_t k = 0; k < N; ++k) {
+      bucket_of[k] = BucketOf(Hash(m_keys[k]));
+      ++bucket_size[bucket_of[k]];
+    }
+
+    std::array<std::size_t, kBuckets> order = {};
+    for (std::size_t b = 0; b < kBuckets; ++b) {
+      order[b] = b;
+    }
+    std::sort(order.begin(), order.end(),
+              [&](std::size_t lhs, std::size_t rhs) {
+                return (bucket_size[lhs] != bucket_size[rhs])
+                           ? (bucket_size[lhs] > bucket_size[rhs])
+                           : (lhs < rhs);
+              });
+
+    m_slots.fill(kEmptySlot);
+
+    for (const std::size_t b : order) {
+      if (bucket_size[b] == 0) break;
+
+      std::array<std::size_t, N> members = {};
+      std::size_t count = 0;
+      for (std::size_t k = 0; k < N; ++k) {
+        if (bucket_of[k] == b) members[count++] = k;
+      }
+
+      // Keys sharing their hash (i.e. duplicates) never land in distinct
+      // slots, whatever the displacement
+      bool placed = AreHashesDistinct(members, count);
+      if (placed) {
+        placed = false;
+        for (std::uint32_t d = 0; (d < kMaxDisplacement) and not placed;
+             ++d) {
+          placed = TryPlace(members, count, d);
+          if (placed) m_displacement[b] = d;
+        }
+      }
+
+      if (not placed) {
+        if (on_failure == OnFailure::kCompileError) {
+          PerfectHashConstructionFailed();
+        }
+        return;
+      }
+    }
+
+    m_is_valid = true;
+  }
+
+  /// False when the construction failed: the table must not be used
+  constexpr auto IsValid() const noexcept -> bool { return m_is_valid; }
+
+  /**
+   *  \brief Look for \a str inside the keys
+   *
+   *  \param[in] str The string we are looking for
+   *
+   *  \return std::size_t Index of the key equals to \a str, npos otherwise
+   */
+  constexpr auto Find(std::string_view str) const noexcept -> std::size_t {
+    const std::uint64_t h = Hash(str);
+    const std::uint32_t key = m_slots[SlotOf(h, m_displacement[BucketOf(h)])];
+    if ((key != kEmptySlot) and (m_keys[key].size() == str.size()) and
+        EqualBytes(m_keys[key].data(), str.data(), str.size())) {
+      return key;
+    } else {
+      return npos;
+    }
+  }
+
+  /**
+   *  \brief Look for \a str inside the keys, ignoring the ASCII case
+   *
+   *  \param[in] str The string we are looking for
+   *
+   *  \return std::size_t Index of the key equals to \a str (ignoring the
+   *          case), npos otherwise
+   */
+  constexpr auto IFind(std::string_view str) const noexcept -> std::size_t {
+    static_assert(IgnoreCase,
+                  "IFind() needs the keys to be hashed ignoring the case.");
+
+    const std::uint64_t h = Hash(str);
+    const std::uint32_t key = m_slots[SlotOf(h, m_displacement[BucketOf(h)])];
+    if ((key != kEmptySlot) and IEqualsAscii(m_keys[key], str)) {
+      return key;
+    } else {
+      return npos;
+    }
+  }
+
+  /// All keys, in the order of construction
+  constexpr auto Keys() const noexcept
+      -> const std::array<std::string_view, N>& {
+    return m_keys;
+  }
+
+ private:
+  static constexpr std::size_t kSlotsShift = 64 - std::countr_zero(kSlots);
+
+  constexpr auto Hash(std::string_view str) const noexcept -> std::uint64_t {
+    if constexpr (IgnoreCase) {
+      return m_full_hash ? MixHash(IHashStr(str)) : QuickHashStr(str, true);
+    } else {
+      return m_full_hash ? MixHash(HashStr(str)) : QuickHashStr(str);
+    }
+  }
+
+  static constexpr auto BucketOf(std::uint64_t h) noexcept -> std::size_t {
+    return static_cast<std::size_t>(((h >> 32) * kBuckets) >> 32);
+  }
+
+  static constexpr auto SlotOf(std::uint64_t h, std::uint32_t d) noexcept
+      -> std::size_t {
+    return static_cast<std::size_t>(((h ^ d) * 0xff51afd7ed558ccdull) >>
+                                    kSlotsShift);
+  }
+
+  constexpr auto AreHashesDistinct(const std::array<std::size_t, N>& members,
+                                   std::size_t count) const -> bool {
+    for (std::size_t i = 0; i < count; ++i) {
+      for (std::size_t j = 0; j < i; ++j) {
+        if (Hash(m_keys[members[i]]) == Hash(m_keys[members[j]])) {
+          return false;
+        }
+      }
+    }
+    return true;
+  }
+
+  constexpr auto TryPlace(const std::array<std::size_t, N>& members,
+                          std::size_t count, std::uint32_t d) -> bool {
+    std::array<std::size_t, N> slots = {};
+    for (std::size_t i = 0; i < count; ++i) {
+      slots[i] = SlotOf(Hash(m_keys[members[i]]), d);
+      if (m_slots[slots[i]] != kEmptySlot) return false;
+      for (std::size_t j = 0; j < i; ++j) {
+        if (slots[j] == slots[i]) return false;
+      }
+    }
+
+    for (std::size_t i = 0; i < count; ++i) {
+      m_slots[slots[i]] = static_cast<std::uint32_t>(members[i]);
+    }
+    return true;
+  }
+
+  std::array<std::string_view, N> m_keys;
+  bool m_full_hash = false;
+  bool m_is_valid = false;
+  std::array<std::uint32_t, kBuckets> m_displacement = {};
+  std::array<std::uint32_t, kSlots> m_slots = {};
+};
+
+}  // namespace swstr::details
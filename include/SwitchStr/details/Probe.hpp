@@ -0,0 +1,67 @@
+#pragma once
+
+#include <atomic>
+#include <cstdint>
+
+/**
+ *  \file
+ *  \brief Probes of the optional instrumentation (see Instrumentation.hpp),
+ *         as used by SwitchStr and the matchers
+ *
+ *  Only pulls the whole instrumentation in when
+ *  SwitchStr_ENABLE_INSTRUMENTATION is 1, such that the switches and matchers
+ *  don't pay for its includes (<map>, <mutex>, <ostream>, ...) otherwise.
+ */
+
+#ifndef SwitchStr_ENABLE_INSTRUMENTATION
+#define SwitchStr_ENABLE_INSTRUMENTATION 0
+#endif
+
+/// Evaluate the boolean expression, recording it into \a probe if enabled
+#if SwitchStr_ENABLE_INSTRUMENTATION
+#define SwitchStr_PROBE(probe, ...) \
+  (probe).Record([&]() -> bool { return (__VA_ARGS__); })
+#else
+#define SwitchStr_PROBE(probe, ...) (__VA_ARGS__)
+#endif
+
+/// Probes are forced inline, such that the instrumented cases stay inlined too,
+/// while their slow paths are kept out of line
+#if defined(__GNUC__) || defined(__clang__)
+#define SwitchStr_PROBE_INLINE __attribute__((always_inline)) inline
+#define SwitchStr_PROBE_NOINLINE __attribute__((noinline))
+#else
+#define SwitchStr_PROBE_INLINE inline
+#define SwitchStr_PROBE_NOINLINE
+#endif
+
+namespace swstr::instrument::details {
+
+/// Counter only written by the thread owning it, but read by any thread
+class Counter {
+ public:
+  Counter() = default;
+
+  /// Only used by the owning thread, when growing its counters
+  Counter(const Counter& other) noexcept : m_value(other.Load()) {}
+
+  void Add(std::uint64_t n) noexcept {
+    m_value.store(m_value.load(std::memory_order_relaxed) + n,
+                  std::memory_order_relaxed);
+  }
+
+  auto Load() const noexcept -> std::uint64_t {
+    return m_value.load(std::memory_order_relaxed);
+  }
+
+  void Reset() noexcept { m_value.store(0, std::memory_order_relaxed); }
+
+ private:
+  std::atomic<std::uint64_t> m_value = 0;
+};
+
+}  // namespace swstr::instrument::details
+
+#if SwitchStr_ENABLE_INSTRUMENTATION
+#include "SwitchStr/Instrumentation.hpp"
+#endif
@@ -0,0 +1,242 @@
+#pragma once
+
+#include <algorithm>
+#include <bit>
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include "SwitchStr/details/Cpu.hpp"
+#include "SwitchStr/details/PerfectHash.hpp"
+
+namespace swstr::details {
+
+/// Bits of the 16 control bytes of a group (bit i for byte i)
+struct GroupMasks {
+  std::uint32_t tags;  /*!< Bytes equal to the tag looked for */
+  std::uint32_t empty; /*!< Free bytes */
+};
+
+/// Byte of a free slot, the only control byte with its high bit set
+inline constexpr std::uint8_t kEmptyCtrl = 0x80;
+
+/// Number of slots (control bytes) probed at once
+inline constexpr std::size_t kGroupSize = 16;
+
+/// Masks of the group of 16 control bytes \a ctrl, looking for \a tag
+inline auto GroupMasksScalar(const std::uint8_t* ctrl,
+                             std::uint8_t tag) noexcept -> GroupMasks {
+  GroupMasks masks{0, 0};
+  for (std::size_t i = 0; i < kGroupSize; ++i) {
+    masks.tags |= std::uint32_t{ctrl[i] == tag} << i;
+    masks.empty |= std::uint32_t{ctrl[i] == kEmptyCtrl} << i;
+  }
+  return masks;
+}
+
+#if SwitchStr_X86_DISPATCH
+/// Same as GroupMasksScalar(), comparing the 16 bytes at once
+SwitchStr_TARGET("sse2")
+inline auto GroupMasksSse2(const std::uint8_t* ctrl,
+                           std::uint8_t tag) noexcept -> GroupMasks {
+  const __m128i group =
+      _mm_loadu_si128(reinterpret_cast<const __m128i*>(ctrl));
+  const __m128i tags =
+      _mm_cmpeq_epi8(group, _mm_set1_epi8(static_cast<char>(tag)));
+
+  // Tags never have their high bit set: it is set on free bytes only
+  return GroupMasks{static_cast<std::uint32_t>(_mm_movemask_epi8(tags)),
+                    static_cast<std::uint32_t>(_mm_movemask_epi8(group))};
+}
+#endif
+
+/// Masks of the group of 16 control bytes \a ctrl, looking for \a tag
+inline auto FindGroupMasks(const std::uint8_t* ctrl,
+                           std::uint8_t tag) noexcept -> GroupMasks {
+#if SwitchStr_X86_DISPATCH
+  return GroupMasksSse2(ctrl, tag);
+#else
+  return GroupMasksScalar(ctrl, tag);
+#endif
+}
+
+/**
+ *  \brief Open addressing hash table (Swiss table like), mapping exact keys
+ *         to an index, built at runtime with any number of keys
+ *
+ *  Slots are split into groups of 16, each slot having a control byte
+ *  holding 7 bits of the hash of its key (its tag), or kEmptyCtrl when free.
+ *  A lookup compares the tag to the 16 control bytes of a group at once (see
+ *  FindGroupMasks()), only comparing the keys whose tag matches, then moves
+ *  to the next group (triangular probing) until a group has a free slot.
+ *
+ *  Keys are copied into a single contiguous buffer, referenced by the slots.
+ *  The table grows (doubling its groups) when more than 7/8 of its slots are
+ *  used.
+ *
+ *  \note Lookups never modify the table
+ */
+class SwissTable {
+ public:
+  /// Index returned when a key is not found
+  static constexpr std::uint32_t kNotFound =
+      std::numeric_limits<std::uint32_t>::max();
+
+  SwissTable() = default;
+
+  /// Number of keys inserted
+  auto Size() const noexcept -> std::size_t { return m_size; }
+
+  /// Number of slots (used or free)
+  auto Capacity() const noexcept -> std::size_t { return m_ctrl.size(); }
+
+  /// Bytes of all the keys, contiguous
+  auto Bytes() const noexcept -> std::string_view { return m_bytes; }
+
+  /// Bytes allocated by the table (slots and keys)
+  auto MemoryUsage() const noexcept -> std::size_t {
+    return m_ctrl.capacity() + (m_slots.capacity() * sizeof(Slot)) +
+           m_bytes.capacity();
+  }
+
+  /// Make room for \a count keys, holding \a bytes bytes overall
+  void Reserve(std::size_t count, std::size_t bytes = 0) {
+    m_bytes.reserve(bytes);
+    if (count > MaxSize()) Rehash(GroupsFor(count));
+  }
+
+  /**
+   *  \brief Insert \a key, associated to \a index, unless already present
+   *
+   *  \return std::uint32_t The index associated to \a key: \a index when
+   *          inserted, the index of the first insertion otherwise
+   *
+   *  \throw std::length_error When the keys overflow 4 GiB
+   */
+  auto Insert(std::string_view key, std::uint32_t index) -> std::uint32_t {
+    const std::uint64_t h = WordHashStr(key);
+    if (const std::uint32_t found = Find(key, h); found != kNotFound) {
+      return found;
+    }
+
+    constexpr std::size_t kMaxBytes = std::numeric_limits<std::uint32_t>::max();
+    if (m_bytes.size() + key.size() > kMaxBytes) {
+      throw std::length_error("SwissTable keys exceed 4 GiB");
+    }
+    if (m_size + 1 > MaxSize()) {
+      Rehash(std::max<std::size_t>(2 * GroupCount(), 1));
+    }
+
+    const auto offset = static_cast<std::uint32_t>(m_bytes.size());
+    m_bytes.append(key);
+    Place(h, Slot{offset, static_cast<std::uint32_t>(key.size()), index});
+    ++m_size;
+    return index;
+  }
+
+  /**
+   *  \brief Look for \a str
+   *
+   *  \return std::uint32_t The index associated to \a str, kNotFound if none
+   */
+  auto Find(std::string_view str) const noexcept -> std::uint32_t {
+    return Find(str, WordHashStr(str));
+  }
+
+ private:
+  struct Slot {
+    std::uint32_t offset; /*!< Start of the key in m_bytes */
+    std::uint32_t size;   /*!< Size of the key */
+    std::uint32_t index;  /*!< Index associated to the key */
+  };
+
+  /// Control byte of the hash \a h: its 7 high bits
+  static constexpr auto TagOf(std::uint64_t h) noexcept -> std::uint8_t {
+    return static_cast<std::uint8_t>(h >> 57);
+  }
+
+  /// Groups needed to hold \a count keys under the maximum load factor
+  static auto GroupsFor(std::size_t count) noexcept -> std::size_t {
+    return std::bit_ceil((count * 8 / 7 + kGroupSize) / kGroupSize);
+  }
+
+  auto GroupCount() const noexcept -> std::size_t {
+    return m_ctrl.size() / kGroupSize;
+  }
+
+  /// Keys held before growing: 7/8 of the slots
+  auto MaxSize() const noexcept -> std::size_t {
+    return m_ctrl.size() - m_ctrl.size() / 8;
+  }
+
+  auto Find(std::string_view str, std::uint64_t h) const noexcept
+      -> std::uint32_t {
+    if (m_ctrl.empty()) return kNotFound;
+
+    const std::uint8_t tag = TagOf(h);
+    const std::size_t mask = GroupCount() - 1;
+    std::size_t group = h & mask;
+
+    for (std::size_t step = 1;; group = (group + step++) & mask) {
+      const std::size_t first = group * kGroupSize;
+      const GroupMasks masks = FindGroupMasks(m_ctrl.data() + first, tag);
+
+      for (std::uint32_t tags = masks.tags; tags != 0; tags &= tags - 1) {
+        const Slot& slot = m_slots[first + std::countr_zero(tags)];
+        if ((slot.size == str.size()) and
+            EqualBytes(m_bytes.data() + slot.offset, str.data(),
+                       str.size())) {
+          return slot.index;
+        }
+      }
+
+      // The triangular probing visits all groups: one of them has room
+      if (masks.empty != 0) return kNotFound;
+    }
+  }
+
+  /// Put \a slot in the first free slot found probing from \a h
+  void Place(std::uint64_t h, const Slot& slot) noexcept {
+    const std::size_t mask = GroupCount() - 1;
+    std::size_t group = h & mask;
+
+    for (std::size_t step = 1;; group = (group + step++) & mask) {
+      const std::size_t first = group * kGroupSize;
+      const GroupMasks masks = FindGroupMasks(m_ctrl.data() + first, 0);
+      if (masks.empty != 0) {
+        const std::size_t free = first + std::countr_zero(masks.empty);
+        m_ctrl[free] = TagOf(h);
+        m_slots[free] = slot;
+        return;
+      }
+    }
+  }
+
+  /// Move all the keys into a table of \a groups groups
+  void Rehash(std::size_t groups) {
+    std::vector<std::uint8_t> ctrl(groups * kGroupSize, kEmptyCtrl);
+    std::vector<Slot> slots(groups * kGroupSize);
+    ctrl.swap(m_ctrl);
+    slots.swap(m_slots);
+
+    for (std::size_t i = 0; i < ctrl.size(); ++i) {
+      if (ctrl[i] != kEmptyCtrl) {
+        const Slot& slot = slots[i];
+        Place(WordHashStr(std::string_view(m_bytes.data() + slot.offset,
+                                           slot.size)),
+              slot);
+      }
+    }
+  }
+
+  std::size_t m_size = 0;
+  std::vector<std::uint8_t> m_ctrl; /*!< Tag of each slot, or kEmptyCtrl */
+  std::vector<Slot> m_slots;
+  std::string m_bytes; /*!< All keys, contiguous */
+};
+
+}  // namespace swstr::details
@@ -0,0 +1,65 @@
+#pragma once
+
+#include <functional>
+#include <optional>
+#include <type_traits>
+#include <utility>
+
+namespace swstr::details {
+
+/**
+ *  \brief Result of the fluent switches (SwitchStr, TokenSwitch,
+ *         SymbolSwitch): the value of the winning case, if any, and the
+ *         Default() ending the switch
+ *
+ *  \tparam ResultType The type used and returned by the switch
+ */
+template <typename ResultType>
+class SwitchResult {
+ public:
+  template <typename T = ResultType>
+  constexpr operator T() const noexcept {
+    static_assert(sizeof(T) == 0, "Missing a Default() switch statement.");
+    return std::move(*m_res);
+  }
+
+  template <typename T>
+  constexpr decltype(auto) Default(T&& val) const& noexcept {
+    return m_res.value_or(std::forward<T>(val));
+  }
+
+  template <typename T>
+  constexpr decltype(auto) Default(T&& val) && noexcept {
+    return std::move(m_res).value_or(std::forward<T>(val));
+  }
+
+ protected:
+  /// True when T is a factory of ResultType taking Args, instead of a value
+  template <typename T, typename... Args>
+  static constexpr auto IsFactory() noexcept -> bool {
+    return std::is_invocable_r_v<ResultType, T, Args...> and
+           not std::is_same_v<std::remove_cvref_t<T>, ResultType>;
+  }
+
+  /// True once a case won
+  constexpr auto HasResult() const noexcept -> bool {
+    return m_res.has_value();
+  }
+
+  /// Set the result to \a value, invoking it when it's a factory
+  template <typename T>
+  constexpr void SetResult(T&& value) {
+    if constexpr (IsFactory<T>()) {
+      m_res.emplace(std::invoke(std::forward<T>(value)));
+    } else {
+      static_assert(std::is_convertible_v<T, ResultType>,
+                    "A Case() value must either be convertible to "
+                    "ResultType, or be a factory returning it.");
+      m_res.emplace(std::forward<T>(value));
+    }
+  }
+
+  std::optional<ResultType> m_res;
+};
+
+}  // namespace swstr::details
@@ -0,0 +1,274 @@
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include <algorithm>
+#include <atomic>
+#include <cerrno>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <string_view>
+#include <utility>
+#include <vector>
+
+#include "SwitchStr/Batch.hpp"
+#include "SwitchStr/Matcher.hpp"
+#include "SwitchStr/Parallel.hpp"
+#include "SwitchStr/SwitchTable.hpp"
+#include "SwitchStr/details/Lines.hpp"
+
+namespace {
+
+constexpr std::string_view kUsage =
+    "Usage: SwitchStr-classify [-j THREADS] [-b BLOCK_SIZE] FILE RULE...\n"
+    "\n"
+    "Count the lines of FILE matching each RULE. Like a switch, each line\n"
+    "is counted by the FIRST rule matching it, or by '(none)'.\n"
+    "\n"
+    "RULE:\n"
+    "  equals:PATTERN    The line is PATTERN\n"
+    "  starts:PATTERN    The line starts with PATTERN\n"
+    "  ends:PATTERN      The line ends with PATTERN\n"
+    "  contains:PATTERN  The line contains PATTERN\n"
+    "\n"
+    "Options:\n"
+    "  -j THREADS     Number of threads (default: all cores)\n"
+    "  -b BLOCK_SIZE  Bytes of the file processed by a thread at once\n"
+    "                 (default: 1048576)\n";
+
+using Table = swstr::SwitchTable<std::size_t, swstr::AnyShareableMatcher>;
+
+/// Lines are looked up by batches of this size
+constexpr std::size_t kBatchSize = 1024;
+
+/**
+ *  \brief Read only memory mapping of a whole file
+ */
+class MappedFile {
+ public:
+  /**
+   *  \brief Map the file at \a path
+   *
+   *  \note On failure, Ok() is false and errno is set
+   */
+  explicit MappedFile(const char* path) {
+    m_fd = ::open(path, O_RDONLY);
+    if (m_fd < 0) return;
+
+    struct stat info;
+    if (::fstat(m_fd, &info) != 0) return;
+    m_size = static_cast<std::size_t>(info.st_size);
+
+    if (m_size == 0) {
+      m_ok = true;
+      return;
+    }
+
+    m_data = ::mmap(nullptr, m_size, PROT_READ, MAP_PRIVATE, m_fd, 0);
+    if (m_data == MAP_FAILED) {
+      m_data = nullptr;
+      return;
+    }
+    ::madvise(m_data, m_size, MADV_SEQUENTIAL);
+    m_ok = true;
+  }
+
+  MappedFile(const MappedFile&) = delete;
+  MappedFile& operator=(const MappedFile&) = delete;
+
+  ~MappedFile() {
+    if (m_data != nullptr) ::munmap(m_data, m_size);
+    if (m_fd >= 0) ::close(m_fd);
+  }
+
+  auto Ok() const noexcept -> bool { return m_ok; }
+
+  auto Text() const noexcept -> std::string_view {
+    return (m_data == nullptr)
+               ? std::string_view()
+               : std::string_view(static_cast<const char*>(m_data), m_size);
+  }
+
+ private:
+  int m_fd = -1;
+  void* m_data = nullptr;
+  std::size_t m_size = 0;
+  bool m_ok = false;
+};
+
+/**
+ *  \brief Add the case described by \a rule ("kind:pattern") to \a builder
+ *
+ *  \return bool False when the rule is invalid
+ */
+auto AddRule(Table::Builder& builder, std::string_view rule,
+             std::size_t index) -> bool {
+  const std::size_t colon = rule.find(':');
+  if (colon == std::string_view::npos) return false;
+
+  const std::string_view kind = rule.substr(0, colon);
+  const std::string_view pattern = rule.substr(colon + 1);
+
+  if (kind == "equals") {
+    builder.Case(swstr::Equals(pattern), index);
+  } else if (kind == "starts") {
+    builder.Case(swstr::StartsWith(pattern), index);
+  } else if (kind == "ends") {
+    builder.Case(swstr::EndsWith(pattern), index);
+  } else if (kind == "contains") {
+    builder.Case(swstr::Contains(pattern), index);
+  } else {
+    return false;
+  }
+  return true;
+}
+
+/**
+ *  \brief The lines STARTING inside text[begin, end), without copy
+ *
+ *  \note The last line may end after \a end, such that all lines belong to
+ *        exactly one block
+ */
+auto LinesOfBlock(std::string_view text, std::size_t begin, std::size_t end)
+    -> std::string_view {
+  if (begin != 0) {
+    const std::size_t newline = text.find('\n', begin - 1);
+    if (newline == std::string_view::npos) return {};
+    begin = newline + 1;
+  }
+  if (begin >= end) return {};
+
+  if (end < text.size()) {
+    const std::size_t newline = text.find('\n', end - 1);
+    end = (newline == std::string_view::npos) ? text.size() : newline + 1;
+  }
+  return text.substr(begin, end - begin);
+}
+
+/**
+ *  \brief Count the lines of text[begin, end) per case of \a table
+ *
+ *  \param[inout] counts Number of lines per case, the last one counting the
+ *                       lines not matching any case
+ */
+void ClassifyBlock(const Table& table, std::string_view text,
+                   std::size_t begin, std::size_t end,
+                   std::vector<std::uint64_t>& counts) {
+  std::vector<std::string_view> lines;
+  std::vector<std::size_t> indexes(kBatchSize);
+  lines.reserve(kBatchSize);
+
+  const auto flush = [&] {
+    swstr::IndexOf(table, lines, indexes);
+    for (std::size_t i = 0; i < lines.size(); ++i) {
+      ++counts[std::min(indexes[i], counts.size() - 1)];
+    }
+    lines.clear();
+  };
+
+  swstr::details::ForEachLine(LinesOfBlock(text, begin, end),
+                              [&](std::string_view line) {
+                                lines.push_back(line);
+                                if (lines.size() == kBatchSize) flush();
+                              });
+  flush();
+}
+
+auto ParseSize(const char* str, std::size_t& value) -> bool {
+  char* end = nullptr;
+  errno = 0;
+  const unsigned long long parsed = std::strtoull(str, &end, 10);
+  if ((errno != 0) or (end == str) or (*end != '\0')) return false;
+  value = static_cast<std::size_t>(parsed);
+  return true;
+}
+
+}  // namespace
+
+int main(int argc, char** argv) {
+  std::size_t threads = 0;
+  std::size_t block_size = 1 << 20;
+
+  int arg = 1;
+  for (; arg < argc; ++arg) {
+    const std::string_view option = argv[arg];
+    if ((option == "-j") and (arg + 1 < argc)) {
+      if (not ParseSize(argv[++arg], threads)) break;
+    } else if ((option == "-b") and (arg + 1 < argc)) {
+      if (not ParseSize(argv[++arg], block_size) or (block_size == 0)) break;
+    } else if ((option == "-h") or (option == "--help")) {
+      std::fputs(kUsage.data(), stdout);
+      return 0;
+    } else {
+      break;
+    }
+  }
+
+  if (argc - arg < 2) {
+    std::fputs(kUsage.data(), stderr);
+    return 1;
+  }
+
+  const char* const path = argv[arg++];
+  const int first_rule = arg;
+
+  Table::Builder builder;
+  for (; arg < argc; ++arg) {
+    if (not AddRule(builder, argv[arg],
+                    static_cast<std::size_t>(arg - first_rule))) {
+      std::fprintf(stderr, "SwitchStr-classify: invalid rule '%s'\n\n%s",
+                   argv[arg], kUsage.data());
+      return 1;
+    }
+  }
+  const Table table = std::move(builder).Build();
+
+  const MappedFile file(path);
+  if (not file.Ok()) {
+    std::fprintf(stderr, "SwitchStr-classify: %s: %s\n", path,
+                 std::strerror(errno));
+    return 1;
+  }
+
+  const auto start = std::chrono::steady_clock::now();
+
+  const std::string_view text = file.Text();
+  std::vector<std::atomic<std::uint64_t>> counts(table.Size() + 1);
+
+  const std::size_t blocks = (text.size() + block_size - 1) / block_size;
+  swstr::details::ParallelChunks(
+      blocks, 1, threads, [&](std::size_t first, std::size_t last) {
+        std::vector<std::uint64_t> block_counts(counts.size(), 0);
+        for (std::size_t block = first; block < last; ++block) {
+          ClassifyBlock(table, text, block * block_size,
+                        std::min(text.size(), (block + 1) * block_size),
+                        block_counts);
+        }
+        for (std::size_t i = 0; i < counts.size(); ++i) {
+          counts[i].fetch_add(block_counts[i], std::memory_order_relaxed);
+        }
+      });
+
+  const std::chrono::duration<double> elapsed =
+      std::chrono::steady_clock::now() - start;
+
+  std::uint64_t total = 0;
+  for (std::size_t i = 0; i < counts.size(); ++i) {
+    const std::uint64_t count = counts[i].load();
+    total += count;
+    std::printf("%llu\t%s\n", static_cast<unsigned long long>(count),
+                (i < table.Size()) ? argv[first_rule + i] : "(none)");
+  }
+
+  std::fprintf(stderr, "%llu lines, %.1f MB in %.3f s (%.2f GB/s)\n",
+               static_cast<unsigned long long>(total),
+               static_cast<double>(text.size()) / 1e6, elapsed.count(),
+               static_cast<double>(text.size()) / 1e9 /
+                   std::max(elapsed.count(), 1e-9));
+  return 0;
+}
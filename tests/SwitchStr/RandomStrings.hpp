@@ -0,0 +1,56 @@
+#pragma once
+
+#include <array>
+#include <cstddef>
+#include <random>
+#include <string>
+#include <string_view>
+#include <vector>
+
+namespace helper {
+
+/// Small alphabet, such that patterns are found (or partially found) often
+inline constexpr std::string_view kSmallAlphabet = "abc";
+
+namespace details {
+
+inline constexpr auto kBytes = [] {
+  std::array<char, 256> bytes = {};
+  for (std::size_t i = 0; i < bytes.size(); ++i) {
+    bytes[i] = static_cast<char>(i);
+  }
+  return bytes;
+}();
+
+}  // namespace details
+
+/// All the 256 bytes
+inline constexpr std::string_view kAllBytes(details::kBytes.data(),
+                                            details::kBytes.size());
+
+/// Random string of \a size chars, picked in \a alphabet
+inline auto RandomString(std::mt19937& rng, std::size_t size,
+                         std::string_view alphabet = kSmallAlphabet)
+    -> std::string {
+  std::uniform_int_distribution<std::size_t> pick(0, alphabet.size() - 1);
+  std::string str(size, '\0');
+  for (auto& c : str) {
+    c = alphabet[pick(rng)];
+  }
+  return str;
+}
+
+/// \a count random strings of [0, \a max_size] chars, picked in \a alphabet
+inline auto RandomStrings(std::mt19937& rng, std::size_t count,
+                          std::size_t max_size,
+                          std::string_view alphabet = kSmallAlphabet)
+    -> std::vector<std::string> {
+  std::uniform_int_distribution<std::size_t> size(0, max_size);
+  std::vector<std::string> strs(count);
+  for (auto& str : strs) {
+    str = RandomString(rng, size(rng), alphabet);
+  }
+  return strs;
+}
+
+}  // namespace helper
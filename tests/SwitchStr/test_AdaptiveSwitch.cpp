@@ -0,0 +1,116 @@
+#include <random>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include "SwitchStr/AdaptiveSwitch.hpp"
+#include "SwitchStr/SwitchStr.hpp"
+#include "gtest/gtest.h"
+
+namespace {
+
+using swstr::Contains;
+using swstr::EndsWith;
+using swstr::Equals;
+using swstr::StartsWith;
+using Switch = swstr::AdaptiveSwitch<int>;
+
+TEST(AdaptiveSwitchTest, Segments) {
+  EXPECT_EQ(Switch::Builder().Build().Segments(), 0);
+
+  // Distinct Equals, prefixes and suffixes are proven disjoint
+  EXPECT_EQ(Switch::Builder()
+                .Case(Equals("a"), 0)
+                .Case("b", 1)
+                .Case(StartsWith("ca"), 2)
+                .Case(StartsWith("cb"), 3)
+                .Case(EndsWith("x"), 4)
+                .Case(EndsWith("xy"), 5)
+                .Build()
+                .Segments(),
+            2);
+
+  // Equals("abc") starts with "ab", and Contains() is opaque
+  EXPECT_EQ(Switch::Builder()
+                .Case(StartsWith("ab"), 0)
+                .Case(Equals("abc"), 1)
+                .Case(Contains("z"), 2)
+                .Case(Equals("z"), 3)
+                .Build()
+                .Segments(),
+            4);
+
+  EXPECT_EQ(Switch::Builder()
+                .Case(StartsWith("ab"), 0)
+                .Case(Contains("z"), 1)
+                .AssumeDisjoint()
+                .Build()
+                .Segments(),
+            1);
+}
+
+TEST(AdaptiveSwitchTest, HottestFirst) {
+  auto keywords = Switch::Builder()
+                      .Case(Equals("SELECT"), 0)
+                      .Case(Equals("FROM"), 1)
+                      .Case(Equals("WHERE"), 2)
+                      .Case(Equals("LIMIT"), 3)
+                      .ReorderEvery(100)
+                      .Build();
+
+  for (int i = 0; i < 99; ++i) {
+    EXPECT_EQ(keywords.LookupOr((i % 3 == 0) ? "WHERE" : "LIMIT", -1),
+              (i % 3 == 0) ? 2 : 3);
+  }
+  EXPECT_EQ(keywords.LookupOr("nope", -1), -1);
+
+  const std::vector<std::uint32_t> expected = {3, 2, 0, 1};
+  EXPECT_EQ(std::vector<std::uint32_t>(keywords.Order().begin(),
+                                       keywords.Order().end()),
+            expected);
+}
+
+TEST(AdaptiveSwitchTest, SameAsSwitchStr) {
+  // Overlapping cases: only the disjoint runs may be reordered
+  const auto reference = [](std::string_view str) {
+    return swstr::SwitchStr<int>(str)
+        .Case(Equals("ab"), 0)
+        .Case(Equals("ba"), 1)
+        .Case(StartsWith("a"), 2)
+        .Case(StartsWith("bb"), 3)
+        .Case(EndsWith("a"), 4)
+        .Case(Contains("c"), 5)
+        .Case(Equals("ac"), 6)
+        .Case(Equals("c"), 7)
+        .Default(-1);
+  };
+
+  auto adaptive = Switch::Builder()
+                      .Case(Equals("ab"), 0)
+                      .Case(Equals("ba"), 1)
+                      .Case(StartsWith("a"), 2)
+                      .Case(StartsWith("bb"), 3)
+                      .Case(EndsWith("a"), 4)
+                      .Case(Contains("c"), 5)
+                      .Case(Equals("ac"), 6)
+                      .Case(Equals("c"), 7)
+                      .ReorderEvery(16)
+                      .Build();
+
+  std::mt19937 rng(42);
+  std::uniform_int_distribution<int> letter('a', 'c');
+  std::uniform_int_distribution<std::size_t> size(0, 3);
+
+  for (int i = 0; i < 10000; ++i) {
+    std::string str(size(rng), '\0');
+    for (auto& c : str) {
+      c = static_cast<char>(letter(rng));
+    }
+    // Skewed traffic, such that cases are reordered
+    const std::string_view input = (i % 4 != 0) ? "c" : std::string_view(str);
+
+    ASSERT_EQ(adaptive.LookupOr(input, -1), reference(input)) << input;
+  }
+}
+
+}  // namespace
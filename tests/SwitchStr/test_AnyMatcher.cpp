@@ -0,0 +1,55 @@
+#include <string_view>
+
+#include "SwitchStr/Matcher.hpp"
+#include "gtest/gtest.h"
+
+namespace {
+
+TEST(AnyMatcherTest, BuiltinsAreInline) {
+  using swstr::AnyMatcher;
+
+  std::size_t* where = nullptr;
+  static_assert(AnyMatcher::IsStoredInline<decltype(swstr::Equals(""))>());
+  static_assert(AnyMatcher::IsStoredInline<decltype(swstr::StartsWith(""))>());
+  static_assert(AnyMatcher::IsStoredInline<decltype(swstr::EndsWith(""))>());
+  static_assert(
+      AnyMatcher::IsStoredInline<decltype(swstr::Contains("", where))>());
+  static_assert(
+      AnyMatcher::IsStoredInline<decltype(swstr::ContainsR("", where))>());
+  static_assert(
+      AnyMatcher::IsStoredInline<decltype(swstr::ContainsOneOf("", where))>());
+  static_assert(
+      AnyMatcher::IsStoredInline<decltype(swstr::ContainsOneOfR("", where))>());
+  static_assert(
+      AnyMatcher::IsStoredInline<decltype(swstr::ContainsAnyOf({""}))>());
+  static_assert(AnyMatcher::IsStoredInline<decltype(swstr::NeverMatches())>());
+  static_assert(AnyMatcher::IsStoredInline<decltype(swstr::AllOf(
+                    swstr::StartsWith(""), swstr::EndsWith("")))>());
+  static_assert(AnyMatcher::IsStoredInline<const char*>());
+}
+
+TEST(AnyMatcherTest, KeepsMatcherState) {
+  using swstr::AnyMatcher;
+
+  int calls = 0;
+  AnyMatcher any_matcher([calls](std::string_view) mutable {
+    return ++calls == 2;
+  });
+
+  EXPECT_FALSE(any_matcher.IsMatching("foo"));
+
+  // The copy has its own state
+  AnyMatcher copy(any_matcher);
+  EXPECT_TRUE(any_matcher.IsMatching("foo"));
+  EXPECT_TRUE(copy.IsMatching("foo"));
+  EXPECT_FALSE(copy.IsMatching("foo"));
+  EXPECT_EQ(calls, 0);
+
+  // Lvalues are copied, not referenced
+  auto equals = swstr::Equals("foo");
+  AnyMatcher from_lvalue(equals);
+  equals = swstr::Equals("bar");
+  EXPECT_TRUE(from_lvalue.IsMatching("foo"));
+}
+
+}  // namespace
@@ -0,0 +1,155 @@
+#include <array>
+#include <atomic>
+#include <cstddef>
+#include <cstdlib>
+#include <new>
+#include <string_view>
+
+#include "SwitchStr/Matcher.hpp"
+#include "gtest/gtest.h"
+
+// This executable replaces the global allocator, counting its allocations:
+// keep it apart from the other tests
+
+namespace {
+
+/// Number of calls to the global operator new, done by this binary
+std::atomic<std::size_t> g_allocations = 0;
+
+auto Allocations() noexcept -> std::size_t {
+  return g_allocations.load(std::memory_order_relaxed);
+}
+
+/// Allocate \a size bytes aligned on \a align, nullptr on failure
+auto Allocate(std::size_t size, std::size_t align) noexcept -> void* {
+  g_allocations.fetch_add(1, std::memory_order_relaxed);
+  if (size == 0) size = 1;
+  if (align <= alignof(std::max_align_t)) return std::malloc(size);
+
+  // std::aligned_alloc() requires a size multiple of the alignment
+  return std::aligned_alloc(align, (size + align - 1) / align * align);
+}
+
+auto AllocateOrThrow(std::size_t size, std::size_t align) -> void* {
+  if (void* ptr = Allocate(size, align)) return ptr;
+  throw std::bad_alloc();
+}
+
+}  // namespace
+
+auto operator new(std::size_t size) -> void* {
+  return AllocateOrThrow(size, alignof(std::max_align_t));
+}
+auto operator new[](std::size_t size) -> void* {
+  return AllocateOrThrow(size, alignof(std::max_align_t));
+}
+auto operator new(std::size_t size, std::align_val_t align) -> void* {
+  return AllocateOrThrow(size, static_cast<std::size_t>(align));
+}
+auto operator new[](std::size_t size, std::align_val_t align) -> void* {
+  return AllocateOrThrow(size, static_cast<std::size_t>(align));
+}
+auto operator new(std::size_t size, const std::nothrow_t&) noexcept -> void* {
+  return Allocate(size, alignof(std::max_align_t));
+}
+auto operator new[](std::size_t size, const std::nothrow_t&) noexcept
+    -> void* {
+  return Allocate(size, alignof(std::max_align_t));
+}
+auto operator new(std::size_t size, std::align_val_t align,
+                  const std::nothrow_t&) noexcept -> void* {
+  return Allocate(size, static_cast<std::size_t>(align));
+}
+auto operator new[](std::size_t size, std::align_val_t align,
+                    const std::nothrow_t&) noexcept -> void* {
+  return Allocate(size, static_cast<std::size_t>(align));
+}
+
+void operator delete(void* ptr) noexcept { std::free(ptr); }
+void operator delete[](void* ptr) noexcept { std::free(ptr); }
+void operator delete(void* ptr, std::size_t) noexcept { std::free(ptr); }
+void operator delete[](void* ptr, std::size_t) noexcept { std::free(ptr); }
+void operator delete(void* ptr, std::align_val_t) noexcept { std::free(ptr); }
+void operator delete[](void* ptr, std::align_val_t) noexcept {
+  std::free(ptr);
+}
+void operator delete(void* ptr, std::size_t, std::align_val_t) noexcept {
+  std::free(ptr);
+}
+void operator delete[](void* ptr, std::size_t, std::align_val_t) noexcept {
+  std::free(ptr);
+}
+void operator delete(void* ptr, const std::nothrow_t&) noexcept {
+  std::free(ptr);
+}
+void operator delete[](void* ptr, const std::nothrow_t&) noexcept {
+  std::free(ptr);
+}
+void operator delete(void* ptr, std::align_val_t,
+                     const std::nothrow_t&) noexcept {
+  std::free(ptr);
+}
+void operator delete[](void* ptr, std::align_val_t,
+                       const std::nothrow_t&) noexcept {
+  std::free(ptr);
+}
+
+namespace {
+
+TEST(AnyMatcherTest, ZeroAllocations) {
+  using swstr::AnyMatcher;
+
+  std::size_t where = 0;
+  const std::size_t before = Allocations();
+
+  AnyMatcher any_matcher;
+  any_matcher = swstr::Contains("foo", &where);
+
+  AnyMatcher copy(any_matcher);
+  AnyMatcher moved(std::move(copy));
+  copy = moved;
+  any_matcher = swstr::AllOf(swstr::StartsWith("a"), swstr::EndsWith("z"));
+
+  const bool matched = moved.IsMatching("barfoo") and
+                       not copy.IsMatching("bar") and
+                       any_matcher.IsMatching("a to z");
+
+  const std::size_t allocations = Allocations() - before;
+
+  EXPECT_TRUE(matched);
+  EXPECT_EQ(where, 3);
+  EXPECT_EQ(allocations, 0);
+}
+
+TEST(AnyMatcherTest, HeapFallback) {
+  using swstr::AnyMatcher;
+
+  std::array<char, 2 * AnyMatcher::kInlineSize> big = {};
+  big[0] = 'f';
+  const auto big_matcher = [big](std::string_view str) {
+    return not str.empty() and (str.front() == big[0]);
+  };
+  static_assert(not AnyMatcher::IsStoredInline<decltype(big_matcher)>());
+
+  std::size_t before = Allocations();
+  AnyMatcher any_matcher(big_matcher);
+  EXPECT_EQ(Allocations() - before, 1);
+
+  before = Allocations();
+  AnyMatcher copy(any_matcher);
+  EXPECT_EQ(Allocations() - before, 1);
+
+  // Moving only steals the heap pointer
+  before = Allocations();
+  AnyMatcher moved(std::move(copy));
+  EXPECT_EQ(Allocations() - before, 0);
+
+  EXPECT_TRUE(any_matcher.IsMatching("foo"));
+  EXPECT_TRUE(moved.IsMatching("foo"));
+  EXPECT_FALSE(moved.IsMatching("bar"));
+
+  // Moved from matchers never match
+  EXPECT_FALSE(copy.IsMatching("foo"));
+}
+
+}  // namespace
@@ -0,0 +1,142 @@
+#include <algorithm>
+#include <random>
+#include <string>
+#include <string_view>
+#include <type_traits>
+
+#include "RandomStrings.hpp"
+#include "SwitchStr/Matcher.hpp"
+#include "SwitchStr/SwitchStr.hpp"
+#include "SwitchStr/details/Ascii.hpp"
+#include "gtest/gtest.h"
+
+namespace {
+
+// Mixed case small alphabet, including the bytes surrounding the letters
+// ('@', '[', '`', '{') and a non ASCII byte, which must never be folded
+constexpr std::string_view kAlphabet = "aAbB@[`{\xC1";
+
+auto ToLower(std::string str) -> std::string {
+  std::transform(str.begin(), str.end(), str.begin(), [](char c) {
+    return ((c >= 'A') and (c <= 'Z')) ? static_cast<char>(c - 'A' + 'a')
+                                       : c;
+  });
+  return str;
+}
+
+TEST(AsciiTest, Constexpr) {
+  using swstr::details::IEqualBytes;
+  using swstr::details::IFind;
+
+  static_assert(IEqualBytes("FoO", "foo", 3));
+  static_assert(IEqualBytes("FoO", "fOo", 3));
+  static_assert(not IEqualBytes("FoO", "fOx", 3));
+  static_assert(not IEqualBytes("@[`", "`{@", 3));
+  static_assert(IFind("xxFOOfoo", "oof") == 3);
+  static_assert(IFind("xxFOOfoo", "OoF") == 3);
+  static_assert(IFind("foo", "") == 0);
+  static_assert(IFind("foo", "foofoo") == std::string_view::npos);
+
+  static_assert(
+      swstr::IEquals("Content-Encoding").IsMatching("CONTENT-encoding"));
+  static_assert(swstr::IContains("KEEP").IsMatching("Connection: keep-alive"));
+  static_assert(swstr::IContainsOneOf("X").IsMatching("abxd"));
+  static_assert(not swstr::IContainsOneOf('@').IsMatching("`"));
+}
+
+TEST(AsciiTest, SameAsLowerCase) {
+  using swstr::details::IEqualBytes;
+  using swstr::details::IFind;
+
+  std::mt19937 rng(42);
+  std::uniform_int_distribution<std::size_t> needle_size(0, 40);
+  std::uniform_int_distribution<std::size_t> str_size(0, 200);
+
+  for (int i = 0; i < 5000; ++i) {
+    const auto needle = helper::RandomString(rng, needle_size(rng), kAlphabet);
+    const auto str = helper::RandomString(rng, str_size(rng), kAlphabet);
+    const auto folded = ToLower(needle);
+
+    SCOPED_TRACE(::testing::Message() << "needle = " << needle
+                                      << ", str = " << str);
+
+    // Neither the needle nor the string need to be folded
+    const auto expected_pos = ToLower(str).find(folded);
+    EXPECT_EQ(IFind(str, needle), expected_pos);
+
+    const std::size_t n = std::min(str.size(), needle.size());
+    EXPECT_EQ(IEqualBytes(str.data(), needle.data(), n),
+              ToLower(str.substr(0, n)) == folded.substr(0, n));
+
+    // Always the same bytes, in any case
+    EXPECT_TRUE(IEqualBytes(needle.data(), folded.data(), needle.size()));
+    EXPECT_TRUE(IEqualBytes(folded.data(), needle.data(), needle.size()));
+
+#if SwitchStr_X86_DISPATCH
+    namespace cpu = swstr::details::cpu;
+
+    if (not needle.empty() and (needle.size() <= str.size())) {
+      EXPECT_EQ(swstr::details::IFindSse2(str, needle), expected_pos);
+      if (cpu::HasAvx2()) {
+        EXPECT_EQ(swstr::details::IFindAvx2(str, needle), expected_pos);
+      }
+    }
+#endif
+  }
+}
+
+TEST(AsciiTest, Matchers) {
+  using swstr::IContains;
+  using swstr::IContainsOneOf;
+  using swstr::IEndsWith;
+  using swstr::IEquals;
+  using swstr::IStartsWith;
+
+  EXPECT_TRUE(IsMatching(IEquals("Content-Length"), "content-length"));
+  EXPECT_TRUE(IsMatching(IEquals("content-length"), "CONTENT-LENGTH"));
+  EXPECT_FALSE(IsMatching(IEquals("content-length"), "content-lengths"));
+  EXPECT_FALSE(IsMatching(IEquals("content-length"), "content_length"));
+  EXPECT_EQ(IEquals("FoO").Pattern(), "FoO");
+
+  // Patterns are viewed, never copied: no allocation whatever their size
+  EXPECT_TRUE(IsMatching(IEquals("Strict-Transport-Security"),
+                         "strict-transport-SECURITY"));
+  EXPECT_TRUE(IsMatching(IEndsWith(".EXAMPLE.COM.CDN.NET"),
+                         "img.example.com.cdn.net"));
+  static_assert(std::is_trivially_copyable_v<swstr::IEqualsMatcher>);
+  static_assert(std::is_trivially_copyable_v<swstr::IStartsWithMatcher>);
+  static_assert(std::is_trivially_copyable_v<swstr::IEndsWithMatcher>);
+  static_assert(
+      std::is_trivially_copyable_v<swstr::IContainsMatcher<true>>);
+
+  EXPECT_TRUE(IsMatching(IStartsWith("HTTP/"), "http/1.1"));
+  EXPECT_FALSE(IsMatching(IStartsWith("HTTP/"), "http"));
+
+  EXPECT_TRUE(IsMatching(IEndsWith(".JPEG"), "photo.jpeg"));
+  EXPECT_FALSE(IsMatching(IEndsWith(".JPEG"), "photo.jpg"));
+
+  std::size_t where = 0;
+  EXPECT_TRUE(IsMatching(IContains("Keep-Alive", &where),
+                         "Connection: keep-alive, KEEP-ALIVE"));
+  EXPECT_EQ(where, 12);
+  EXPECT_FALSE(IsMatching(IContains("close"), "Connection: keep-alive"));
+
+  EXPECT_TRUE(IsMatching(IContainsOneOf("XYZ", &where), "abcyz"));
+  EXPECT_EQ(where, 3);
+  EXPECT_FALSE(IsMatching(IContainsOneOf("XYZ"), "abc"));
+
+  // Plugs into SwitchStr and AnyMatcher unchanged
+  const auto classify = [](std::string_view header) {
+    return swstr::SwitchStr<int>(header)
+        .Case(IEquals("host"), 0)
+        .Case(swstr::AnyMatcher(IStartsWith("x-")), 1)
+        .Case(IContains("type"), 2)
+        .Default(-1);
+  };
+  EXPECT_EQ(classify("HOST"), 0);
+  EXPECT_EQ(classify("X-Forwarded-For"), 1);
+  EXPECT_EQ(classify("Content-Type"), 2);
+  EXPECT_EQ(classify("Accept"), -1);
+}
+
+}  // namespace
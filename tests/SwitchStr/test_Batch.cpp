@@ -0,0 +1,135 @@
+#include <cstdint>
+#include <optional>
+#include <random>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include "RandomStrings.hpp"
+#include "SwitchStr/Batch.hpp"
+#include "SwitchStr/StaticSwitch.hpp"
+#include "SwitchStr/SwitchTable.hpp"
+#include "gtest/gtest.h"
+
+namespace {
+
+template <typename Matcher>
+void ExpectSameAsScalar(const Matcher& m,
+                        const std::vector<std::string_view>& strs) {
+  std::vector<std::uint8_t> out(strs.size(), 2);
+  swstr::IsMatching(m, strs, out);
+
+  bool out_bool[512] = {};
+  ASSERT_LE(strs.size(), 512);
+  swstr::IsMatching(m, strs, std::span<bool>(out_bool, strs.size()));
+
+  std::vector<std::optional<swstr::MatchSpan>> spans(strs.size());
+  swstr::Match(m, strs, spans);
+
+  for (std::size_t i = 0; i < strs.size(); ++i) {
+    SCOPED_TRACE(strs[i]);
+    EXPECT_EQ(out[i], swstr::IsMatching(m, strs[i]) ? 1 : 0);
+    EXPECT_EQ(out_bool[i], swstr::IsMatching(m, strs[i]));
+    EXPECT_EQ(spans[i], swstr::Match(m, strs[i]));
+  }
+}
+
+TEST(BatchTest, SameAsScalar) {
+  std::mt19937 rng(42);
+  const auto storage = helper::RandomStrings(rng, 512, 40);
+  const std::vector<std::string_view> strs(storage.begin(), storage.end());
+
+  for (std::string_view pattern :
+       {"", "a", "ab", "abc", "abca", "abcab", "aabbccaa", "abcabcabc",
+        "abcabcabcabcabcab", "abcabcabcabcabcabcabc"}) {
+    SCOPED_TRACE(pattern);
+    ExpectSameAsScalar(swstr::Equals(pattern), strs);
+    ExpectSameAsScalar(swstr::StartsWith(pattern), strs);
+    ExpectSameAsScalar(swstr::EndsWith(pattern), strs);
+    ExpectSameAsScalar(swstr::Contains(pattern), strs);
+    ExpectSameAsScalar(swstr::ContainsR(pattern), strs);
+  }
+
+  ExpectSameAsScalar(swstr::Contains('c'), strs);
+  ExpectSameAsScalar(swstr::ContainsR('c'), strs);
+
+  // Matchers without batch interface
+  ExpectSameAsScalar(swstr::ContainsOneOf("bc"), strs);
+  ExpectSameAsScalar(
+      swstr::AnyOf(swstr::StartsWith("ab"), swstr::EndsWith("ba")), strs);
+}
+
+TEST(BatchTest, Where) {
+  using swstr::MatchSpan;
+  using Spans = std::vector<std::optional<MatchSpan>>;
+
+  const std::vector<std::string_view> strs = {"foo", "barfoo", "bar",
+                                              "foofoo", "baz"};
+  Spans out(strs.size());
+
+  // One position per string
+  swstr::Match(swstr::Contains("foo"), strs, out);
+  EXPECT_EQ(out, (Spans{MatchSpan{0, 3}, MatchSpan{3, 3}, std::nullopt,
+                        MatchSpan{0, 3}, std::nullopt}));
+
+  swstr::Match(swstr::ContainsR("foo"), strs, out);
+  EXPECT_EQ(out, (Spans{MatchSpan{0, 3}, MatchSpan{3, 3}, std::nullopt,
+                        MatchSpan{3, 3}, std::nullopt}));
+
+  // 'where' is left untouched by the batch
+  std::size_t where = std::string_view::npos;
+  swstr::Match(swstr::Contains('a', &where), strs, out);
+  EXPECT_EQ(out, (Spans{std::nullopt, MatchSpan{1, 1}, MatchSpan{1, 1},
+                        std::nullopt, MatchSpan{1, 1}}));
+  EXPECT_EQ(where, std::string_view::npos);
+
+  // Matchers without batch interface
+  swstr::Match(swstr::StartsWith("ba"), strs, out);
+  EXPECT_EQ(out, (Spans{std::nullopt, MatchSpan{0, 2}, MatchSpan{0, 2},
+                        std::nullopt, MatchSpan{0, 2}}));
+  swstr::Match(swstr::Equals("bar"), strs, out);
+  EXPECT_EQ(out, (Spans{std::nullopt, std::nullopt, MatchSpan{0, 3},
+                        std::nullopt, std::nullopt}));
+}
+
+TEST(BatchTest, IndexOf) {
+  using swstr::Equals;
+  using swstr::StartsWith;
+
+  const std::vector<std::string_view> strs = {
+      "GET", "POST", "PUT", "DELETE", "PATCH", "HEAD", "", "GETS", "P"};
+
+  const auto hash = swstr::SwitchTable<int>::Builder()
+                        .Case(Equals("GET"), 0)
+                        .Case(Equals("POST"), 1)
+                        .Case(Equals("PUT"), 2)
+                        .Case(Equals("DELETE"), 3)
+                        .Case(Equals("PATCH"), 4)
+                        .Build();
+  const auto trie = swstr::SwitchTable<int>::Builder()
+                        .Case(Equals("GET"), 0)
+                        .Case(StartsWith("PO"), 1)
+                        .Case(Equals("PUT"), 2)
+                        .Case(Equals("DELETE"), 3)
+                        .Case(StartsWith("P"), 4)
+                        .Build();
+  constexpr swstr::StaticSwitch<int, "GET", "POST", "PUT", "DELETE", "PATCH">
+      fixed{0, 1, 2, 3, 4};
+
+  constexpr auto npos = std::string_view::npos;
+  std::vector<std::size_t> out(strs.size());
+
+  swstr::IndexOf(hash, strs, out);
+  EXPECT_EQ(out, (std::vector<std::size_t>{0, 1, 2, 3, 4, npos, npos, npos,
+                                           npos}));
+
+  swstr::IndexOf(trie, strs, out);
+  EXPECT_EQ(out, (std::vector<std::size_t>{0, 1, 2, 3, 4, npos, npos, npos,
+                                           4}));
+
+  swstr::IndexOf(fixed, strs, out);
+  EXPECT_EQ(out, (std::vector<std::size_t>{0, 1, 2, 3, 4, npos, npos, npos,
+                                           npos}));
+}
+
+}  // namespace
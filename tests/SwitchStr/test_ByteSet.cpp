@@ -0,0 +1,96 @@
+#include <random>
+#include <string>
+#include <string_view>
+
+#include "RandomStrings.hpp"
+#include "SwitchStr/Matcher.hpp"
+#include "SwitchStr/details/ByteSet.hpp"
+#include "gtest/gtest.h"
+
+namespace {
+
+TEST(ByteSetTest, Contains) {
+  using swstr::details::ByteSet;
+
+  constexpr auto set = ByteSet("a\x7f\x80\xff");
+  static_assert(set.Contains('a'));
+  static_assert(set.Contains('\x7f'));
+  static_assert(set.Contains('\x80'));
+  static_assert(set.Contains('\xff'));
+  static_assert(not set.Contains('b'));
+  static_assert(not set.Contains('\0'));
+  static_assert(set.FindFirst("bcda") == 3);
+  static_assert(set.FindLast("abcd") == 0);
+
+  for (int c = 0; c < 256; ++c) {
+    EXPECT_FALSE(ByteSet().Contains(static_cast<char>(c)));
+  }
+}
+
+TEST(ByteSetTest, SameAsFindFirstOfLastOf) {
+  using swstr::details::ByteSet;
+
+  std::mt19937 rng(42);
+  std::uniform_int_distribution<std::size_t> pattern_size(0, 8);
+  std::uniform_int_distribution<std::size_t> str_size(0, 200);
+
+  for (int i = 0; i < 5000; ++i) {
+    const auto pattern =
+        helper::RandomString(rng, pattern_size(rng), helper::kAllBytes);
+    const auto str =
+        helper::RandomString(rng, str_size(rng), helper::kAllBytes);
+    const auto set = ByteSet(pattern);
+
+    SCOPED_TRACE(::testing::Message()
+                 << "pattern size = " << pattern.size()
+                 << ", str size = " << str.size());
+
+    const auto first = std::string_view{str}.find_first_of(pattern);
+    const auto last = std::string_view{str}.find_last_of(pattern);
+
+    EXPECT_EQ(set.FindFirst(str), first);
+    EXPECT_EQ(set.FindLast(str), last);
+    EXPECT_EQ(set.FindFirstScalar(str), first);
+    EXPECT_EQ(set.FindLastScalar(str), last);
+
+#if SwitchStr_X86_DISPATCH
+    namespace cpu = swstr::details::cpu;
+
+    if (cpu::HasSsse3() and (str.size() >= 16)) {
+      EXPECT_EQ(set.FindFirstSsse3(str), first);
+      EXPECT_EQ(set.FindLastSsse3(str), last);
+    }
+
+    if (cpu::HasAvx2() and (str.size() >= 32)) {
+      EXPECT_EQ(set.FindFirstAvx2(str), first);
+      EXPECT_EQ(set.FindLastAvx2(str), last);
+    }
+#endif
+  }
+}
+
+TEST(ByteSetTest, ContainsOneOfLongStrings) {
+  using swstr::ContainsOneOf;
+  using swstr::ContainsOneOfR;
+
+  std::string str(100, '.');
+  str[37] = ',';
+  str[71] = ';';
+
+  std::size_t pos = std::string_view::npos;
+  EXPECT_TRUE(IsMatching(ContainsOneOf(",;", &pos), str));
+  EXPECT_EQ(pos, 37);
+  EXPECT_TRUE(IsMatching(ContainsOneOfR(",;", &pos), str));
+  EXPECT_EQ(pos, 71);
+  EXPECT_TRUE(IsMatching(ContainsOneOf(';', &pos), str));
+  EXPECT_EQ(pos, 71);
+  EXPECT_TRUE(IsMatching(ContainsOneOfR(',', &pos), str));
+  EXPECT_EQ(pos, 37);
+
+  pos = std::string_view::npos;
+  EXPECT_FALSE(IsMatching(ContainsOneOf(":!", &pos), str));
+  EXPECT_FALSE(IsMatching(ContainsOneOfR(":!", &pos), str));
+  EXPECT_EQ(pos, std::string_view::npos);
+}
+
+}  // namespace
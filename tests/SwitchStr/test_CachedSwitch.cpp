@@ -0,0 +1,204 @@
+#include <atomic>
+#include <string>
+#include <string_view>
+#include <thread>
+#include <vector>
+
+#include "SwitchStr/CachedSwitch.hpp"
+#include "SwitchStr/SwitchStr.hpp"
+#include "gtest/gtest.h"
+
+namespace {
+
+/// Switch counting how many times it is called
+struct CountingSwitch {
+  auto operator()(std::string_view str) const -> std::string {
+    ++*calls;
+    return swstr::SwitchStr<std::string>(str)
+        .Case(swstr::Contains("bot"), "BOT")
+        .Case(swstr::StartsWith("Mozilla/"), "BROWSER")
+        .Default("OTHER");
+  }
+
+  std::atomic<int>* calls;
+};
+
+TEST(CachedSwitchTest, Memoize) {
+  std::atomic<int> calls = 0;
+  swstr::CachedSwitch classify(CountingSwitch{&calls}, 16);
+  EXPECT_EQ(classify.Capacity(), 16);
+
+  EXPECT_EQ(classify("Mozilla/5.0"), "BROWSER");
+  EXPECT_EQ(classify("Googlebot/2.1"), "BOT");
+  EXPECT_EQ(classify("curl/8.0"), "OTHER");
+  EXPECT_EQ(calls, 3);
+
+  for (int i = 0; i < 10; ++i) {
+    EXPECT_EQ(classify("Mozilla/5.0"), "BROWSER");
+    EXPECT_EQ(classify("Googlebot/2.1"), "BOT");
+    EXPECT_EQ(classify("curl/8.0"), "OTHER");
+  }
+  EXPECT_EQ(calls, 3);
+
+  const swstr::CacheStats stats = classify.Stats();
+  EXPECT_EQ(stats.hits, 30);
+  EXPECT_EQ(stats.misses, 3);
+  EXPECT_EQ(stats.evictions, 0);
+  EXPECT_EQ(stats.bypasses, 0);
+  EXPECT_EQ(stats.Lookups(), 33);
+  EXPECT_DOUBLE_EQ(stats.HitRate(), 30. / 33.);
+
+  classify.Clear();
+  EXPECT_EQ(classify.Stats().Lookups(), 0);
+  EXPECT_EQ(classify.Stats().HitRate(), 0.);
+  EXPECT_EQ(classify("curl/8.0"), "OTHER");
+  EXPECT_EQ(calls, 4);
+}
+
+TEST(CachedSwitchTest, OwnsKeys) {
+  std::atomic<int> calls = 0;
+  swstr::CachedSwitch classify(CountingSwitch{&calls}, 8);
+
+  // The string switched on is modified afterward: the cache must not hold
+  // a view on it
+  std::string str = "Googlebot";
+  EXPECT_EQ(classify(str), "BOT");
+  str = "Mozilla/5";
+  EXPECT_EQ(classify(str), "BROWSER");
+  str = "Googlebot";
+  EXPECT_EQ(classify(str), "BOT");
+  EXPECT_EQ(calls, 2);
+
+  // Same hash set, different lengths/bytes
+  EXPECT_EQ(classify("Googlebo"), "OTHER");
+  EXPECT_EQ(classify(""), "OTHER");
+  EXPECT_EQ(classify(""), "OTHER");
+  EXPECT_EQ(calls, 4);
+}
+
+TEST(CachedSwitchTest, Bypass) {
+  std::atomic<int> calls = 0;
+  swstr::CachedSwitch classify(CountingSwitch{&calls}, 8, 8);
+
+  EXPECT_EQ(classify("Mozilla/"), "BROWSER");
+  EXPECT_EQ(classify("Mozilla/"), "BROWSER");
+  EXPECT_EQ(calls, 1);
+
+  // Longer than max_key_size: never cached
+  EXPECT_EQ(classify("Mozilla/5"), "BROWSER");
+  EXPECT_EQ(classify("Mozilla/5"), "BROWSER");
+  EXPECT_EQ(calls, 3);
+  EXPECT_EQ(classify.Stats().bypasses, 2);
+  EXPECT_EQ(classify.Stats().hits, 1);
+}
+
+TEST(CachedSwitchTest, Eviction) {
+  std::atomic<int> calls = 0;
+  swstr::CachedSwitch classify(
+      [&calls](std::string_view str) {
+        ++calls;
+        return str.size();
+      },
+      8);
+  ASSERT_EQ(classify.Capacity(), 8);
+
+  // A single set: filling it, then hitting the first 4 entries
+  std::vector<std::string> strs;
+  for (int i = 0; i < 12; ++i) {
+    strs.push_back(std::string(static_cast<std::size_t>(i), 'x'));
+  }
+  for (int i = 0; i < 8; ++i) {
+    EXPECT_EQ(classify(strs[i]), i);
+  }
+  for (int i = 0; i < 4; ++i) {
+    EXPECT_EQ(classify(strs[i]), i);
+  }
+  EXPECT_EQ(calls, 8);
+  EXPECT_EQ(classify.Stats().evictions, 0);
+
+  // CLOCK: the 4 entries hit get a second chance, the others are evicted
+  for (int i = 8; i < 12; ++i) {
+    EXPECT_EQ(classify(strs[i]), i);
+  }
+  EXPECT_EQ(classify.Stats().evictions, 4);
+  EXPECT_EQ(calls, 12);
+
+  for (int i = 0; i < 4; ++i) {
+    EXPECT_EQ(classify(strs[i]), i);
+  }
+  for (int i = 8; i < 12; ++i) {
+    EXPECT_EQ(classify(strs[i]), i);
+  }
+  EXPECT_EQ(calls, 12);
+
+  EXPECT_EQ(classify(strs[4]), 4);
+  EXPECT_EQ(calls, 13);
+}
+
+TEST(CachedSwitchTest, ThreadLocal) {
+  constexpr int kThreads = 4;
+  constexpr int kLookups = 1000;
+
+  std::atomic<int> calls = 0;
+  const swstr::ThreadLocalCachedSwitch classify(CountingSwitch{&calls}, 64);
+  EXPECT_EQ(classify.CacheCount(), 0);
+
+  const std::vector<std::string> agents = {"Mozilla/5.0", "Googlebot/2.1",
+                                           "curl/8.0", "bingbot"};
+  const std::vector<std::string> expected = {"BROWSER", "BOT", "OTHER",
+                                             "BOT"};
+  std::atomic<bool> failed = false;
+
+  std::vector<std::thread> threads;
+  for (int t = 0; t < kThreads; ++t) {
+    threads.emplace_back([&] {
+      for (int i = 0; i < kLookups; ++i) {
+        const std::size_t a = i % agents.size();
+        if (classify(agents[a]) != expected[a]) {
+          failed = true;
+        }
+      }
+    });
+  }
+  for (std::thread& thread : threads) {
+    thread.join();
+  }
+
+  EXPECT_FALSE(failed);
+  EXPECT_EQ(classify.CacheCount(), kThreads);
+
+  // Each thread computes each agent once, in its own cache
+  EXPECT_EQ(calls, kThreads * agents.size());
+  const swstr::CacheStats stats = classify.Stats();
+  EXPECT_EQ(stats.misses, kThreads * agents.size());
+  EXPECT_EQ(stats.hits, kThreads * (kLookups - agents.size()));
+
+  // The calling thread gets its own cache too
+  EXPECT_EQ(classify("bingbot"), "BOT");
+  EXPECT_EQ(classify.CacheCount(), kThreads + 1);
+
+  // Caches of another switch are not mixed up with these ones
+  std::atomic<int> other_calls = 0;
+  const swstr::ThreadLocalCachedSwitch other(CountingSwitch{&other_calls}, 8);
+  EXPECT_EQ(other("bingbot"), "BOT");
+  EXPECT_EQ(other_calls, 1);
+  EXPECT_EQ(classify("bingbot"), "BOT");
+  EXPECT_EQ(other("bingbot"), "BOT");
+  EXPECT_EQ(other_calls, 1);
+}
+
+TEST(CachedSwitchTest, ThreadLocalDestroyed) {
+  std::atomic<int> calls = 0;
+  const std::size_t entries = swstr::details::ThreadCaches().size();
+
+  // The entries of the switches destroyed are dropped by the thread
+  for (int i = 0; i < 100; ++i) {
+    const swstr::ThreadLocalCachedSwitch classify(CountingSwitch{&calls}, 8);
+    EXPECT_EQ(classify("bingbot"), "BOT");
+    EXPECT_EQ(classify("bingbot"), "BOT");
+  }
+  EXPECT_EQ(calls, 100);
+  EXPECT_LE(swstr::details::ThreadCaches().size(), entries + 1);
+}
+
+}  // namespace
@@ -0,0 +1,156 @@
+#include <cstdint>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include "SwitchStr/EqualsTable.hpp"
+#include "SwitchStr/SwitchStr.hpp"
+#include "SwitchStr/SwitchTable.hpp"
+#include "gtest/gtest.h"
+
+namespace {
+
+TEST(EqualsTableTest, Lookup) {
+  using swstr::EqualsTable;
+
+  const auto table = EqualsTable<std::string>::Builder()
+                         .Case("example.com", "EXAMPLE")
+                         .Case("example.org", "ORG")
+                         .Case("", "EMPTY")
+                         .Case("example.com", "EXAMPLE (again)")
+                         .Build();
+
+  EXPECT_EQ(table.Size(), 4);
+  EXPECT_EQ(table.LookupOr("example.com", "NONE"), "EXAMPLE");
+  EXPECT_EQ(table.LookupOr("example.org", "NONE"), "ORG");
+  EXPECT_EQ(table.LookupOr("", "NONE"), "EMPTY");
+  EXPECT_EQ(table.LookupOr("example.net", "NONE"), "NONE");
+  EXPECT_EQ(table.LookupOr("example.co", "NONE"), "NONE");
+  EXPECT_EQ(table.LookupOr("example.comm", "NONE"), "NONE");
+
+  EXPECT_EQ(table.IndexOf("example.org"), 1);
+  EXPECT_EQ(table.IndexOf("example.net"), table.npos);
+  EXPECT_EQ(table.Lookup("example.net"), nullptr);
+  EXPECT_EQ(table.ValueAt(3), "EXAMPLE (again)");
+
+  EXPECT_EQ(table.Lengths().min, 0);
+  EXPECT_EQ(table.Lengths().max, 11);
+
+  const auto empty = EqualsTable<int>::Builder().Build();
+  EXPECT_EQ(empty.Size(), 0);
+  EXPECT_EQ(empty.Lookup(""), nullptr);
+  EXPECT_EQ(empty.Lookup("example.com"), nullptr);
+
+  static_assert(swstr::IsThreadShareable_v<EqualsTable<int>>);
+}
+
+TEST(EqualsTableTest, Growth) {
+  // Enough keys to grow the table many times, sharing long prefixes and
+  // suffixes
+  std::vector<std::string> hosts;
+  for (std::size_t i = 0; i < 50000; ++i) {
+    hosts.push_back("host-" + std::to_string(i) + ".cluster.example.com");
+  }
+
+  auto builder = swstr::EqualsTable<std::size_t>::Builder();
+  for (std::size_t i = 0; i < hosts.size(); ++i) {
+    builder.Case(hosts[i], i);
+  }
+  const auto table = std::move(builder).Build();
+
+  ASSERT_EQ(table.Size(), hosts.size());
+  for (std::size_t i = 0; i < hosts.size(); ++i) {
+    ASSERT_EQ(table.IndexOf(hosts[i]), i) << hosts[i];
+  }
+  EXPECT_EQ(table.Lookup("host-50000.cluster.example.com"), nullptr);
+  EXPECT_EQ(table.Lookup("host-0.cluster.example.co"), nullptr);
+
+  // Keys copied contiguously, slots at most 8/7 of the keys, rounded up
+  EXPECT_GE(table.MemoryUsage(), hosts.size() * 20);
+  EXPECT_LE(table.MemoryUsage(), hosts.size() * 200);
+}
+
+TEST(EqualsTableTest, Reserve) {
+  swstr::details::SwissTable table;
+  table.Reserve(1000);
+  const std::size_t capacity = table.Capacity();
+  EXPECT_GE(capacity, 1000);
+
+  for (std::uint32_t i = 0; i < 1000; ++i) {
+    EXPECT_EQ(table.Insert(std::to_string(i), i), i);
+  }
+  EXPECT_EQ(table.Insert("10", 1000), 10);
+  EXPECT_EQ(table.Size(), 1000);
+  EXPECT_EQ(table.Capacity(), capacity);
+}
+
+TEST(EqualsTableTest, GroupMasks) {
+  using swstr::details::FindGroupMasks;
+  using swstr::details::GroupMasksScalar;
+  using swstr::details::kEmptyCtrl;
+
+  std::uint8_t ctrl[16];
+  for (std::size_t i = 0; i < 16; ++i) {
+    ctrl[i] = static_cast<std::uint8_t>((i % 3 == 0) ? kEmptyCtrl : i % 4);
+  }
+
+  for (std::uint8_t tag = 0; tag < 5; ++tag) {
+    const auto expected = GroupMasksScalar(ctrl, tag);
+    const auto masks = FindGroupMasks(ctrl, tag);
+    EXPECT_EQ(masks.tags, expected.tags) << int{tag};
+    EXPECT_EQ(masks.empty, expected.empty) << int{tag};
+  }
+  EXPECT_EQ(GroupMasksScalar(ctrl, 1).tags, 0b0010'0000'0010'0010);
+  EXPECT_EQ(GroupMasksScalar(ctrl, 0).empty, 0b1001'0010'0100'1001);
+}
+
+TEST(EqualsTableTest, Switch) {
+  using swstr::EndsWith;
+  using swstr::EqualsAnyOf;
+
+  const auto hosts = swstr::EqualsTable<int>::Builder()
+                         .Case("localhost", 1)
+                         .Case("db.internal", 2)
+                         .Case("api.example.com", 3)
+                         .Build();
+
+  std::size_t which = hosts.npos;
+  const auto classify = [&](std::string_view host) {
+    return swstr::SwitchStr<int>(host)
+        .Case("localhost", 0)
+        .Case(EqualsAnyOf(hosts, &which), [&] { return hosts.ValueAt(which); })
+        .Case(EndsWith(".internal"), 4)
+        .Default(-1);
+  };
+
+  // Cases keep their declaration order, around and inside the table
+  EXPECT_EQ(classify("localhost"), 0);
+  EXPECT_EQ(classify("db.internal"), 2);
+  EXPECT_EQ(classify("api.example.com"), 3);
+  EXPECT_EQ(classify("cache.internal"), 4);
+  EXPECT_EQ(classify("example.com"), -1);
+
+  EXPECT_TRUE(EqualsAnyOf(hosts)("db.internal"));
+  EXPECT_FALSE(EqualsAnyOf(hosts)("db.internal."));
+  EXPECT_EQ(EqualsAnyOf(hosts).Lengths().max, 15);
+
+  static_assert(swstr::IsThreadShareable_v<decltype(EqualsAnyOf(hosts))>);
+  static_assert(
+      not swstr::IsThreadShareable_v<decltype(EqualsAnyOf(hosts, &which))>);
+
+  // As a single opaque case of a SwitchTable
+  const auto table = swstr::SwitchTable<int>::Builder()
+                         .Case(swstr::StartsWith("db."), 10)
+                         .Case(EqualsAnyOf(hosts), 11)
+                         .Case(EndsWith(".com"), 12)
+                         .Case("localhost", 13)
+                         .Case(swstr::Equals("other"), 14)
+                         .Build();
+  EXPECT_EQ(table.LookupOr("db.internal", -1), 10);
+  EXPECT_EQ(table.LookupOr("api.example.com", -1), 11);
+  EXPECT_EQ(table.LookupOr("localhost", -1), 11);
+  EXPECT_EQ(table.LookupOr("example.com", -1), 12);
+  EXPECT_EQ(table.LookupOr("other", -1), 14);
+}
+
+}  // namespace
@@ -0,0 +1,89 @@
+#include <random>
+#include <string>
+#include <string_view>
+
+#include "RandomStrings.hpp"
+#include "SwitchStr/Matcher.hpp"
+#include "SwitchStr/details/Find.hpp"
+#include "gtest/gtest.h"
+
+namespace {
+
+TEST(FindTest, Constexpr) {
+  using swstr::details::Find;
+  using swstr::details::RFind;
+
+  static_assert(Find("foofoo", "oof") == 1);
+  static_assert(RFind("foofoo", "foo") == 3);
+  static_assert(Find("foofoo", "") == 0);
+  static_assert(RFind("foofoo", "") == 6);
+  static_assert(Find("foo", "foofoo") == std::string_view::npos);
+}
+
+TEST(FindTest, SameAsFindRFind) {
+  using swstr::details::Find;
+  using swstr::details::RFind;
+
+  std::mt19937 rng(42);
+  std::uniform_int_distribution<std::size_t> needle_size(0, 8);
+  std::uniform_int_distribution<std::size_t> str_size(0, 200);
+
+  for (int i = 0; i < 5000; ++i) {
+    const auto needle = helper::RandomString(rng, needle_size(rng));
+    const auto str = helper::RandomString(rng, str_size(rng));
+
+    SCOPED_TRACE(::testing::Message() << "needle = " << needle
+                                      << ", str = " << str);
+
+    const auto first = std::string_view{str}.find(needle);
+    const auto last = std::string_view{str}.rfind(needle);
+
+    EXPECT_EQ(Find(str, needle), first);
+    EXPECT_EQ(RFind(str, needle), last);
+
+#if SwitchStr_X86_DISPATCH
+    namespace cpu = swstr::details::cpu;
+
+    if (not needle.empty() and (needle.size() <= str.size())) {
+      EXPECT_EQ(swstr::details::FindSse2(str, needle), first);
+      EXPECT_EQ(swstr::details::RFindSse2(str, needle), last);
+
+      if (cpu::HasAvx2()) {
+        EXPECT_EQ(swstr::details::FindAvx2(str, needle), first);
+        EXPECT_EQ(swstr::details::RFindAvx2(str, needle), last);
+      }
+    }
+#endif
+  }
+}
+
+TEST(FindTest, ContainsLongStrings) {
+  using swstr::Contains;
+  using swstr::ContainsR;
+
+  // Many partial matches of the needle (only its prefix)
+  std::string str;
+  for (int i = 0; i < 100; ++i) {
+    str += "needl";
+  }
+  str.replace(137, 6, "needle");
+  str.replace(371, 6, "needle");
+
+  std::size_t pos = std::string_view::npos;
+  EXPECT_TRUE(IsMatching(Contains("needle", &pos), str));
+  EXPECT_EQ(pos, 137);
+  EXPECT_TRUE(IsMatching(ContainsR("needle", &pos), str));
+  EXPECT_EQ(pos, 371);
+  EXPECT_TRUE(IsMatching(Contains('e', &pos), str));
+  EXPECT_EQ(pos, 1);
+  EXPECT_TRUE(IsMatching(ContainsR('e', &pos), str));
+  EXPECT_EQ(pos, str.rfind('e'));
+
+  pos = std::string_view::npos;
+  EXPECT_FALSE(IsMatching(Contains("needles", &pos), str));
+  EXPECT_FALSE(IsMatching(ContainsR("needles", &pos), str));
+  EXPECT_FALSE(IsMatching(ContainsR('!', &pos), str));
+  EXPECT_EQ(pos, std::string_view::npos);
+}
+
+}  // namespace
@@ -0,0 +1,121 @@
+#include <sstream>
+#include <string_view>
+#include <thread>
+
+#include "SwitchStr/Instrumentation.hpp"
+#include "SwitchStr/Matcher.hpp"
+#include "SwitchStr/SwitchStr.hpp"
+#include "SwitchStr/TokenSwitch.hpp"
+#include "gtest/gtest.h"
+
+namespace {
+
+static_assert(SwitchStr_ENABLE_INSTRUMENTATION,
+              "This test must be built with the instrumentation enabled");
+
+auto Classify(std::string_view str) -> int {
+  return swstr::SwitchStr<int>(str)
+      .Case("foo", 0)
+      .Case(swstr::StartsWith("ba"), 1)
+      .Case(swstr::EndsWith("z"), 2)
+      .Default(-1);
+}
+
+// Not instrumented when used in constant expressions
+static_assert(swstr::SwitchStr<int>("bar").Case("foo", 0).Default(-1) == -1);
+
+/// The stats of the only site of \a kind
+auto SiteOf(std::string_view kind) -> swstr::instrument::SiteStats {
+  swstr::instrument::SiteStats found;
+  for (auto& site : swstr::instrument::Collect()) {
+    if (site.kind == kind) {
+      EXPECT_TRUE(found.kind.empty()) << "More than one site of " << kind;
+      found = site;
+    }
+  }
+  return found;
+}
+
+TEST(InstrumentationTest, SwitchStr) {
+  swstr::instrument::Reset();
+
+  EXPECT_EQ(Classify("foo"), 0);
+  EXPECT_EQ(Classify("bar"), 1);
+  EXPECT_EQ(Classify("baz"), 1);
+  EXPECT_EQ(Classify("fiz"), 2);
+  EXPECT_EQ(Classify("nope"), -1);
+
+  const auto site = SiteOf("SwitchStr");
+  EXPECT_EQ(site.file, __FILE__);
+  ASSERT_EQ(site.cases.size(), 3);
+
+  // Cases are only evaluated until one wins
+  EXPECT_EQ(site.cases[0].evaluations, 5);
+  EXPECT_EQ(site.cases[0].hits, 1);
+  EXPECT_EQ(site.cases[1].evaluations, 4);
+  EXPECT_EQ(site.cases[1].hits, 2);
+  EXPECT_EQ(site.cases[2].evaluations, 2);
+  EXPECT_EQ(site.cases[2].hits, 1);
+  EXPECT_EQ(site.cases[2].cycles, 0);
+}
+
+TEST(InstrumentationTest, TokenSwitch) {
+  swstr::instrument::Reset();
+
+  for (const auto* line : {"get a", "set a 1", "del a", "get b"}) {
+    swstr::TokenSwitch<int>(line).Case("get", 0).Case("set", 1).Default(-1);
+  }
+
+  const auto site = SiteOf("TokenSwitch");
+  ASSERT_EQ(site.cases.size(), 2);
+  EXPECT_EQ(site.cases[0].evaluations, 4);
+  EXPECT_EQ(site.cases[0].hits, 2);
+  EXPECT_EQ(site.cases[1].evaluations, 2);
+  EXPECT_EQ(site.cases[1].hits, 1);
+}
+
+TEST(InstrumentationTest, MergesThreads) {
+  swstr::instrument::Reset();
+  swstr::instrument::EnableCycles();
+
+  std::thread worker([] {
+    for (int i = 0; i < 100; ++i) Classify("foo");
+  });
+  for (int i = 0; i < 50; ++i) Classify("bar");
+  worker.join();
+
+  swstr::instrument::EnableCycles(false);
+
+  // Cases never evaluated by any thread may be reported with 0 evaluations
+  const auto site = SiteOf("SwitchStr");
+  ASSERT_GE(site.cases.size(), 2);
+  EXPECT_EQ(site.cases[0].evaluations, 150);
+  EXPECT_EQ(site.cases[0].hits, 100);
+  EXPECT_EQ(site.cases[1].evaluations, 50);
+  EXPECT_EQ(site.cases[1].hits, 50);
+  EXPECT_GT(site.cases[0].cycles, 0);
+}
+
+TEST(InstrumentationTest, AnyMatcher) {
+  swstr::instrument::Reset();
+
+  const swstr::AnyMatcher matcher(swstr::Contains("needle"));
+  const swstr::AnyMatcher copy = swstr::AnyMatcher(matcher);
+
+  EXPECT_TRUE(matcher.IsMatching("a needle"));
+  EXPECT_FALSE(matcher.IsMatching("hay"));
+  EXPECT_TRUE(copy.IsMatching("needles"));
+
+  // The copy records into the site of the original
+  const auto site = SiteOf("AnyMatcher");
+  ASSERT_EQ(site.cases.size(), 1);
+  EXPECT_EQ(site.cases[0].evaluations, 3);
+  EXPECT_EQ(site.cases[0].hits, 2);
+
+  std::ostringstream dump;
+  swstr::instrument::Dump(dump);
+  EXPECT_NE(dump.str().find("AnyMatcher #0 3 2 0\n"), std::string::npos)
+      << dump.str();
+}
+
+}  // namespace
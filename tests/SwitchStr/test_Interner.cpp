@@ -0,0 +1,243 @@
+#include <atomic>
+#include <string>
+#include <string_view>
+#include <thread>
+#include <vector>
+
+#include "SwitchStr/Interner.hpp"
+#include "SwitchStr/Matcher.hpp"
+#include "gtest/gtest.h"
+
+namespace {
+
+TEST(InternerTest, Intern) {
+  swstr::Interner interner;
+  EXPECT_EQ(interner.Size(), 0);
+  EXPECT_FALSE(interner.Find("cpu.load").IsValid());
+
+  const swstr::Symbol cpu = interner.Intern("cpu.load");
+  const swstr::Symbol mem = interner.Intern("mem.used");
+  const swstr::Symbol empty = interner.Intern("");
+
+  EXPECT_EQ(cpu.Id(), 0);
+  EXPECT_EQ(mem.Id(), 1);
+  EXPECT_EQ(empty.Id(), 2);
+  EXPECT_EQ(interner.Size(), 3);
+
+  EXPECT_EQ(interner.Intern("cpu.load"), cpu);
+  EXPECT_EQ(interner.Intern(std::string("mem.used")), mem);
+  EXPECT_EQ(interner.Intern(""), empty);
+  EXPECT_EQ(interner.Size(), 3);
+
+  EXPECT_EQ(interner.Find("cpu.load"), cpu);
+  EXPECT_EQ(interner.Find("mem.used"), mem);
+  EXPECT_EQ(interner.Find(""), empty);
+  EXPECT_FALSE(interner.Find("cpu.loa").IsValid());
+  EXPECT_FALSE(interner.Find("cpu.loads").IsValid());
+  EXPECT_FALSE(swstr::Symbol().IsValid());
+
+  EXPECT_EQ(interner.View(cpu), "cpu.load");
+  EXPECT_EQ(interner.View(mem), "mem.used");
+  EXPECT_EQ(interner.View(empty), "");
+
+  // Views point to the copies owned by the interner
+  const std::string temporary = "disk.free";
+  const swstr::Symbol disk = interner.Intern(temporary);
+  EXPECT_NE(interner.View(disk).data(), temporary.data());
+}
+
+TEST(InternerTest, EmptyFirst) {
+  // Nothing was stored yet when interning ""
+  swstr::Interner interner;
+  const swstr::Symbol empty = interner.Intern("");
+  EXPECT_EQ(empty.Id(), 0);
+  EXPECT_EQ(interner.View(empty), "");
+  EXPECT_EQ(interner.Find(""), empty);
+
+  const swstr::Symbol cpu = interner.Intern("cpu.load");
+  EXPECT_EQ(interner.View(cpu), "cpu.load");
+  EXPECT_EQ(interner.Intern(""), empty);
+  EXPECT_EQ(interner.Size(), 2);
+}
+
+TEST(InternerTest, Growth) {
+  // Enough symbols to grow the table many times and fill many directory
+  // segments, with some strings longer than a chunk
+  swstr::Interner interner;
+  std::vector<std::string> strs;
+  for (std::size_t i = 0; i < 20000; ++i) {
+    strs.push_back("metric." + std::to_string(i) + ".count");
+  }
+  strs.push_back(std::string(swstr::Interner::kChunkSize + 1, 'x'));
+  strs.push_back(std::string(swstr::Interner::kChunkSize / 2, 'y'));
+
+  std::vector<swstr::Symbol> symbols;
+  for (const std::string& str : strs) {
+    symbols.push_back(interner.Intern(str));
+  }
+
+  ASSERT_EQ(interner.Size(), strs.size());
+  for (std::size_t i = 0; i < strs.size(); ++i) {
+    EXPECT_EQ(symbols[i].Id(), i);
+    EXPECT_EQ(interner.Find(strs[i]), symbols[i]);
+    EXPECT_EQ(interner.Intern(strs[i]), symbols[i]);
+    EXPECT_EQ(interner.View(symbols[i]), strs[i]);
+  }
+  EXPECT_EQ(interner.Size(), strs.size());
+  EXPECT_FALSE(interner.Find("metric.20000.count").IsValid());
+
+  const swstr::InternerMemory memory = interner.Memory();
+  EXPECT_EQ(memory.symbols, strs.size());
+
+  std::size_t string_bytes = 0;
+  for (const std::string& str : strs) {
+    string_bytes += str.size();
+  }
+  EXPECT_EQ(memory.string_bytes, string_bytes);
+  EXPECT_GE(memory.arena_bytes, string_bytes);
+  EXPECT_GE(memory.directory_bytes, strs.size() * sizeof(void*));
+  EXPECT_GE(memory.table_bytes, 2 * strs.size() * sizeof(std::uint64_t));
+  EXPECT_LT(memory.retired_bytes, memory.table_bytes);
+  EXPECT_EQ(memory.Total(), memory.arena_bytes + memory.directory_bytes +
+                                memory.table_bytes + memory.retired_bytes);
+}
+
+TEST(InternerTest, Reserve) {
+  swstr::Interner interner(1000);
+  const std::size_t table_bytes = interner.Memory().table_bytes;
+
+  for (std::size_t i = 0; i < 1000; ++i) {
+    interner.Intern(std::to_string(i));
+  }
+  EXPECT_EQ(interner.Memory().table_bytes, table_bytes);
+  EXPECT_EQ(interner.Memory().retired_bytes, 0);
+}
+
+TEST(InternerTest, Concurrent) {
+  constexpr std::size_t kStrings = 4096;
+  constexpr std::size_t kThreads = 4;
+
+  std::vector<std::string> strs;
+  for (std::size_t i = 0; i < kStrings; ++i) {
+    strs.push_back("tag." + std::to_string(i));
+  }
+
+  swstr::Interner interner;
+  std::vector<std::vector<swstr::Symbol>> symbols(kThreads);
+  std::atomic<bool> find_failed = false;
+
+  // All threads intern all strings, each in a different order (kStrings is
+  // a power of 2), while looking up the ones they already interned
+  std::vector<std::thread> threads;
+  for (std::size_t t = 0; t < kThreads; ++t) {
+    threads.emplace_back([&, t] {
+      symbols[t].resize(kStrings);
+      for (std::size_t n = 0; n < kStrings; ++n) {
+        const std::size_t i = (n * (2 * t + 1) + t) % kStrings;
+        symbols[t][i] = interner.Intern(strs[i]);
+        if ((interner.Find(strs[i]) != symbols[t][i]) or
+            (interner.View(symbols[t][i]) != strs[i])) {
+          find_failed = true;
+        }
+      }
+    });
+  }
+  for (std::thread& thread : threads) {
+    thread.join();
+  }
+
+  EXPECT_FALSE(find_failed);
+  EXPECT_EQ(interner.Size(), kStrings);
+  for (std::size_t t = 1; t < kThreads; ++t) {
+    EXPECT_EQ(symbols[t], symbols[0]);
+  }
+  for (std::size_t i = 0; i < kStrings; ++i) {
+    EXPECT_EQ(interner.View(symbols[0][i]), strs[i]);
+  }
+}
+
+TEST(InternerTest, SymbolSwitch) {
+  using swstr::Equals;
+  using swstr::SymbolSwitch;
+
+  swstr::Interner interner;
+  const swstr::Symbol cpu = interner.Intern("cpu.load");
+  const swstr::Symbol mem = interner.Intern("mem.used");
+  const swstr::Symbol disk = interner.Intern("disk.free");
+
+  const auto classify = [&](std::string_view name) {
+    return SymbolSwitch<int>(interner.Find(name))
+        .Case(cpu, 0)
+        .Case(Equals(mem), 1)
+        .Case([&](swstr::Symbol s) { return s == disk; }, [] { return 2; })
+        .Default(-1);
+  };
+
+  EXPECT_EQ(classify("cpu.load"), 0);
+  EXPECT_EQ(classify("mem.used"), 1);
+  EXPECT_EQ(classify("disk.free"), 2);
+  EXPECT_EQ(classify("net.rx"), -1);
+  EXPECT_EQ(classify(""), -1);
+
+  // The invalid symbol never matches, not even itself
+  EXPECT_FALSE(Equals(swstr::Symbol()).IsMatching(swstr::Symbol()));
+  EXPECT_EQ(SymbolSwitch<int>(interner.Find("net.rx"))
+                .Case(interner.Find("net.tx"), 0)
+                .Default(-1),
+            -1);
+
+  static_assert(Equals(swstr::Symbol(3)).IsMatching(swstr::Symbol(3)));
+  static_assert(not Equals(swstr::Symbol(3))(swstr::Symbol(4)));
+  static_assert(swstr::IsThreadShareable_v<swstr::SymbolMatcher>);
+}
+
+TEST(InternerTest, SymbolTable) {
+  using swstr::SymbolTable;
+
+  swstr::Interner interner;
+  const swstr::Symbol unrelated = interner.Intern("unrelated");
+
+  const auto table = SymbolTable<std::string>::Builder(interner)
+                         .Case("cpu.load", "CPU")
+                         .Case("mem.used", "MEM")
+                         .Case(interner.Intern("disk.free"), "DISK")
+                         .Case("cpu.load", "CPU (again)")
+                         .Case(swstr::Symbol(), "NEVER")
+                         .Build();
+
+  EXPECT_EQ(table.Size(), 5);
+  EXPECT_EQ(table.LookupOr(interner.Find("cpu.load"), "NONE"), "CPU");
+  EXPECT_EQ(table.LookupOr(interner.Find("mem.used"), "NONE"), "MEM");
+  EXPECT_EQ(table.LookupOr(interner.Find("disk.free"), "NONE"), "DISK");
+  EXPECT_EQ(table.LookupOr(interner.Find("net.rx"), "NONE"), "NONE");
+  EXPECT_EQ(table.LookupOr(unrelated, "NONE"), "NONE");
+  EXPECT_EQ(table.LookupOr(swstr::Symbol(), "NONE"), "NONE");
+  EXPECT_EQ(table.LookupOr(swstr::Symbol(1000), "NONE"), "NONE");
+
+  EXPECT_EQ(table.IndexOf(interner.Find("disk.free")), 2);
+  EXPECT_EQ(table.IndexOf(unrelated), table.npos);
+  EXPECT_EQ(table.Lookup(unrelated), nullptr);
+
+  const auto empty = SymbolTable<int>::Builder(interner).Build();
+  EXPECT_EQ(empty.Size(), 0);
+  EXPECT_EQ(empty.Lookup(unrelated), nullptr);
+  EXPECT_EQ(empty.Lookup(swstr::Symbol()), nullptr);
+}
+
+TEST(InternerTest, WordHashStr) {
+  using swstr::details::WordHashStr;
+
+  static_assert(WordHashStr("cpu.load") == WordHashStr("cpu.load"));
+  static_assert(WordHashStr("cpu.load") != WordHashStr("cpu.loaD"));
+
+  // Every byte is hashed, unlike QuickHashStr
+  const std::string base(40, 'a');
+  for (std::size_t i = 0; i < base.size(); ++i) {
+    std::string other = base;
+    other[i] = 'b';
+    EXPECT_NE(WordHashStr(base), WordHashStr(other)) << i;
+  }
+  EXPECT_NE(WordHashStr(""), WordHashStr(std::string_view("\0", 1)));
+}
+
+}  // namespace
@@ -0,0 +1,49 @@
+#include <random>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include "SwitchStr/details/Lines.hpp"
+#include "gtest/gtest.h"
+
+namespace {
+
+auto SplitLines(std::string_view text) -> std::vector<std::string_view> {
+  std::vector<std::string_view> lines;
+  swstr::details::ForEachLine(
+      text, [&](std::string_view line) { lines.push_back(line); });
+  return lines;
+}
+
+TEST(LinesTest, ForEachLine) {
+  using Lines = std::vector<std::string_view>;
+
+  EXPECT_EQ(SplitLines(""), Lines{});
+  EXPECT_EQ(SplitLines("\n"), Lines{""});
+  EXPECT_EQ(SplitLines("foo"), Lines{"foo"});
+  EXPECT_EQ(SplitLines("foo\n"), Lines{"foo"});
+  EXPECT_EQ(SplitLines("foo\n\nbar"), (Lines{"foo", "", "bar"}));
+}
+
+TEST(LinesTest, SameAsScalar) {
+  std::mt19937 rng(42);
+  std::uniform_int_distribution<int> byte(0, 7);
+
+  // New lines at all positions of the 16/32 bytes blocks
+  for (std::size_t size = 0; size < 200; ++size) {
+    std::string text(size, 'a');
+    for (auto& c : text) {
+      if (byte(rng) == 0) c = '\n';
+    }
+
+    std::vector<std::size_t> expected;
+    std::vector<std::size_t> found;
+    swstr::details::ForEachByteScalar(
+        text, '\n', [&](std::size_t pos) { expected.push_back(pos); });
+    swstr::details::ForEachByte(
+        text, '\n', [&](std::size_t pos) { found.push_back(pos); });
+    EXPECT_EQ(found, expected) << text;
+  }
+}
+
+}  // namespace
@@ -1,3 +1,10 @@
+#include <optional>
+#include <string>
+#include <string_view>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
 #include "MatcherMock.hpp"
 #include "gmock/gmock.h"
 #include "gtest/gtest.h"
@@ -177,6 +184,66 @@ TEST(SwitchStrMatcherTest, ContainsOneOfR) {
   EXPECT_TRUE(IsMatching(ContainsOneOfR("foo"), "bar fo "));
 }
 
+TEST(SwitchStrMatcherTest, ContainsAnyOf) {
+  using swstr::ContainsAnyOf;
+
+  std::size_t pos = std::string_view::npos;
+  std::size_t needle = std::string_view::npos;
+  EXPECT_TRUE(IsMatching(ContainsAnyOf({"foo", "bar"}), "foo"));
+  EXPECT_TRUE(IsMatching(ContainsAnyOf({"foo", "bar"}), "bar"));
+
+  EXPECT_TRUE(IsMatching(ContainsAnyOf({"foo", "bar"}, &pos, &needle),
+                         "0123bar43210foo"));
+  EXPECT_EQ(pos, 4);
+  EXPECT_EQ(needle, 1);
+
+  // The needle ending first wins
+  EXPECT_TRUE(IsMatching(ContainsAnyOf({"abcd", "bc"}, &pos, &needle),
+                         "xabcd"));
+  EXPECT_EQ(pos, 2);
+  EXPECT_EQ(needle, 1);
+
+  // Then, the first declared
+  EXPECT_TRUE(
+      IsMatching(ContainsAnyOf({"o", "foo", "oo"}, &pos, &needle), "xfoo"));
+  EXPECT_EQ(pos, 2);
+  EXPECT_EQ(needle, 0);
+  EXPECT_TRUE(IsMatching(ContainsAnyOf({"oo", "foo"}, &pos, &needle), "xfoo"));
+  EXPECT_EQ(pos, 2);
+  EXPECT_EQ(needle, 0);
+
+  EXPECT_TRUE(IsMatching(ContainsAnyOf({"foo", ""}, &pos, &needle), "bar"));
+  EXPECT_EQ(pos, 0);
+  EXPECT_EQ(needle, 1);
+
+  pos = std::string_view::npos;
+  needle = std::string_view::npos;
+  EXPECT_FALSE(IsMatching(ContainsAnyOf({"foo", "bar"}, &pos, &needle),
+                          "fo obaz"));
+  EXPECT_EQ(pos, std::string_view::npos);
+  EXPECT_EQ(needle, std::string_view::npos);
+
+  EXPECT_FALSE(IsMatching(ContainsAnyOf({}), "foo"));
+  EXPECT_FALSE(IsMatching(ContainsAnyOf({"foo"}), ""));
+
+  // Same as AnyOf(Contains(...)...)
+  using swstr::AnyOf;
+  using swstr::Contains;
+
+  const std::vector<std::string> needles = {"he", "she", "his", "hers",
+                                            "\xff\x7f"};
+  const auto any_of_contains = ContainsAnyOf(needles);
+  for (std::string_view str :
+       {"", "h", "ushers", "hi", "this", "shers", "hxexrxs", "sh", "ahishers",
+        "\xff", "\xff\x7f"}) {
+    EXPECT_EQ(IsMatching(any_of_contains, str),
+              IsMatching(AnyOf(Contains("he"), Contains("she"), Contains("his"),
+                               Contains("hers"), Contains("\xff\x7f")),
+                         str))
+        << str;
+  }
+}
+
 TEST(SwitchStrMatcherTest, DoNot) {
   using swstr::DoNot;
   using swstr::Equals;
@@ -400,4 +467,356 @@ TEST(SwitchStrMatcherTest, AnyMatcher) {
   EXPECT_FALSE(IsMatching(any_matcher, "bar"));
 }
 
+/// Side effect free matcher of a given cost, logging its calls
+template <std::size_t Cost>
+struct LoggingMatcher {
+  static constexpr bool is_thread_shareable = true;
+  static constexpr std::size_t match_cost = Cost;
+
+  auto IsMatching(std::string_view) const -> bool {
+    log->push_back(id);
+    return result;
+  }
+
+  int id;
+  bool result;
+  std::vector<int>* log;
+};
+
+TEST(SwitchStrMatcherTest, MetaSimplifications) {
+  using swstr::AllOf;
+  using swstr::AnyOf;
+  using swstr::DoNot;
+  using swstr::Equals;
+  using swstr::StartsWith;
+
+  static_assert(std::is_same_v<decltype(DoNot(DoNot(Equals("a")))),
+                               swstr::EqualsMatcher>);
+  static_assert(
+      std::is_same_v<decltype(AllOf(AllOf(Equals("a"), StartsWith("b")),
+                                    AllOf("c"))),
+                     swstr::AllOfMatcher<swstr::EqualsMatcher,
+                                         swstr::StartsWithMatcher,
+                                         const char*>>);
+  static_assert(
+      std::is_same_v<decltype(AnyOf(AllOf("a"), AnyOf("b", "c"))),
+                     swstr::AnyOfMatcher<swstr::AllOfMatcher<const char*>,
+                                         const char*, const char*>>);
+
+  static_assert(swstr::MatchCost_v<decltype(Equals("a"))> <
+                swstr::MatchCost_v<decltype(swstr::Contains("a"))>);
+  static_assert(swstr::MatchCost_v<decltype([](std::string_view) {
+                  return true;
+                })> == swstr::details::kCostOpaque);
+
+  EXPECT_TRUE(IsMatching(DoNot(DoNot(Equals("a"))), "a"));
+}
+
+int g_predicate_calls = 0;
+
+/// User predicate with a side effect
+auto CountAndAccept(std::string_view) -> bool {
+  ++g_predicate_calls;
+  return true;
+}
+
+TEST(SwitchStrMatcherTest, MetaEvaluationOrder) {
+  using swstr::AllOf;
+  using swstr::AnyOf;
+
+  std::vector<int> log;
+  const LoggingMatcher<10> expensive{0, true, &log};
+  const LoggingMatcher<1> cheap{1, true, &log};
+
+  EXPECT_TRUE(IsMatching(AllOf(expensive, cheap), "foo"));
+  EXPECT_EQ(log, (std::vector<int>{1, 0}));
+
+  // Matchers with side effects ('where') are never moved across
+  log.clear();
+  std::size_t where = 0;
+  EXPECT_TRUE(
+      IsMatching(AllOf(expensive, swstr::Contains("o", &where), cheap), "foo"));
+  EXPECT_EQ(log, (std::vector<int>{0, 1}));
+  EXPECT_EQ(where, 1);
+
+  log.clear();
+  const LoggingMatcher<1> cheap_miss{2, false, &log};
+  EXPECT_TRUE(IsMatching(AnyOf(expensive, cheap_miss, cheap), "foo"));
+  EXPECT_EQ(log, (std::vector<int>{2, 1}));
+
+  // User predicates are called when declared: never moved nor skipped (i.e.
+  // by the length check), even when they look side effects free
+  g_predicate_calls = 0;
+  EXPECT_FALSE(IsMatching(AllOf(&CountAndAccept, swstr::Equals("x")), "y"));
+  EXPECT_EQ(g_predicate_calls, 1);
+  EXPECT_TRUE(IsMatching(
+      AnyOf([](std::string_view) { return CountAndAccept("") and false; },
+            swstr::Equals("y")),
+      "y"));
+  EXPECT_EQ(g_predicate_calls, 2);
+
+  static_assert(swstr::IsReorderable_v<decltype(swstr::Equals("x"))>);
+  static_assert(swstr::IsReorderable_v<decltype("x")>);
+  static_assert(swstr::IsReorderable_v<decltype(AllOf(swstr::Equals("x"),
+                                                      swstr::Contains("y")))>);
+  static_assert(not swstr::IsReorderable_v<decltype(&CountAndAccept)>);
+  static_assert(not swstr::IsReorderable_v<swstr::AnyShareableMatcher>);
+  static_assert(not swstr::IsReorderable_v<decltype(AllOf(
+                    swstr::Equals("x"), &CountAndAccept))>);
+  static_assert(not swstr::IsReorderable_v<decltype(swstr::Contains(
+                    "x", static_cast<std::size_t*>(nullptr)))>);
+}
+
+TEST(SwitchStrMatcherTest, MetaLengths) {
+  using swstr::AllOf;
+  using swstr::AnyOf;
+  using swstr::EndsWith;
+  using swstr::Equals;
+  using swstr::StartsWith;
+
+  constexpr auto all_of = AllOf(StartsWith("abc"), EndsWith("wxyz"));
+  static_assert(all_of.Lengths().min == 4);
+  static_assert(all_of.Lengths().max == std::string_view::npos);
+
+  constexpr auto any_of = AnyOf(Equals("ab"), "abcd", Equals("abcdef"));
+  static_assert(any_of.Lengths().min == 2);
+  static_assert(any_of.Lengths().max == 6);
+
+  // Too short strings are rejected before calling any matcher
+  std::vector<int> log;
+  const LoggingMatcher<1> logging{0, true, &log};
+  EXPECT_FALSE(IsMatching(AllOf(StartsWith("abc"), logging), "ab"));
+  EXPECT_TRUE(log.empty());
+  EXPECT_TRUE(IsMatching(AllOf(StartsWith("abc"), logging), "abc"));
+  EXPECT_EQ(log.size(), 1);
+}
+
+TEST(SwitchStrMatcherTest, MetaEqualsSet) {
+  using swstr::AnyOf;
+  using swstr::Equals;
+
+  // Constant evaluated: the Equals are collapsed into a set, built once
+  static constexpr auto kMethods =
+      AnyOf(Equals("GET"), Equals("HEAD"), "POST", Equals("PUT"), "DELETE",
+            Equals("CONNECT"), Equals("OPTIONS"), Equals("TRACE"),
+            swstr::StartsWith("X-"));
+
+  // Built at runtime: no set, the Equals are evaluated one by one
+  const auto methods =
+      AnyOf(Equals("GET"), Equals("HEAD"), "POST", Equals("PUT"), "DELETE",
+            Equals("CONNECT"), Equals("OPTIONS"), Equals("TRACE"),
+            swstr::StartsWith("X-"));
+
+  for (const auto* method : {"GET", "HEAD", "POST", "PUT", "DELETE",
+                             "CONNECT", "OPTIONS", "TRACE", "X-PATCH"}) {
+    EXPECT_TRUE(IsMatching(kMethods, method)) << method;
+    EXPECT_TRUE(IsMatching(methods, method)) << method;
+  }
+  for (const auto* method : {"", "GE", "GETS", "get", "PATCH", "-X"}) {
+    EXPECT_FALSE(IsMatching(kMethods, method)) << method;
+    EXPECT_FALSE(IsMatching(methods, method)) << method;
+  }
+  static_assert(IsMatching(kMethods, "OPTIONS"));
+  static_assert(not IsMatching(kMethods, "OPTION"));
+
+  // Duplicated patterns: the Equals are evaluated one by one
+  static constexpr auto duplicated =
+      AnyOf("a", "b", "c", "d", "e", "f", "g", "a");
+  EXPECT_TRUE(IsMatching(duplicated, "g"));
+  EXPECT_FALSE(IsMatching(duplicated, "h"));
+
+  // A perfect hash that can't be built is reported, instead of missing keys
+  using PerfectHash = swstr::details::PerfectHash<3>;
+  const PerfectHash failed({"a", "b", "a"}, PerfectHash::OnFailure::kReport);
+  EXPECT_FALSE(failed.IsValid());
+  static_assert(PerfectHash({"a", "b", "c"}).IsValid());
+}
+
+TEST(SwitchStrMatcherTest, Match) {
+  using swstr::Match;
+  using swstr::MatchSpan;
+
+  constexpr std::string_view str = "key: value: more";
+
+  // Matchers without Match() report the whole string
+  EXPECT_EQ(Match("key", "key"), (MatchSpan{0, 3}));
+  EXPECT_EQ(Match(swstr::Equals(str), str), (MatchSpan{0, str.size()}));
+  EXPECT_EQ(Match(swstr::DoNot(swstr::Contains('x')), str),
+            (MatchSpan{0, str.size()}));
+  EXPECT_EQ(Match("key", str), std::nullopt);
+
+  static_assert(Match(swstr::StartsWith("key"), str) == MatchSpan{0, 3});
+  static_assert(Match(swstr::EndsWith("more"), str) == MatchSpan{12, 4});
+  static_assert(Match(swstr::Contains(": "), str) == MatchSpan{3, 2});
+  static_assert(Match(swstr::ContainsR(": "), str) == MatchSpan{10, 2});
+  static_assert(Match(swstr::Contains(':'), str) == MatchSpan{3, 1});
+  static_assert(Match(swstr::ContainsOneOf(":e"), str) == MatchSpan{1, 1});
+  static_assert(Match(swstr::ContainsOneOfR(":e"), str) == MatchSpan{15, 1});
+  static_assert(Match(swstr::Contains("none"), str) == std::nullopt);
+
+  EXPECT_EQ(Match(swstr::ContainsAnyOf({"value", "more"}), str),
+            (MatchSpan{5, 5}));
+  EXPECT_EQ(Match(swstr::IStartsWith("KEY"), str), (MatchSpan{0, 3}));
+  EXPECT_EQ(Match(swstr::IEndsWith("MORE"), str), (MatchSpan{12, 4}));
+  EXPECT_EQ(Match(swstr::IContains("VALUE"), str), (MatchSpan{5, 5}));
+  EXPECT_EQ(Match(swstr::IContains("none"), str), std::nullopt);
+
+  // 'where' is still written
+  std::size_t where = 0;
+  EXPECT_EQ(Match(swstr::Contains("value", &where), str), (MatchSpan{5, 5}));
+  EXPECT_EQ(where, 5);
+
+  const MatchSpan span{3, 2};
+  EXPECT_EQ(span.End(), 5);
+  EXPECT_EQ(span.Before(str), "key");
+  EXPECT_EQ(span.In(str), ": ");
+  EXPECT_EQ(span.After(str), "value: more");
+}
+
+TEST(SwitchStrMatcherTest, MatchMeta) {
+  using swstr::AllOf;
+  using swstr::AnyOf;
+  using swstr::Contains;
+  using swstr::Match;
+  using swstr::MatchSpan;
+  using swstr::StartsWith;
+
+  constexpr std::string_view str = "GET /index.html HTTP/1.1";
+
+  // AllOf: the span covering all spans, whatever the evaluation order
+  static_assert(Match(AllOf(StartsWith("GET "), Contains(" HTTP/")), str) ==
+                MatchSpan{0, 21});
+  static_assert(Match(AllOf(Contains("index"), Contains(".html")), str) ==
+                MatchSpan{5, 10});
+  static_assert(Match(AllOf(StartsWith("GET "), Contains("none")), str) ==
+                std::nullopt);
+  static_assert(Match(AllOf(), str) == MatchSpan{0, str.size()});
+
+  // AnyOf: the span of the first matcher matching, in declaration order
+  static_assert(Match(AnyOf(Contains("none"), Contains("HTTP"),
+                            StartsWith("GET")),
+                      str) == MatchSpan{16, 4});
+  static_assert(Match(AnyOf(Contains("none"), StartsWith("POST")), str) ==
+                std::nullopt);
+
+  // AnyOf Equals looked up inside a set
+  const auto methods =
+      AnyOf(Contains("/api/"), "GET", "HEAD", "POST", "PUT", "DELETE",
+            "CONNECT", "OPTIONS", "TRACE", Contains(' '));
+  EXPECT_EQ(Match(methods, "PUT"), (MatchSpan{0, 3}));
+  EXPECT_EQ(Match(methods, "GET /api/users"), (MatchSpan{4, 5}));
+  EXPECT_EQ(Match(methods, "GET /"), (MatchSpan{3, 1}));
+  EXPECT_EQ(Match(methods, "PATCH"), std::nullopt);
+}
+
+/// FixedBytes<N> against all strings of N bytes differing by at most 1 byte
+template <std::size_t... N>
+void ExpectFixedBytes(std::index_sequence<N...>) {
+  constexpr std::string_view kBytes =
+      "0123456789abcdefghijklmnopqrstuvwxyzABCDEFGHIJKLMNOPQRSTUVWXYZ@#";
+  const auto expect = [&](auto bytes) {
+    const std::string_view pattern = bytes.View();
+    std::string str(pattern);
+    EXPECT_TRUE(bytes.IsAt(str.data())) << pattern;
+    for (std::size_t i = 0; i < str.size(); ++i) {
+      str[i] = '!';
+      EXPECT_FALSE(bytes.IsAt(str.data())) << pattern << " at " << i;
+      str[i] = pattern[i];
+    }
+  };
+  (expect(swstr::details::FixedBytes<N>(
+       std::string(kBytes).append(kBytes).data())),
+   ...);
+}
+
+TEST(SwitchStrMatcherTest, FixedBytes) {
+  ExpectFixedBytes(std::make_index_sequence<80>{});
+
+  static_assert(swstr::details::FixedBytes<3>("abc").IsAt("abc"));
+  static_assert(not swstr::details::FixedBytes<3>("abc").IsAt("abd"));
+}
+
+TEST(SwitchStrMatcherTest, FixedLiterals) {
+  using swstr::EndsWith;
+  using swstr::Equals;
+  using swstr::Match;
+  using swstr::MatchSpan;
+  using swstr::StartsWith;
+
+  static_assert(IsMatching(Equals<"Content-Length">(), "Content-Length"));
+  static_assert(not IsMatching(Equals<"Content-Length">(), "Content-Type"));
+  static_assert(IsMatching(StartsWith<"HTTP/">(), "HTTP/1.1"));
+  static_assert(IsMatching(EndsWith<".html">(), "/index.html"));
+  static_assert(Equals<"Host">().Lengths().max == 4);
+  static_assert(Match(EndsWith<".html">(), "/index.html") ==
+                MatchSpan{6, 5});
+  static_assert(swstr::IsThreadShareable_v<decltype(Equals<"a">())>);
+
+  // Same as their runtime counterparts, for all lengths around the words
+  const std::string text = "Content-Length: 42 HTTP/1.1 accept-encoding";
+  for (std::size_t size = 0; size <= text.size(); ++size) {
+    for (std::size_t begin = 0; begin + size <= text.size(); ++begin) {
+      const auto str = std::string_view(text).substr(begin, size);
+      EXPECT_EQ(IsMatching(Equals<"">(), str), IsMatching(Equals(""), str));
+      EXPECT_EQ(IsMatching(Equals<"Content-Length">(), str),
+                IsMatching(Equals("Content-Length"), str));
+      EXPECT_EQ(IsMatching(StartsWith<"Con">(), str),
+                IsMatching(StartsWith("Con"), str));
+      EXPECT_EQ(IsMatching(StartsWith<"Content-Length: 42 HTTP/1.1">(), str),
+                IsMatching(StartsWith("Content-Length: 42 HTTP/1.1"), str));
+      EXPECT_EQ(IsMatching(EndsWith<"ing">(), str),
+                IsMatching(EndsWith("ing"), str));
+      EXPECT_EQ(IsMatching(EndsWith<"1.1 accept-encoding">(), str),
+                IsMatching(EndsWith("1.1 accept-encoding"), str));
+    }
+  }
+
+  // Equals are still collapsed inside an AnyOf
+  const auto methods = swstr::AnyOf(
+      Equals<"GET">(), Equals<"HEAD">(), Equals<"POST">(), Equals<"PUT">(),
+      Equals<"DELETE">(), Equals<"CONNECT">(), Equals<"OPTIONS">(),
+      Equals<"TRACE">());
+  EXPECT_TRUE(IsMatching(methods, "TRACE"));
+  EXPECT_FALSE(IsMatching(methods, "PATCH"));
+}
+
+TEST(SwitchStrMatcherTest, CharLiterals) {
+  using swstr::IsMatching;
+
+  static_assert(IsMatching("foo", "foo"));
+  static_assert(not IsMatching("foo", "fo"));
+  static_assert(not IsMatching("foo", "foo "));
+  static_assert(IsMatching("", ""));
+  static_assert(not IsMatching("", "a"));
+
+  // Zero padded buffers are compared up to their first '\0'
+  static constexpr char kBuffer[8] = "foo";
+  static_assert(IsMatching(kBuffer, "foo"));
+  EXPECT_TRUE(IsMatching(kBuffer, "foo"));
+  EXPECT_FALSE(IsMatching(kBuffer, std::string_view("foo\0\0\0\0", 7)));
+
+  // Same for an embedded '\0', anywhere
+  static_assert(IsMatching("a\0b", "a"));
+  EXPECT_TRUE(IsMatching("a\0b", "a"));
+  EXPECT_FALSE(IsMatching("a\0b", std::string_view("a\0b", 3)));
+  EXPECT_TRUE(IsMatching("\0abc", ""));
+
+  // The compile time literals stop at their first '\0' too
+  static_assert(swstr::Equals<"a\0b">().Pattern() == "a");
+  static_assert(swstr::Equals<"a\0b">().Lengths().max == 1);
+  EXPECT_TRUE(IsMatching(swstr::Equals<"a\0b">(), "a"));
+  EXPECT_FALSE(
+      IsMatching(swstr::Equals<"a\0b">(), std::string_view("a\0b", 3)));
+  EXPECT_TRUE(IsMatching(swstr::StartsWith<"a\0b">(), "ac"));
+  EXPECT_TRUE(IsMatching(swstr::EndsWith<"a\0b">(), "ca"));
+  EXPECT_FALSE(
+      IsMatching(swstr::EndsWith<"a\0b">(), std::string_view("a\0b", 3)));
+
+  const std::string long_str = "a-long-header-name-of-more-than-16-bytes";
+  EXPECT_TRUE(IsMatching("a-long-header-name-of-more-than-16-bytes",
+                         long_str));
+  EXPECT_FALSE(IsMatching("a-long-header-name-of-more-than-16-bytez",
+                          long_str));
+}
+
 }  // namespace
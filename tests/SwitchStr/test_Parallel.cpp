@@ -0,0 +1,193 @@
+#include <algorithm>
+#include <cstdint>
+#include <functional>
+#include <random>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <thread>
+#include <vector>
+
+#include "RandomStrings.hpp"
+#include "MatcherMock.hpp"
+#include "SwitchStr/Parallel.hpp"
+#include "SwitchStr/StaticSwitch.hpp"
+#include "SwitchStr/SwitchTable.hpp"
+#include "gtest/gtest.h"
+
+namespace {
+
+auto IsEmpty(std::string_view str) -> bool { return str.empty(); }
+
+/// Thread shareable matcher throwing on "boom"
+struct ThrowingMatcher {
+  static constexpr bool is_thread_shareable = true;
+
+  auto IsMatching(std::string_view str) const -> bool {
+    if (str == "boom") throw std::runtime_error("boom");
+    return false;
+  }
+};
+
+TEST(ParallelTest, IsThreadShareable) {
+  using swstr::IsThreadShareable_v;
+
+  std::size_t where = 0;
+  int state = 0;
+  const auto stateless = [](std::string_view) { return true; };
+  const auto stateful = [&state](std::string_view) { return ++state > 0; };
+
+  static_assert(IsThreadShareable_v<const char*>);
+  static_assert(IsThreadShareable_v<std::string>);
+  static_assert(IsThreadShareable_v<decltype(&IsEmpty)>);
+  static_assert(IsThreadShareable_v<decltype(stateless)>);
+  static_assert(not IsThreadShareable_v<decltype(stateful)>);
+  static_assert(not IsThreadShareable_v<helper::MatcherMock>);
+
+  static_assert(IsThreadShareable_v<decltype(swstr::Equals(""))>);
+  static_assert(IsThreadShareable_v<decltype(swstr::StartsWith(""))>);
+  static_assert(IsThreadShareable_v<decltype(swstr::EndsWith(""))>);
+  static_assert(IsThreadShareable_v<decltype(swstr::Contains(""))>);
+  static_assert(IsThreadShareable_v<decltype(swstr::ContainsR(""))>);
+  static_assert(IsThreadShareable_v<decltype(swstr::ContainsOneOf(""))>);
+  static_assert(IsThreadShareable_v<decltype(swstr::ContainsAnyOf({""}))>);
+  static_assert(not IsThreadShareable_v<decltype(swstr::Contains("", &where))>);
+  static_assert(
+      not IsThreadShareable_v<decltype(swstr::ContainsOneOfR("", &where))>);
+  static_assert(
+      not IsThreadShareable_v<decltype(swstr::ContainsAnyOf({""}, &where))>);
+
+  static_assert(IsThreadShareable_v<decltype(swstr::AllOf(
+                    swstr::StartsWith(""), swstr::DoNot("foo")))>);
+  static_assert(not IsThreadShareable_v<decltype(swstr::AnyOf(
+                    swstr::StartsWith(""), swstr::Contains("", &where)))>);
+  static_assert(not IsThreadShareable_v<decltype(swstr::DoNot(stateful))>);
+
+  static_assert(IsThreadShareable_v<swstr::AnyShareableMatcher>);
+  static_assert(not IsThreadShareable_v<swstr::AnyMatcher>);
+
+  static_assert(IsThreadShareable_v<swstr::StaticSwitch<int, "a", "b">>);
+  static_assert(
+      IsThreadShareable_v<swstr::SwitchTable<int, swstr::AnyShareableMatcher>>);
+  static_assert(not IsThreadShareable_v<swstr::SwitchTable<int>>);
+}
+
+TEST(ParallelTest, SameAsSerial) {
+  std::mt19937 rng(42);
+  const auto storage = helper::RandomStrings(rng, 50'000, 20);
+  const std::vector<std::string_view> strs(storage.begin(), storage.end());
+
+  const auto matcher =
+      swstr::AnyOf(swstr::StartsWith("ab"), swstr::Contains("cca"));
+  std::vector<std::uint8_t> expected(strs.size());
+  swstr::IsMatching(matcher, strs, expected);
+
+  const auto table =
+      swstr::SwitchTable<int, swstr::AnyShareableMatcher>::Builder()
+          .Case(swstr::Equals("abc"), 0)
+          .Case(swstr::StartsWith("ca"), 1)
+          .Case(swstr::ContainsAnyOf({"bbb", "aca"}), 2)
+          .Case(swstr::EndsWith("ba"), 3)
+          .Case(&IsEmpty, 4)
+          .Build();
+  std::vector<std::size_t> expected_index(strs.size());
+  swstr::IndexOf(table, strs, expected_index);
+
+  for (std::size_t threads : {0, 1, 2, 3, 8}) {
+    SCOPED_TRACE(threads);
+
+    std::vector<std::uint8_t> out(strs.size(), 2);
+    swstr::ParallelClassify(matcher, strs, out, threads);
+    EXPECT_EQ(out, expected);
+
+    std::vector<std::size_t> out_index(strs.size(), 42);
+    swstr::ParallelClassify(table, strs, out_index, threads);
+    EXPECT_EQ(out_index, expected_index);
+  }
+
+  // Less strings than threads
+  std::vector<std::uint8_t> out(3, 2);
+  swstr::ParallelClassify(matcher, std::span(strs).first(3), out, 8);
+  EXPECT_EQ(out, std::vector<std::uint8_t>(expected.begin(),
+                                           expected.begin() + 3));
+
+  swstr::ParallelClassify(matcher, {}, std::span<std::uint8_t>(), 8);
+}
+
+TEST(ParallelTest, RethrowsExceptions) {
+  std::vector<std::string_view> strs(100'000, "foo");
+  strs[strs.size() / 2] = "boom";
+  std::vector<std::uint8_t> out(strs.size());
+
+  EXPECT_THROW(swstr::ParallelClassify(ThrowingMatcher{}, strs, out, 4),
+               std::runtime_error);
+}
+
+TEST(ParallelTest, Executor) {
+  std::mt19937 rng(7);
+  const auto storage = helper::RandomStrings(rng, 50'000, 20);
+  const std::vector<std::string_view> strs(storage.begin(), storage.end());
+
+  const auto matcher = swstr::AnyOf(swstr::EndsWith("ba"), swstr::Equals(""));
+  std::vector<std::uint8_t> expected(strs.size());
+  swstr::IsMatching(matcher, strs, expected);
+
+  constexpr swstr::StaticSwitch<int, "a", "ab", "abc"> table{0, 1, 2};
+  std::vector<std::size_t> expected_index(strs.size());
+  swstr::IndexOf(table, strs, expected_index);
+
+  // Tasks running on threads of their own
+  {
+    std::vector<std::jthread> pool;
+    const auto executor = [&pool](std::function<void()> task) {
+      pool.emplace_back(std::move(task));
+    };
+
+    std::vector<std::uint8_t> out(strs.size(), 2);
+    swstr::ParallelClassify(matcher, strs, out, 4, executor);
+    EXPECT_EQ(out, expected);
+    EXPECT_EQ(pool.size(), 3);
+
+    std::vector<std::size_t> out_index(strs.size(), 42);
+    swstr::ParallelClassify(table, strs, out_index, 4, executor);
+    EXPECT_EQ(out_index, expected_index);
+    EXPECT_EQ(pool.size(), 6);
+  }
+
+  // Busy executor, only starting the tasks once the call returned: the
+  // calling thread did all the work
+  std::vector<std::function<void()>> late;
+  const auto busy = [&late](std::function<void()> task) {
+    late.push_back(std::move(task));
+  };
+
+  std::vector<std::uint8_t> out(strs.size(), 2);
+  swstr::ParallelClassify(matcher, strs, out, 8, busy);
+  EXPECT_EQ(out, expected);
+  EXPECT_EQ(late.size(), 7);
+  for (const auto& task : late) task();
+
+  // Failing executor
+  const auto failing = [](std::function<void()>) {
+    throw std::runtime_error("no thread");
+  };
+  std::fill(out.begin(), out.end(), 2);
+  swstr::ParallelClassify(matcher, strs, out, 8, failing);
+  EXPECT_EQ(out, expected);
+}
+
+TEST(ParallelTest, ExecutorRethrowsExceptions) {
+  std::vector<std::string_view> strs(100'000, "foo");
+  strs[strs.size() / 2] = "boom";
+  std::vector<std::uint8_t> out(strs.size());
+
+  std::vector<std::jthread> pool;
+  EXPECT_THROW(swstr::ParallelClassify(
+                   ThrowingMatcher{}, strs, out, 4,
+                   [&pool](std::function<void()> task) {
+                     pool.emplace_back(std::move(task));
+                   }),
+               std::runtime_error);
+}
+
+}  // namespace
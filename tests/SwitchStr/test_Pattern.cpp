@@ -0,0 +1,126 @@
+#include <random>
+#include <regex>
+#include <string>
+#include <string_view>
+
+#include "SwitchStr/Matcher.hpp"
+#include "SwitchStr/Pattern.hpp"
+#include "SwitchStr/SwitchStr.hpp"
+#include "gtest/gtest.h"
+
+namespace {
+
+using swstr::Glob;
+using swstr::Regex;
+
+// Compiled and matched at compile time
+static_assert(Glob<"*.log">.IsMatching("server.log"));
+static_assert(not Glob<"*.log">.IsMatching("server.log.1"));
+static_assert(Regex<"user-[0-9]+">.IsMatching("user-42"));
+static_assert(not Regex<"user-[0-9]+">.IsMatching("user-"));
+
+// Bytes never told apart share the same class, equivalent states are merged
+static_assert(Regex<"[a-z]+">.ClassCount() == 2);
+static_assert(Regex<"[a-z]+">.StateCount() == 3);
+static_assert(Regex<"(a|b)*">.StateCount() == Regex<"[ab]*">.StateCount());
+
+static_assert(swstr::IsThreadShareable_v<decltype(Regex<"a">)>);
+
+// Quantifiers can't be stacked, as in ECMAScript
+constexpr auto RegexError(std::string_view pattern)
+    -> swstr::details::PatternError {
+  return swstr::details::CompilePattern(swstr::details::PatternSyntax::kRegex,
+                                        pattern)
+      .error;
+}
+static_assert(RegexError("a**") ==
+              swstr::details::PatternError::kNothingToRepeat);
+static_assert(RegexError("a+?*") ==
+              swstr::details::PatternError::kNothingToRepeat);
+static_assert(RegexError("a{2}{3}") ==
+              swstr::details::PatternError::kNothingToRepeat);
+static_assert(RegexError("a??") == swstr::details::PatternError::kNone);
+static_assert(RegexError("(a*)*") == swstr::details::PatternError::kNone);
+
+TEST(PatternTest, Glob) {
+  EXPECT_TRUE(Glob<"*">.IsMatching(""));
+  EXPECT_TRUE(Glob<"*">.IsMatching("anything/at all"));
+  EXPECT_TRUE(Glob<"a?c">.IsMatching("abc"));
+  EXPECT_FALSE(Glob<"a?c">.IsMatching("ac"));
+  EXPECT_TRUE(Glob<"[!a-c]x">.IsMatching("dx"));
+  EXPECT_FALSE(Glob<"[!a-c]x">.IsMatching("bx"));
+  EXPECT_TRUE(Glob<"[]]">.IsMatching("]"));
+  EXPECT_TRUE(Glob<"file.{log,txt}">.IsMatching("file.txt"));
+  EXPECT_FALSE(Glob<"file.{log,txt}">.IsMatching("file.csv"));
+  EXPECT_TRUE(Glob<"\\*.{a,b{c,d}}">.IsMatching("*.bd"));
+  EXPECT_FALSE(Glob<"\\*.{a,b{c,d}}">.IsMatching("x.bd"));
+  EXPECT_TRUE(Glob<"*a*b*">.IsMatching("xxaxxbxx"));
+  EXPECT_FALSE(Glob<"*a*b*">.IsMatching("xxbxxaxx"));
+}
+
+TEST(PatternTest, Regex) {
+  EXPECT_TRUE(Regex<"^(GET|POST) /api/v[0-9]{1,2}/\\w+$">.IsMatching(
+      "GET /api/v12/users"));
+  EXPECT_FALSE(Regex<"^(GET|POST) /api/v[0-9]{1,2}/\\w+$">.IsMatching(
+      "GET /api/v123/users"));
+  EXPECT_TRUE(Regex<"a{3}">.IsMatching("aaa"));
+  EXPECT_FALSE(Regex<"a{3}">.IsMatching("aaaa"));
+  EXPECT_TRUE(Regex<"(ab){2,}">.IsMatching("ababab"));
+  EXPECT_FALSE(Regex<"(ab){2,}">.IsMatching("ab"));
+  EXPECT_TRUE(Regex<"\\x41.?\\.">.IsMatching("A."));
+  EXPECT_FALSE(Regex<"a.b">.IsMatching("a\nb"));
+  EXPECT_FALSE(Regex<"a.b">.IsMatching("a\rb"));
+  EXPECT_TRUE(Regex<"a.b">.IsMatching("a\tb"));
+  EXPECT_TRUE(Regex<"[^\\d\\s]+">.IsMatching("abc"));
+  EXPECT_FALSE(Regex<"[^\\d\\s]+">.IsMatching("a c"));
+  EXPECT_TRUE(Regex<"a*?b">.IsMatching("aab"));
+  EXPECT_TRUE(Regex<"(?:x|)y">.IsMatching("y"));
+}
+
+// Same results as std::regex_match, over random strings of a small alphabet
+template <swstr::FixedString Expression>
+void ExpectSameAsStdRegex() {
+  const std::regex reference(std::string(Expression.view()));
+  std::mt19937 rng(42);
+  std::uniform_int_distribution<int> letter('a', 'd');
+  std::uniform_int_distribution<std::size_t> size(0, 12);
+
+  for (int i = 0; i < 2000; ++i) {
+    std::string str(size(rng), '\0');
+    for (auto& c : str) {
+      c = static_cast<char>(letter(rng));
+    }
+    EXPECT_EQ(Regex<Expression>.IsMatching(str),
+              std::regex_match(str, reference))
+        << Expression.view() << " on " << str;
+  }
+}
+
+TEST(PatternTest, SameAsStdRegex) {
+  ExpectSameAsStdRegex<"a*b+c?">();
+  ExpectSameAsStdRegex<"(ab|cd)*">();
+  ExpectSameAsStdRegex<"[a-c]{2,4}d">();
+  ExpectSameAsStdRegex<".*abc.*">();
+  ExpectSameAsStdRegex<"(a|b(c|d)*)+">();
+  ExpectSameAsStdRegex<"[^a]*a[^a]*">();
+}
+
+TEST(PatternTest, Matchers) {
+  const auto classify = [](std::string_view file) {
+    return swstr::SwitchStr<int>(file)
+        .Case(Glob<"*.log">, 0)
+        .Case(swstr::AllOf(Glob<"*.txt">, swstr::DoNot(Regex<"tmp.*">)), 1)
+        .Case(swstr::AnyMatcher(Regex<"user-[0-9]+">), 2)
+        .Case(swstr::AnyOf(Regex<"a+">, Glob<"b*">), 3)
+        .Default(-1);
+  };
+
+  EXPECT_EQ(classify("server.log"), 0);
+  EXPECT_EQ(classify("notes.txt"), 1);
+  EXPECT_EQ(classify("tmp.txt"), -1);
+  EXPECT_EQ(classify("user-12"), 2);
+  EXPECT_EQ(classify("aaa"), 3);
+  EXPECT_EQ(classify("bcd"), 3);
+}
+
+}  // namespace
@@ -0,0 +1,122 @@
+#include <string>
+#include <string_view>
+
+#include "SwitchStr/StaticSwitch.hpp"
+#include "SwitchStr/SwitchStr.hpp"
+#include "gtest/gtest.h"
+
+namespace {
+
+TEST(StaticSwitchTest, IndexOf) {
+  using swstr::StaticSwitch;
+  using Switch = StaticSwitch<int, "GET", "POST", "PUT", "">;
+
+  static_assert(Switch::IndexOf<"GET">() == 0);
+  static_assert(Switch::IndexOf<"PUT">() == 2);
+  static_assert(Switch::IndexOf<"">() == 3);
+  static_assert(Switch::IndexOf<"DELETE">() == Switch::npos);
+
+  static_assert(Switch::IndexOf("POST") == 1);
+  static_assert(Switch::IndexOf("DELETE") == Switch::npos);
+
+  EXPECT_EQ(Switch::IndexOf("GET"), 0);
+  EXPECT_EQ(Switch::IndexOf("POST"), 1);
+  EXPECT_EQ(Switch::IndexOf("PUT"), 2);
+  EXPECT_EQ(Switch::IndexOf(""), 3);
+  EXPECT_EQ(Switch::IndexOf("GE"), Switch::npos);
+  EXPECT_EQ(Switch::IndexOf("GETT"), Switch::npos);
+  EXPECT_EQ(Switch::IndexOf("get"), Switch::npos);
+
+  EXPECT_EQ(StaticSwitch<int>::IndexOf(""), StaticSwitch<int>::npos);
+}
+
+TEST(StaticSwitchTest, EmbeddedNul) {
+  // Literals stop at their first '\0', same as SwitchStr<>().Case("a\0b")
+  using Switch = swstr::StaticSwitch<int, "a\0b", "c">;
+
+  static_assert(Switch::IndexOf("a") == 0);
+  EXPECT_EQ(Switch::IndexOf("a"), 0);
+  EXPECT_EQ(Switch::IndexOf(std::string_view("a\0b", 3)), Switch::npos);
+  EXPECT_EQ(swstr::SwitchStr<int>("a").Case("a\0b", 0).Default(-1), 0);
+  EXPECT_EQ(swstr::SwitchStr<int>(std::string_view("a\0b", 3))
+                .Case("a\0b", 0)
+                .Default(-1),
+            -1);
+}
+
+TEST(StaticSwitchTest, Lookup) {
+  using swstr::StaticSwitch;
+
+  constexpr StaticSwitch<int, "foo", "bar", ""> table{0, 1, 2};
+  static_assert(*table.Lookup("bar") == 1);
+  static_assert(table.Lookup("baz") == nullptr);
+  static_assert(table.LookupOr("foo", 42) == 0);
+  static_assert(table.Get<"">() == 2);
+
+  EXPECT_EQ(table.LookupOr("foo", 42), 0);
+  EXPECT_EQ(table.LookupOr("bar", 42), 1);
+  EXPECT_EQ(table.LookupOr("", 42), 2);
+  EXPECT_EQ(table.LookupOr("Ceci est un string", 42), 42);
+  EXPECT_EQ(table.Lookup("fo"), nullptr);
+
+  constexpr StaticSwitch<int> empty{};
+  EXPECT_EQ(empty.LookupOr("", 42), 42);
+
+  const StaticSwitch<std::string, "foo", "bar"> strings{"FOO", "BAR"};
+  EXPECT_EQ(strings.LookupOr("foo", "NONE"), "FOO");
+  EXPECT_EQ(strings.LookupOr("bar", "NONE"), "BAR");
+  EXPECT_EQ(strings.LookupOr("baz", "NONE"), "NONE");
+}
+
+TEST(StaticSwitchTest, SameAsSwitchStr) {
+  using swstr::StaticSwitch;
+  using swstr::SwitchStr;
+
+  constexpr StaticSwitch<int, "GET", "POST", "PUT", "PATCH", "DELETE", "HEAD",
+                         "OPTIONS", "TRACE", "CONNECT">
+      table{0, 1, 2, 3, 4, 5, 6, 7, 8};
+
+  for (std::string_view str :
+       {"", "a", "GET", "POST", "PUT", "PATCH", "DELETE", "HEAD", "OPTIONS",
+        "TRACE", "CONNECT", "get", "GETS", "GE", "POS", "PUTT", " GET",
+        "GET ", "OPTION", "CONNECTED"}) {
+    SCOPED_TRACE(str);
+
+    EXPECT_EQ(SwitchStr<int>(str)
+                  .Case("GET", 0)
+                  .Case("POST", 1)
+                  .Case("PUT", 2)
+                  .Case("PATCH", 3)
+                  .Case("DELETE", 4)
+                  .Case("HEAD", 5)
+                  .Case("OPTIONS", 6)
+                  .Case("TRACE", 7)
+                  .Case("CONNECT", 8)
+                  .Default(-1),
+              table.LookupOr(str, -1));
+  }
+}
+
+TEST(StaticSwitchTest, ManyLiterals) {
+  using swstr::StaticSwitch;
+  using Switch =
+      StaticSwitch<int, "k00", "k01", "k02", "k03", "k04", "k05", "k06", "k07",
+                   "k08", "k09", "k10", "k11", "k12", "k13", "k14", "k15",
+                   "k16", "k17", "k18", "k19", "k20", "k21", "k22", "k23",
+                   "k24", "k25", "k26", "k27", "k28", "k29", "k30", "k31",
+                   "k32", "k33", "k34", "k35", "k36", "k37", "k38", "k39",
+                   "k40", "k41", "k42", "k43", "k44", "k45", "k46", "k47",
+                   "k48", "k49", "k50", "k51", "k52", "k53", "k54", "k55",
+                   "k56", "k57", "k58", "k59">;
+
+  for (std::size_t i = 0; i < 60; ++i) {
+    const std::string key = (i < 10 ? "k0" : "k") + std::to_string(i);
+    EXPECT_EQ(Switch::IndexOf(key), i) << key;
+    EXPECT_EQ(Switch::IndexOf(key + "0"), Switch::npos) << key;
+  }
+
+  EXPECT_EQ(Switch::IndexOf("k60"), Switch::npos);
+  EXPECT_EQ(Switch::IndexOf("k"), Switch::npos);
+}
+
+}  // namespace
@@ -0,0 +1,125 @@
+#include <algorithm>
+#include <random>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include "RandomStrings.hpp"
+#include "SwitchStr/Stream.hpp"
+#include "gtest/gtest.h"
+
+namespace {
+
+/// Split \a str into random chunks (some being empty)
+auto RandomChunks(std::mt19937& rng, std::string_view str)
+    -> std::vector<std::string_view> {
+  std::uniform_int_distribution<std::size_t> size(0, 7);
+
+  std::vector<std::string_view> chunks;
+  while (not str.empty()) {
+    const std::size_t chunk_size = std::min(size(rng), str.size());
+    chunks.push_back(str.substr(0, chunk_size));
+    str.remove_prefix(chunk_size);
+  }
+  return chunks;
+}
+
+/// Feed all \a chunks to the streaming version of \a matcher
+template <typename Matcher>
+auto StreamIsMatching(const Matcher& matcher,
+                      const std::vector<std::string_view>& chunks) -> bool {
+  auto stream = swstr::Stream(matcher);
+  for (std::string_view chunk : chunks) {
+    stream.Feed(chunk);
+  }
+  return stream.Finish();
+}
+
+TEST(StreamTest, SameAsContiguous) {
+  std::mt19937 rng(42);
+
+  for (std::size_t i = 0; i < 2000; ++i) {
+    const std::string str = helper::RandomString(rng, i % 40);
+    const auto chunks = RandomChunks(rng, str);
+    SCOPED_TRACE(str);
+
+    for (std::string_view pattern :
+         {"", "a", "ab", "abc", "abca", "aabbcc", "abcabcabc"}) {
+      SCOPED_TRACE(pattern);
+
+      EXPECT_EQ(StreamIsMatching(swstr::Equals(pattern), chunks),
+                swstr::IsMatching(swstr::Equals(pattern), str));
+      EXPECT_EQ(StreamIsMatching(swstr::StartsWith(pattern), chunks),
+                swstr::IsMatching(swstr::StartsWith(pattern), str));
+      EXPECT_EQ(StreamIsMatching(swstr::EndsWith(pattern), chunks),
+                swstr::IsMatching(swstr::EndsWith(pattern), str));
+
+      std::size_t expected = 0;
+      std::size_t where = 0;
+      EXPECT_EQ(StreamIsMatching(swstr::Contains(pattern, &where), chunks),
+                swstr::IsMatching(swstr::Contains(pattern, &expected), str));
+      EXPECT_EQ(where, expected);
+
+      EXPECT_EQ(StreamIsMatching(swstr::ContainsR(pattern, &where), chunks),
+                swstr::IsMatching(swstr::ContainsR(pattern, &expected), str));
+      EXPECT_EQ(where, expected);
+
+      EXPECT_EQ(
+          StreamIsMatching(swstr::ContainsOneOf(pattern, &where), chunks),
+          swstr::IsMatching(swstr::ContainsOneOf(pattern, &expected), str));
+      EXPECT_EQ(where, expected);
+
+      EXPECT_EQ(
+          StreamIsMatching(swstr::ContainsOneOfR(pattern, &where), chunks),
+          swstr::IsMatching(swstr::ContainsOneOfR(pattern, &expected), str));
+      EXPECT_EQ(where, expected);
+    }
+  }
+}
+
+TEST(StreamTest, AcrossChunks) {
+  std::size_t where = 0;
+  auto stream = swstr::Stream(swstr::Contains("needle", &where));
+
+  stream.Feed("hay hay nee");
+  stream.Feed("d");
+  stream.Feed("le hay");
+  EXPECT_TRUE(stream.Finish());
+  EXPECT_EQ(where, 8);
+
+  // Reused for another string
+  stream.Reset();
+  stream.Feed("needl");
+  stream.Feed("needl");
+  EXPECT_FALSE(stream.Finish());
+
+  auto r_stream = swstr::Stream(swstr::ContainsR('e', &where));
+  r_stream.Feed("e--");
+  r_stream.Feed("e-");
+  r_stream.Feed("---");
+  EXPECT_TRUE(r_stream.Finish());
+  EXPECT_EQ(where, 3);
+
+  auto ends_with = swstr::Stream(swstr::EndsWith("tail"));
+  ends_with.Feed("ta");
+  ends_with.Feed("il");
+  EXPECT_TRUE(ends_with.Finish());
+  ends_with.Feed("");
+  EXPECT_TRUE(ends_with.Finish());
+  ends_with.Feed("!");
+  EXPECT_FALSE(ends_with.Finish());
+
+  auto fixed = swstr::Stream(swstr::EndsWith<"tail">());
+  fixed.Feed("ta");
+  fixed.Feed("il");
+  EXPECT_TRUE(fixed.Finish());
+
+  auto fixed_equals = swstr::Stream(swstr::Equals<"head">());
+  fixed_equals.Feed("he");
+  fixed_equals.Feed("ad");
+  EXPECT_TRUE(fixed_equals.Finish());
+  fixed_equals.Feed("!");
+  EXPECT_FALSE(fixed_equals.Finish());
+}
+
+}  // namespace
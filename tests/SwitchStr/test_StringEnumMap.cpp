@@ -0,0 +1,179 @@
+#include <cstdint>
+#include <optional>
+#include <string>
+#include <string_view>
+
+#include "SwitchStr/StringEnumMap.hpp"
+#include "SwitchStr/SwitchStr.hpp"
+#include "gtest/gtest.h"
+
+namespace {
+
+enum class Level { kDebug, kInfo, kWarning, kError, kUnnamed };
+
+constexpr auto kLevels = swstr::MakeStringEnumMap<Level>({
+    {"debug", Level::kDebug},
+    {"info", Level::kInfo},
+    {"warning", Level::kWarning},
+    {"error", Level::kError},
+    {"warn", Level::kWarning},
+});
+
+enum class Status : std::int16_t {
+  kContinue = 100,
+  kOk = 200,
+  kNotFound = 404,
+  kError = 500,
+  kNegative = -1,
+  kUnnamed = 0,
+};
+
+constexpr auto kStatuses = swstr::MakeStringEnumMap<Status>({
+    {"Continue", Status::kContinue},
+    {"OK", Status::kOk},
+    {"Not Found", Status::kNotFound},
+    {"Internal Server Error", Status::kError},
+    {"Negative", Status::kNegative},
+});
+
+TEST(StringEnumMapTest, Constexpr) {
+  static_assert(kLevels.size() == 5);
+  static_assert(kLevels.FromString("info") == Level::kInfo);
+  static_assert(kLevels.FromString("warn") == Level::kWarning);
+  static_assert(not kLevels.FromString("INFO").has_value());
+  static_assert(kLevels.FromStringIgnoreCase("INFO") == Level::kInfo);
+  static_assert(kLevels.ToString(Level::kError) == "error");
+  static_assert(kLevels.ToString(Level::kWarning) == "warning");
+  static_assert(kLevels.ToString(Level::kUnnamed).empty());
+  static_assert(kLevels.IsDense());
+
+  static_assert(kStatuses.FromString("Not Found") == Status::kNotFound);
+  static_assert(kStatuses.ToString(Status::kNegative) == "Negative");
+  static_assert(not kStatuses.IsDense());
+}
+
+TEST(StringEnumMapTest, FromString) {
+  EXPECT_EQ(kLevels.FromString("debug"), Level::kDebug);
+  EXPECT_EQ(kLevels.FromString("info"), Level::kInfo);
+  EXPECT_EQ(kLevels.FromString("warning"), Level::kWarning);
+  EXPECT_EQ(kLevels.FromString("warn"), Level::kWarning);
+  EXPECT_EQ(kLevels.FromString("error"), Level::kError);
+
+  for (std::string_view str :
+       {"", "d", "debu", "debugg", "Debug", "ERROR", "warnings", " info",
+        "info ", "trace"}) {
+    SCOPED_TRACE(str);
+    EXPECT_EQ(kLevels.FromString(str), std::nullopt);
+  }
+
+  EXPECT_EQ(kStatuses.FromString("Internal Server Error"), Status::kError);
+  EXPECT_EQ(kStatuses.FromString("internal server error"), std::nullopt);
+  EXPECT_EQ(kStatuses.FromString("Internal Server Errors"), std::nullopt);
+}
+
+TEST(StringEnumMapTest, FromStringIgnoreCase) {
+  EXPECT_EQ(kLevels.FromStringIgnoreCase("debug"), Level::kDebug);
+  EXPECT_EQ(kLevels.FromStringIgnoreCase("DEBUG"), Level::kDebug);
+  EXPECT_EQ(kLevels.FromStringIgnoreCase("Warn"), Level::kWarning);
+  EXPECT_EQ(kLevels.FromStringIgnoreCase("wArNiNg"), Level::kWarning);
+  EXPECT_EQ(kLevels.FromStringIgnoreCase("ERRORS"), std::nullopt);
+  EXPECT_EQ(kLevels.FromStringIgnoreCase(""), std::nullopt);
+
+  // Long enough for the 8 bytes kernel
+  EXPECT_EQ(kStatuses.FromStringIgnoreCase("INTERNAL SERVER ERROR"),
+            Status::kError);
+  EXPECT_EQ(kStatuses.FromStringIgnoreCase("internal server error"),
+            Status::kError);
+  EXPECT_EQ(kStatuses.FromStringIgnoreCase("internal_server error"),
+            std::nullopt);
+  EXPECT_EQ(kStatuses.FromStringIgnoreCase("not found"), Status::kNotFound);
+  EXPECT_EQ(kStatuses.FromStringIgnoreCase("ok"), Status::kOk);
+
+  // Only the ASCII letters are folded
+  EXPECT_EQ(kStatuses.FromStringIgnoreCase(std::string_view("NOT\0FOUND", 9)),
+            std::nullopt);
+  EXPECT_EQ(kStatuses.FromStringIgnoreCase("NOT\x7f"), std::nullopt);
+}
+
+TEST(StringEnumMapTest, ToString) {
+  EXPECT_EQ(kLevels.ToString(Level::kDebug), "debug");
+  EXPECT_EQ(kLevels.ToString(Level::kInfo), "info");
+  EXPECT_EQ(kLevels.ToString(Level::kWarning), "warning");
+  EXPECT_EQ(kLevels.ToString(Level::kError), "error");
+  EXPECT_EQ(kLevels.ToString(Level::kUnnamed), "");
+  EXPECT_EQ(kLevels.ToString(static_cast<Level>(-1)), "");
+  EXPECT_FALSE(kLevels.Contains(Level::kUnnamed));
+  EXPECT_TRUE(kLevels.Contains(Level::kDebug));
+
+  EXPECT_EQ(kStatuses.ToString(Status::kContinue), "Continue");
+  EXPECT_EQ(kStatuses.ToString(Status::kOk), "OK");
+  EXPECT_EQ(kStatuses.ToString(Status::kNotFound), "Not Found");
+  EXPECT_EQ(kStatuses.ToString(Status::kError), "Internal Server Error");
+  EXPECT_EQ(kStatuses.ToString(Status::kNegative), "Negative");
+  EXPECT_EQ(kStatuses.ToString(Status::kUnnamed), "");
+  EXPECT_EQ(kStatuses.ToString(static_cast<Status>(201)), "");
+  EXPECT_EQ(kStatuses.ToString(static_cast<Status>(1000)), "");
+}
+
+TEST(StringEnumMapTest, RoundTrip) {
+  for (const Level level :
+       {Level::kDebug, Level::kInfo, Level::kWarning, Level::kError}) {
+    EXPECT_EQ(kLevels.FromString(kLevels.ToString(level)), level);
+  }
+
+  // Dense, but not starting at 0
+  enum class Weekday : std::uint8_t { kMonday = 1, kTuesday, kWednesday };
+  constexpr auto kDays = swstr::MakeStringEnumMap<Weekday>({
+      {"Wednesday", Weekday::kWednesday},
+      {"Monday", Weekday::kMonday},
+      {"Tuesday", Weekday::kTuesday},
+  });
+  static_assert(kDays.IsDense());
+
+  for (const Weekday day :
+       {Weekday::kMonday, Weekday::kTuesday, Weekday::kWednesday}) {
+    EXPECT_EQ(kDays.FromString(kDays.ToString(day)), day);
+  }
+  EXPECT_EQ(kDays.ToString(static_cast<Weekday>(0)), "");
+  EXPECT_EQ(kDays.ToString(static_cast<Weekday>(4)), "");
+  EXPECT_EQ(kDays.ToString(static_cast<Weekday>(255)), "");
+}
+
+TEST(StringEnumMapTest, Empty) {
+  constexpr swstr::StringEnumMap<Level, 0> kEmpty{{}};
+
+  EXPECT_EQ(kEmpty.FromString(""), std::nullopt);
+  EXPECT_EQ(kEmpty.FromStringIgnoreCase("debug"), std::nullopt);
+  EXPECT_EQ(kEmpty.ToString(Level::kDebug), "");
+}
+
+TEST(StringEnumMapTest, SameAsSwitchStr) {
+  using swstr::IEquals;
+  using swstr::SwitchStr;
+
+  for (std::string_view str :
+       {"", "debug", "info", "warning", "warn", "error", "DEBUG", "Warn",
+        "warnin", "errors", "inf", "trace"}) {
+    SCOPED_TRACE(str);
+
+    EXPECT_EQ(SwitchStr<std::optional<Level>>(str)
+                  .Case("debug", Level::kDebug)
+                  .Case("info", Level::kInfo)
+                  .Case("warning", Level::kWarning)
+                  .Case("error", Level::kError)
+                  .Case("warn", Level::kWarning)
+                  .Default(std::nullopt),
+              kLevels.FromString(str));
+
+    EXPECT_EQ(SwitchStr<std::optional<Level>>(str)
+                  .Case(IEquals("debug"), Level::kDebug)
+                  .Case(IEquals("info"), Level::kInfo)
+                  .Case(IEquals("warning"), Level::kWarning)
+                  .Case(IEquals("error"), Level::kError)
+                  .Case(IEquals("warn"), Level::kWarning)
+                  .Default(std::nullopt),
+              kLevels.FromStringIgnoreCase(str));
+  }
+}
+
+}  // namespace
@@ -1,4 +1,8 @@
 
+#include <string>
+#include <string_view>
+#include <utility>
+
 #include "MatcherMock.hpp"
 #include "SwitchStr/SwitchStr.hpp"
 #include "gmock/gmock.h"
@@ -41,4 +45,126 @@ TEST(SwitchStrTest, Simple) {
                    .Default(42));
 }
 
+/// Count how many times it has been constructed (from a value)
+struct Counted {
+  static inline int constructed = 0;
+
+  Counted(int v) : value(v) { ++constructed; }
+  Counted(int a, int b) : value(a + b) { ++constructed; }
+
+  int value;
+};
+
+TEST(SwitchStrTest, LazyValues) {
+  using swstr::SwitchStr;
+
+  Counted::constructed = 0;
+  EXPECT_EQ(2, SwitchStr<Counted>("bar")
+                   .Case("foo", 1)
+                   .Case("bar", 2)
+                   .Case("bar", 3)
+                   .Case("baz", 4)
+                   .Default(42)
+                   .value);
+  EXPECT_EQ(Counted::constructed, 1);
+
+  int invoked = 0;
+  const auto make = [&invoked](int v) {
+    return [&invoked, v] {
+      ++invoked;
+      return Counted(v);
+    };
+  };
+
+  Counted::constructed = 0;
+  EXPECT_EQ(2, SwitchStr<Counted>("bar")
+                   .Case("foo", make(1))
+                   .Case("bar", make(2))
+                   .Case("bar", make(3))
+                   .Default(42)
+                   .value);
+  EXPECT_EQ(invoked, 1);
+  EXPECT_EQ(Counted::constructed, 1);
+
+  Counted::constructed = 0;
+  EXPECT_EQ(5, SwitchStr<Counted>("bar")
+                   .Emplace("foo", 1, 1)
+                   .Emplace("bar", 2, 3)
+                   .Emplace("bar", 3, 3)
+                   .Default(42)
+                   .value);
+  EXPECT_EQ(Counted::constructed, 1);
+
+  EXPECT_EQ("bar!", SwitchStr<std::string>("bar")
+                        .Case("foo", "foo!")
+                        .Case("bar", [] { return std::string("bar!"); })
+                        .Default("none"));
+}
+
+TEST(SwitchStrTest, MatchSpan) {
+  using swstr::Contains;
+  using swstr::MatchSpan;
+  using swstr::StartsWith;
+  using swstr::SwitchStr;
+
+  using Header = std::pair<std::string_view, std::string_view>;
+  const auto parse = [](std::string_view line) {
+    return SwitchStr<Header>(line)
+        .Case(StartsWith("#"), Header{})
+        .Case(Contains(": "),
+              [&](MatchSpan sep) {
+                return Header{sep.Before(line), sep.After(line)};
+              })
+        .Case(Contains(':'),
+              [&](MatchSpan sep) {
+                return Header{sep.Before(line), sep.After(line)};
+              })
+        .Default(Header{line, ""});
+  };
+
+  EXPECT_EQ(parse("Host: example.com"), Header("Host", "example.com"));
+  EXPECT_EQ(parse("Host:example.com"), Header("Host", "example.com"));
+  EXPECT_EQ(parse("# Host: example.com"), Header());
+  EXPECT_EQ(parse("Host"), Header("Host", ""));
+
+  // The chars matched
+  EXPECT_EQ("value", SwitchStr<std::string>("key=value")
+                         .Case(Contains("none"),
+                               [](std::string_view) -> std::string {
+                                 ADD_FAILURE() << "Should not be invoked";
+                                 return "";
+                               })
+                         .Case(Contains("value"),
+                               [](std::string_view found) {
+                                 return std::string(found);
+                               })
+                         .Default("none"));
+}
+
+TEST(SwitchStrTest, ReferenceMode) {
+  using swstr::SwitchStr;
+
+  static const std::string kFoo = "foo";
+  static const std::string kBar = "bar";
+  static const std::string kNone = "none";
+
+  const std::string& found = SwitchStr<const std::string&>("bar")
+                                 .Case("foo", kFoo)
+                                 .Case("bar", kBar)
+                                 .Default(kNone);
+  EXPECT_EQ(&found, &kBar);
+
+  const std::string& not_found = SwitchStr<const std::string&>("baz")
+                                     .Case("foo", kFoo)
+                                     .Case("bar", kBar)
+                                     .Default(kNone);
+  EXPECT_EQ(&not_found, &kNone);
+
+  int a = 0;
+  int b = 0;
+  SwitchStr<int&>("b").Case("a", a).Case("b", b).Default(a) = 42;
+  EXPECT_EQ(a, 0);
+  EXPECT_EQ(b, 42);
+}
+
 }  // namespace
@@ -0,0 +1,199 @@
+#include <string>
+#include <string_view>
+
+#include "MatcherMock.hpp"
+#include "SwitchStr/SwitchStr.hpp"
+#include "SwitchStr/SwitchTable.hpp"
+#include "gmock/gmock.h"
+#include "gtest/gtest.h"
+
+namespace {
+
+TEST(SwitchTableTest, Strategy) {
+  using swstr::Contains;
+  using swstr::EndsWith;
+  using swstr::Equals;
+  using swstr::StartsWith;
+  using Table = swstr::SwitchTable<int>;
+
+  EXPECT_EQ(Table::Builder().Build().GetStrategy(), Table::Strategy::kLinear);
+  EXPECT_EQ(Table::Builder().Build().LookupOr("foo", 42), 42);
+
+  EXPECT_EQ(Table::Builder()
+                .Case(Equals("a"), 0)
+                .Case(StartsWith("b"), 1)
+                .Build()
+                .GetStrategy(),
+            Table::Strategy::kLinear);
+
+  EXPECT_EQ(Table::Builder()
+                .Case(Equals("a"), 0)
+                .Case(Equals("b"), 1)
+                .Case("c", 2)
+                .Case(Equals("d"), 3)
+                .Case(Equals("e"), 4)
+                .Build()
+                .GetStrategy(),
+            Table::Strategy::kHash);
+
+  EXPECT_EQ(Table::Builder()
+                .Case(Equals("a"), 0)
+                .Case(Equals("b"), 1)
+                .Case(StartsWith("c"), 2)
+                .Case(EndsWith("d"), 3)
+                .Case(Contains("e"), 4)
+                .Build()
+                .GetStrategy(),
+            Table::Strategy::kTrie);
+
+  EXPECT_EQ(Table::Builder()
+                .Case(Contains("a"), 0)
+                .Case(Contains("b"), 1)
+                .Case(Contains("c"), 2)
+                .Case(Contains("d"), 3)
+                .Case(Contains("e"), 4)
+                .Build()
+                .GetStrategy(),
+            Table::Strategy::kLinear);
+}
+
+TEST(SwitchTableTest, Hash) {
+  using swstr::Equals;
+
+  // Keys sharing their size and first/last 8 bytes collide with QuickHashStr
+  const std::string keys[] = {
+      "/api/v1/users/list/all", "/api/v1/group/list/all",
+      "/api/v1/posts/list/all", "/api/v1/users/list/all",
+      "GET",                    "",
+  };
+
+  auto builder = swstr::SwitchTable<int>::Builder();
+  for (int i = 0; i < 6; ++i) {
+    builder.Case(Equals(keys[i]), i);
+  }
+
+  const auto table = builder.Build();
+  ASSERT_EQ(table.GetStrategy(), swstr::SwitchTable<int>::Strategy::kHash);
+
+  EXPECT_EQ(table.LookupOr("/api/v1/users/list/all", 42), 0);
+  EXPECT_EQ(table.LookupOr("/api/v1/group/list/all", 42), 1);
+  EXPECT_EQ(table.LookupOr("/api/v1/posts/list/all", 42), 2);
+  EXPECT_EQ(table.LookupOr("GET", 42), 4);
+  EXPECT_EQ(table.LookupOr("", 42), 5);
+  EXPECT_EQ(table.LookupOr("/api/v1/other/list/all", 42), 42);
+  EXPECT_EQ(table.LookupOr("GE", 42), 42);
+  EXPECT_EQ(table.LookupOr("GETS", 42), 42);
+}
+
+TEST(SwitchTableTest, SameAsSwitchStr) {
+  using swstr::Contains;
+  using swstr::EndsWith;
+  using swstr::Equals;
+  using swstr::StartsWith;
+  using swstr::SwitchStr;
+
+  // Patterns are copied, they don't need to outlive the table
+  auto builder = swstr::SwitchTable<std::string>::Builder();
+  {
+    const std::string api = "/api/";
+    builder.Case(StartsWith("/api/v2/"), "0")
+        .Case(EndsWith(".json"), "1")
+        .Case(StartsWith(api), "2")
+        .Case(Equals("/"), "3")
+        .Case("/index.html", "4")
+        .Case(Contains("admin"), "5")
+        .Case(EndsWith(".html"), "6")
+        .Case(StartsWith("/static/"), "7")
+        .Case(Equals(api), "8")
+        .Case(EndsWith("/"), "9");
+  }
+
+  const auto table = builder.Build();
+  EXPECT_EQ(table.GetStrategy(),
+            swstr::SwitchTable<std::string>::Strategy::kTrie);
+  EXPECT_EQ(table.Size(), 10);
+
+  for (std::string_view str :
+       {"", "/", "/api", "/api/", "/api/v1/users", "/api/v2/users",
+        "/api/v2/users.json", "/users.json", "/index.html", "/about.html",
+        "/static/main.js", "/static/index.html", "/static/", "/foo/",
+        "api/", ".json", "json", "/api/v2/", "/admin/", "/admin.html"}) {
+    SCOPED_TRACE(str);
+
+    EXPECT_EQ(SwitchStr<std::string>(str)
+                  .Case(StartsWith("/api/v2/"), "0")
+                  .Case(EndsWith(".json"), "1")
+                  .Case(StartsWith("/api/"), "2")
+                  .Case(Equals("/"), "3")
+                  .Case("/index.html", "4")
+                  .Case(Contains("admin"), "5")
+                  .Case(EndsWith(".html"), "6")
+                  .Case(StartsWith("/static/"), "7")
+                  .Case(Equals("/api/"), "8")
+                  .Case(EndsWith("/"), "9")
+                  .Default("42"),
+              table.LookupOr(str, "42"));
+  }
+}
+
+TEST(SwitchTableTest, FixedLiterals) {
+  using swstr::EndsWith;
+  using swstr::Equals;
+  using swstr::StartsWith;
+  using Table = swstr::SwitchTable<int>;
+
+  // Compile time literals are looked up inside the tables too
+  const auto table = Table::Builder()
+                         .Case(Equals<"a">(), 0)
+                         .Case(Equals<"b">(), 1)
+                         .Case(Equals<"c">(), 2)
+                         .Case(Equals<"d">(), 3)
+                         .Case(Equals<"e">(), 4)
+                         .Build();
+  EXPECT_EQ(table.GetStrategy(), Table::Strategy::kHash);
+  EXPECT_EQ(table.LookupOr("c", 42), 2);
+  EXPECT_EQ(table.LookupOr("f", 42), 42);
+
+  const auto affixes = Table::Builder()
+                           .Case(StartsWith<"/api/">(), 0)
+                           .Case(EndsWith<".html">(), 1)
+                           .Build();
+  EXPECT_EQ(affixes.LookupOr("/api/users", 42), 0);
+  EXPECT_EQ(affixes.LookupOr("/index.html", 42), 1);
+  EXPECT_EQ(affixes.LookupOr("/index.htm", 42), 42);
+}
+
+TEST(SwitchTableTest, Linear) {
+  using swstr::EndsWith;
+  using swstr::Equals;
+  using swstr::StartsWith;
+
+  using helper::MatcherMock;
+  auto mock = MatcherMock::MakeMockPtr();
+
+  const auto table = swstr::SwitchTable<int>::Builder()
+                         .Case(StartsWith("foo"), 0)
+                         .Case(MatcherMock(mock), 1)
+                         .Case(EndsWith("bar"), 2)
+                         .Case(Equals("baz"), 3)
+                         .Build();
+  ASSERT_EQ(table.GetStrategy(), swstr::SwitchTable<int>::Strategy::kLinear);
+
+  using testing::Return;
+  EXPECT_CALL(*mock, IsMatching("foobar")).Times(0);
+  EXPECT_EQ(table.LookupOr("foobar", 42), 0);
+
+  EXPECT_CALL(*mock, IsMatching("baz"))
+      .Times(1)
+      .WillOnce(Return(false))
+      .RetiresOnSaturation();
+  EXPECT_EQ(table.LookupOr("baz", 42), 3);
+
+  EXPECT_CALL(*mock, IsMatching("bar"))
+      .Times(1)
+      .WillOnce(Return(true))
+      .RetiresOnSaturation();
+  EXPECT_EQ(table.LookupOr("bar", 42), 1);
+}
+
+}  // namespace
@@ -0,0 +1,120 @@
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include "SwitchStr/TokenSwitch.hpp"
+#include "gmock/gmock.h"
+#include "gtest/gtest.h"
+
+namespace {
+
+TEST(TokenSwitchTest, SplitToken) {
+  using swstr::details::ByteSet;
+  using swstr::details::SplitToken;
+
+  constexpr ByteSet kBlanks(" \t");
+  static_assert(SplitToken("get key", kBlanks).token == "get");
+  static_assert(SplitToken("get key", kBlanks).rest == "key");
+  static_assert(SplitToken(" \tget \t key value ", kBlanks).token == "get");
+  static_assert(SplitToken(" \tget \t key value ", kBlanks).rest ==
+                "key value ");
+  static_assert(SplitToken("get", kBlanks).token == "get");
+  static_assert(SplitToken("get", kBlanks).rest.empty());
+  static_assert(SplitToken("get   ", kBlanks).rest.empty());
+  static_assert(SplitToken("", kBlanks).token.empty());
+  static_assert(SplitToken("  ", kBlanks).token.empty());
+
+  // Long enough for the SIMD kernels
+  const std::string line = std::string(40, 'a') + "\t" + std::string(40, 'b');
+  const auto split = SplitToken(line, kBlanks);
+  EXPECT_EQ(split.token, std::string(40, 'a'));
+  EXPECT_EQ(split.rest, std::string(40, 'b'));
+
+  // The views point inside the input, nothing is copied
+  EXPECT_EQ(split.token.data(), line.data());
+  EXPECT_EQ(split.rest.data(), line.data() + 41);
+}
+
+TEST(TokenSwitchTest, Simple) {
+  using swstr::StartsWith;
+  using swstr::TokenSwitch;
+
+  const auto command = [](std::string_view line) -> std::string {
+    return TokenSwitch<std::string>(line)
+        .Case("get",
+              [](std::string_view key) { return "GET " + std::string(key); })
+        .Case(StartsWith("del"),
+              [](std::string_view key) { return "DEL " + std::string(key); })
+        .Case("ping", "PONG")
+        .Case("quit", [] { return std::string("BYE"); })
+        .Default("ERR");
+  };
+
+  EXPECT_EQ(command("get key"), "GET key");
+  EXPECT_EQ(command("  get   key  "), "GET key  ");
+  EXPECT_EQ(command("delete key"), "DEL key");
+  EXPECT_EQ(command("ping"), "PONG");
+  EXPECT_EQ(command("ping extra args"), "PONG");
+  EXPECT_EQ(command("quit"), "BYE");
+  EXPECT_EQ(command("getkey"), "ERR");
+  EXPECT_EQ(command(""), "ERR");
+
+  const TokenSwitch<int> split(" set;key=value", "; ");
+  EXPECT_EQ(split.Token(), "set");
+  EXPECT_EQ(split.Rest(), "key=value");
+}
+
+TEST(TokenSwitchTest, CommandTree) {
+  using swstr::TokenSwitch;
+
+  std::vector<std::string> args;
+  const auto git = [&args](std::string_view line) -> int {
+    args.clear();
+    const auto remote = [&args](std::string_view rest) {
+      return TokenSwitch<int>(rest)
+          .Case("add",
+                [&args](std::string_view remote_args) {
+                  const TokenSwitch<int> name(remote_args);
+                  args = {std::string(name.Token()),
+                          std::string(name.Rest())};
+                  return 1;
+                })
+          .Case("remove", 2)
+          .Default(-2);
+    };
+
+    return TokenSwitch<int>(line)
+        .Case("status", 0)
+        .Case("remote", remote)
+        .Default(-1);
+  };
+
+  EXPECT_EQ(git("status"), 0);
+  EXPECT_EQ(git("remote add origin https://example.com/repo.git"), 1);
+  EXPECT_THAT(args, testing::ElementsAre("origin",
+                                         "https://example.com/repo.git"));
+  EXPECT_EQ(git("remote remove origin"), 2);
+  EXPECT_EQ(git("remote rename a b"), -2);
+  EXPECT_EQ(git("push"), -1);
+}
+
+TEST(TokenSwitchTest, LazyValues) {
+  using swstr::TokenSwitch;
+
+  int invoked = 0;
+  const auto make = [&invoked](int v) {
+    return [&invoked, v](std::string_view) {
+      ++invoked;
+      return v;
+    };
+  };
+
+  EXPECT_EQ(2, TokenSwitch<int>("bar baz")
+                   .Case("foo", make(1))
+                   .Case("bar", make(2))
+                   .Case("bar", make(3))
+                   .Default(42));
+  EXPECT_EQ(invoked, 1);
+}
+
+}  // namespace
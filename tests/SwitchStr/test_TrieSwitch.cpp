@@ -0,0 +1,147 @@
+#include "MatcherMock.hpp"
+#include "SwitchStr/SwitchStr.hpp"
+#include "SwitchStr/TrieSwitch.hpp"
+#include "gmock/gmock.h"
+#include "gtest/gtest.h"
+
+namespace {
+
+TEST(TrieSwitchTest, Simple) {
+  using swstr::EndsWith;
+  using swstr::Equals;
+  using swstr::StartsWith;
+  using swstr::TrieSwitch;
+
+  EXPECT_EQ(TrieSwitch<int>().Lookup(""), nullptr);
+  EXPECT_EQ(TrieSwitch<int>().LookupOr("foo", 42), 42);
+
+  const auto trie = TrieSwitch<int>()
+                        .Case(Equals("foo"), 0)
+                        .Case(StartsWith("foo"), 1)
+                        .Case(EndsWith("bar"), 2)
+                        .Case("", 3)
+                        .Case(StartsWith("ba"), 4);
+
+  EXPECT_EQ(trie.LookupOr("foo", 42), 0);
+  EXPECT_EQ(trie.LookupOr("foobar", 42), 1);
+  EXPECT_EQ(trie.LookupOr("bar", 42), 2);
+  EXPECT_EQ(trie.LookupOr("", 42), 3);
+  EXPECT_EQ(trie.LookupOr("baz", 42), 4);
+  EXPECT_EQ(trie.LookupOr("fo", 42), 42);
+  EXPECT_EQ(trie.LookupOr("abar", 42), 2);
+  EXPECT_EQ(trie.LookupOr("bbar", 42), 2);
+  EXPECT_EQ(trie.LookupOr("bb", 42), 42);
+}
+
+TEST(TrieSwitchTest, FirstDeclaredWins) {
+  using swstr::EndsWith;
+  using swstr::Equals;
+  using swstr::StartsWith;
+  using swstr::TrieSwitch;
+
+  const auto trie = TrieSwitch<int>()
+                        .Case(EndsWith("o"), 0)
+                        .Case(StartsWith("f"), 1)
+                        .Case(Equals("foo"), 2)
+                        .Case(StartsWith(""), 3)
+                        .Case(Equals("bar"), 4);
+
+  EXPECT_EQ(trie.LookupOr("foo", 42), 0);
+  EXPECT_EQ(trie.LookupOr("fob", 42), 1);
+  EXPECT_EQ(trie.LookupOr("bar", 42), 3);
+  EXPECT_EQ(trie.LookupOr("", 42), 3);
+}
+
+TEST(TrieSwitchTest, SameAsSwitchStr) {
+  using swstr::EndsWith;
+  using swstr::Equals;
+  using swstr::StartsWith;
+  using swstr::SwitchStr;
+  using swstr::TrieSwitch;
+
+  const auto trie = TrieSwitch<int>()
+                        .Case(StartsWith("/api/v2/"), 0)
+                        .Case(EndsWith(".json"), 1)
+                        .Case(StartsWith("/api/"), 2)
+                        .Case(Equals("/"), 3)
+                        .Case("/index.html", 4)
+                        .Case(EndsWith(".html"), 5)
+                        .Case(StartsWith("/static/"), 6)
+                        .Case(Equals("/api/"), 7)
+                        .Case(EndsWith("/"), 8);
+
+  for (std::string_view str :
+       {"", "/", "/api", "/api/", "/api/v1/users", "/api/v2/users",
+        "/api/v2/users.json", "/users.json", "/index.html", "/about.html",
+        "/static/main.js", "/static/index.html", "/static/", "/foo/",
+        "api/", ".json", "json", "/api/v2/"}) {
+    SCOPED_TRACE(str);
+
+    EXPECT_EQ(SwitchStr<int>(str)
+                  .Case(StartsWith("/api/v2/"), 0)
+                  .Case(EndsWith(".json"), 1)
+                  .Case(StartsWith("/api/"), 2)
+                  .Case(Equals("/"), 3)
+                  .Case("/index.html", 4)
+                  .Case(EndsWith(".html"), 5)
+                  .Case(StartsWith("/static/"), 6)
+                  .Case(Equals("/api/"), 7)
+                  .Case(EndsWith("/"), 8)
+                  .Default(42),
+              trie.LookupOr(str, 42));
+  }
+}
+
+TEST(TrieSwitchTest, OpaqueMatchers) {
+  using swstr::Contains;
+  using swstr::Equals;
+  using swstr::StartsWith;
+  using swstr::TrieSwitch;
+
+  using helper::MatcherMock;
+  auto mock = MatcherMock::MakeMockPtr();
+
+  const auto trie = TrieSwitch<int>()
+                        .Case(MatcherMock(mock), 0)
+                        .Case(StartsWith("foo"), 1)
+                        .Case(MatcherMock(mock), 2)
+                        .Case(Contains("bar"), 3);
+
+  using testing::Return;
+  {
+    ::testing::InSequence seq;
+
+    // Only the opaque matcher declared before "foo" is called
+    EXPECT_CALL(*mock, IsMatching("foobar"))
+        .Times(1)
+        .WillOnce(Return(false))
+        .RetiresOnSaturation();
+
+    EXPECT_EQ(trie.LookupOr("foobar", 42), 1);
+  }
+
+  {
+    ::testing::InSequence seq;
+
+    EXPECT_CALL(*mock, IsMatching("bar"))
+        .Times(2)
+        .WillOnce(Return(false))
+        .WillOnce(Return(false))
+        .RetiresOnSaturation();
+
+    EXPECT_EQ(trie.LookupOr("bar", 42), 3);
+  }
+
+  {
+    ::testing::InSequence seq;
+
+    EXPECT_CALL(*mock, IsMatching("foo"))
+        .Times(1)
+        .WillOnce(Return(true))
+        .RetiresOnSaturation();
+
+    EXPECT_EQ(trie.LookupOr("foo", 42), 0);
+  }
+}
+
+}  // namespace
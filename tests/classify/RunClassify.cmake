@@ -0,0 +1,51 @@
+# Generate a log whose per rule counts are known, classify it with many
+# threads and tiny blocks (such that lines cross blocks boundaries), then
+# compare the counts.
+#
+# Expects:
+#  CLASSIFY - Path to the SwitchStr-classify executable
+#  WORK_DIR - Directory where the log is generated
+
+set(log "")
+foreach(i RANGE 1 200)
+  string(APPEND log
+    "GET /index.html\n"
+    "POST /api/users\n"
+    "DELETE /api/items error\n"
+    "PUT /static/page.html\n"
+    "\n"
+    )
+endforeach()
+# Last line without trailing new line
+string(APPEND log "GET /last")
+
+set(log_file "${WORK_DIR}/classify.log")
+file(WRITE "${log_file}" "${log}")
+
+set(expected
+  "200\tstarts:POST\n"
+  "200\tcontains:error\n"
+  "201\tstarts:GET\n"
+  "200\tends:.html\n"
+  "200\t(none)\n"
+  )
+string(CONCAT expected ${expected})
+
+foreach(threads 1 3)
+  execute_process(
+    COMMAND "${CLASSIFY}" -j ${threads} -b 64 "${log_file}"
+            starts:POST contains:error starts:GET ends:.html
+    OUTPUT_VARIABLE output
+    RESULT_VARIABLE result
+    )
+
+  if(NOT result EQUAL 0)
+    message(FATAL_ERROR "SwitchStr-classify failed (${result})")
+  endif()
+
+  if(NOT output STREQUAL expected)
+    message(FATAL_ERROR
+      "Unexpected counts with ${threads} threads:\n${output}\n"
+      "Expected:\n${expected}")
+  endif()
+endforeach()